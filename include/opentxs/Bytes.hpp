@@ -68,6 +68,16 @@ public:
         , cb_(cb)
     {
     }
+    // Takes ownership of a lock which the caller has already acquired
+    ProtectedView(
+        ViewType&& view,
+        std::unique_ptr<LockType> lock,
+        DestructCallback cb = {}) noexcept
+        : ViewWrapper<ViewType>(std::move(view))
+        , lock_(std::move(lock))
+        , cb_(cb)
+    {
+    }
     ProtectedView() noexcept = default;
     ProtectedView(const ProtectedView&) = delete;
     ProtectedView(ProtectedView&&) = default;
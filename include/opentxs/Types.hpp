@@ -22,9 +22,11 @@
 #include <tuple>
 #include <vector>
 
+#define OPENTXS_ARG_ASIO_THREADS "asiothreads"
 #define OPENTXS_ARG_BACKUP_DIRECTORY "backupdirectory"
 #define OPENTXS_ARG_BINDIP "bindip"
 #define OPENTXS_ARG_BLOCKCHAIN_SYNC "blockchainsync"
+#define OPENTXS_ARG_BLOCK_CACHE_SIZE "blockcachesize"
 #define OPENTXS_ARG_BLOCK_STORAGE_LEVEL "blockstoragelevel"
 #define OPENTXS_ARG_COMMANDPORT "commandport"
 #define OPENTXS_ARG_DISABLED_BLOCKCHAINS "disabledblockchain"
@@ -40,6 +42,7 @@
 #define OPENTXS_ARG_LOGENDPOINT "logendpoint"
 #define OPENTXS_ARG_LOGLEVEL "log_level"
 #define OPENTXS_ARG_NAME "name"
+#define OPENTXS_ARG_NOTARY_THREADS "notarythreads"
 #define OPENTXS_ARG_NOTIFICATIONPORT "notificationport"
 #define OPENTXS_ARG_ONION "onion"
 #define OPENTXS_ARG_PASSPHRASE "passphrase"
@@ -48,6 +51,7 @@
 #define OPENTXS_ARG_RESET_HEADER_DB "resetheaderdb"
 #define OPENTXS_ARG_STORAGE_PLUGIN "storageplugin"
 #define OPENTXS_ARG_TERMS "terms"
+#define OPENTXS_ARG_VERIFY_CACHE "verifycache"
 #define OPENTXS_ARG_VERSION "version"
 #define OPENTXS_ARG_WORDS "words"
 
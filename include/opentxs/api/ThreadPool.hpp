@@ -36,6 +36,7 @@ class ThreadPool
 public:
     using Message = opentxs::network::zeromq::Message;
     using Callback = std::function<void(const Message&)>;
+    using Job = std::function<void()>;
     using WorkType = OTZMQWorkType;
 
     OPENTXS_EXPORT static auto Capacity() noexcept -> std::size_t;
@@ -46,6 +47,9 @@ public:
     OPENTXS_EXPORT virtual auto Endpoint() const noexcept -> std::string = 0;
     OPENTXS_EXPORT virtual auto Register(WorkType type, Callback handler)
         const noexcept -> bool = 0;
+    // Runs a job on the pool without serializing it into a message. Returns
+    // false if the pool has been shut down.
+    OPENTXS_EXPORT virtual auto Run(Job&& job) const noexcept -> bool = 0;
 
     virtual ~ThreadPool() = default;
 
@@ -11,6 +11,8 @@
 
 #include "opentxs/Version.hpp"  // IWYU pragma: associated
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 #include <vector>
@@ -45,16 +47,34 @@ public:
     using Socket = opentxs::network::asio::Socket;
     using Resolved = std::vector<Endpoint>;
 
+    // Activity of one io_context thread since startup. Queued and handled
+    // counts include socket connect, read and write operations, which are
+    // queued until their completion handlers run. Latency is the time between
+    // a callback being posted and starting to run, and is not measured for
+    // socket operations because they wait on the peer.
+    struct ThreadStatistics {
+        std::size_t sockets_{};
+        std::size_t queued_{};
+        std::size_t handled_{};
+        std::chrono::microseconds average_latency_{};
+        std::chrono::microseconds max_latency_{};
+    };
+
     OPENTXS_EXPORT auto MakeSocket(const Endpoint& endpoint) const noexcept
         -> Socket;
     OPENTXS_EXPORT auto NotificationEndpoint() const noexcept -> const char*;
     OPENTXS_EXPORT auto Resolve(std::string_view server, std::uint16_t port)
         const noexcept -> Resolved;
+    OPENTXS_EXPORT auto Statistics() const noexcept
+        -> std::vector<ThreadStatistics>;
 
     auto Init() noexcept -> void;
     auto Shutdown() noexcept -> void;
 
-    Asio(const opentxs::network::zeromq::Context& zmq) noexcept;
+    // A thread count of zero chooses one based on the number of cores
+    Asio(
+        const opentxs::network::zeromq::Context& zmq,
+        const unsigned int threads = 0) noexcept;
 
     ~Asio();
 
@@ -21,6 +21,7 @@ namespace storage
 class Driver
 {
 public:
+    virtual bool Delete(const std::string& key) const = 0;
     virtual bool EmptyBucket(const bool bucket) const = 0;
 
     virtual bool Load(
@@ -8,6 +8,7 @@
 
 #include "opentxs/Version.hpp"  // IWYU pragma: associated
 
+#include <cstddef>
 #include <future>
 #include <memory>
 #include <vector>
@@ -30,6 +31,18 @@ public:
     using BlockHashes = std::vector<block::pHash>;
     using BitcoinBlockFutures = std::vector<BitcoinBlockFuture>;
 
+    struct CacheStats {
+        std::size_t hits_{};
+        std::size_t misses_{};
+        std::size_t evictions_{};
+        std::size_t blocks_{};
+        std::size_t bytes_{};
+        std::size_t limit_{};
+    };
+
+    /// Counters for the in-memory block cache
+    OPENTXS_EXPORT virtual auto CacheStatistics() const noexcept
+        -> CacheStats = 0;
     OPENTXS_EXPORT virtual auto LoadBitcoin(
         const block::Hash& block) const noexcept -> BitcoinBlockFuture = 0;
     OPENTXS_EXPORT virtual auto LoadBitcoin(
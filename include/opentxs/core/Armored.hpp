@@ -35,6 +35,8 @@ extern const char* OT_END_ARMORED_escaped;
 extern const char* OT_BEGIN_SIGNED;
 extern const char* OT_BEGIN_SIGNED_escaped;
 
+extern const char* OT_UNARMORED_PROBE;
+
 /** The natural state of Armored is in compressed and base64-encoded,
  string form.
 
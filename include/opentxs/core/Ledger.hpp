@@ -15,6 +15,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
@@ -86,6 +87,14 @@ public:
 
     bool LoadedLegacyData() const { return m_bLoadedLegacyData; }
 
+    // In lazy mode the abbreviated records of a box are kept in a compact
+    // sorted index when it is loaded, and each one becomes an OTTransaction
+    // only when it is accessed. The box receipts which VerifyAccount() would
+    // load are then loaded one at a time, as their records are accessed.
+    // Must be set before the box is loaded.
+    bool IsLazy() const { return m_bLazy; }
+    void SetLazy(const bool lazy) { m_bLazy = lazy; }
+
     // This function assumes that this is an INBOX.
     // If you don't use an INBOX to call this method, then it will return
     // nullptr immediately. If you DO use an inbox, then it will create a
@@ -207,7 +216,8 @@ public:
     // inline for the top one only.
     inline std::int32_t GetTransactionCount() const
     {
-        return static_cast<std::int32_t>(m_mapTransactions.size());
+        return static_cast<std::int32_t>(
+            m_mapTransactions.size() + m_abbreviated.size());
     }
     std::int32_t GetTransactionCountInRefTo(std::int64_t lReferenceNum) const;
     std::int64_t GetTotalPendingValue(
@@ -265,8 +275,50 @@ private:  // Private prevents erroneous use by other classes.
 
     using ot_super = OTTransactionType;
 
-    mapOfTransactions m_mapTransactions;  // a ledger contains a map of
-                                          // transactions.
+    // An abbreviated record which has not been turned into an OTTransaction
+    struct Abbreviated {
+        TransactionNumber number_;
+        transactionType type_;
+        originType origin_type_;
+        bool reply_success_;
+        std::int64_t adjustment_;
+        std::int64_t display_value_;
+        std::int64_t number_of_origin_;
+        std::int64_t in_ref_to_;
+        std::int64_t in_ref_display_;
+        std::int64_t closing_num_;
+        std::int64_t request_num_;
+        Time date_signed_;
+        std::string hash_;
+        // totalListOfNumbers, for nymbox records
+        std::string numbers_;
+    };
+    using Index = std::vector<Abbreviated>;
+
+    bool m_bLazy;
+    // Set when VerifyAccount() has deferred loading box receipts in lazy mode
+    mutable bool m_bLoadReceipts;
+    // Records not yet accessed in lazy mode, sorted by transaction number. A
+    // number is never in both this and m_mapTransactions.
+    mutable Index m_abbreviated;
+    mutable mapOfTransactions m_mapTransactions;  // a ledger contains a map of
+                                                  // transactions.
+    // Every transaction number in the ledger, in order, so transactions can
+    // be found by position. Materializing a record does not change it.
+    mutable std::vector<TransactionNumber> m_numbers;
+    mutable bool m_bNumbersValid;
+
+    bool contains(const TransactionNumber number) const;
+    Index::iterator find_abbreviated(const TransactionNumber number) const;
+    std::unique_ptr<OTTransaction> instantiate(
+        const Abbreviated& record) const;
+    std::shared_ptr<OTTransaction> materialize(Index::iterator it) const;
+    void materialize_all() const;
+    std::shared_ptr<OTTransaction> materialize_record(
+        const Abbreviated& record) const;
+    void materialize_type(const transactionType type) const;
+    const std::vector<TransactionNumber>& numbers() const;
+    void numbers_changed() const;
 
     std::tuple<bool, std::string, std::string, std::string> make_filename(
         const ledgerType theType);
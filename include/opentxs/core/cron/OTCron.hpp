@@ -10,6 +10,7 @@
 
 #include <irrxml/irrXML.hpp>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <map>
@@ -51,6 +52,7 @@ class UnitDefinition;
 }  // namespace identifier
 
 class Armored;
+class CronSchedule;
 class Identifier;
 class OTCronItem;
 class OTMarket;
@@ -71,6 +73,22 @@ using listOfLongNumbers = std::list<std::int64_t>;
 class OTCron final : public Contract
 {
 public:
+    /** A round begins when one or more items become due and ends when no due
+     * items remain, which may take several calls to ProcessCronItems(). */
+    struct RoundStatistics {
+        // Items on cron when the round finished
+        std::size_t scheduled_{};
+        // Items which became due during the round. An item which is processed
+        // and becomes due again before the round ends is counted each time.
+        std::size_t due_{};
+        std::size_t processed_{};
+        std::size_t removed_{};
+        // Number of calls to ProcessCronItems() used by the round
+        std::size_t slices_{};
+        // Time spent processing, excluding time between slices
+        std::chrono::microseconds elapsed_{};
+    };
+
     static std::chrono::milliseconds GetCronMsBetweenProcess()
     {
         return __cron_ms_between_process;
@@ -151,10 +169,17 @@ public:
      * transaction numbers in there must be enough to last for the entire
      * ProcessCronItems() call, and all the trades and payment plans within,
      * since it will not be replenished again at least until the call has
-     * finished.) */
-    void ProcessCronItems();
-
-    std::chrono::milliseconds computeTimeout();
+     * finished.)
+     *
+     * Only items which are due are processed, and at most nLimit of them
+     * (0 for no limit) so the caller can yield between slices. Returns true
+     * if due items remain. */
+    bool ProcessCronItems(const std::size_t nLimit = 0);
+    /** Time remaining until the next item is due. Zero or negative if an item
+     * is due now. */
+    std::chrono::milliseconds computeTimeout() const;
+    /** Statistics for the most recently finished round. */
+    const RoundStatistics& LastRound() const;
 
     inline void SetNotaryID(const identifier::Server& NOTARY_ID)
     {
@@ -192,18 +217,22 @@ private:
     // Number of transaction numbers Cron  will grab for itself, when it gets
     // low, before each round.
     static std::int32_t __trans_refill_amount;
-    // Number of milliseconds (ideally) between each "Cron Process" event.
+    // Minimum number of milliseconds between each time a given cron item is
+    // processed.
     static std::chrono::milliseconds __cron_ms_between_process;
     // Int. The maximum number of cron items any given Nym can have
     // active at the same time.
     static std::int32_t __cron_max_items_per_nym;
-    static Time last_executed_;
 
     // A list of all valid markets.
     mapOfMarkets m_mapMarkets;
     // Cron Items are found on both lists.
     mapOfCronItems m_mapCronItems;
     multimapOfCronItems m_multimapCronItems;
+    // Where each item is found in m_multimapCronItems
+    std::map<std::int64_t, multimapOfCronItems::iterator> m_mapPositions;
+    // Every item on cron is scheduled, except while it is being processed.
+    std::unique_ptr<CronSchedule> m_pSchedule;
     // Always store this in any object that's associated with a specific server.
     OTServerID m_NOTARY_ID;
     // I can't put receipts in people's inboxes without a supply of these.
@@ -214,6 +243,8 @@ private:
     // I'll need this for later.
     Nym_p m_pServerNym{nullptr};
 
+    Time next_due(const OTCronItem& item, const Time now) const;
+
     explicit OTCron(const api::internal::Core& server);
 
     OTCron() = delete;
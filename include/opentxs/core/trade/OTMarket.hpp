@@ -9,8 +9,12 @@
 #include "opentxs/Version.hpp"  // IWYU pragma: associated
 
 #include <irrxml/irrXML.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "opentxs/Types.hpp"
@@ -53,6 +57,7 @@ class TradeListMarket;
 class Account;
 class Armored;
 class Identifier;
+class MarketJournal;
 class OTCron;
 class OTOffer;
 class OTTrade;
@@ -206,6 +211,38 @@ private:
 
     mapOfOffersTrnsNum m_mapOffers;  // All of the offers on a single list,
                                      // ordered by transaction number.
+    // Where each offer is found in m_mapBids or m_mapAsks
+    std::map<std::int64_t, mapOfOffers::iterator> m_mapOfferPositions;
+
+    // Aggregate of the offers at a single price
+    struct PriceLevel {
+        std::int64_t volume_{0};  // Sum of the amounts available
+        std::size_t count_{0};
+    };
+    using mapOfPriceLevels = std::map<std::int64_t, PriceLevel>;
+
+    // Kept in step with m_mapBids and m_mapAsks
+    mapOfPriceLevels m_mapBidLevels;
+    mapOfPriceLevels m_mapAskLevels;
+    std::int64_t m_lAskVolume{0};
+
+    // Packed market data, discarded whenever the book or the list of recent
+    // trades changes. A negative depth means the offer list is not cached.
+    // Market queries run concurrently, so these are only accessed while
+    // holding m_lockCache.
+    mutable std::mutex m_lockCache;
+    std::int64_t m_lOfferListDepth{-1};
+    std::int32_t m_nOfferListCount{0};
+    std::string m_strOfferList;
+    bool m_bTradeListCached{false};
+    std::int32_t m_nTradeListCount{0};
+    std::string m_strTradeList;
+
+    // Changes since the market file was last written. Created on first use,
+    // since the file name depends on the market ID.
+    std::unique_ptr<MarketJournal> m_pJournal;
+    // Incremented each time the market file is written
+    std::uint64_t m_lJournalSequence{0};
 
     OTServerID m_NOTARY_ID;  // Always store this in any object that's
                              // associated with a specific server.
@@ -248,6 +285,35 @@ private:
         const identifier::UnitDefinition& CURRENCY_TYPE_ID,
         const std::int64_t& lScale);
 
+    void book_changed();
+    void trades_changed();
+    MarketJournal* journal();
+    std::int64_t level_volume(
+        const mapOfPriceLevels& levels,
+        const std::int64_t lPrice) const;
+    std::unique_ptr<OTOffer> load_offer(const String& strOffer) const;
+    // Loads the signed market file and the list of recent trades
+    bool load_snapshot();
+    // Appends to the journal, or writes the whole market if the journal is
+    // unavailable or a snapshot is due.
+    bool record(
+        const std::function<bool(MarketJournal&)>& write,
+        const PasswordPrompt& reason);
+    void record_sale(
+        const std::int64_t lTransactionNum,
+        const Time tDate,
+        const std::int64_t lPrice,
+        const std::int64_t lAmountSold);
+    std::unique_ptr<OTOffer> remove_offer(const std::int64_t lTransactionNum);
+    bool replace_offer(std::unique_ptr<OTOffer> pOffer);
+    // Returns false if the journal is invalid or does not match the book, in
+    // which case it may have been partially applied
+    bool replay_journal(const PasswordPrompt& reason);
+    // Adds lVolume and lCount to the price level of an offer on this market
+    void update_level(
+        OTOffer& theOffer,
+        const std::int64_t lVolume,
+        const std::int64_t lCount);
     void rollback_four_accounts(
         Account& p1,
         bool b1,
@@ -10,6 +10,9 @@
 
 #include "opentxs/Version.hpp"  // IWYU pragma: associated
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -77,6 +80,22 @@ namespace zeromq
 class Context
 {
 public:
+    // Activity of the threads which poll subscribe sockets
+    struct ReactorStatistics {
+        // Polling threads
+        std::size_t threads_{};
+        // Threads which run callbacks
+        std::size_t workers_{};
+        std::size_t sockets_{};
+        // Number of times a polling thread returned from zmq_poll
+        std::uint64_t wakeups_{};
+        // Number of callbacks run because a socket task or endpoint was queued
+        std::uint64_t notifications_{};
+        // Time from queueing a task or endpoint until the callback started
+        std::chrono::microseconds average_latency_{};
+        std::chrono::microseconds max_latency_{};
+    };
+
     OPENTXS_EXPORT static bool RawToZ85(
         const ReadView input,
         const AllocateOutput output) noexcept;
@@ -186,6 +205,7 @@ public:
         const socket::Socket::Direction direction) const noexcept = 0;
     OPENTXS_EXPORT virtual Pimpl<network::zeromq::socket::Push> PushSocket(
         const socket::Socket::Direction direction) const noexcept = 0;
+    OPENTXS_EXPORT virtual ReactorStatistics ReactorStats() const noexcept = 0;
     OPENTXS_EXPORT virtual Pimpl<network::zeromq::Message> ReplyMessage(
         const zeromq::Message& request) const noexcept = 0;
     OPENTXS_EXPORT virtual Pimpl<network::zeromq::Message> ReplyMessage(
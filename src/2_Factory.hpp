@@ -979,6 +979,16 @@ public:
         const std::size_t size) -> network::zeromq::Frame*;
     OPENTXS_EXPORT static auto ZMQFrame(const ProtobufType& data)
         -> network::zeromq::Frame*;
+    // Refers to data without copying it. release(data, hint) is called once
+    // the last message referring to the data has been closed.
+    OPENTXS_EXPORT static auto ZMQFrame(
+        void* data,
+        const std::size_t size,
+        void (*release)(void*, void*),
+        void* hint) -> network::zeromq::Frame*;
+    // Takes the contents of the input frame without copying, leaving it empty
+    OPENTXS_EXPORT static auto ZMQFrame(network::zeromq::Frame& take)
+        -> network::zeromq::Frame*;
     OPENTXS_EXPORT static auto ZMQMessage() -> network::zeromq::Message*;
     OPENTXS_EXPORT static auto ZMQMessage(
         const void* data,
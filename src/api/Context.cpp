@@ -27,6 +27,7 @@ extern "C" {
 #include <vector>
 
 #include "2_Factory.hpp"
+#include "crypto/library/VerificationCache.hpp"
 #include "internal/api/Api.hpp"
 #include "internal/api/Factory.hpp"
 #include "internal/api/client/Client.hpp"
@@ -51,7 +52,7 @@ extern "C" {
 #include "opentxs/protobuf/RPCResponse.pb.h"
 #include "opentxs/util/Signals.hpp"
 
-// #define OT_METHOD "opentxs::api::implementation::Context::"
+#define OT_METHOD "opentxs::api::implementation::Context::"
 
 namespace opentxs::factory
 {
@@ -234,7 +235,24 @@ void Context::Init()
 
 void Context::Init_Asio()
 {
-    asio_ = std::make_unique<network::Asio>(zmq_context_);
+    // Zero lets Asio choose a thread count based on the number of cores
+    const auto threads = [&] {
+        const auto arg = get_arg(args_, OPENTXS_ARG_ASIO_THREADS);
+
+        if (arg.empty()) { return 0u; }
+
+        try {
+
+            return static_cast<unsigned int>(std::stoul(arg));
+        } catch (...) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid ")(
+                OPENTXS_ARG_ASIO_THREADS)(" value: ")(arg)
+                .Flush();
+
+            return 0u;
+        }
+    }();
+    asio_ = std::make_unique<network::Asio>(zmq_context_, threads);
 
     OT_ASSERT(asio_);
 
@@ -246,6 +264,21 @@ void Context::Init_Crypto()
     crypto_ = factory::Crypto(Config(legacy_->OpentxsConfigFilePath()));
 
     OT_ASSERT(crypto_);
+
+    // Deployments which do not want verified signatures remembered can set
+    // the capacity to zero
+    const auto capacity = get_arg(args_, OPENTXS_ARG_VERIFY_CACHE);
+
+    if (false == capacity.empty()) {
+        try {
+            opentxs::crypto::VerificationCache::Get().SetCapacity(
+                std::stoul(capacity));
+        } catch (...) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid ")(
+                OPENTXS_ARG_VERIFY_CACHE)(" value: ")(capacity)
+                .Flush();
+        }
+    }
 }
 
 void Context::Init_Profile()
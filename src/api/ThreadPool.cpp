@@ -57,7 +57,6 @@ auto ThreadPool::MakeWork(const zmq::Context& zmq, WorkType type) noexcept
 namespace opentxs::api::implementation
 {
 constexpr auto endpoint_{"inproc://opentxs//thread_pool/1"};
-constexpr auto internal_endpoint_{"inproc://opentxs//thread_pool/internal"};
 using Direction = zmq::socket::Socket::Direction;
 
 ThreadPool::ThreadPool(const zmq::Context& zmq) noexcept
@@ -65,33 +64,8 @@ ThreadPool::ThreadPool(const zmq::Context& zmq) noexcept
     , lock_()
     , map_()
     , running_(true)
-    , cbi_(zmq::ListenCallback::Factory([this](auto& in) { callback(in); }))
-    , workers_([&] {
-        auto out = Vector{};
-        const auto target = Capacity();
-        out.reserve(target);
-
-        for (unsigned int i{0}; i < target; ++i) {
-            auto& worker =
-                out.emplace_back(zmq_.PullSocket(cbi_, Direction::Connect));
-            const auto rc = worker->Start(internal_endpoint_);
-
-            OT_ASSERT(rc);
-
-            LogTrace("Started thread pool worker #")(i).Flush();
-        }
-
-        return out;
-    }())
-    , int_([&] {
-        auto out = zmq_.PushSocket(Direction::Bind);
-        const auto rc = out->Start(internal_endpoint_);
-
-        OT_ASSERT(rc);
-
-        return out;
-    }())
-    , cbe_(zmq::ListenCallback::Factory([this](auto& in) { int_->Send(in); }))
+    , executor_(Capacity())
+    , cbe_(zmq::ListenCallback::Factory([this](auto& in) { dispatch(in); }))
     , ext_([&] {
         auto out = zmq_.PullSocket(cbe_, Direction::Bind);
         const auto rc = out->Start(endpoint_);
@@ -103,7 +77,7 @@ ThreadPool::ThreadPool(const zmq::Context& zmq) noexcept
 {
 }
 
-auto ThreadPool::callback(zmq::Message& in) noexcept -> void
+auto ThreadPool::callback(const zmq::Message& in) const noexcept -> void
 {
     const auto header = in.Header();
 
@@ -122,8 +96,8 @@ auto ThreadPool::callback(zmq::Message& in) noexcept -> void
                 OT_FAIL;
             }
         }();
-        const auto& cb = [&] {
-            auto lock = Lock{lock_};
+        const auto& cb = [&]() -> const Callback& {
+            auto lock = sLock{lock_};
 
             try {
 
@@ -141,6 +115,18 @@ auto ThreadPool::callback(zmq::Message& in) noexcept -> void
     }
 }
 
+auto ThreadPool::dispatch(const zmq::Message& in) noexcept -> void
+{
+    // The message owned by the pull socket is reused after this returns
+    auto work = OTZMQMessage{in};
+    const auto queued = executor_.Submit(
+        [this, work = std::move(work)]() { callback(work); });
+
+    if (false == queued) {
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Pool is shut down").Flush();
+    }
+}
+
 auto ThreadPool::Endpoint() const noexcept -> std::string { return endpoint_; }
 
 auto ThreadPool::Register(WorkType type, Callback handler) const noexcept
@@ -152,7 +138,7 @@ auto ThreadPool::Register(WorkType type, Callback handler) const noexcept
         return false;
     }
 
-    auto lock = Lock{lock_};
+    auto lock = eLock{lock_};
     const auto [it, added] = map_.try_emplace(type, std::move(handler));
 
     return added;
@@ -162,8 +148,12 @@ auto ThreadPool::Shutdown() noexcept -> void
 {
     if (running_.exchange(false)) {
         ext_->Close();
-        int_->Close();
-        workers_.clear();
+        executor_.Shutdown();
     }
 }
+
+auto ThreadPool::Run(Job&& job) const noexcept -> bool
+{
+    return executor_.Submit(std::move(job));
+}
 }  // namespace opentxs::api::implementation
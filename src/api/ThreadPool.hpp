@@ -12,14 +12,13 @@
 
 #include <atomic>
 #include <map>
-#include <mutex>
-#include <vector>
+#include <shared_mutex>
 
 #include "internal/api/Api.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/ListenCallback.hpp"
 #include "opentxs/network/zeromq/socket/Pull.hpp"
-#include "opentxs/network/zeromq/socket/Push.hpp"
+#include "util/Executor.hpp"
 
 namespace opentxs
 {
@@ -42,6 +41,7 @@ class ThreadPool final : public internal::ThreadPool
 public:
     auto Endpoint() const noexcept -> std::string final;
     auto Register(WorkType type, Callback handler) const noexcept -> bool final;
+    auto Run(Job&& job) const noexcept -> bool final;
 
     auto Shutdown() noexcept -> void final;
 
@@ -51,19 +51,19 @@ public:
 
 private:
     using Map = std::map<WorkType, Callback>;
-    using Vector = std::vector<OTZMQPullSocket>;
 
     const opentxs::network::zeromq::Context& zmq_;
-    mutable std::mutex lock_;
+    mutable std::shared_mutex lock_;
+    // Handlers are never removed, so references into the map remain valid
+    // after lock_ is released
     mutable Map map_;
     std::atomic<bool> running_;
-    OTZMQListenCallback cbi_;
-    Vector workers_;
-    OTZMQPushSocket int_;
+    mutable Executor executor_;
     OTZMQListenCallback cbe_;
     OTZMQPullSocket ext_;
 
-    auto callback(zmq::Message& in) noexcept -> void;
+    auto callback(const zmq::Message& in) const noexcept -> void;
+    auto dispatch(const zmq::Message& in) noexcept -> void;
 
     ThreadPool() = delete;
     ThreadPool(const ThreadPool&) = delete;
@@ -13,6 +13,7 @@
 #include <iterator>
 #include <optional>
 #include <sstream>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
@@ -179,6 +180,17 @@ BlockchainImp::BlockchainImp(
         } catch (...) {
         }
 
+        try {
+            const auto& arg = args.at(OPENTXS_ARG_BLOCK_CACHE_SIZE);
+
+            if (0 < arg.size()) {
+                // NOTE specified in MiB
+                output.block_cache_bytes_ =
+                    std::stoul(*arg.cbegin()) * 1024u * 1024u;
+            }
+        } catch (...) {
+        }
+
         return output;
     }())
     , config_()
@@ -224,6 +236,8 @@ BlockchainImp::BlockchainImp(
     using Work = api::internal::ThreadPool::Work;
     using Wallet = opentxs::blockchain::client::internal::Wallet;
     using Filters = opentxs::blockchain::client::internal::FilterOracle;
+    using Scanner = opentxs::blockchain::client::internal::FilterScanner;
+    using Headers = opentxs::blockchain::client::internal::HeaderOracle;
     constexpr auto value = [](auto work) {
         return static_cast<OTZMQWorkType>(work);
     };
@@ -237,6 +251,12 @@ BlockchainImp::BlockchainImp(
     pool.Register(value(Work::CalculateBlockFilters), [](const auto& work) {
         Filters::ProcessThreadPool(work);
     });
+    pool.Register(value(Work::BlockchainFilterScan), [](const auto& work) {
+        Scanner::ProcessThreadPool(work);
+    });
+    pool.Register(value(Work::BlockchainHeaderValidate), [](const auto& work) {
+        Headers::ProcessThreadPool(work);
+    });
 }
 
 auto BlockchainImp::ActivityDescription(
@@ -21,7 +21,6 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
 #include "opentxs/protobuf/BlockchainFilterHeader.pb.h"
-#include "opentxs/protobuf/GCS.pb.h"
 #include "util/LMDB.hpp"
 
 #define OT_METHOD                                                              \
@@ -70,7 +69,7 @@ auto BlockFilter::LoadFilter(const FilterType type, const ReadView blockHash)
     auto cb = [this, &output](const auto in) {
         if ((nullptr == in.data()) || (0 == in.size())) { return; }
 
-        output = factory::GCS(api_, proto::Factory<proto::GCS>(in));
+        output = factory::GCS(api_, in);
     };
 
     try {
@@ -82,6 +81,41 @@ auto BlockFilter::LoadFilter(const FilterType type, const ReadView blockHash)
     return output;
 }
 
+auto BlockFilter::LoadFilters(
+    const FilterType type,
+    const std::vector<ReadView>& blocks,
+    const FilterCallback& cb) const noexcept -> std::size_t
+{
+    auto output = std::size_t{0};
+
+    try {
+        const auto table = translate_filter(type);
+        // The filters passed to cb refer to pages owned by this transaction
+        auto txn = lmdb_.TransactionRO();
+
+        for (const auto& block : blocks) {
+            auto filter = std::unique_ptr<opentxs::blockchain::client::GCS>{};
+            lmdb_.Load(
+                table,
+                block,
+                [&](const auto in) {
+                    if ((nullptr == in.data()) || (0 == in.size())) { return; }
+
+                    filter = factory::GCSView(api_, in);
+                },
+                txn);
+
+            if (false == bool(filter)) { break; }
+
+            cb(output++, *filter);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
+
+    return output;
+}
+
 auto BlockFilter::LoadFilterHash(
     const FilterType type,
     const ReadView blockHash,
@@ -191,10 +225,9 @@ auto BlockFilter::StoreFilters(
         OT_ASSERT(pFilter);
 
         const auto& filter = *pFilter;
-        const auto proto = filter.Serialize();
-        auto bytes = space(proto.ByteSize());
-        proto.SerializeWithCachedSizesToArray(
-            reinterpret_cast<std::uint8_t*>(bytes.data()));
+        auto bytes = Space{};
+
+        if (false == filter.Serialize(writer(bytes))) { return false; }
 
         try {
             const auto stored = lmdb_.Store(
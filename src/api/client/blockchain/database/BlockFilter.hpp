@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -54,6 +55,10 @@ public:
         const FilterType type,
         const ReadView blockHash,
         const AllocateOutput filterHash) const noexcept -> bool;
+    auto LoadFilters(
+        const FilterType type,
+        const std::vector<ReadView>& blocks,
+        const FilterCallback& cb) const noexcept -> std::size_t;
     auto LoadFilterHeader(
         const FilterType type,
         const ReadView blockHash,
@@ -40,6 +40,7 @@ Blocks::Blocks(
           Table::Config,
           static_cast<std::size_t>(Database::Key::NextBlockAddress))
     , table_(Table::BlockIndex)
+    , index_lock_()
     , lock_()
     , block_locks_()
 {
@@ -50,33 +51,83 @@ auto Blocks::Exists(const Hash& block) const noexcept -> bool
     return lmdb_.Exists(table_, block.Bytes());
 }
 
-auto Blocks::Load(const Hash& block) const noexcept -> BlockReader
+auto Blocks::get_lock(const Hash& block) const noexcept -> BlockLock
 {
     auto lock = Lock{lock_};
-    auto index = IndexData{};
-    auto cb = [&index](const auto in) {
-        if (sizeof(index) != in.size()) { return; }
+    auto& entry = block_locks_[block];
 
-        std::memcpy(static_cast<void*>(&index), in.data(), in.size());
-    };
-    lmdb_.Load(table_, block.Bytes(), cb);
+    if (auto output = entry.lock(); output) { return output; }
 
-    if (0 == index.size_) {
-        LogTrace(OT_METHOD)(__FUNCTION__)(": Block ")(block.asHex())(
-            " not found in index")
-            .Flush();
+    auto output = BlockLock{
+        new std::shared_mutex{}, [this, id = pHash{block}](auto* mutex) {
+            {
+                auto lock = Lock{lock_};
+                auto it = block_locks_.find(id);
 
-        return {};
+                // A new entry may have replaced this one before the lock was
+                // acquired
+                if ((block_locks_.end() != it) && it->second.expired()) {
+                    block_locks_.erase(it);
+                }
+            }
+
+            delete mutex;
+        }};
+    entry = output;
+
+    return output;
+}
+
+auto Blocks::LockedBlocks() const noexcept -> std::size_t
+{
+    auto lock = Lock{lock_};
+
+    return block_locks_.size();
+}
+
+auto Blocks::Load(const Hash& block) const noexcept -> BlockReader
+{
+    auto view = ReadView{};
+
+    {
+        // Concurrent loads only read the index, and the file containing an
+        // indexed block is always mapped already
+        auto lock = sLock{index_lock_};
+        const auto index = load_index(block);
+
+        if (0 == index.size_) {
+            LogTrace(OT_METHOD)(__FUNCTION__)(": Block ")(block.asHex())(
+                " not found in index")
+                .Flush();
+
+            return {};
+        }
+
+        view = get_read_view(index);
     }
 
-    return BlockReader{get_read_view(index), block_locks_[block]};
+    auto mutex = get_lock(block);
+
+    // The lock table entry is released along with the last view holding it
+    return BlockReader{std::move(view), *mutex, [mutex] {}};
+}
+
+auto Blocks::load_index(const Hash& block) const noexcept -> IndexData
+{
+    auto output = IndexData{};
+    auto cb = [&output](const auto in) {
+        if (sizeof(output) != in.size()) { return; }
+
+        std::memcpy(static_cast<void*>(&output), in.data(), in.size());
+    };
+    lmdb_.Load(table_, block.Bytes(), cb);
+
+    return output;
 }
 
 auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
     -> BlockWriter
 {
-    auto lock = Lock{lock_};
-
     if (0 == bytes) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Block ")(block.asHex())(
             " invalid block size")
@@ -85,17 +136,14 @@ auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
         return {};
     }
 
-    auto index = [&] {
-        auto output = IndexData{};
-        auto cb = [&output](const auto in) {
-            if (sizeof(output) != in.size()) { return; }
-
-            std::memcpy(static_cast<void*>(&output), in.data(), in.size());
-        };
-        lmdb_.Load(table_, block.Bytes(), cb);
-
-        return output;
-    }();
+    auto mutex = get_lock(block);
+    // The block is locked before the index so that waiting for readers of
+    // this block never prevents other blocks from being loaded or stored.
+    // Any reader which follows the updated index must then wait until the
+    // new contents have been written.
+    auto blockLock = std::make_unique<eLock>(*mutex);
+    auto lock = eLock{index_lock_};
+    auto index = load_index(block);
     auto cb = [&](auto& tx) -> bool {
         const auto result = lmdb_.Store(table_, block.Bytes(), tsv(index), tx);
 
@@ -119,6 +167,6 @@ auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
         return {};
     }
 
-    return BlockWriter{std::move(view), block_locks_[block]};
+    return BlockWriter{std::move(view), std::move(blockLock), [mutex] {}};
 }
 }  // namespace opentxs::api::client::blockchain::database::implementation
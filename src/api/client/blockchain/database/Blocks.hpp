@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -41,6 +43,8 @@ public:
 
     auto Exists(const Hash& block) const noexcept -> bool;
     auto Load(const Hash& block) const noexcept -> BlockReader;
+    // Number of blocks which currently have a reader or writer
+    auto LockedBlocks() const noexcept -> std::size_t;
     auto Store(const Hash& block, const std::size_t bytes) const noexcept
         -> BlockWriter;
 
@@ -49,8 +53,16 @@ public:
         const std::string& path) noexcept(false);
 
 private:
+    using BlockLock = std::shared_ptr<std::shared_mutex>;
+
     const int table_;
+    // Guards the index and the mapped files. Loads only need it shared.
+    mutable std::shared_mutex index_lock_;
     mutable std::mutex lock_;
-    mutable std::map<pHash, std::shared_mutex> block_locks_;
+    // Entries exist only while a reader or writer for the block is alive
+    mutable std::map<pHash, std::weak_ptr<std::shared_mutex>> block_locks_;
+
+    auto get_lock(const Hash& block) const noexcept -> BlockLock;
+    auto load_index(const Hash& block) const noexcept -> IndexData;
 };
 }  // namespace opentxs::api::client::blockchain::database::implementation
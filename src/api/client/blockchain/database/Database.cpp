@@ -455,6 +455,14 @@ auto Database::LoadFilter(const FilterType type, const ReadView blockHash)
     return imp_.filters_.LoadFilter(type, blockHash);
 }
 
+auto Database::LoadFilters(
+    const FilterType type,
+    const std::vector<ReadView>& blocks,
+    const FilterCallback& cb) const noexcept -> std::size_t
+{
+    return imp_.filters_.LoadFilters(type, blocks, cb);
+}
+
 auto Database::LoadFilterHash(
     const FilterType type,
     const ReadView blockHash,
@@ -8,14 +8,17 @@
 #include "opentxs/api/network/Asio.hpp"  // IWYU pragma: associated
 
 #include <memory>
+#include <vector>
 
 #include "api/network/Asio.hpp"
 #include "opentxs/network/asio/Socket.hpp"
 
 namespace opentxs::api::network
 {
-Asio::Asio(const opentxs::network::zeromq::Context& zmq) noexcept
-    : imp_(std::make_unique<Imp>(zmq).release())
+Asio::Asio(
+    const opentxs::network::zeromq::Context& zmq,
+    const unsigned int threads) noexcept
+    : imp_(std::make_unique<Imp>(zmq, threads).release())
 {
 }
 
@@ -40,5 +43,10 @@ auto Asio::Resolve(std::string_view server, std::uint16_t port) const noexcept
 
 auto Asio::Shutdown() noexcept -> void { imp_->Shutdown(); }
 
+auto Asio::Statistics() const noexcept -> std::vector<ThreadStatistics>
+{
+    return imp_->Statistics();
+}
+
 Asio::~Asio() { std::unique_ptr<Imp>{imp_}.reset(); }
 }  // namespace opentxs::api::network
@@ -10,11 +10,13 @@
 #include <boost/thread/thread.hpp>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -26,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "2_Factory.hpp"
 #include "internal/api/network/Network.hpp"
 #include "network/asio/Endpoint.hpp"
 #include "network/asio/Socket.hpp"
@@ -66,10 +69,11 @@ struct Asio::Imp final : public api::network::internal::Asio {
 
         const auto& endpoint = socket.endpoint_;
         const auto& internal = endpoint.GetInternal().data_;
+        auto& shard = *shards_.at(socket.shard_);
         socket.socket_.async_connect(
             internal,
-            [this, connection{space(id)}, address{endpoint.str()}](
-                const auto& e) {
+            shard.wrap([this, connection{space(id)}, address{endpoint.str()}](
+                           const auto& e) {
                 if (e) {
                     LogVerbose(IMP)(__FUNCTION__)(": asio connect error: ")(
                         e.message())
@@ -81,13 +85,14 @@ struct Asio::Imp final : public api::network::internal::Asio {
                     e ? WorkType::AsioDisconnect : WorkType::AsioConnect);
                 work->AddFrame(address);
                 socket_->Send(std::move(work));
-            });
+            }));
 
         return true;
     }
-    auto Context() noexcept -> boost::asio::io_context& final
+    auto Context(const std::size_t shard) noexcept
+        -> boost::asio::io_context& final
     {
-        return context_;
+        return shards_.at(shard)->context_;
     }
     auto Init() noexcept -> void
     {
@@ -100,25 +105,25 @@ struct Asio::Imp final : public api::network::internal::Asio {
 
             OT_ASSERT(listen);
         }
-        {
-            const auto threads = std::min<unsigned int>(
-                2u, std::thread::hardware_concurrency() / 4u);
 
-            for (unsigned int i{0}; i < threads; ++i) {
-                auto* thread = thread_pool_.create_thread(
-                    boost::bind(&boost::asio::io_context::run, &context_));
+        for (auto& shard : shards_) {
+            auto* thread = thread_pool_.create_thread(boost::bind(
+                &boost::asio::io_context::run, &shard->context_));
 
-                OT_ASSERT(nullptr != thread);
-            }
+            OT_ASSERT(nullptr != thread);
         }
+
+        LogVerbose(IMP)(__FUNCTION__)(": Started ")(shards_.size())(
+            " io_context threads")
+            .Flush();
     }
-    auto Post(Callback cb) noexcept -> bool final
+    auto Post(const std::size_t shard, Callback cb) noexcept -> bool final
     {
         auto lock = sLock{lock_};
 
         if (false == running_) { return false; }
 
-        boost::asio::post(context_, std::move(cb));
+        post(*shards_.at(shard), std::move(cb));
 
         return true;
     }
@@ -134,38 +139,71 @@ struct Asio::Imp final : public api::network::internal::Asio {
 
         if (0 == id.size()) { return false; }
 
-        auto bufData = buffers_.get(bytes);
+        auto buffer = socket.buffer_;
+        auto& [data, begin, end, shared] = *buffer;
+        const auto available = end - begin;
+
+        if (bool(data) && (bytes <= available)) {
+            post(
+                *shards_.at(socket.shard_),
+                [this, connection{space(id)}, type, bytes, buffer] {
+                    deliver(reader(connection), type, bytes, *buffer);
+                });
+
+            return true;
+        }
+
+        if ((false == bool(data)) || (bytes > (data->size() - begin))) {
+            // Continue in a new buffer, starting with whatever part of the
+            // requested bytes has already been read
+            auto next = buffers_->get(bytes);
+
+            if (0 < available) {
+                std::memcpy(next->data(), data->data() + begin, available);
+            }
+
+            data = std::move(next);
+            begin = 0;
+            end = available;
+            shared = false;
+        }
+
         const auto& endpoint = socket.endpoint_;
+        auto& shard = *shards_.at(socket.shard_);
+        // Read as much as the buffer will hold so whatever follows the
+        // requested bytes is often available before it is requested
         boost::asio::async_read(
             socket.socket_,
-            bufData.second,
-            [this,
-             connection{space(id)},
-             type,
-             bufData,
-             address{endpoint.str()}](const auto& e, auto size) {
-                const auto& [index, buffer] = bufData;
-                auto work = zmq_.TaggedReply(
-                    reader(connection),
-                    e ? value(WorkType::AsioDisconnect) : type);
-
+            boost::asio::buffer(data->data() + end, data->size() - end),
+            boost::asio::transfer_at_least(bytes - available),
+            shard.wrap([this,
+                        connection{space(id)},
+                        type,
+                        bytes,
+                        buffer,
+                        address{endpoint.str()}](const auto& e, auto size) {
                 if (e) {
                     LogVerbose(IMP)(__FUNCTION__)(": asio receive error: ")(
                         e.message())
                         .Flush();
+                    auto work = zmq_.TaggedReply(
+                        reader(connection), value(WorkType::AsioDisconnect));
                     work->AddFrame(address);
-                } else {
-                    work->AddFrame(buffer.data(), buffer.size());
-                }
+                    socket_->Send(std::move(work));
 
-                OT_ASSERT(1 < work->Body().size());
+                    return;
+                }
 
-                socket_->Send(std::move(work));
-                buffers_.clear(index);
-            });
+                buffer->end_ += size;
+                deliver(reader(connection), type, bytes, *buffer);
+            }));
 
         return true;
     }
+    auto Release(const std::size_t shard) noexcept -> void final
+    {
+        --shards_.at(shard)->sockets_;
+    }
     auto Resolve(std::string_view server, std::uint16_t port) const noexcept
         -> Resolved
     {
@@ -178,7 +216,7 @@ struct Asio::Imp final : public api::network::internal::Asio {
         using Type = opentxs::network::asio::Endpoint::Type;
 
         try {
-            auto resolver = Resolver{const_cast<Imp*>(this)->context_};
+            auto resolver = Resolver{shards_.front()->context_};
             const auto results = resolver.resolve(
                 server, std::to_string(port), Resolver::query::numeric_service);
             output.reserve(results.size());
@@ -210,29 +248,100 @@ struct Asio::Imp final : public api::network::internal::Asio {
 
         return output;
     }
+    auto Shard() noexcept -> std::size_t final
+    {
+        // Sockets are assigned to whichever thread serves the fewest of them
+        auto output = std::size_t{0};
+
+        for (auto i = std::size_t{1}; i < shards_.size(); ++i) {
+            if (shards_.at(i)->sockets_ < shards_.at(output)->sockets_) {
+                output = i;
+            }
+        }
+
+        ++shards_.at(output)->sockets_;
+
+        return output;
+    }
     auto Shutdown() noexcept -> void
     {
         auto lock = eLock{lock_};
 
         if (running_) {
             running_ = false;
-            context_.stop();
+
+            for (auto& shard : shards_) { shard->context_.stop(); }
+
             thread_pool_.join_all();
-            work_.reset();
+
+            for (auto& shard : shards_) { shard->work_.reset(); }
+
             socket_->Close();
+            log_statistics();
         }
     }
+    auto Statistics() const noexcept -> std::vector<ThreadStatistics>
+    {
+        auto output = std::vector<ThreadStatistics>{};
+        output.reserve(shards_.size());
 
-    Imp(const zmq::Context& zmq) noexcept
+        for (const auto& shard : shards_) { output.emplace_back(*shard); }
+
+        return output;
+    }
+    auto Transmit(
+        const ReadView data,
+        Notification notifier,
+        internal::Asio::Socket& socket) noexcept -> bool final
+    {
+        auto lock = sLock{lock_};
+
+        if (false == running_) { return false; }
+
+        using Status = Notification::element_type;
+        auto& shard = *shards_.at(socket.shard_);
+        post(
+            shard,
+            [&shard,
+             &socket,
+             buffer{std::make_shared<Space>(space(data))},
+             promise{std::shared_ptr<Status>{std::move(notifier)}}] {
+                boost::asio::async_write(
+                    socket.socket_,
+                    boost::asio::buffer(buffer->data(), buffer->size()),
+                    shard.wrap([buffer, promise](const auto& e, auto) {
+                        try {
+                            if (promise) { promise->set_value(!e); }
+                        } catch (...) {
+                        }
+                    }));
+            });
+
+        return true;
+    }
+
+    Imp(const zmq::Context& zmq, const unsigned int threads) noexcept
         : zmq_(zmq)
         , endpoint_(zmq_.BuildEndpoint("asio/register", -1, 1))
         , cb_(zmq::ListenCallback::Factory([this](auto& in) { callback(in); }))
         , socket_(zmq_.RouterSocket(cb_, zmq::socket::Socket::Direction::Bind))
-        , context_()
-        , work_(std::make_unique<boost::asio::io_context::work>(context_))
+        , shards_([&] {
+            const auto count =
+                (0 < threads)
+                    ? threads
+                    : std::max(2u, std::thread::hardware_concurrency() / 4u);
+            auto output = std::vector<std::unique_ptr<Worker>>{};
+            output.reserve(count);
+
+            for (auto i = 0u; i < count; ++i) {
+                output.emplace_back(std::make_unique<Worker>());
+            }
+
+            return output;
+        }())
         , thread_pool_()
         , running_(true)
-        , buffers_()
+        , buffers_(std::make_shared<Buffers>())
         , lock_()
     {
     }
@@ -240,45 +349,250 @@ struct Asio::Imp final : public api::network::internal::Asio {
     ~Imp() final { Shutdown(); }
 
 private:
-    struct Buffers {
-        using AsioBuffer = decltype(boost::asio::buffer(
-            std::declval<void*>(),
-            std::declval<std::size_t>()));
-        using Index = std::int64_t;
+    // Recycles receive buffers. A buffer is shared by the socket reading into
+    // it and by every frame referring to data already delivered from it, and
+    // returns here once all of them are done with it.
+    class Buffers : public std::enable_shared_from_this<Buffers>
+    {
+    public:
+        using Pointer = std::shared_ptr<Space>;
+
+        // Refers to part of a buffer without copying it
+        static auto Frame(
+            const Pointer& buffer,
+            std::byte* data,
+            const std::size_t bytes) noexcept -> OTZMQFrame
+        {
+            return OTZMQFrame{opentxs::Factory::ZMQFrame(
+                data,
+                bytes,
+                [](void*, void* hint) { delete static_cast<Pointer*>(hint); },
+                new Pointer{buffer})};
+        }
 
-        auto clear(Index id) noexcept -> void
+        auto get(const std::size_t bytes) noexcept -> Pointer
         {
-            auto lock = Lock{lock_};
-            buffers_.erase(id);
+            const auto size = std::max(bytes, buffer_size_);
+            auto output = std::unique_ptr<Space>{};
+
+            {
+                auto lock = Lock{lock_};
+                auto best = idle_.end();
+
+                for (auto i = idle_.begin(); i != idle_.end(); ++i) {
+                    const auto& candidate = **i;
+
+                    if ((size <= candidate.size()) &&
+                        ((idle_.end() == best) ||
+                         (candidate.size() < (*best)->size()))) {
+                        best = i;
+                    }
+                }
+
+                if (idle_.end() != best) {
+                    output = std::move(*best);
+                    idle_.erase(best);
+                    idle_bytes_ -= output->size();
+                }
+            }
+
+            if (false == bool(output)) {
+                output = std::make_unique<Space>(size);
+            }
+
+            return Pointer{
+                output.release(),
+                [pool = shared_from_this()](auto* buffer) {
+                    pool->recycle(buffer);
+                }};
         }
-        auto get(const std::size_t bytes) noexcept
-            -> std::pair<Index, AsioBuffer>
+
+    private:
+        static constexpr auto buffer_size_ = std::size_t{256 * 1024};
+        static constexpr auto max_idle_bytes_ = std::size_t{64 * 1024 * 1024};
+
+        mutable std::mutex lock_{};
+        std::vector<std::unique_ptr<Space>> idle_{};
+        std::size_t idle_bytes_{};
+
+        auto recycle(Space* buffer) noexcept -> void
         {
+            auto pointer = std::unique_ptr<Space>{buffer};
             auto lock = Lock{lock_};
-            auto id = ++counter_;
-            auto& buffer = buffers_[id];
-            buffer.resize(bytes, std::byte{0x0});
 
-            return {id, boost::asio::buffer(buffer.data(), buffer.size())};
+            if (max_idle_bytes_ >= (idle_bytes_ + pointer->size())) {
+                idle_bytes_ += pointer->size();
+                idle_.emplace_back(std::move(pointer));
+            }
+        }
+    };
+
+    // One io_context served by a single thread. Every handler for a socket
+    // runs on the shard the socket was assigned to, so handlers for one socket
+    // never run concurrently and each added thread adds capacity.
+    struct Worker {
+        using Clock = std::chrono::steady_clock;
+
+        boost::asio::io_context context_;
+        std::unique_ptr<boost::asio::io_context::work> work_;
+        std::atomic<std::size_t> sockets_;
+        std::atomic<std::size_t> queued_;
+        std::atomic<std::size_t> handled_;
+        // Callbacks included in latency_
+        std::atomic<std::size_t> posted_;
+        std::atomic<std::uint64_t> latency_;
+        std::atomic<std::uint64_t> max_latency_;
+
+        operator ThreadStatistics() const noexcept
+        {
+            using Micro = std::chrono::microseconds;
+            const auto posted = posted_.load();
+            const auto total = std::chrono::nanoseconds(latency_.load());
+
+            return {
+                sockets_.load(),
+                queued_.load(),
+                handled_.load(),
+                (0 < posted) ? std::chrono::duration_cast<Micro>(total) /
+                                   static_cast<Micro::rep>(posted)
+                             : Micro{},
+                std::chrono::duration_cast<Micro>(
+                    std::chrono::nanoseconds(max_latency_.load()))};
+        }
+
+        auto record(const Clock::duration elapsed) noexcept -> void
+        {
+            const auto nanoseconds = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                    .count());
+            --queued_;
+            ++handled_;
+            ++posted_;
+            latency_ += nanoseconds;
+            auto max = max_latency_.load();
+
+            while ((max < nanoseconds) &&
+                   (false ==
+                    max_latency_.compare_exchange_weak(max, nanoseconds))) {
+            }
+        }
+
+        // Completion handler for a socket operation started by wrap()
+        template <typename Handler>
+        struct Tracked {
+            Worker& shard_;
+            Handler handler_;
+
+            template <typename... Args>
+            auto operator()(Args&&... args) -> void
+            {
+                --shard_.queued_;
+                ++shard_.handled_;
+                handler_(std::forward<Args>(args)...);
+            }
+        };
+
+        // Counts a socket operation as queued until its completion handler
+        // runs. The time spent waiting for the peer is not latency, so only
+        // the handled count is updated.
+        template <typename Handler>
+        auto wrap(Handler&& handler) noexcept -> Tracked<std::decay_t<Handler>>
+        {
+            ++queued_;
+
+            return {*this, std::forward<Handler>(handler)};
+        }
+
+        Worker() noexcept
+            : context_(1)
+            , work_(std::make_unique<boost::asio::io_context::work>(context_))
+            , sockets_(0)
+            , queued_(0)
+            , handled_(0)
+            , posted_(0)
+            , latency_(0)
+            , max_latency_(0)
+        {
         }
 
     private:
-        mutable std::mutex lock_{};
-        Index counter_{-1};
-        std::map<Index, Space> buffers_{};
+        Worker(const Worker&) = delete;
+        Worker(Worker&&) = delete;
+        Worker& operator=(const Worker&) = delete;
+        Worker& operator=(Worker&&) = delete;
     };
 
+    // Smaller deliveries are copied, which costs less than sharing a buffer
+    static constexpr auto zero_copy_threshold_ = std::size_t{4096};
+
     const zmq::Context& zmq_;
     const std::string endpoint_;
     const OTZMQListenCallback cb_;
     OTZMQRouterSocket socket_;
-    boost::asio::io_context context_;
-    std::unique_ptr<boost::asio::io_context::work> work_;
+    const std::vector<std::unique_ptr<Worker>> shards_;
     boost::thread_group thread_pool_;
     bool running_;
-    Buffers buffers_;
+    const std::shared_ptr<Buffers> buffers_;
     mutable std::shared_mutex lock_;
 
+    auto deliver(
+        const ReadView connection,
+        const OTZMQWorkType type,
+        const std::size_t bytes,
+        internal::Asio::Socket::Buffer& buffer) noexcept -> void
+    {
+        auto& [data, begin, end, shared] = buffer;
+        auto work = zmq_.TaggedReply(connection, type);
+        auto* start = data->data() + begin;
+
+        if (zero_copy_threshold_ > bytes) {
+            work->AddFrame(start, bytes);
+        } else {
+            work->AddFrame();
+            work->Replace(
+                work->size() - 1u, Buffers::Frame(data, start, bytes));
+            shared = true;
+        }
+
+        begin += bytes;
+
+        if (begin == end) {
+            // A buffer which frames refer to is never written again. It
+            // returns to the pool once the last of them has been destroyed.
+            if (shared) {
+                data.reset();
+                shared = false;
+            }
+
+            begin = 0;
+            end = 0;
+        }
+
+        socket_->Send(std::move(work));
+    }
+    auto log_statistics() const noexcept -> void
+    {
+        auto i = std::size_t{0};
+
+        for (const auto& shard : shards_) {
+            const ThreadStatistics stats = *shard;
+            LogVerbose(IMP)(__FUNCTION__)(": io_context ")(i++)(": ")(
+                stats.handled_)(" callbacks, average latency ")(
+                stats.average_latency_.count())(" us, maximum latency ")(
+                stats.max_latency_.count())(" us")
+                .Flush();
+        }
+    }
+    auto post(Worker& shard, Callback cb) noexcept -> void
+    {
+        ++shard.queued_;
+        boost::asio::post(
+            shard.context_,
+            [&shard, cb{std::move(cb)}, start{Worker::Clock::now()}] {
+                shard.record(Worker::Clock::now() - start);
+                cb();
+            });
+    }
     auto callback(zmq::Message& in) noexcept -> void
     {
         const auto header = in.Header();
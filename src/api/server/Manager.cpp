@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <deque>
 #include <exception>
 #include <list>
@@ -573,8 +574,17 @@ void Manager::Start()
 
     auto pubkey = Data::Factory();
     auto privateKey = server_.TransportKey(pubkey);
+    const auto workers = [&]() -> std::size_t {
+        try {
+
+            return std::stoul(get_arg(OPENTXS_ARG_NOTARY_THREADS));
+        } catch (...) {
+
+            return 0;
+        }
+    }();
     message_processor_.init(
-        (core::AddressType::Inproc == type), port, privateKey);
+        (core::AddressType::Inproc == type), port, privateKey, workers);
     message_processor_.Start();
 #if OT_CASH
     ScanMints();
@@ -184,6 +184,44 @@ auto Factory::Storage(
         defaultGcInterval,
         configGcInterval,
         notUsed);
+    {
+        auto batchSize = std::int64_t{0};
+        auto queueLimit = std::int64_t{0};
+        auto flushInterval = std::int64_t{0};
+        config.CheckSet_long(
+            String::Factory(STORAGE_CONFIG_KEY),
+            String::Factory("write_batch_size"),
+            static_cast<std::int64_t>(storageConfig.write_batch_size_),
+            batchSize,
+            notUsed);
+        config.CheckSet_long(
+            String::Factory(STORAGE_CONFIG_KEY),
+            String::Factory("write_queue_limit"),
+            static_cast<std::int64_t>(storageConfig.write_queue_limit_),
+            queueLimit,
+            notUsed);
+        config.CheckSet_long(
+            String::Factory(STORAGE_CONFIG_KEY),
+            String::Factory("write_flush_interval_ms"),
+            storageConfig.write_flush_interval_.count(),
+            flushInterval,
+            notUsed);
+
+        if (0 < batchSize) {
+            storageConfig.write_batch_size_ =
+                static_cast<std::size_t>(batchSize);
+        }
+
+        if (0 < queueLimit) {
+            storageConfig.write_queue_limit_ =
+                static_cast<std::size_t>(queueLimit);
+        }
+
+        if (0 <= flushInterval) {
+            storageConfig.write_flush_interval_ =
+                std::chrono::milliseconds{flushInterval};
+        }
+    }
     config.CheckSet_str(
         String::Factory(STORAGE_CONFIG_KEY),
         String::Factory("path"),
@@ -555,7 +593,10 @@ void Storage::Cleanup_Storage()
         if (thread.joinable()) { thread.join(); }
     }
 
-    if (root_) { root_->cleanup(); }
+    if (root_) {
+        root_->cleanup();
+        root_->save_gc_index();
+    }
 }
 
 void Storage::Cleanup() { Cleanup_Storage(); }
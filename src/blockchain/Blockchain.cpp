@@ -289,6 +289,37 @@ SerializedBloomFilter::SerializedBloomFilter() noexcept
     static_assert(9u == sizeof(SerializedBloomFilter));
 }
 
+SerializedGCS::SerializedGCS(
+    const std::uint8_t bits,
+    const std::uint32_t fpRate,
+    const std::uint32_t count,
+    const ReadView key) noexcept(false)
+    : format_(version_)
+    , bits_(bits)
+    , false_positive_rate_(fpRate)
+    , count_(count)
+    , key_()
+{
+    static_assert(26u == sizeof(SerializedGCS));
+
+    if (key_.size() != key.size()) {
+        throw std::runtime_error(
+            "Invalid key size: " + std::to_string(key.size()));
+    }
+
+    std::memcpy(key_.data(), key.data(), key_.size());
+}
+
+SerializedGCS::SerializedGCS() noexcept
+    : format_()
+    , bits_()
+    , false_positive_rate_()
+    , count_()
+    , key_()
+{
+    static_assert(26u == sizeof(SerializedGCS));
+}
+
 auto BlockHashToFilterKey(const ReadView hash) noexcept(false) -> ReadView
 {
     if (16u > hash.size()) { throw std::runtime_error("Hash too short"); }
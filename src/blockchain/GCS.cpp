@@ -10,14 +10,15 @@
 #include <boost/core/enable_if.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/endian/buffers.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -25,27 +26,26 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/GolombReader.hpp"
+#include "blockchain/SipHash.hpp"
 #include "blockchain/bitcoin/CompactSize.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Pimpl.hpp"
+#include "opentxs/Proto.tpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
-#include "opentxs/api/crypto/Crypto.hpp"
-#include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/FilterType.hpp"
 #include "opentxs/blockchain/block/Block.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
-#include "opentxs/crypto/HashType.hpp"
 #include "opentxs/protobuf/GCS.pb.h"
 #include "util/Container.hpp"
 
 //#define OT_METHOD "opentxs::blockchain::implementation::GCS::"
 
 namespace be = boost::endian;
-namespace mp = boost::multiprecision;
 
 namespace opentxs
 {
@@ -143,6 +143,19 @@ auto GCS(
     }
 }
 
+auto GCS(const api::Core& api, const ReadView serialized) noexcept
+    -> std::unique_ptr<blockchain::client::GCS>
+{
+    return blockchain::implementation::GCS::Deserialize(api, serialized, true);
+}
+
+auto GCSView(const api::Core& api, const ReadView serialized) noexcept
+    -> std::unique_ptr<blockchain::client::GCS>
+{
+    return blockchain::implementation::GCS::Deserialize(
+        api, serialized, false);
+}
+
 auto GCS(
     const api::Core& api,
     const blockchain::filter::Type type,
@@ -181,31 +194,16 @@ auto GCS(
 
 namespace opentxs::gcs
 {
-using BitReader = blockchain::internal::BitReader;
 using BitWriter = blockchain::internal::BitWriter;
 
-auto golomb_decode(const std::uint8_t P, BitReader& stream) noexcept(false)
-    -> std::uint64_t;
 auto golomb_encode(
     const std::uint8_t P,
     const std::uint64_t value,
     BitWriter& stream) noexcept -> void;
-auto siphash(
-    const api::Core& api,
-    const ReadView key,
-    const ReadView item) noexcept(false) -> std::uint64_t;
-
-auto golomb_decode(const std::uint8_t P, BitReader& stream) noexcept(false)
-    -> std::uint64_t
-{
-    auto quotient = std::uint64_t{0};
-
-    while (1 == stream.read(1)) { quotient++; }
-
-    auto remainder = stream.read(P);
-
-    return std::uint64_t{(quotient << P) + remainder};
-}
+auto HashedSetConstruct(
+    const SipHash& hasher,
+    const std::uint64_t range,
+    const std::vector<ReadView>& items) noexcept -> std::vector<std::uint64_t>;
 
 auto golomb_encode(
     const std::uint8_t P,
@@ -230,15 +228,11 @@ auto GolombDecode(
     const Space& encoded) noexcept(false) -> std::vector<std::uint64_t>
 {
     auto output = std::vector<std::uint64_t>{};
-    auto stream = BitReader(encoded);
-    auto last = std::uint64_t{0};
+    output.reserve(N);
+    auto stream = GolombReader{P, N, reader(encoded)};
+    auto value = std::uint64_t{};
 
-    for (auto i = std::size_t{0}; i < N; ++i) {
-        auto delta = golomb_decode(P, stream);
-        auto value = last + delta;
-        output.emplace_back(value);
-        last = value;
-    }
+    while (stream.Next(value)) { output.emplace_back(value); }
 
     return output;
 }
@@ -265,51 +259,36 @@ auto GolombEncode(
     return output;
 }
 
-auto siphash(
-    const api::Core& api,
-    const ReadView key,
-    const ReadView item) noexcept(false) -> std::uint64_t
-{
-    if (16 != key.size()) { throw std::runtime_error("Invalid key"); }
-
-    auto output = std::uint64_t{};
-    auto writer = preallocated(sizeof(output), &output);
-
-    if (false == api.Crypto().Hash().HMAC(
-                     crypto::HashType::SipHash24, key, item, writer)) {
-        throw std::runtime_error("siphash failed");
-    }
-
-    return output;
-}
-
 auto HashToRange(
-    const api::Core& api,
+    const api::Core&,
     const ReadView key,
     const std::uint64_t range,
     const ReadView item) noexcept(false) -> std::uint64_t
 {
-    return ((mp::uint128_t{siphash(api, key, item)} * mp::uint128_t{range}) >>
-            64u)
-        .convert_to<std::uint64_t>();
+    return FastRange(SipHash{key}(item), range);
 }
 
 auto HashedSetConstruct(
-    const api::Core& api,
+    const api::Core&,
     const ReadView key,
     const std::uint32_t N,
     const std::uint32_t M,
     const std::vector<ReadView> items) noexcept(false)
     -> std::vector<std::uint64_t>
 {
-    auto output = std::vector<std::uint64_t>{};
-    std::transform(
-        std::begin(items),
-        std::end(items),
-        std::back_inserter(output),
-        [&](const auto& item) {
-            return HashToRange(api, key, range(N, M), item);
-        });
+    return HashedSetConstruct(SipHash{key}, range(N, M), items);
+}
+
+auto HashedSetConstruct(
+    const SipHash& hasher,
+    const std::uint64_t range,
+    const std::vector<ReadView>& items) noexcept -> std::vector<std::uint64_t>
+{
+    auto output = std::vector<std::uint64_t>(items.size());
+    hasher.Batch(items, output.data());
+
+    for (auto& hash : output) { hash = FastRange(hash, range); }
+
     std::sort(output.begin(), output.end());
 
     return output;
@@ -324,19 +303,25 @@ GCS::GCS(
     const std::uint32_t fpRate,
     const std::uint32_t filterElementCount,
     const ReadView key,
-    const ReadView encoded) noexcept(false)
+    const ReadView encoded,
+    const bool copy) noexcept(false)
     : version_(1)
     , api_(api)
     , bits_(bits)
     , false_positive_rate_(fpRate)
     , count_(filterElementCount)
+    , lock_()
     , elements_()
-    , compressed_(api_.Factory().Data(encoded))
-    , key_(api_.Factory().Data(key))
-{
-    if (16u != key_->size()) {
+    , decoded_(false)
+    , storage_(copy ? concatenate(key, encoded) : Space{})
+    , key_(copy ? reader(storage_).substr(0, key.size()) : key)
+    , compressed_(copy ? reader(storage_).substr(key.size()) : encoded)
+    , hasher_(key_)
+    , queries_(0)
+{
+    if (16u != key_.size()) {
         throw std::runtime_error(
-            "Invalid key size: " + std::to_string(key_->size()));
+            "Invalid key size: " + std::to_string(key_.size()));
     }
 }
 
@@ -351,15 +336,18 @@ GCS::GCS(
     , bits_(bits)
     , false_positive_rate_(fpRate)
     , count_(static_cast<std::uint32_t>(elements.size()))
+    , lock_()
     , elements_(gcs::HashedSetConstruct(
-          api_,
-          key,
-          static_cast<std::uint32_t>(elements.size()),
-          false_positive_rate_,
+          gcs::SipHash{key},
+          range(count_, false_positive_rate_),
           elements))
-    , compressed_(
-          api_.Factory().Data(reader(gcs::GolombEncode(bits_, *elements_))))
-    , key_(api_.Factory().Data(key))
+    , decoded_(true)
+    , storage_(
+          concatenate(key, reader(gcs::GolombEncode(bits_, *elements_))))
+    , key_(reader(storage_).substr(0, key.size()))
+    , compressed_(reader(storage_).substr(key.size()))
+    , hasher_(key_)
+    , queries_(0)
 {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtautological-type-limit-compare"
@@ -370,42 +358,97 @@ GCS::GCS(
     }
 #pragma GCC diagnostic pop
 
-    if (16u != key_->size()) {
+    if (16u != key_.size()) {
         throw std::runtime_error(
-            "Invalid key size: " + std::to_string(key_->size()));
+            "Invalid key size: " + std::to_string(key_.size()));
     }
 }
 
-auto GCS::Compressed() const noexcept -> Space
+auto GCS::Compressed() const noexcept -> Space { return space(compressed_); }
+
+auto GCS::concatenate(const ReadView key, const ReadView encoded) noexcept
+    -> Space
 {
-    return {
-        reinterpret_cast<const std::byte*>(compressed_->data()),
-        reinterpret_cast<const std::byte*>(compressed_->data()) +
-            compressed_->size()};
+    auto output = Space(key.size() + encoded.size());
+    std::memcpy(output.data(), key.data(), key.size());
+
+    if (0 < encoded.size()) {
+        std::memcpy(
+            output.data() + key.size(), encoded.data(), encoded.size());
+    }
+
+    return output;
 }
 
 auto GCS::decompress() const noexcept -> const Elements&
 {
+    if (decoded_.load()) { return elements_.value(); }
+
+    Lock lock(lock_);
+
     if (false == elements_.has_value()) {
-        auto& set = const_cast<std::optional<Elements>&>(elements_);
-        set = gcs::GolombDecode(
-            count_,
-            bits_,
-            Space{
-                reinterpret_cast<const std::byte*>(compressed_->data()),
-                reinterpret_cast<const std::byte*>(compressed_->data()) +
-                    compressed_->size()});
-        std::sort(set.value().begin(), set.value().end());
+        auto output = Elements{};
+        output.reserve(count_);
+        auto stream = gcs::GolombReader{bits_, count_, compressed_};
+        auto value = std::uint64_t{};
+
+        while (stream.Next(value)) { output.emplace_back(value); }
+
+        std::sort(output.begin(), output.end());
+        elements_ = std::move(output);
+        decoded_.store(true);
     }
 
     return elements_.value();
 }
 
+auto GCS::Deserialize(
+    const api::Core& api,
+    const ReadView in,
+    const bool copy) noexcept -> std::unique_ptr<client::GCS>
+{
+    using Header = internal::SerializedGCS;
+
+    try {
+        if ((nullptr == in.data()) || (0 == in.size())) {
+            throw std::runtime_error("Empty input");
+        }
+
+        if (Header::version_ != static_cast<std::uint8_t>(in.front())) {
+
+            return factory::GCS(api, proto::Factory<proto::GCS>(in));
+        }
+
+        auto header = Header{};
+
+        if (sizeof(header) > in.size()) {
+            throw std::runtime_error("Input too short");
+        }
+
+        std::memcpy(static_cast<void*>(&header), in.data(), sizeof(header));
+
+        return std::make_unique<GCS>(
+            api,
+            header.bits_.value(),
+            header.false_positive_rate_.value(),
+            header.count_.value(),
+            in.substr(sizeof(header) - header.key_.size(), header.key_.size()),
+            in.substr(sizeof(header)),
+            copy);
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::blockchain::implementation::GCS::")(__FUNCTION__)(
+            ": ")(e.what())
+            .Flush();
+
+        return nullptr;
+    }
+}
+
 auto GCS::Encode() const noexcept -> OTData
 {
     const auto bytes = bitcoin::CompactSize(count_).Encode();
     auto output = Data::Factory(bytes.data(), bytes.size());
-    output->Concatenate(compressed_->data(), compressed_->size());
+    output->Concatenate(compressed_.data(), compressed_.size());
 
     return output;
 }
@@ -431,13 +474,12 @@ auto GCS::hashed_set_construct(const std::vector<ReadView>& elements)
     const noexcept -> std::vector<std::uint64_t>
 {
     return gcs::HashedSetConstruct(
-        api_, key_->Bytes(), count_, false_positive_rate_, elements);
+        hasher_, range(count_, false_positive_rate_), elements);
 }
 
 auto GCS::hash_to_range(const ReadView in) const noexcept -> std::uint64_t
 {
-    return gcs::HashToRange(
-        api_, key_->Bytes(), range(count_, false_positive_rate_), in);
+    return gcs::FastRange(hasher_(in), range(count_, false_positive_rate_));
 }
 
 auto GCS::Header(const ReadView previous) const noexcept -> OTData
@@ -445,31 +487,75 @@ auto GCS::Header(const ReadView previous) const noexcept -> OTData
     return internal::FilterToHeader(api_, Encode()->Bytes(), previous);
 }
 
+template <typename Found>
+auto GCS::intersect(const Elements& targets, Found found) const noexcept
+    -> void
+{
+    if (targets.empty()) { return; }
+
+    // Once a filter has been queried the decoded set is cached so that
+    // subsequent queries only pay for the search
+    if (decoded_.load() || (0 < queries_++)) {
+        const auto& set = decompress();
+        auto element = std::begin(set);
+
+        for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+            element = std::lower_bound(element, std::end(set), targets[i]);
+
+            if (std::end(set) == element) { return; }
+
+            if ((targets[i] == *element) && (false == found(i))) { return; }
+        }
+
+        return;
+    }
+
+    auto stream = gcs::GolombReader{bits_, count_, compressed_};
+    auto element = std::uint64_t{};
+
+    if (false == stream.Next(element)) { return; }
+
+    for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+        const auto& target = targets[i];
+
+        while (element < target) {
+            if (false == stream.Next(element)) { return; }
+        }
+
+        if ((target == element) && (false == found(i))) { return; }
+    }
+}
+
 auto GCS::Match(const Targets& targets) const noexcept -> Matches
 {
     auto output = Matches{};
-    auto hashed = std::vector<std::uint64_t>{};
-    auto matches = std::vector<std::uint64_t>{};
-    auto map = std::map<std::uint64_t, Targets::const_iterator>{};
-    const auto& set = decompress();
-
-    for (auto i = targets.cbegin(); i != targets.cend(); ++i) {
-        const auto& hash = hashed.emplace_back(hash_to_range(*i));
-        map.emplace(hash, i);
+    auto hashes = std::vector<std::uint64_t>(targets.size());
+    auto hashed = std::vector<std::pair<std::uint64_t, std::size_t>>{};
+    const auto limit = range(count_, false_positive_rate_);
+    hasher_.Batch(targets, hashes.data());
+    hashed.reserve(hashes.size());
+
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+        hashed.emplace_back(gcs::FastRange(hashes[i], limit), i);
     }
 
     std::sort(std::begin(hashed), std::end(hashed));
-    std::set_intersection(
+    std::transform(
         std::begin(hashed),
         std::end(hashed),
-        std::begin(set),
-        std::end(set),
-        std::back_inserter(matches));
-    std::transform(
-        std::begin(matches),
-        std::end(matches),
-        std::back_inserter(output),
-        [&](const auto& in) { return map.at(in); });
+        std::begin(hashes),
+        [](const auto& in) { return in.first; });
+    auto previous = std::optional<std::uint64_t>{};
+    intersect(hashes, [&](const auto index) {
+        const auto& [hash, target] = hashed[index];
+
+        if (previous != hash) {
+            output.emplace_back(std::next(targets.cbegin(), target));
+            previous = hash;
+        }
+
+        return true;
+    });
 
     return output;
 }
@@ -480,38 +566,55 @@ auto GCS::Serialize() const noexcept -> proto::GCS
     output.set_version(version_);
     output.set_bits(bits_);
     output.set_fprate(false_positive_rate_);
-    output.set_key(key_->data(), key_->size());
+    output.set_key(key_.data(), key_.size());
     output.set_count(count_);
-    output.set_filter(
-        static_cast<const char*>(compressed_->data()), compressed_->size());
+    output.set_filter(compressed_.data(), compressed_.size());
 
     return output;
 }
 
-auto GCS::Test(const Data& target) const noexcept -> bool
+auto GCS::Serialize(AllocateOutput out) const noexcept -> bool
 {
-    return Test(target.Bytes());
-}
+    try {
+        if (false == bool(out)) {
+            throw std::runtime_error("Invalid output allocator");
+        }
 
-auto GCS::Test(const ReadView target) const noexcept -> bool
-{
-    const auto set = hashed_set_construct({target});
+        const auto header = internal::SerializedGCS{
+            bits_, false_positive_rate_, count_, key_};
+        const auto size = sizeof(header) + compressed_.size();
+        auto output = out(size);
 
-    OT_ASSERT(1 == set.size());
+        if (false == output.valid(size)) {
+            throw std::runtime_error("Failed to allocate output bytes");
+        }
 
-    const auto& hash = set.front();
+        auto* it = output.as<std::byte>();
+        std::memcpy(it, static_cast<const void*>(&header), sizeof(header));
 
-    for (const auto& element : decompress()) {
-        if (element == hash) {
+        if (0 < compressed_.size()) {
+            std::memcpy(
+                it + sizeof(header), compressed_.data(), compressed_.size());
+        }
 
-            return true;
-        } else if (element > hash) {
+        return true;
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::blockchain::implementation::GCS::")(__FUNCTION__)(
+            ": ")(e.what())
+            .Flush();
 
-            return false;
-        }
+        return false;
     }
+}
+
+auto GCS::Test(const Data& target) const noexcept -> bool
+{
+    return Test(target.Bytes());
+}
 
-    return false;
+auto GCS::Test(const ReadView target) const noexcept -> bool
+{
+    return test({hash_to_range(target)});
 }
 
 auto GCS::Test(const std::vector<OTData>& targets) const noexcept -> bool
@@ -526,16 +629,14 @@ auto GCS::Test(const std::vector<Space>& targets) const noexcept -> bool
 
 auto GCS::test(const std::vector<std::uint64_t>& targets) const noexcept -> bool
 {
-    const auto& set = decompress();
-    auto matches = std::vector<std::uint64_t>{};
-    std::set_intersection(
-        std::begin(targets),
-        std::end(targets),
-        std::begin(set),
-        std::end(set),
-        std::back_inserter(matches));
+    auto output{false};
+    intersect(targets, [&](const auto) {
+        output = true;
+
+        return false;
+    });
 
-    return 0 < matches.size();
+    return output;
 }
 
 auto GCS::transform(const std::vector<OTData>& in) noexcept
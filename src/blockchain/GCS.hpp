@@ -8,10 +8,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
+#include "blockchain/SipHash.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Proto.hpp"
@@ -33,6 +38,11 @@ namespace opentxs::blockchain::implementation
 class GCS final : virtual public client::GCS
 {
 public:
+    static auto Deserialize(
+        const api::Core& api,
+        const ReadView serialized,
+        const bool copy) noexcept -> std::unique_ptr<client::GCS>;
+
     auto Compressed() const noexcept -> Space final;
     auto ElementCount() const noexcept -> std::uint32_t final { return count_; }
     auto Encode() const noexcept -> OTData final;
@@ -40,17 +50,21 @@ public:
     auto Header(const ReadView previous) const noexcept -> OTData final;
     auto Match(const Targets&) const noexcept -> Matches final;
     auto Serialize() const noexcept -> proto::GCS final;
+    auto Serialize(AllocateOutput out) const noexcept -> bool final;
     auto Test(const Data& target) const noexcept -> bool final;
     auto Test(const ReadView target) const noexcept -> bool final;
     auto Test(const std::vector<OTData>& targets) const noexcept -> bool final;
     auto Test(const std::vector<Space>& targets) const noexcept -> bool final;
 
+    // When copy is false the filter refers to key and encoded, which must
+    // outlive it
     GCS(const api::Core& api,
         const std::uint8_t bits,
         const std::uint32_t fpRate,
         const std::uint32_t filterElementCount,
         const ReadView key,
-        const ReadView encoded)
+        const ReadView encoded,
+        const bool copy = true)
     noexcept(false);
     GCS(const api::Core& api,
         const std::uint8_t bits,
@@ -69,10 +83,19 @@ private:
     const std::uint8_t bits_;
     const std::uint32_t false_positive_rate_;
     const std::uint32_t count_;
-    const std::optional<Elements> elements_;
-    const OTData compressed_;
-    const OTData key_;
+    mutable std::mutex lock_;
+    // Decoded on first use by decompress(), and never modified once set
+    mutable std::optional<Elements> elements_;
+    mutable std::atomic<bool> decoded_;
+    // Empty if the filter refers to memory it does not own
+    const Space storage_;
+    const ReadView key_;
+    const ReadView compressed_;
+    const gcs::SipHash hasher_;
+    mutable std::atomic<std::size_t> queries_;
 
+    static auto concatenate(const ReadView key, const ReadView encoded) noexcept
+        -> Space;
     static auto transform(const std::vector<OTData>& in) noexcept
         -> std::vector<ReadView>;
     static auto transform(const std::vector<Space>& in) noexcept
@@ -85,6 +108,11 @@ private:
         -> std::vector<std::uint64_t>;
     auto hashed_set_construct(const std::vector<ReadView>& elements)
         const noexcept -> std::vector<std::uint64_t>;
+    // Calls found() with the position of every element of the sorted targets
+    // which is present in the filter until found() returns false
+    template <typename Found>
+    auto intersect(const Elements& targets, Found found) const noexcept
+        -> void;
     auto test(const std::vector<std::uint64_t>& targetHashes) const noexcept
         -> bool;
     auto hash_to_range(const ReadView in) const noexcept -> std::uint64_t;
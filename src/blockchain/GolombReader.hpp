@@ -0,0 +1,126 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opentxs/Bytes.hpp"
+
+namespace opentxs::gcs
+{
+// Incremental decoder for a Golomb-Rice coded set which yields the
+// reconstructed (cumulative) values in ascending order without allocating.
+//
+// Bits are consumed from a left aligned 64 bit window so the unary part of
+// each code is found with a single count-leading-ones per word instead of one
+// call per bit. Bits past the end of the input read as zero, matching
+// BitReader.
+class GolombReader
+{
+public:
+    auto Next(std::uint64_t& value) noexcept -> bool
+    {
+        if (0u == remaining_) { return false; }
+
+        --remaining_;
+        last_ += (unary() << P_) + fixed();
+        value = last_;
+
+        return true;
+    }
+    auto Remaining() const noexcept -> std::uint32_t { return remaining_; }
+
+    GolombReader(
+        const std::uint8_t P,
+        const std::uint32_t N,
+        const ReadView encoded) noexcept
+        : P_(P)
+        , data_(reinterpret_cast<const std::uint8_t*>(encoded.data()))
+        , end_(data_ + encoded.size())
+        , window_(0)
+        , bits_(0)
+        , remaining_(N)
+        , last_(0)
+    {
+    }
+
+private:
+    static constexpr auto window_bits_ = std::size_t{64};
+
+    const std::uint8_t P_;
+    const std::uint8_t* data_;
+    const std::uint8_t* const end_;
+    std::uint64_t window_;
+    std::size_t bits_;
+    std::uint32_t remaining_;
+    std::uint64_t last_;
+
+    static auto leading_ones(const std::uint64_t word) noexcept -> std::size_t
+    {
+        const auto inverted = ~word;
+
+        if (0u == inverted) { return window_bits_; }
+
+#if defined(__GNUC__)
+        return static_cast<std::size_t>(__builtin_clzll(inverted));
+#else
+        auto output = std::size_t{0};
+
+        while (0u == (inverted & (std::uint64_t{1} << (63u - output)))) {
+            ++output;
+        }
+
+        return output;
+#endif
+    }
+
+    auto consume(const std::size_t count) noexcept -> void
+    {
+        window_ = (count < window_bits_) ? (window_ << count) : 0u;
+        bits_ -= count;
+    }
+    auto fixed() noexcept -> std::uint64_t
+    {
+        if (0u == P_) { return 0u; }
+
+        refill();
+        const auto output = window_ >> (window_bits_ - P_);
+        consume(P_);
+
+        return output;
+    }
+    // Tops up the window to at least 57 valid bits. Past the end of the input
+    // the window is padded with zero bits.
+    auto refill() noexcept -> void
+    {
+        while (bits_ <= (window_bits_ - 8u)) {
+            const auto byte = (data_ < end_) ? *data_++ : std::uint8_t{0};
+            window_ |= std::uint64_t{byte} << (window_bits_ - 8u - bits_);
+            bits_ += 8u;
+        }
+    }
+    auto unary() noexcept -> std::uint64_t
+    {
+        auto output = std::uint64_t{0};
+
+        while (true) {
+            refill();
+            const auto ones = leading_ones(window_);
+
+            if (ones < bits_) {
+                output += ones;
+                consume(ones + 1u);
+
+                return output;
+            }
+
+            output += bits_;
+            consume(bits_);
+        }
+    }
+};
+}  // namespace opentxs::gcs
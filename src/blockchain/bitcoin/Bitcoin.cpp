@@ -566,6 +566,117 @@ auto EncodedWitnessItem::size() const noexcept -> std::size_t
     return cs_.Total();
 }
 
+auto ScanTransaction(
+    const ReadView in,
+    const ScanCallback& outpoint,
+    const ScanCallback& script) noexcept(false) -> TransactionLayout
+{
+    if ((nullptr == in.data()) || (0 == in.size())) {
+        throw std::runtime_error("Invalid bytes");
+    }
+
+    auto output = TransactionLayout{};
+    auto it = reinterpret_cast<ByteIterator>(in.data());
+    const auto start{it};
+    auto expectedSize = std::size_t{0};
+    const auto decode = [&](const char* error) -> std::size_t {
+        expectedSize += 1;
+        auto value = std::size_t{};
+
+        if ((in.size() < expectedSize) ||
+            (false == bb::DecodeCompactSizeFromPayload(
+                          it, expectedSize, in.size(), value))) {
+            throw std::runtime_error(error);
+        }
+
+        return value;
+    };
+    const auto skip = [&](const std::size_t bytes,
+                          const char* error) -> ReadView {
+        expectedSize += bytes;
+
+        if (in.size() < expectedSize) { throw std::runtime_error(error); }
+
+        const auto view = ReadView{reinterpret_cast<const char*>(it), bytes};
+        std::advance(it, bytes);
+
+        return view;
+    };
+    skip(sizeof(EncodedTransaction::version_), "Partial transaction (version)");
+    const auto segwit = HasSegwit(it, expectedSize, in.size()).has_value();
+    const auto inputs = decode("Failed to decode txin count");
+
+    for (auto i = std::size_t{0}; i < inputs; ++i) {
+        const auto view =
+            skip(sizeof(EncodedInput::outpoint_), "Partial input (outpoint)");
+
+        if (outpoint) { outpoint(view); }
+
+        skip(decode("Failed to decode input script bytes"),
+             "Partial input (script)");
+        skip(sizeof(EncodedInput::sequence_), "Partial input (sequence)");
+    }
+
+    const auto outputs = decode("Failed to decode txout count");
+
+    for (auto i = std::size_t{0}; i < outputs; ++i) {
+        skip(sizeof(EncodedOutput::value_), "Partial output (value)");
+        const auto view = skip(
+            decode("Failed to decode output script bytes"),
+            "Partial output (script)");
+
+        if (script) { script(view); }
+    }
+
+    if (segwit) {
+        output.witness_ = static_cast<std::size_t>(std::distance(start, it));
+
+        for (auto i = std::size_t{0}; i < inputs; ++i) {
+            const auto items = decode("Failed to witness item count");
+
+            for (auto w = std::size_t{0}; w < items; ++w) {
+                skip(decode("Failed to witness item bytes"),
+                     "Partial witness item");
+            }
+        }
+    }
+
+    skip(
+        sizeof(EncodedTransaction::lock_time_),
+        "Partial transaction (lock time)");
+    output.size_ = static_cast<std::size_t>(std::distance(start, it));
+
+    return output;
+}
+
+auto TransactionLayout::txid_preimage(const ReadView tx) const noexcept
+    -> Space
+{
+    // version, marker, and flag
+    constexpr auto prefix = std::size_t{6};
+    constexpr auto version = sizeof(EncodedTransaction::version_);
+    constexpr auto locktime = sizeof(EncodedTransaction::lock_time_);
+    const auto* in = reinterpret_cast<const std::byte*>(tx.data());
+
+    if (false == witness_.has_value()) {
+        return space(ReadView{tx.data(), size_});
+    }
+
+    const auto witness = witness_.value();
+
+    OT_ASSERT(prefix <= witness);
+    OT_ASSERT((witness + locktime) <= size_);
+    OT_ASSERT(size_ <= tx.size());
+
+    auto output = Space{};
+    output.reserve(version + (witness - prefix) + locktime);
+    output.insert(output.end(), in, in + version);
+    output.insert(output.end(), in + prefix, in + witness);
+    output.insert(output.end(), in + size_ - locktime, in + size_);
+
+    return output;
+}
+
 constexpr auto All = std::byte{0x01};
 constexpr auto None = std::byte{0x02};
 constexpr auto Single = std::byte{0x03};
@@ -7,6 +7,7 @@
 #include "1_Internal.hpp"                      // IWYU pragma: associated
 #include "blockchain/block/bitcoin/Block.hpp"  // IWYU pragma: associated
 
+#include <boost/container/flat_set.hpp>
 #include <boost/endian/buffers.hpp>
 #include <algorithm>
 #include <array>
@@ -29,6 +30,7 @@
 
 #include "blockchain/block/Block.hpp"
 #include "blockchain/block/bitcoin/BlockParser.hpp"
+#include "internal/blockchain/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "opentxs/api/Core.hpp"
@@ -37,6 +39,7 @@
 #include "opentxs/blockchain/BlockchainType.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
 #include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
@@ -213,15 +216,17 @@ auto parse_normal_block(
 
     const auto& header = *pHeader;
     auto sizeData = ReturnType::CalculatedSize{in.size(), bb::CompactSize{}};
-    auto [index, transactions] = parse_transactions(
-        api, blockchain, chain, in, header, sizeData, it, expectedSize);
+    auto [index, spans] =
+        parse_transactions(api, chain, in, header, sizeData, it, expectedSize);
 
     return std::make_shared<ReturnType>(
         api,
+        blockchain,
         chain,
         std::move(pHeader),
+        space(in),
         std::move(index),
-        std::move(transactions),
+        std::move(spans),
         std::move(sizeData));
 }
 }  // namespace opentxs::factory
@@ -325,6 +330,75 @@ auto PushData(const ReadView in) noexcept(false) -> ScriptElement
 
 namespace opentxs::blockchain::block::bitcoin::implementation
 {
+namespace
+{
+// Finds transactions which might contain a match by searching their
+// serialized bytes, so that only those transactions need to be instantiated.
+// Every element which Transaction::FindMatches compares is either an input
+// outpoint or a substring of an output script.
+class Prefilter
+{
+public:
+    auto operator()(const ReadView tx) const noexcept -> bool
+    {
+        auto found{false};
+
+        try {
+            bb::ScanTransaction(
+                tx,
+                [&](const auto outpoint) {
+                    found = found || (0 < outpoints_.count(outpoint));
+                },
+                [&](const auto script) {
+                    found = found || contains(script);
+                });
+        } catch (...) {
+            // Let the full parser report the error
+            return true;
+        }
+
+        return found;
+    }
+
+    Prefilter(
+        const Block::Patterns& outpoints,
+        const Block::ParsedPatterns& patterns) noexcept
+        : outpoints_()
+        , elements_()
+        , sizes_()
+    {
+        for (const auto& [element, outpoint] : outpoints) {
+            outpoints_.emplace(reader(outpoint));
+        }
+
+        for (const auto& data : patterns.data_) {
+            elements_.emplace(reader(data));
+            sizes_.emplace(data.size());
+        }
+    }
+
+private:
+    boost::container::flat_set<ReadView> outpoints_;
+    boost::container::flat_set<ReadView> elements_;
+    boost::container::flat_set<std::size_t> sizes_;
+
+    auto contains(const ReadView script) const noexcept -> bool
+    {
+        for (const auto size : sizes_) {
+            if (size > script.size()) { break; }
+
+            for (auto i = std::size_t{0}; (i + size) <= script.size(); ++i) {
+                if (0 < elements_.count(script.substr(i, size))) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+};
+}  // namespace
+
 const std::size_t Block::header_bytes_{80};
 const Block::value_type Block::null_tx_{};
 
@@ -338,9 +412,13 @@ Block::Block(
     : block::implementation::Block(api, *header)
     , header_p_(std::move(header))
     , header_(*header_p_)
+    , serialized_()
     , index_(std::move(index))
+    , positions_(index_positions(index_))
+    , lock_()
     , transactions_(std::move(transactions))
     , size_(std::move(size))
+    , invalid_(false)
 {
     if (index_.size() != transactions_.size()) {
         throw std::runtime_error("Invalid transaction index");
@@ -357,6 +435,44 @@ Block::Block(
     }
 }
 
+Block::Block(
+    const api::Core& api,
+    const api::client::Blockchain& blockchain,
+    const blockchain::Type chain,
+    std::unique_ptr<const internal::Header> header,
+    Space&& serialized,
+    TxidIndex&& index,
+    TxSpans&& spans,
+    std::optional<CalculatedSize>&& size) noexcept(false)
+    : block::implementation::Block(api, *header)
+    , header_p_(std::move(header))
+    , header_(*header_p_)
+    , serialized_(std::make_unique<Serialized>(
+          Serialized{blockchain, std::move(serialized), std::move(spans)}))
+    , index_(std::move(index))
+    , positions_(index_positions(index_))
+    , lock_()
+    , transactions_()
+    , size_(std::move(size))
+    , invalid_(false)
+{
+    if (index_.size() != serialized_->spans_.size()) {
+        throw std::runtime_error("Invalid transaction index");
+    }
+
+    if (false == bool(header_p_)) {
+        throw std::runtime_error("Invalid header");
+    }
+
+    const auto total = serialized_->bytes_.size();
+
+    for (const auto& [offset, bytes] : serialized_->spans_) {
+        if ((offset > total) || (bytes > (total - offset))) {
+            throw std::runtime_error("Invalid transaction position");
+        }
+    }
+}
+
 auto Block::at(const std::size_t index) const noexcept -> const value_type&
 {
     try {
@@ -364,7 +480,7 @@ auto Block::at(const std::size_t index) const noexcept -> const value_type&
             throw std::out_of_range("invalid index " + std::to_string(index));
         }
 
-        return at(reader(index_.at(index)));
+        return get(index);
     } catch (const std::exception& e) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
 
@@ -376,7 +492,7 @@ auto Block::at(const ReadView txid) const noexcept -> const value_type&
 {
     try {
 
-        return transactions_.at(txid);
+        return get(positions_.at(txid));
     } catch (...) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": transaction ")(
             api_.Factory().Data(txid)->asHex())(" not found in block ")(
@@ -479,16 +595,19 @@ auto Block::calculate_merkle_value(
 
 auto Block::calculate_size() const noexcept -> CalculatedSize
 {
-    auto output = CalculatedSize{0, bb::CompactSize(transactions_.size())};
+    auto output = CalculatedSize{0, bb::CompactSize(index_.size())};
     auto& [bytes, cs] = output;
-    auto cb = [](const auto& previous, const auto& in) -> std::size_t {
-        return previous + in.second->CalculateSize();
-    };
-    bytes = std::accumulate(
-        std::begin(transactions_),
-        std::end(transactions_),
-        header_bytes_ + cs.Size() + extra_bytes(),
-        cb);
+    bytes = header_bytes_ + cs.Size() + extra_bytes();
+
+    if (serialized_) {
+        for (const auto& [offset, size] : serialized_->spans_) {
+            bytes += size;
+        }
+    } else {
+        for (const auto& [txid, tx] : transactions_) {
+            bytes += tx->CalculateSize();
+        }
+    }
 
     return output;
 }
@@ -497,11 +616,15 @@ auto Block::ExtractElements(const FilterType style) const noexcept
     -> std::vector<Space>
 {
     auto output = std::vector<Space>{};
-    LogTrace(OT_METHOD)(__FUNCTION__)(": processing ")(transactions_.size())(
+    LogTrace(OT_METHOD)(__FUNCTION__)(": processing ")(index_.size())(
         " transactions")
         .Flush();
 
-    for (const auto& [txid, tx] : transactions_) {
+    for (auto i = std::size_t{0}; i < index_.size(); ++i) {
+        const auto tx = load(i);
+
+        if (false == bool(tx)) { break; }
+
         auto temp = tx->ExtractElements(style);
         output.insert(
             output.end(),
@@ -509,6 +632,14 @@ auto Block::ExtractElements(const FilterType style) const noexcept
             std::make_move_iterator(temp.end()));
     }
 
+    if (invalid_) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Block ")(header_.Hash().asHex())(
+            " is invalid")
+            .Flush();
+
+        return {};
+    }
+
     LogTrace(OT_METHOD)(__FUNCTION__)(": extracted ")(output.size())(
         " elements")
         .Flush();
@@ -526,13 +657,22 @@ auto Block::FindMatches(
 
     LogTrace(OT_METHOD)(__FUNCTION__)(": Verifying ")(
         patterns.size() + outpoints.size())(" potential matches in ")(
-        transactions_.size())(" transactions")
+        index_.size())(" transactions")
         .Flush();
     auto output = Matches{};
     auto& [inputs, outputs] = output;
     const auto parsed = ParsedPatterns{patterns};
+    const auto candidate = Prefilter{outpoints, parsed};
+
+    for (auto i = std::size_t{0}; i < index_.size(); ++i) {
+        if (serialized_ && (false == candidate(transaction_bytes(i)))) {
+            continue;
+        }
+
+        const auto& tx = get(i);
+
+        if (false == bool(tx)) { break; }
 
-    for (const auto& [txid, tx] : transactions_) {
         auto temp = tx->FindMatches(style, outpoints, parsed);
         inputs.insert(
             inputs.end(),
@@ -544,12 +684,38 @@ auto Block::FindMatches(
             std::make_move_iterator(temp.second.end()));
     }
 
+    if (invalid_) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Block ")(header_.Hash().asHex())(
+            " is invalid")
+            .Flush();
+
+        return {};
+    }
+
     dedup(inputs);
     dedup(outputs);
 
     return output;
 }
 
+auto Block::get(const std::size_t index) const noexcept -> const value_type&
+{
+    if (invalid_) { return null_tx_; }
+
+    const auto txid = reader(index_.at(index));
+    auto lock = Lock{lock_};
+
+    if (auto it = transactions_.find(txid); transactions_.end() != it) {
+        return it->second;
+    }
+
+    auto tx = instantiate(index);
+
+    if (false == bool(tx)) { return null_tx_; }
+
+    return transactions_.emplace(txid, std::move(tx)).first->second;
+}
+
 auto Block::get_or_calculate_size() const noexcept -> CalculatedSize
 {
     if (false == size_.has_value()) { size_ = calculate_size(); }
@@ -559,6 +725,68 @@ auto Block::get_or_calculate_size() const noexcept -> CalculatedSize
     return size_.value();
 }
 
+auto Block::index_positions(const TxidIndex& index) noexcept
+    -> std::map<ReadView, std::size_t>
+{
+    auto output = std::map<ReadView, std::size_t>{};
+
+    for (auto i = std::size_t{0}; i < index.size(); ++i) {
+        output.emplace(reader(index.at(i)), i);
+    }
+
+    return output;
+}
+
+auto Block::instantiate(const std::size_t index) const noexcept -> value_type
+{
+    if (false == bool(serialized_)) { return {}; }
+
+    try {
+        const auto chain = header_.Type();
+        auto output = factory::BitcoinTransaction(
+            api_,
+            serialized_->blockchain_,
+            chain,
+            index,
+            header_.Timestamp(),
+            bb::EncodedTransaction::Deserialize(
+                api_, chain, transaction_bytes(index)));
+
+        if (false == bool(output)) {
+            invalidate(index, "failed to instantiate transaction");
+        }
+
+        return output;
+    } catch (const std::exception& e) {
+        invalidate(index, e.what());
+
+        return {};
+    }
+}
+
+auto Block::invalidate(const std::size_t index, const std::string& reason)
+    const noexcept -> void
+{
+    invalid_ = true;
+    LogOutput(OT_METHOD)(__FUNCTION__)(": Block ")(header_.Hash().asHex())(
+        " is invalid. Transaction ")(index)(": ")(reason)
+        .Flush();
+}
+
+auto Block::load(const std::size_t index) const noexcept -> value_type
+{
+    if (invalid_) { return {}; }
+
+    {
+        auto lock = Lock{lock_};
+        const auto it = transactions_.find(reader(index_.at(index)));
+
+        if (transactions_.end() != it) { return it->second; }
+    }
+
+    return instantiate(index);
+}
+
 auto Block::Print() const noexcept -> std::string
 {
     auto out = std::stringstream{};
@@ -597,6 +825,13 @@ auto Block::Serialize(AllocateOutput bytes) const noexcept -> bool
     LogInsane(OT_METHOD)(__FUNCTION__)(": Serializing ")(txCount.Value())(
         " transactions into ")(size)(" bytes.")
         .Flush();
+
+    if (serialized_ && (serialized_->bytes_.size() == size)) {
+        std::memcpy(out.data(), serialized_->bytes_.data(), size);
+
+        return true;
+    }
+
     auto remaining = std::size_t{size};
     auto it = static_cast<std::byte*>(out.data());
 
@@ -629,11 +864,17 @@ auto Block::Serialize(AllocateOutput bytes) const noexcept -> bool
     remaining -= txCount.Size();
     std::advance(it, txCount.Size());
 
-    for (const auto& txid : index_) {
+    for (auto i = std::size_t{0}; i < index_.size(); ++i) {
         try {
-            const auto& pTX = transactions_.at(reader(txid));
+            const auto pTX = load(i);
 
-            OT_ASSERT(pTX);
+            if (false == bool(pTX)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": missing transaction ")(
+                    i)
+                    .Flush();
+
+                return false;
+            }
 
             const auto& tx = *pTX;
             const auto encoded = tx.Serialize(preallocated(remaining, it));
@@ -665,6 +906,18 @@ auto Block::Serialize(AllocateOutput bytes) const noexcept -> bool
     return true;
 }
 
+auto Block::transaction_bytes(const std::size_t index) const noexcept(false)
+    -> ReadView
+{
+    OT_ASSERT(serialized_);
+
+    const auto& [offset, size] = serialized_->spans_.at(index);
+
+    return {
+        reinterpret_cast<const char*>(serialized_->bytes_.data()) + offset,
+        size};
+}
+
 auto Block::serialize_post_header(
     [[maybe_unused]] ByteIterator& it,
     [[maybe_unused]] std::size_t& remaining) const noexcept -> bool
@@ -5,10 +5,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -66,6 +68,8 @@ public:
         std::pair<std::size_t, blockchain::bitcoin::CompactSize>;
     using TxidIndex = std::vector<Space>;
     using TransactionMap = std::map<ReadView, value_type>;
+    /// offset and size of each transaction in the serialized block
+    using TxSpans = std::vector<std::pair<std::size_t, std::size_t>>;
 
     static const std::size_t header_bytes_;
 
@@ -120,23 +124,55 @@ public:
         TxidIndex&& index,
         TransactionMap&& transactions,
         std::optional<CalculatedSize>&& size = {}) noexcept(false);
+    /// Transactions are instantiated from serialized on first access
+    Block(
+        const api::Core& api,
+        const api::client::Blockchain& blockchain,
+        const blockchain::Type chain,
+        std::unique_ptr<const internal::Header> header,
+        Space&& serialized,
+        TxidIndex&& index,
+        TxSpans&& spans,
+        std::optional<CalculatedSize>&& size = {}) noexcept(false);
     ~Block() override;
 
 protected:
     using ByteIterator = std::byte*;
 
 private:
+    struct Serialized {
+        const api::client::Blockchain& blockchain_;
+        Space bytes_;
+        TxSpans spans_;
+    };
+
     static const value_type null_tx_;
 
     const std::unique_ptr<const internal::Header> header_p_;
     const internal::Header& header_;
+    const std::unique_ptr<const Serialized> serialized_;
     const TxidIndex index_;
-    const TransactionMap transactions_;
+    const std::map<ReadView, std::size_t> positions_;
+    mutable std::mutex lock_;
+    mutable TransactionMap transactions_;
     mutable std::optional<CalculatedSize> size_;
+    // Set when a transaction can not be instantiated from the serialized
+    // block. An invalid block provides no transactions, elements or matches.
+    mutable std::atomic<bool> invalid_;
+
+    static auto index_positions(const TxidIndex& index) noexcept
+        -> std::map<ReadView, std::size_t>;
 
     auto calculate_size() const noexcept -> CalculatedSize;
     virtual auto extra_bytes() const noexcept -> std::size_t { return 0; }
+    auto get(const std::size_t index) const noexcept -> const value_type&;
     auto get_or_calculate_size() const noexcept -> CalculatedSize;
+    auto instantiate(const std::size_t index) const noexcept -> value_type;
+    auto invalidate(const std::size_t index, const std::string& reason)
+        const noexcept -> void;
+    auto load(const std::size_t index) const noexcept -> value_type;
+    auto transaction_bytes(const std::size_t index) const noexcept(false)
+        -> ReadView;
     virtual auto serialize_post_header(ByteIterator& it, std::size_t& remaining)
         const noexcept -> bool;
 
@@ -60,7 +60,6 @@ auto parse_header(
 
 auto parse_transactions(
     const api::Core& api,
-    const api::client::Blockchain& blockchain,
     const blockchain::Type chain,
     const ReadView in,
     const blockchain::block::bitcoin::Header& header,
@@ -89,29 +88,38 @@ auto parse_transactions(
         throw std::runtime_error("too many transactions");
     }
 
-    auto counter = int{-1};
+    const auto* start = reinterpret_cast<ByteIterator>(in.data());
     auto output = ParsedTransactions{};
-    auto& [index, transactions] = output;
-
-    while (transactions.size() < transactionCount) {
-        auto data = bb::EncodedTransaction::Deserialize(
-            api,
-            chain,
-            ReadView{
-                reinterpret_cast<const char*>(it), in.size() - expectedSize});
-        const auto txBytes = data.size();
+    auto& [index, spans] = output;
+    index.reserve(transactionCount);
+    spans.reserve(transactionCount);
+
+    while (index.size() < transactionCount) {
+        const auto tx = ReadView{
+            reinterpret_cast<const char*>(it), in.size() - expectedSize};
+        const auto layout = bb::ScanTransaction(tx);
+        const auto txBytes = layout.size_;
+        const auto bytes = ReadView{tx.data(), txBytes};
+        auto& txid = index.emplace_back();
+        const auto hashed = [&] {
+            if (layout.witness_.has_value()) {
+                const auto preimage = layout.txid_preimage(bytes);
+
+                return TransactionHash(
+                    api, chain, reader(preimage), writer(txid));
+            }
+
+            return TransactionHash(api, chain, bytes, writer(txid));
+        }();
+
+        if (false == hashed) {
+            throw std::runtime_error("Failed to calculate txid");
+        }
+
+        spans.emplace_back(
+            static_cast<std::size_t>(std::distance(start, it)), txBytes);
         std::advance(it, txBytes);
         expectedSize += txBytes;
-        auto& txid = index.emplace_back(data.txid_);
-        transactions.emplace(
-            reader(txid),
-            BitcoinTransaction(
-                api,
-                blockchain,
-                chain,
-                ++counter,
-                header.Timestamp(),
-                std::move(data)));
     }
 
     const auto merkle = ReturnType::calculate_merkle_value(api, chain, index);
@@ -87,7 +87,7 @@ namespace opentxs::factory
 using ReturnType = blockchain::block::bitcoin::implementation::Block;
 using ByteIterator = const std::byte*;
 using ParsedTransactions =
-    std::pair<ReturnType::TxidIndex, ReturnType::TransactionMap>;
+    std::pair<ReturnType::TxidIndex, ReturnType::TxSpans>;
 
 auto parse_header(
     const api::Core& api,
@@ -108,9 +108,9 @@ auto parse_pkt_block(
     const blockchain::Type chain,
     const ReadView in) noexcept(false)
     -> std::shared_ptr<blockchain::block::bitcoin::Block>;
+/// Locates each transaction and calculates its txid without instantiating it
 auto parse_transactions(
     const api::Core& api,
-    const api::client::Blockchain& blockchain,
     const blockchain::Type chain,
     const ReadView in,
     const blockchain::block::bitcoin::Header& header,
@@ -188,6 +188,47 @@ auto BitcoinBlockHeader(
     }
 }
 
+auto BitcoinBlockHeader(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const ReadView raw,
+    const blockchain::block::Hash& hash,
+    const blockchain::block::Height height,
+    const blockchain::block::Header::Status status,
+    const blockchain::block::Header::Status inheritStatus,
+    const blockchain::Work& inheritWork) noexcept
+    -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>
+{
+    auto serialized = ReturnType::BitcoinFormat{};
+
+    if (sizeof(serialized) != raw.size()) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(
+            ": Invalid serialized block size. Got: ")(raw.size())(" expected ")(
+            sizeof(serialized))
+            .Flush();
+
+        return nullptr;
+    }
+
+    std::memcpy(static_cast<void*>(&serialized), raw.data(), raw.size());
+
+    try {
+        return std::make_unique<ReturnType>(
+            api,
+            chain,
+            serialized,
+            api.Factory().Data(hash.Bytes()),
+            height,
+            status,
+            inheritStatus,
+            inheritWork);
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+
 auto BitcoinBlockHeader(
     const api::Core& api,
     const blockchain::Type chain,
@@ -355,6 +396,39 @@ Header::Header(const api::Core& api, const SerializedType& serialized) noexcept(
 {
 }
 
+Header::Header(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const BitcoinFormat& serialized,
+    block::pHash&& hash,
+    const block::Height height,
+    const Status status,
+    const Status inheritStatus,
+    const blockchain::Work& inheritWork) noexcept(false)
+    : Header(
+          api,
+          default_version_,
+          chain,
+          std::move(hash),
+          calculate_pow(api, chain, serialized),
+          api.Factory().Data(ReadView{
+              serialized.previous_.data(), serialized.previous_.size()}),
+          height,
+          status,
+          inheritStatus,
+          calculate_work(chain, serialized.nbits_.value()),
+          inheritWork,
+          subversion_default_,
+          serialized.version_.value(),
+          api.Factory().Data(
+              ReadView{serialized.merkle_.data(), serialized.merkle_.size()}),
+          Clock::from_time_t(std::time_t(serialized.time_.value())),
+          serialized.nbits_.value(),
+          serialized.nonce_.value(),
+          true)
+{
+}
+
 Header::Header(const Header& rhs) noexcept
     : bitcoin::Header()
     , ot_super(rhs)
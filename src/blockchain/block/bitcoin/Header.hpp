@@ -141,6 +141,17 @@ public:
         const block::Height height) noexcept(false);
     Header(const api::Core& api, const SerializedType& serialized) noexcept(
         false);
+    // Restores a header from its network serialization and the metadata
+    // recorded when it was stored
+    Header(
+        const api::Core& api,
+        const blockchain::Type chain,
+        const BitcoinFormat& serialized,
+        block::pHash&& hash,
+        const block::Height height,
+        const Status status,
+        const Status inheritStatus,
+        const blockchain::Work& inheritWork) noexcept(false);
     Header(const Header& rhs) noexcept;
 
     ~Header() final = default;
@@ -58,11 +58,13 @@ public:
 
     Block(
         const api::Core& api,
+        const api::client::Blockchain& blockchain,
         const blockchain::Type chain,
         std::unique_ptr<const bitcoin::internal::Header> header,
         Proofs&& proofs,
+        Space&& serialized,
         TxidIndex&& index,
-        TransactionMap&& transactions,
+        TxSpans&& spans,
         std::optional<std::size_t>&& proofBytes = {},
         std::optional<CalculatedSize>&& size = {}) noexcept(false);
 
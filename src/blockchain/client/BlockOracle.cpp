@@ -31,6 +31,7 @@ namespace opentxs::factory
 {
 auto BlockOracle(
     const api::Core& api,
+    const blockchain::client::internal::Config& config,
     const blockchain::client::internal::Network& network,
     const blockchain::client::internal::HeaderOracle& header,
     const blockchain::client::internal::BlockDatabase& db,
@@ -41,7 +42,7 @@ auto BlockOracle(
     using ReturnType = blockchain::client::implementation::BlockOracle;
 
     return std::make_unique<ReturnType>(
-        api, network, header, db, chain, shutdown);
+        api, config, network, header, db, chain, shutdown);
 }
 }  // namespace opentxs::factory
 
@@ -49,6 +50,7 @@ namespace opentxs::blockchain::client::implementation
 {
 BlockOracle::BlockOracle(
     const api::Core& api,
+    const internal::Config& config,
     const internal::Network& network,
     const internal::HeaderOracle& header,
     const internal::BlockDatabase& db,
@@ -58,7 +60,7 @@ BlockOracle::BlockOracle(
     , network_(network)
     , db_(db)
     , lock_()
-    , cache_(api, network, db, chain)
+    , cache_(api, network, db, chain, config.block_cache_bytes_)
     , block_downloader_([&]() -> std::unique_ptr<BlockDownloader> {
         using Policy = api::client::blockchain::BlockStorage;
 
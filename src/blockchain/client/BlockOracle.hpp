@@ -7,10 +7,11 @@
 
 #include <boost/container/flat_map.hpp>
 #include <chrono>
-#include <deque>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <iosfwd>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -62,6 +63,8 @@ class Message;
 
 namespace opentxs::blockchain::client::implementation
 {
+class BlockCacheTest;
+
 class BlockOracle final : public internal::BlockOracle,
                           public Worker<BlockOracle, api::Core>
 {
@@ -76,12 +79,20 @@ public:
         statemachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
     };
 
+    auto CacheStatistics() const noexcept -> CacheStats final
+    {
+        return cache_.Statistics();
+    }
     auto GetBlockJob() const noexcept -> BlockJob final;
     auto Heartbeat() const noexcept -> void final;
     auto LoadBitcoin(const block::Hash& block) const noexcept
         -> BitcoinBlockFuture final;
     auto LoadBitcoin(const BlockHashes& hashes) const noexcept
         -> BitcoinBlockFutures final;
+    auto PinBlock(const block::Hash& block) const noexcept -> Pin final
+    {
+        return cache_.Pin(block);
+    }
     auto SubmitBlock(const ReadView in) const noexcept -> void final;
     auto Tip() const noexcept -> block::Position final
     {
@@ -100,6 +111,7 @@ public:
 
     BlockOracle(
         const api::Core& api,
+        const internal::Config& config,
         const internal::Network& network,
         const internal::HeaderOracle& header,
         const internal::BlockDatabase& db,
@@ -110,12 +122,14 @@ public:
 
 private:
     friend Worker<BlockOracle, api::Core>;
+    friend BlockCacheTest;
 
     using Promise = std::promise<BitcoinBlock_p>;
     using PendingData = std::tuple<Time, Promise, BitcoinBlockFuture, bool>;
     using Pending = std::map<block::pHash, PendingData>;
 
     struct Cache {
+        auto Pin(const block::Hash& block) const noexcept -> BlockOracle::Pin;
         auto ReceiveBlock(const zmq::Frame& in) const noexcept -> void;
         auto ReceiveBlock(BitcoinBlock_p in) const noexcept -> void;
         auto Request(const block::Hash& block) const noexcept
@@ -123,6 +137,7 @@ private:
         auto Request(const BlockHashes& hashes) const noexcept
             -> BitcoinBlockFutures;
         auto StateMachine() const noexcept -> bool;
+        auto Statistics() const noexcept -> CacheStats;
 
         auto Shutdown() noexcept -> void;
 
@@ -130,31 +145,86 @@ private:
             const api::Core& api_,
             const internal::Network& network,
             const internal::BlockDatabase& db,
-            const blockchain::Type chain) noexcept;
+            const blockchain::Type chain,
+            const std::size_t limit) noexcept;
         ~Cache() { Shutdown(); }
 
     private:
-        static const std::size_t cache_limit_;
+        friend BlockCacheTest;
+
         static const std::chrono::seconds download_timeout_;
 
+        // Completed blocks limited by their total size. The least recently
+        // used blocks which are not pinned are evicted first, when a block is
+        // added and when the last pin on a block is released.
         struct Mem {
-            auto find(const ReadView& id) const noexcept -> BitcoinBlockFuture;
+            OPENTXS_EXPORT auto Statistics() const noexcept -> CacheStats;
 
-            auto clear() noexcept -> void;
-            auto push(block::pHash&& id, BitcoinBlockFuture&& future) noexcept
-                -> void;
+            OPENTXS_EXPORT auto clear() noexcept -> void;
+            OPENTXS_EXPORT auto find(const ReadView& id) noexcept
+                -> BitcoinBlockFuture;
+            // The owner's lock must not be held when a pin is released
+            OPENTXS_EXPORT auto pin(const block::Hash& id) noexcept
+                -> BlockOracle::Pin;
+            OPENTXS_EXPORT auto push(
+                block::pHash&& id,
+                BitcoinBlockFuture&& future) noexcept -> void;
 
-            Mem(const std::size_t limit) noexcept;
+            // lock is the mutex which protects every call to this object
+            OPENTXS_EXPORT Mem(
+                const std::size_t limit,
+                std::mutex& lock) noexcept;
+
+            OPENTXS_EXPORT ~Mem();
 
         private:
-            using Completed =
-                std::deque<std::pair<block::pHash, BitcoinBlockFuture>>;
-            using Index = boost::container::
-                flat_map<ReadView, Completed::const_reverse_iterator>;
+            struct Item {
+                block::pHash id_;
+                BitcoinBlockFuture future_;
+                std::size_t bytes_;
+            };
+            // Shared with the pins so that a pin which outlives the cache
+            // does not access it when it is released
+            struct Shared {
+                std::mutex lock_;
+                std::mutex& owner_;
+                Mem* mem_;
+
+                Shared(std::mutex& owner, Mem* mem) noexcept
+                    : lock_()
+                    , owner_(owner)
+                    , mem_(mem)
+                {
+                }
+            };
+
+            // Most recently used blocks are at the front
+            using Completed = std::list<Item>;
+            using Index =
+                boost::container::flat_map<ReadView, Completed::iterator>;
+            using Pins =
+                std::map<block::pHash, std::weak_ptr<const block::Hash>>;
 
             const std::size_t limit_;
+            const std::shared_ptr<Shared> shared_;
             Completed queue_;
             Index index_;
+            Pins pins_;
+            std::size_t bytes_;
+            std::size_t hits_;
+            std::size_t misses_;
+            std::size_t evictions_;
+
+            auto is_pinned(const block::pHash& id) noexcept -> bool;
+
+            auto evict() noexcept -> void;
+            auto unpin(const block::pHash& id) noexcept -> void;
+
+            Mem() = delete;
+            Mem(const Mem&) = delete;
+            Mem(Mem&&) = delete;
+            auto operator=(const Mem&) -> Mem& = delete;
+            auto operator=(Mem&&) -> Mem& = delete;
         };
 
         const api::Core& api_;
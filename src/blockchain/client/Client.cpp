@@ -13,6 +13,9 @@
 
 namespace opentxs::blockchain::client::internal
 {
+// NOTE a single block can be several megabytes
+const std::size_t Config::default_block_cache_bytes_{64u * 1024u * 1024u};
+
 auto Config::print() const noexcept -> std::string
 {
     constexpr auto print_bool = [](const bool in) {
@@ -34,6 +37,7 @@ auto Config::print() const noexcept -> std::string
     output << "  * use sync server: " << print_bool(use_sync_server_) << '\n';
     output << "  * disable wallet: " << print_bool(disable_wallet_) << '\n';
     output << "  * sync endpoint: " << sync_endpoint_ << '\n';
+    output << "  * block cache size: " << block_cache_bytes_ << " bytes\n";
 
     return output.str();
 }
@@ -383,6 +383,37 @@ auto FilterOracle::LoadFilterOrResetTip(
     return {};
 }
 
+auto FilterOracle::LoadFiltersOrResetTip(
+    const filter::Type type,
+    const std::vector<block::Position>& blocks,
+    const internal::FilterDatabase::FilterCallback& cb) const noexcept
+    -> std::size_t
+{
+    auto hashes = std::vector<ReadView>{};
+    hashes.reserve(blocks.size());
+
+    for (const auto& block : blocks) {
+        hashes.emplace_back(block.second->Bytes());
+    }
+
+    const auto output = database_.LoadFilters(type, hashes, cb);
+
+    if (output == blocks.size()) { return output; }
+
+    const auto height = blocks.at(output).first;
+
+    OT_ASSERT(0 < height);
+
+    const auto parent = height - 1;
+    const auto hash = header_.BestHash(parent);
+
+    OT_ASSERT(false == hash->empty());
+
+    reset_tips_to(type, block::Position{parent, hash}, false, true);
+
+    return output;
+}
+
 auto FilterOracle::new_tip(
     const rLock&,
     const filter::Type type,
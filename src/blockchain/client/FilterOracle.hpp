@@ -8,6 +8,7 @@
 #include <boost/circular_buffer.hpp>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <deque>
 #include <functional>
 #include <future>
@@ -136,6 +137,11 @@ public:
         const filter::Type type,
         const block::Position& position) const noexcept
         -> std::unique_ptr<const GCS> final;
+    auto LoadFiltersOrResetTip(
+        const filter::Type type,
+        const std::vector<block::Position>& blocks,
+        const internal::FilterDatabase::FilterCallback& cb) const noexcept
+        -> std::size_t final;
     auto ProcessBlock(const block::bitcoin::Block& block) const noexcept
         -> bool final;
     auto ProcessBlock(BlockIndexerData& data) const noexcept -> void;
@@ -0,0 +1,350 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                         // IWYU pragma: associated
+#include "1_Internal.hpp"                       // IWYU pragma: associated
+#include "blockchain/client/FilterScanner.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <utility>
+
+#include "internal/api/Api.hpp"
+#include "internal/blockchain/client/Factory.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/ThreadPool.hpp"
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Socket.hpp"
+
+#define OT_METHOD "opentxs::blockchain::client::implementation::FilterScanner::"
+
+namespace opentxs::factory
+{
+auto BlockchainFilterScanner(
+    const api::Core& api,
+    const blockchain::client::internal::Network& network) noexcept
+    -> std::unique_ptr<blockchain::client::internal::FilterScanner>
+{
+    using ReturnType = blockchain::client::implementation::FilterScanner;
+
+    return std::make_unique<ReturnType>(api, network);
+}
+}  // namespace opentxs::factory
+
+namespace opentxs::blockchain::client::internal
+{
+auto FilterScanner::ProcessThreadPool(const zmq::Message& in) noexcept -> void
+{
+    implementation::RunFromThreadPool<implementation::FilterScanner::Job>(in);
+}
+}  // namespace opentxs::blockchain::client::internal
+
+namespace opentxs::blockchain::client::implementation
+{
+FilterScanner::FilterScanner(
+    const api::Core& api,
+    const internal::Network& network) noexcept
+    : api_(api)
+    , network_(network)
+    , lock_()
+    , pending_()
+    , active_()
+    , thread_pool_(
+          api_.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Connect))
+{
+    const auto zmq = thread_pool_->Start(api_.ThreadPool().Endpoint());
+
+    OT_ASSERT(zmq);
+}
+
+FilterScanner::Job::Job(
+    const FilterScanner& parent,
+    const filter::Type type,
+    std::vector<Request*>&& requests) noexcept
+    : Job(parent, type, std::move(requests), Divide(requests))
+{
+}
+
+FilterScanner::Job::Job(
+    const FilterScanner& parent,
+    const filter::Type type,
+    std::vector<Request*>&& requests,
+    Plan&& plan) noexcept
+    : ParallelJob()
+    , parent_(parent)
+    , type_(type)
+    , requests_(std::move(requests))
+    , segments_(std::move(plan.first))
+    , chunks_(std::move(plan.second))
+    , missing_(std::numeric_limits<block::Height>::max())
+    , lock_()
+    , matches_(requests_.size())
+{
+}
+
+auto FilterScanner::Job::Divide(const std::vector<Request*>& requests) noexcept
+    -> Plan
+{
+    auto output = Plan{};
+    auto& [segments, chunks] = output;
+    auto bounds = std::vector<block::Height>{};
+
+    for (const auto* request : requests) {
+        if (request->start_ > request->stop_) { continue; }
+
+        bounds.emplace_back(request->start_);
+        bounds.emplace_back(request->stop_ + 1);
+    }
+
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+    for (auto i = std::size_t{1}; i < bounds.size(); ++i) {
+        auto segment = Segment{bounds.at(i - 1), bounds.at(i) - 1};
+        auto covered{false};
+
+        for (auto r = std::size_t{0}; r < requests.size(); ++r) {
+            const auto& request = *requests.at(r);
+
+            if ((request.start_ > segment.first_) ||
+                (request.stop_ < segment.last_)) {
+                continue;
+            }
+
+            covered = true;
+
+            for (const auto& target : request.targets_) {
+                segment.targets_.emplace_back(target);
+                segment.owners_.emplace_back(r);
+            }
+        }
+
+        if (false == covered) { continue; }
+
+        const auto index = segments.size();
+
+        for (auto first = segment.first_; first <= segment.last_;
+             first += batch_) {
+            chunks.emplace_back(Chunk{
+                index, first, std::min(first + batch_ - 1, segment.last_)});
+        }
+
+        segments.emplace_back(std::move(segment));
+    }
+
+    return output;
+}
+
+auto FilterScanner::Job::Deliver() noexcept -> void
+{
+    const auto& headers = parent_.network_.HeaderOracleInternal();
+    const auto missing = missing_.load();
+    auto results = std::vector<Result>(requests_.size());
+
+    for (auto r = std::size_t{0}; r < requests_.size(); ++r) {
+        const auto& request = *requests_.at(r);
+        auto& result = results.at(r);
+        const auto last = std::min(request.stop_, missing - 1);
+
+        if (last >= request.start_) {
+            result.tested_ = block::Position{last, headers.BestHash(last)};
+        }
+
+        auto& matches = matches_.at(r);
+        matches.erase(
+            std::remove_if(
+                matches.begin(),
+                matches.end(),
+                [&](const auto& match) { return match.first.first > last; }),
+            matches.end());
+        std::sort(
+            matches.begin(),
+            matches.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.first.first < rhs.first.first;
+            });
+        result.matches_ = std::move(matches);
+    }
+
+    // NOTE a request, including the targets it references, may be destroyed
+    // as soon as its promise is satisfied
+    for (auto r = std::size_t{0}; r < requests_.size(); ++r) {
+        requests_.at(r)->promise_.set_value(std::move(results.at(r)));
+    }
+}
+
+auto FilterScanner::Job::finish() noexcept -> void
+{
+    parent_.release(*this);
+    Deliver();
+}
+
+auto FilterScanner::Job::missing(const block::Height height) noexcept -> void
+{
+    auto current = missing_.load();
+
+    while ((height < current) &&
+           (false == missing_.compare_exchange_weak(current, height))) {}
+}
+
+auto FilterScanner::Job::process(const std::size_t index) noexcept -> void
+{
+    const auto& chunk = chunks_.at(index);
+    const auto& headers = parent_.network_.HeaderOracleInternal();
+    const auto& filters = parent_.network_.FilterOracleInternal();
+    const auto& segment = segments_.at(chunk.segment_);
+    const auto& targets = segment.targets_;
+
+    if (chunk.first_ >= missing_.load()) { return; }
+
+    auto positions = std::vector<block::Position>{};
+    positions.reserve(
+        static_cast<std::size_t>(chunk.last_ - chunk.first_) + 1u);
+
+    for (auto height = chunk.first_; height <= chunk.last_; ++height) {
+        positions.emplace_back(height, headers.BestHash(height));
+    }
+
+    // index into positions, owners of the matching targets
+    auto found = std::vector<std::pair<std::size_t, std::set<std::size_t>>>{};
+    // NOTE the filters are only valid inside the callback because they refer
+    // to database memory instead of being copied
+    const auto loaded = filters.LoadFiltersOrResetTip(
+        type_, positions, [&](const auto index, const auto& filter) {
+            if (targets.empty()) { return; }
+
+            const auto matches = filter.Match(targets);
+
+            if (matches.empty()) { return; }
+
+            auto& owners =
+                found.emplace_back(index, std::set<std::size_t>{}).second;
+
+            for (const auto& it : matches) {
+                // NOTE GCS::Match returns const_iterators to items in the
+                // input vector
+                const auto pos = std::distance(targets.cbegin(), it);
+                owners.emplace(segment.owners_.at(pos));
+            }
+        });
+
+    if (loaded < positions.size()) {
+        const auto height = positions.at(loaded).first;
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": filter at height ")(height)(
+            " not found")
+            .Flush();
+        missing(height);
+    }
+
+    // Matches are rare, so only matching filters are loaded again to obtain
+    // copies which outlive the read transaction
+    for (const auto& [index, owners] : found) {
+        const auto& position = positions.at(index);
+        const auto filter = Filter{filters.LoadFilter(type_, position.second)};
+
+        if (false == bool(filter)) {
+            missing(position.first);
+
+            return;
+        }
+
+        auto lock = Lock{lock_};
+
+        for (const auto& owner : owners) {
+            matches_.at(owner).emplace_back(position, filter);
+        }
+    }
+}
+
+auto FilterScanner::make_job(const Lock& lock) const noexcept
+    -> std::shared_ptr<Job>
+{
+    while (false == pending_.empty()) {
+        const auto type = pending_.front()->type_;
+        auto requests = std::vector<Request*>{};
+        auto it = std::stable_partition(
+            pending_.begin(), pending_.end(), [&](const auto* request) {
+                return type != request->type_;
+            });
+        std::move(it, pending_.end(), std::back_inserter(requests));
+        pending_.erase(it, pending_.end());
+        auto job = std::make_shared<Job>(*this, type, std::move(requests));
+
+        if (job->chunks_.empty()) {
+            job->Deliver();
+
+            continue;
+        }
+
+        LogTrace(OT_METHOD)(__FUNCTION__)(": scanning ")(
+            job->requests_.size())(" requests in ")(job->chunks_.size())(
+            " chunks")
+            .Flush();
+        SendToThreadPool(
+            api_,
+            thread_pool_,
+            api::internal::ThreadPool::Work::BlockchainFilterScan,
+            job,
+            job->chunks_.size());
+
+        return job;
+    }
+
+    return {};
+}
+
+auto FilterScanner::release(const Job& job) const noexcept -> void
+{
+    auto lock = Lock{lock_};
+
+    if (active_.get() == &job) { active_.reset(); }
+}
+
+auto FilterScanner::Scan(
+    const filter::Type type,
+    const block::Height start,
+    const block::Height stop,
+    const GCS::Targets& targets) const noexcept -> Result
+{
+    auto request = Request{type, start, stop, targets, {}};
+    auto future = request.promise_.get_future();
+
+    {
+        auto lock = Lock{lock_};
+        pending_.emplace_back(&request);
+    }
+
+    while (std::future_status::ready !=
+           future.wait_for(std::chrono::seconds{0})) {
+        auto job = [&] {
+            auto lock = Lock{lock_};
+
+            if (false == bool(active_)) { active_ = make_job(lock); }
+
+            return active_;
+        }();
+
+        if (job) {
+            job->Run();
+            job->Wait();
+        } else {
+            // The job containing this request has been released and is
+            // delivering results
+            future.wait();
+        }
+    }
+
+    return future.get();
+}
+
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,144 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// IWYU pragma: private
+// IWYU pragma: friend ".*src/blockchain/client/FilterScanner.cpp"
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "blockchain/client/ParallelJob.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "opentxs/network/zeromq/socket/Push.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+class Core;
+}  // namespace api
+}  // namespace opentxs
+
+namespace opentxs::blockchain::client::implementation
+{
+class FilterScannerTest;
+
+class FilterScanner final : public internal::FilterScanner
+{
+public:
+    struct Job;
+
+    auto Scan(
+        const filter::Type type,
+        const block::Height start,
+        const block::Height stop,
+        const GCS::Targets& targets) const noexcept -> Result final;
+
+    FilterScanner(
+        const api::Core& api,
+        const internal::Network& network) noexcept;
+
+    ~FilterScanner() final = default;
+
+private:
+    friend FilterScannerTest;
+
+    struct Request;
+
+    const api::Core& api_;
+    const internal::Network& network_;
+    mutable std::mutex lock_;
+    mutable std::vector<Request*> pending_;
+    mutable std::shared_ptr<Job> active_;
+    OTZMQPushSocket thread_pool_;
+
+    auto make_job(const Lock& lock) const noexcept -> std::shared_ptr<Job>;
+    auto release(const Job& job) const noexcept -> void;
+
+    FilterScanner() = delete;
+    FilterScanner(const FilterScanner&) = delete;
+    FilterScanner(FilterScanner&&) = delete;
+    auto operator=(const FilterScanner&) -> FilterScanner& = delete;
+    auto operator=(FilterScanner&&) -> FilterScanner& = delete;
+};
+
+struct FilterScanner::Request {
+    const filter::Type type_;
+    const block::Height start_;
+    const block::Height stop_;
+    const GCS::Targets& targets_;
+    std::promise<Result> promise_;
+};
+
+// A set of requests which are scanned together. Block ranges are divided into
+// segments in which the set of requests is constant, and each segment is
+// divided into chunks which are claimed by the threads running the job.
+struct FilterScanner::Job final : public ParallelJob<FilterScanner::Job> {
+    struct Segment {
+        block::Height first_{};
+        block::Height last_{};
+        GCS::Targets targets_{};
+        // Index into requests_ for each element of targets_
+        std::vector<std::size_t> owners_{};
+    };
+    struct Chunk {
+        std::size_t segment_{};
+        block::Height first_{};
+        block::Height last_{};
+    };
+
+    using Plan = std::pair<std::vector<Segment>, std::vector<Chunk>>;
+
+    // Number of consecutive filters in a chunk
+    static constexpr auto batch_ = block::Height{100};
+
+    const FilterScanner& parent_;
+    const filter::Type type_;
+    const std::vector<Request*> requests_;
+    const std::vector<Segment> segments_;
+    const std::vector<Chunk> chunks_;
+
+    // Divides the block ranges of the requests into segments and chunks.
+    // Heights which are not covered by any request are skipped.
+    OPENTXS_EXPORT static auto Divide(
+        const std::vector<Request*>& requests) noexcept -> Plan;
+
+    // Delivers the results of every request
+    auto Deliver() noexcept -> void;
+
+    Job(const FilterScanner& parent,
+        const filter::Type type,
+        std::vector<Request*>&& requests) noexcept;
+
+private:
+    friend ParallelJob<Job>;
+
+    std::atomic<block::Height> missing_;
+    std::mutex lock_;
+    std::vector<std::vector<Match>> matches_;
+
+    auto chunks() const noexcept -> std::size_t { return chunks_.size(); }
+
+    auto finish() noexcept -> void;
+    auto missing(const block::Height height) noexcept -> void;
+    auto process(const std::size_t chunk) noexcept -> void;
+
+    Job(const FilterScanner& parent,
+        const filter::Type type,
+        std::vector<Request*>&& requests,
+        Plan&& plan) noexcept;
+};
+}  // namespace opentxs::blockchain::client::implementation
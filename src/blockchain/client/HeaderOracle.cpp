@@ -18,6 +18,7 @@
 #include <type_traits>
 
 #include "blockchain/client/UpdateTransaction.hpp"
+#include "internal/api/Api.hpp"
 #include "internal/blockchain/Params.hpp"
 #include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
@@ -26,6 +27,7 @@
 #include "opentxs/Proto.tpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
+#include "opentxs/api/ThreadPool.hpp"
 #include "opentxs/blockchain/FilterType.hpp"
 #include "opentxs/blockchain/Work.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
@@ -34,10 +36,12 @@
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/FrameIterator.hpp"
 #include "opentxs/network/zeromq/FrameSection.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Socket.hpp"
 #include "opentxs/protobuf/BlockchainP2PSync.pb.h"
 
 #define OT_METHOD "opentxs::blockchain::client::implementation::HeaderOracle::"
@@ -87,6 +91,15 @@ auto HeaderOracle::GenesisBlockHash(const blockchain::Type type)
 }
 }  // namespace opentxs::blockchain::client
 
+namespace opentxs::blockchain::client::internal
+{
+auto HeaderOracle::ProcessThreadPool(const zmq::Message& in) noexcept -> void
+{
+    implementation::RunFromThreadPool<implementation::HeaderOracle::Validation>(
+        in);
+}
+}  // namespace opentxs::blockchain::client::internal
+
 namespace opentxs::blockchain::client::implementation
 {
 HeaderOracle::HeaderOracle(
@@ -98,11 +111,16 @@ HeaderOracle::HeaderOracle(
     , database_(database)
     , chain_(type)
     , lock_()
+    , best_(std::make_shared<Snapshot>(database_))
+    , thread_pool_(
+          api_.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Connect))
 {
-    Lock lock(lock_);
-    const auto best = best_chain(lock);
+    OT_ASSERT(best_);
+    OT_ASSERT(0 <= best_->Tip().first);
+
+    const auto zmq = thread_pool_->Start(api_.ThreadPool().Endpoint());
 
-    OT_ASSERT(0 <= best.first);
+    OT_ASSERT(zmq);
 }
 
 auto HeaderOracle::Ancestors(
@@ -110,16 +128,15 @@ auto HeaderOracle::Ancestors(
     const block::Position& target,
     const std::size_t limit) const noexcept(false) -> Positions
 {
-    Lock lock(lock_);
+    const auto chain = best();
     const auto check =
         std::max<block::Height>(std::min(start.first, target.first), 0);
-    const auto fast = is_in_best_chain(lock, target.second).first &&
-                      is_in_best_chain(lock, start.second).first &&
+    const auto fast = is_in_best_chain(*chain, target.second).first &&
+                      is_in_best_chain(*chain, start.second).first &&
                       (start.first < target.first);
 
     if (fast) {
-        auto output = best_chain(lock, start, limit);
-        lock.unlock();
+        auto output = best_chain(*chain, start, limit);
 
         while ((1 < output.size()) && (output.back().first > target.first)) {
             output.pop_back();
@@ -203,7 +220,7 @@ auto HeaderOracle::AddCheckpoint(
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -240,7 +257,26 @@ auto HeaderOracle::AddHeaders(
         }
     }
 
-    return database_.ApplyUpdate(update);
+    return apply_update(lock, update);
+}
+
+auto HeaderOracle::AddSerializedHeaders(
+    const std::vector<ReadView>& serialized,
+    const HeaderParser& parser) noexcept -> bool
+{
+    if (serialized.empty()) { return false; }
+
+    auto job = std::make_shared<Validation>(serialized, parser);
+    SendToThreadPool(
+        api_,
+        thread_pool_,
+        api::internal::ThreadPool::Work::BlockchainHeaderValidate,
+        job,
+        job->chunks_);
+    job->Run();
+    auto headers = job->Wait();
+
+    return AddHeaders(headers);
 }
 
 auto HeaderOracle::add_header(
@@ -350,39 +386,45 @@ auto HeaderOracle::apply_checkpoint(
     }
 }
 
-auto HeaderOracle::best_chain(const Lock& lock) const noexcept
-    -> block::Position
+auto HeaderOracle::apply_update(
+    const Lock& lock,
+    const UpdateTransaction& update) noexcept -> bool
+{
+    auto next = best()->Update(update);
+
+    return database_.ApplyUpdate(update, [&] {
+        if (next) { std::atomic_store(&best_, std::move(next)); }
+    });
+}
+
+auto HeaderOracle::best() const noexcept -> std::shared_ptr<const Snapshot>
 {
-    return database_.CurrentBest()->Position();
+    return std::atomic_load(&best_);
 }
 
 auto HeaderOracle::BestChain() const noexcept -> block::Position
 {
-    Lock lock(lock_);
-
-    return best_chain(lock);
+    return best()->Tip();
 }
 
 auto HeaderOracle::BestChain(
     const block::Position& tip,
     const std::size_t limit) const noexcept(false) -> Positions
 {
-    Lock lock(lock_);
-
-    return best_chain(lock, tip, limit);
+    return best_chain(*best(), tip, limit);
 }
 
 auto HeaderOracle::best_chain(
-    const Lock& lock,
+    const Snapshot& chain,
     const block::Position& tip,
     const std::size_t limit) const noexcept -> Positions
 {
-    const auto [youngest, best] = common_parent(lock, tip);
+    const auto [youngest, best] = common_parent(chain, tip);
     static const auto blank = api_.Factory().Data();
     auto height{youngest.first};
     auto output = Positions{};
 
-    for (auto& hash : best_hashes(lock, height, blank, 0)) {
+    for (auto& hash : best_hashes(chain, height, blank, 0)) {
         output.emplace_back(height++, std::move(hash));
 
         if ((0u < limit) && (output.size() == limit)) { break; }
@@ -394,13 +436,12 @@ auto HeaderOracle::best_chain(
 auto HeaderOracle::BestHash(const block::Height height) const noexcept
     -> block::pHash
 {
-    Lock lock(lock_);
+    const auto chain = best();
+    const auto hash = chain->Hash(height);
 
-    try {
-        return database_.BestBlock(height);
-    } catch (...) {
-        return make_blank<block::pHash>::value(api_);
-    }
+    if (hash.empty()) { return make_blank<block::pHash>::value(api_); }
+
+    return api_.Factory().Data(hash);
 }
 
 auto HeaderOracle::BestHashes(
@@ -409,9 +450,7 @@ auto HeaderOracle::BestHashes(
 {
     static const auto blank = api_.Factory().Data();
 
-    Lock lock(lock_);
-
-    return best_hashes(lock, start, blank, limit);
+    return best_hashes(*best(), start, blank, limit);
 }
 
 auto HeaderOracle::BestHashes(
@@ -419,9 +458,7 @@ auto HeaderOracle::BestHashes(
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
 {
-    Lock lock(lock_);
-
-    return best_hashes(lock, start, stop, limit);
+    return best_hashes(*best(), start, stop, limit);
 }
 
 auto HeaderOracle::BestHashes(
@@ -429,11 +466,11 @@ auto HeaderOracle::BestHashes(
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
 {
-    Lock lock(lock_);
+    const auto chain = best();
     auto start = std::size_t{0};
 
     for (const auto& hash : previous) {
-        const auto [best, height] = is_in_best_chain(lock, hash);
+        const auto [best, height] = is_in_best_chain(*chain, hash);
 
         if (best) {
             start = height;
@@ -441,11 +478,11 @@ auto HeaderOracle::BestHashes(
         }
     }
 
-    return best_hashes(lock, start, stop, limit);
+    return best_hashes(*chain, start, stop, limit);
 }
 
 auto HeaderOracle::best_hashes(
-    const Lock& lock,
+    const Snapshot& chain,
     const block::Height start,
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
@@ -458,20 +495,14 @@ auto HeaderOracle::best_hashes(
         static_cast<block::Height>(1)};
 
     while (limitIsZero || (current <= last)) {
-        try {
-            auto hash = database_.BestBlock(current++);
+        const auto hash = chain.Hash(current++);
 
-            // TODO this check shouldn't be necessary but BestBlock doesn't
-            // throw the exception documented in its declaration.
-            if (hash->empty()) { break; }
+        if (hash.empty()) { break; }
 
-            const auto stopHere = stop.empty() ? false : (stop == hash);
-            output.emplace_back(std::move(hash));
+        const auto stopHere = stop.empty() ? false : (stop.Bytes() == hash);
+        output.emplace_back(api_.Factory().Data(hash));
 
-            if (stopHere) { break; }
-        } catch (...) {
-            break;
-        }
+        if (stopHere) { break; }
     }
 
     return output;
@@ -481,9 +512,9 @@ auto HeaderOracle::CalculateReorg(const block::Position tip) const
     noexcept(false) -> Positions
 {
     auto output = Positions{};
-    Lock lock(lock_);
+    const auto chain = best();
 
-    if (is_in_best_chain(lock, tip)) { return output; }
+    if (is_in_best_chain(*chain, tip)) { return output; }
 
     output.emplace_back(tip);
 
@@ -508,7 +539,7 @@ auto HeaderOracle::CalculateReorg(const block::Position tip) const
 
         auto parent = block::Position{height - 1, header.ParentHash()};
 
-        if (is_in_best_chain(lock, parent)) { break; }
+        if (is_in_best_chain(*chain, parent)) { break; }
 
         output.emplace_back(std::move(parent));
     }
@@ -603,19 +634,17 @@ auto HeaderOracle::choose_candidate(
 auto HeaderOracle::CommonParent(const block::Position& position) const noexcept
     -> std::pair<block::Position, block::Position>
 {
-    Lock lock(lock_);
-
-    return common_parent(lock, position);
+    return common_parent(*best(), position);
 }
 
 auto HeaderOracle::common_parent(
-    const Lock& lock,
+    const Snapshot& chain,
     const block::Position& position) const noexcept
     -> std::pair<block::Position, block::Position>
 {
     const auto& database = database_;
     std::pair<block::Position, block::Position> output{
-        {0, GenesisBlockHash(chain_)}, best_chain(lock)};
+        {0, GenesisBlockHash(chain_)}, chain.Tip()};
     auto& [parent, best] = output;
     auto test{position};
     auto pHeader = database.TryLoadHeader(test.second);
@@ -623,7 +652,7 @@ auto HeaderOracle::common_parent(
     if (false == bool(pHeader)) { return output; }
 
     while (0 < test.first) {
-        if (is_in_best_chain(lock, test.second).first) {
+        if (is_in_best_chain(chain, test.second).first) {
             parent = test;
 
             return output;
@@ -708,7 +737,7 @@ auto HeaderOracle::DeleteCheckpoint() noexcept -> bool
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -820,17 +849,13 @@ auto HeaderOracle::initialize_candidate(
 
 auto HeaderOracle::IsInBestChain(const block::Hash& hash) const noexcept -> bool
 {
-    Lock lock(lock_);
-
-    return is_in_best_chain(lock, hash).first;
+    return is_in_best_chain(*best(), hash).first;
 }
 
 auto HeaderOracle::IsInBestChain(const block::Position& position) const noexcept
     -> bool
 {
-    Lock lock(lock_);
-
-    return is_in_best_chain(lock, position.first, position.second);
+    return is_in_best_chain(*best(), position.first, position.second);
 }
 
 auto HeaderOracle::is_disconnected(
@@ -853,8 +878,9 @@ auto HeaderOracle::is_disconnected(
     }
 }
 
-auto HeaderOracle::is_in_best_chain(const Lock& lock, const block::Hash& hash)
-    const noexcept -> std::pair<bool, block::Height>
+auto HeaderOracle::is_in_best_chain(
+    const Snapshot& chain,
+    const block::Hash& hash) const noexcept -> std::pair<bool, block::Height>
 {
     const auto pHeader = database_.TryLoadHeader(hash);
 
@@ -862,28 +888,24 @@ auto HeaderOracle::is_in_best_chain(const Lock& lock, const block::Hash& hash)
 
     const auto& header = *pHeader;
 
-    return {is_in_best_chain(lock, header.Height(), hash), header.Height()};
+    return {is_in_best_chain(chain, header.Height(), hash), header.Height()};
 }
 
 auto HeaderOracle::is_in_best_chain(
-    const Lock& lock,
+    const Snapshot& chain,
     const block::Position& position) const noexcept -> bool
 {
-    return is_in_best_chain(lock, position.first, position.second);
+    return is_in_best_chain(chain, position.first, position.second);
 }
 
 auto HeaderOracle::is_in_best_chain(
-    const Lock& lock,
+    const Snapshot& chain,
     const block::Height height,
     const block::Hash& hash) const noexcept -> bool
 {
-    try {
-        return hash == database_.BestBlock(height);
-
-    } catch (...) {
+    const auto best = chain.Hash(height);
 
-        return false;
-    }
+    return (false == best.empty()) && (hash.Bytes() == best);
 }
 
 auto HeaderOracle::LoadBitcoinHeader(const block::Hash& hash) const noexcept
@@ -910,6 +932,7 @@ auto HeaderOracle::ProcessSyncData(
     vector.clear();
     vector.reserve(b.size() - 1u);
     Lock lock(lock_);
+    const auto chain = best();
     auto update = UpdateTransaction{api_, database_};
     auto previous = [&] {
         const auto& first = b.at(2);
@@ -957,7 +980,7 @@ auto HeaderOracle::ProcessSyncData(
                     api_.Factory().Data(sync.filter(), StringStyle::Raw));
             previous = hash;
 
-            if (is_in_best_chain(lock, hash).first) { continue; }
+            if (is_in_best_chain(*chain, hash).first) { continue; }
         }
 
         if (false == add_header(lock, update, std::move(pHeader))) {
@@ -969,7 +992,7 @@ auto HeaderOracle::ProcessSyncData(
         }
     }
 
-    database_.ApplyUpdate(update);
+    apply_update(lock, update);
 
     return 0 < vector.size();
 }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <deque>
 #include <iosfwd>
 #include <map>
@@ -17,7 +19,9 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/client/ParallelJob.hpp"
 #include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
@@ -25,6 +29,7 @@
 #include "opentxs/blockchain/Types.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/core/Data.hpp"
+#include "opentxs/network/zeromq/socket/Push.hpp"
 
 namespace opentxs
 {
@@ -67,6 +72,8 @@ namespace opentxs::blockchain::client::implementation
 class HeaderOracle final : virtual public internal::HeaderOracle
 {
 public:
+    struct Validation;
+
     auto Ancestors(
         const block::Position& start,
         const block::Position& target,
@@ -112,6 +119,9 @@ public:
         -> bool final;
     auto AddHeaders(std::vector<std::unique_ptr<block::Header>>&) noexcept
         -> bool final;
+    auto AddSerializedHeaders(
+        const std::vector<ReadView>& headers,
+        const HeaderParser& parser) noexcept -> bool final;
     auto DeleteCheckpoint() noexcept -> bool final;
     auto Init() noexcept -> void final;
     auto ProcessSyncData(
@@ -131,35 +141,71 @@ private:
         std::deque<block::Position> chain_{};
     };
 
+    // Immutable copy of the best chain. Every update to the header database
+    // publishes a new snapshot so queries never wait for header processing.
+    // Pages which are not modified by an update are shared with the previous
+    // snapshot.
+    class Snapshot
+    {
+    public:
+        // Returns an empty view if the height is not in the best chain
+        auto Hash(const block::Height height) const noexcept -> ReadView;
+        auto Tip() const noexcept -> const block::Position& { return tip_; }
+        // Returns nullptr if the update does not modify the best chain
+        auto Update(const UpdateTransaction& update) const noexcept
+            -> std::shared_ptr<const Snapshot>;
+
+        Snapshot(const internal::HeaderDatabase& database) noexcept;
+        Snapshot(const Snapshot&) = default;
+
+    private:
+        using Page = std::shared_ptr<const Space>;
+
+        static constexpr auto hash_size_ = std::size_t{32};
+        static constexpr auto page_size_ = std::size_t{1024};
+
+        std::vector<Page> pages_;
+        block::Position tip_;
+
+        Snapshot() = delete;
+        Snapshot(Snapshot&&) = delete;
+        auto operator=(const Snapshot&) -> Snapshot& = delete;
+        auto operator=(Snapshot&&) -> Snapshot& = delete;
+    };
+
     using Candidates = std::vector<Candidate>;
 
     const api::Core& api_;
     const internal::HeaderDatabase& database_;
     const blockchain::Type chain_;
     mutable std::mutex lock_;
+    // NOTE only access via std::atomic_load and std::atomic_store
+    std::shared_ptr<const Snapshot> best_;
+    OTZMQPushSocket thread_pool_;
 
     static auto evaluate_candidate(
         const block::Header& current,
         const block::Header& candidate) noexcept -> bool;
 
-    auto best_chain(const Lock& lock) const noexcept -> block::Position;
+    auto best() const noexcept -> std::shared_ptr<const Snapshot>;
     auto best_chain(
-        const Lock& lock,
+        const Snapshot& chain,
         const block::Position& tip,
         const std::size_t limit) const noexcept -> Positions;
     auto best_hashes(
-        const Lock& lock,
+        const Snapshot& chain,
         const block::Height start,
         const block::Hash& stop,
         const std::size_t limit) const noexcept -> Hashes;
-    auto common_parent(const Lock& lock, const block::Position& position)
+    auto common_parent(const Snapshot& chain, const block::Position& position)
         const noexcept -> std::pair<block::Position, block::Position>;
-    auto is_in_best_chain(const Lock& lock, const block::Hash& hash)
+    auto is_in_best_chain(const Snapshot& chain, const block::Hash& hash)
         const noexcept -> std::pair<bool, block::Height>;
-    auto is_in_best_chain(const Lock& lock, const block::Position& position)
-        const noexcept -> bool;
     auto is_in_best_chain(
-        const Lock& lock,
+        const Snapshot& chain,
+        const block::Position& position) const noexcept -> bool;
+    auto is_in_best_chain(
+        const Snapshot& chain,
         const block::Height height,
         const block::Hash& hash) const noexcept -> bool;
 
@@ -171,6 +217,9 @@ private:
         const Lock& lock,
         const block::Height height,
         UpdateTransaction& update) noexcept -> bool;
+    auto apply_update(
+        const Lock& lock,
+        const UpdateTransaction& update) noexcept -> bool;
     auto choose_candidate(
         const block::Header& current,
         const Candidates& candidates,
@@ -212,4 +261,29 @@ private:
     auto operator=(const HeaderOracle&) -> HeaderOracle& = delete;
     auto operator=(HeaderOracle&&) -> HeaderOracle& = delete;
 };
+
+// Stateless validation of a batch of serialized headers. The batch is divided
+// into chunks which are claimed by the threads running the job. Headers which
+// fail validation are left null.
+struct HeaderOracle::Validation final
+    : public ParallelJob<HeaderOracle::Validation> {
+    const std::size_t chunks_;
+
+    auto Wait() noexcept -> std::vector<std::unique_ptr<block::Header>>;
+
+    Validation(
+        const std::vector<ReadView>& serialized,
+        const HeaderParser& parser) noexcept;
+
+private:
+    friend ParallelJob<Validation>;
+
+    const std::vector<ReadView>& serialized_;
+    const HeaderParser& parser_;
+    std::vector<std::unique_ptr<block::Header>> headers_;
+
+    auto chunks() const noexcept -> std::size_t { return chunks_; }
+    auto finish() noexcept -> void {}
+    auto process(const std::size_t chunk) noexcept -> void;
+};
 }  // namespace opentxs::blockchain::client::implementation
@@ -139,6 +139,7 @@ Network::Network(
     , header_p_(factory::HeaderOracle(api, *database_p_, type))
     , block_p_(factory::BlockOracle(
           api,
+          config_,
           *this,
           *header_p_,
           *database_p_,
@@ -166,6 +167,7 @@ Network::Network(
           database_p_->BlockPolicy(),
           seednode,
           shutdown_sender_.endpoint_))
+    , scanner_p_(factory::BlockchainFilterScanner(api, *this))
     , wallet_p_([&]() -> std::unique_ptr<blockchain::client::internal::Wallet> {
         if (config_.disable_wallet_) {
 
@@ -222,6 +224,7 @@ Network::Network(
     OT_ASSERT(header_p_);
     OT_ASSERT(peer_p_);
     OT_ASSERT(block_p_);
+    OT_ASSERT(scanner_p_);
     OT_ASSERT(wallet_p_);
 
     database_.SetDefaultFilterType(filters_.DefaultType());
@@ -537,14 +540,12 @@ auto Network::process_header(network::zeromq::Message& in) noexcept -> void
         promise = promiseFrame.as<int>();
     }
 
-    auto headers = std::vector<std::unique_ptr<block::Header>>{};
-
-    for (const auto& header : input) {
-        headers.emplace_back(instantiate_header(header));
+    if (false == input.empty()) {
+        header_.AddSerializedHeaders(input, [this](const auto bytes) {
+            return instantiate_header(bytes);
+        });
     }
 
-    if (false == headers.empty()) { header_.AddHeaders(headers); }
-
     work_promises_.clear(promise);
 }
 
@@ -116,7 +116,8 @@ public:
     auto AddBlock(const std::shared_ptr<const block::bitcoin::Block> block)
         const noexcept -> bool final;
     auto AddPeer(const p2p::Address& address) const noexcept -> bool final;
-    auto BlockOracle() const noexcept -> const internal::BlockOracle& final
+    auto BlockOracleInternal() const noexcept
+        -> const internal::BlockOracle& final
     {
         return *block_p_;
     }
@@ -134,6 +135,11 @@ public:
     {
         return *filter_p_;
     }
+    auto FilterScanner() const noexcept
+        -> const internal::FilterScanner& final
+    {
+        return *scanner_p_;
+    }
     auto GetBalance() const noexcept -> Balance final
     {
         return database_.GetBalance();
@@ -225,6 +231,7 @@ private:
     std::unique_ptr<internal::BlockOracle> block_p_;
     std::unique_ptr<internal::FilterOracle> filter_p_;
     std::unique_ptr<internal::PeerManager> peer_p_;
+    std::unique_ptr<internal::FilterScanner> scanner_p_;
     std::unique_ptr<internal::Wallet> wallet_p_;
 
 protected:
@@ -0,0 +1,167 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "internal/api/Api.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/ThreadPool.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
+#include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Push.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+// Work divided into chunks which are claimed by any thread which calls Run().
+//
+// Child must implement these members, which may be private if Child declares
+// ParallelJob<Child> as a friend:
+//
+//   auto chunks() const noexcept -> std::size_t;
+//   auto process(const std::size_t chunk) noexcept -> void;
+//   // Called once, by the thread which completes the last chunk, before any
+//   // thread blocked in Wait() is released
+//   auto finish() noexcept -> void;
+template <typename Child>
+class ParallelJob
+{
+public:
+    // Returns when no unclaimed chunks remain, which may be before the chunks
+    // claimed by other threads have been processed. A job without chunks is
+    // finished by the first call.
+    auto Run() noexcept -> void
+    {
+        auto& child = static_cast<Child&>(*this);
+        const auto count = child.chunks();
+
+        if (0u == count) {
+            if (0u == next_.fetch_add(1)) { complete(child); }
+
+            return;
+        }
+
+        while (true) {
+            const auto chunk = next_.fetch_add(1);
+
+            if (chunk >= count) { return; }
+
+            child.process(chunk);
+
+            if (count == ++done_) { complete(child); }
+        }
+    }
+    // Blocks until every chunk has been processed and the job is finished
+    auto Wait() noexcept -> void
+    {
+        auto lock = Lock{lock_};
+        cv_.wait(lock, [this] { return finished_; });
+    }
+
+protected:
+    ParallelJob() noexcept
+        : next_(0)
+        , done_(0)
+        , lock_()
+        , cv_()
+        , finished_(false)
+    {
+    }
+
+    ~ParallelJob() = default;
+
+private:
+    std::atomic<std::size_t> next_;
+    std::atomic<std::size_t> done_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    bool finished_;
+
+    auto complete(Child& child) noexcept -> void
+    {
+        child.finish();
+
+        {
+            auto lock = Lock{lock_};
+            finished_ = true;
+        }
+
+        cv_.notify_all();
+    }
+
+    ParallelJob(const ParallelJob&) = delete;
+    ParallelJob(ParallelJob&&) = delete;
+    auto operator=(const ParallelJob&) -> ParallelJob& = delete;
+    auto operator=(ParallelJob&&) -> ParallelJob& = delete;
+};
+
+// Queues helpers for the job on the thread pool, one fewer than the number of
+// chunks since the calling thread is expected to call Run() itself. The
+// calling thread performs the work without assistance if the thread pool is
+// busy, so queued helpers may find no work remaining, in which case they
+// return immediately.
+template <typename Job>
+auto SendToThreadPool(
+    const api::Core& api,
+    const network::zeromq::socket::Push& socket,
+    const api::internal::ThreadPool::Work type,
+    const std::shared_ptr<Job>& job,
+    const std::size_t chunks) noexcept -> void
+{
+    if (0u == chunks) { return; }
+
+    using Pool = api::internal::ThreadPool;
+    const auto helpers = std::min(chunks, api::ThreadPool::Capacity()) - 1u;
+
+    for (auto i = std::size_t{0}; i < helpers; ++i) {
+        auto work = Pool::MakeWork(api.ZeroMQ(), value(type));
+        auto* pJob = new std::shared_ptr<Job>{job};
+        work->AddFrame(reinterpret_cast<std::uintptr_t>(pJob));
+
+        if (false == socket.Send(work)) {
+            delete pJob;
+
+            return;
+        }
+    }
+}
+
+// Runs a job queued by SendToThreadPool on a thread pool thread
+template <typename Job>
+auto RunFromThreadPool(const network::zeromq::Message& in) noexcept -> void
+{
+    const auto body = in.Body();
+
+    if (1 > body.size()) {
+        LogOutput("opentxs::blockchain::client::implementation::")(
+            __FUNCTION__)(": Invalid message")
+            .Flush();
+
+        OT_FAIL;
+    }
+
+    auto job = std::unique_ptr<std::shared_ptr<Job>>{
+        reinterpret_cast<std::shared_ptr<Job>*>(
+            body.at(0).as<std::uintptr_t>())};
+
+    OT_ASSERT(job);
+    OT_ASSERT(*job);
+
+    (*job)->Run();
+}
+}  // namespace opentxs::blockchain::client::implementation
@@ -29,21 +29,21 @@
 
 namespace opentxs::blockchain::client::implementation
 {
-const std::size_t BlockOracle::Cache::cache_limit_{16};
 const std::chrono::seconds BlockOracle::Cache::download_timeout_{15};
 
 BlockOracle::Cache::Cache(
     const api::Core& api,
     const internal::Network& network,
     const internal::BlockDatabase& db,
-    const blockchain::Type chain) noexcept
+    const blockchain::Type chain,
+    const std::size_t limit) noexcept
     : api_(api)
     , network_(network)
     , db_(db)
     , chain_(chain)
     , lock_()
     , pending_()
-    , mem_(cache_limit_)
+    , mem_(limit, lock_)
     , running_(true)
 {
 }
@@ -54,6 +54,14 @@ auto BlockOracle::Cache::download(const block::Hash& block) const noexcept
     return network_.RequestBlock(block);
 }
 
+auto BlockOracle::Cache::Pin(const block::Hash& block) const noexcept
+    -> BlockOracle::Pin
+{
+    Lock lock{lock_};
+
+    return mem_.pin(block);
+}
+
 auto BlockOracle::Cache::ReceiveBlock(const zmq::Frame& in) const noexcept
     -> void
 {
@@ -149,8 +157,8 @@ auto BlockOracle::Cache::Request(const BlockHashes& hashes) const noexcept
 
             auto promise = Promise{};
             promise.set_value(std::move(pBlock));
-            mem_.push(OTData{block}, promise.get_future());
-            output.emplace_back(mem_.find(block->Bytes()));
+            const auto& future = output.emplace_back(promise.get_future());
+            mem_.push(OTData{block}, BitcoinBlockFuture{future});
             found = true;
         }
 
@@ -239,4 +247,11 @@ auto BlockOracle::Cache::StateMachine() const noexcept -> bool
 
     return 0 < pending_.size();
 }
+
+auto BlockOracle::Cache::Statistics() const noexcept -> CacheStats
+{
+    Lock lock{lock_};
+
+    return mem_.Statistics();
+}
 }  // namespace opentxs::blockchain::client::implementation
@@ -8,9 +8,13 @@
 #include "blockchain/client/BlockOracle.hpp"  // IWYU pragma: associated
 
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
 #include "opentxs/blockchain/client/BlockOracle.hpp"
 
 // #define OT_METHOD
@@ -18,10 +22,18 @@
 
 namespace opentxs::blockchain::client::implementation
 {
-BlockOracle::Cache::Mem::Mem(const std::size_t limit) noexcept
+BlockOracle::Cache::Mem::Mem(
+    const std::size_t limit,
+    std::mutex& lock) noexcept
     : limit_(limit)
+    , shared_(std::make_shared<Shared>(lock, this))
     , queue_()
     , index_()
+    , pins_()
+    , bytes_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0)
 {
 }
 
@@ -29,20 +41,84 @@ auto BlockOracle::Cache::Mem::clear() noexcept -> void
 {
     index_.clear();
     queue_.clear();
+    pins_.clear();
+    bytes_ = 0;
 }
 
-auto BlockOracle::Cache::Mem::find(const ReadView& id) const noexcept
+auto BlockOracle::Cache::Mem::evict() noexcept -> void
+{
+    auto it = queue_.end();
+
+    while ((bytes_ > limit_) && (queue_.begin() != it)) {
+        --it;
+
+        if (is_pinned(it->id_)) { continue; }
+
+        bytes_ -= it->bytes_;
+        index_.erase(it->id_->Bytes());
+        it = queue_.erase(it);
+        ++evictions_;
+    }
+}
+
+auto BlockOracle::Cache::Mem::find(const ReadView& id) noexcept
     -> BitcoinBlockFuture
 {
     if ((nullptr == id.data()) || (0 == id.size())) { return {}; }
 
-    try {
+    auto it = index_.find(id);
 
-        return index_.at(id)->second;
-    } catch (...) {
+    if (index_.end() == it) {
+        ++misses_;
 
         return {};
     }
+
+    ++hits_;
+    queue_.splice(queue_.begin(), queue_, it->second);
+
+    return it->second->future_;
+}
+
+auto BlockOracle::Cache::Mem::is_pinned(const block::pHash& id) noexcept
+    -> bool
+{
+    auto it = pins_.find(id);
+
+    if (pins_.end() == it) { return false; }
+
+    if (it->second.expired()) {
+        pins_.erase(it);
+
+        return false;
+    }
+
+    return true;
+}
+
+auto BlockOracle::Cache::Mem::pin(const block::Hash& id) noexcept
+    -> BlockOracle::Pin
+{
+    auto key = Data::Factory(id);
+
+    if (auto it = pins_.find(key); pins_.end() != it) {
+        if (auto output = it->second.lock(); output) { return output; }
+    }
+
+    auto owner = std::make_shared<block::pHash>(key);
+    auto output = BlockOracle::Pin{
+        &(owner->get()),
+        [owner, shared = shared_](const block::Hash*) {
+            Lock lock{shared->lock_};
+
+            if (nullptr == shared->mem_) { return; }
+
+            Lock owned{shared->owner_};
+            shared->mem_->unpin(*owner);
+        }};
+    pins_[std::move(key)] = output;
+
+    return output;
 }
 
 auto BlockOracle::Cache::Mem::push(
@@ -51,13 +127,51 @@ auto BlockOracle::Cache::Mem::push(
 {
     if (0 == id->size()) { return; }
 
-    const auto& item = queue_.emplace_back(std::move(id), std::move(future));
-    index_[item.first->Bytes()] = queue_.crbegin();
-
-    while (queue_.size() > limit_) {
-        const auto& item = queue_.front();
-        index_.erase(item.first->Bytes());
-        queue_.pop_front();
+    if (auto it = index_.find(id->Bytes()); index_.end() != it) {
+        auto item = it->second;
+        bytes_ -= item->bytes_;
+        index_.erase(it);
+        queue_.erase(item);
     }
+
+    // NOTE futures are always ready when they are added to the cache. The size
+    // of the serialized block is used as an estimate of its memory usage.
+    const auto bytes = [&]() -> std::size_t {
+        const auto& pBlock = future.get();
+
+        return bool(pBlock) ? pBlock->CalculateSize() : 0u;
+    }();
+    queue_.push_front(Item{std::move(id), std::move(future), bytes});
+    const auto item = queue_.begin();
+    index_.emplace(item->id_->Bytes(), item);
+    bytes_ += bytes;
+    evict();
+}
+
+auto BlockOracle::Cache::Mem::Statistics() const noexcept -> CacheStats
+{
+    auto output = CacheStats{};
+    output.hits_ = hits_;
+    output.misses_ = misses_;
+    output.evictions_ = evictions_;
+    output.blocks_ = queue_.size();
+    output.bytes_ = bytes_;
+    output.limit_ = limit_;
+
+    return output;
+}
+
+auto BlockOracle::Cache::Mem::unpin(const block::pHash& id) noexcept -> void
+{
+    // The block may have been pinned again since the pin was released
+    if (is_pinned(id)) { return; }
+
+    evict();
+}
+
+BlockOracle::Cache::Mem::~Mem()
+{
+    Lock lock{shared_->lock_};
+    shared_->mem_ = nullptr;
 }
 }  // namespace opentxs::blockchain::client::implementation
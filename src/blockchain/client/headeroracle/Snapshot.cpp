@@ -0,0 +1,130 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                        // IWYU pragma: associated
+#include "1_Internal.hpp"                      // IWYU pragma: associated
+#include "blockchain/client/HeaderOracle.hpp"  // IWYU pragma: associated
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "blockchain/client/UpdateTransaction.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+HeaderOracle::Snapshot::Snapshot(
+    const internal::HeaderDatabase& database) noexcept
+    : pages_()
+    , tip_(database.CurrentBest()->Position())
+{
+    const auto count = static_cast<std::size_t>(tip_.first + 1);
+    auto page = std::make_shared<Space>();
+
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        if (page_size_ * hash_size_ == page->size()) {
+            pages_.emplace_back(std::move(page));
+            page = std::make_shared<Space>();
+        }
+
+        const auto hash = database.BestBlock(static_cast<block::Height>(i));
+        const auto bytes = hash->Bytes();
+
+        OT_ASSERT(hash_size_ == bytes.size());
+
+        page->reserve(page_size_ * hash_size_);
+        const auto* it = reinterpret_cast<const std::byte*>(bytes.data());
+        page->insert(page->end(), it, it + hash_size_);
+    }
+
+    if (false == page->empty()) { pages_.emplace_back(std::move(page)); }
+}
+
+auto HeaderOracle::Snapshot::Hash(const block::Height height) const noexcept
+    -> ReadView
+{
+    if ((0 > height) || (height > tip_.first)) { return {}; }
+
+    const auto index = static_cast<std::size_t>(height);
+    const auto& page = *pages_.at(index / page_size_);
+    const auto offset = (index % page_size_) * hash_size_;
+
+    OT_ASSERT((offset + hash_size_) <= page.size());
+
+    return {reinterpret_cast<const char*>(page.data() + offset), hash_size_};
+}
+
+auto HeaderOracle::Snapshot::Update(
+    const UpdateTransaction& update) const noexcept
+    -> std::shared_ptr<const Snapshot>
+{
+    const auto& best = update.BestChain();
+
+    if ((false == update.HaveReorg()) && best.empty()) { return {}; }
+
+    auto output = std::make_shared<Snapshot>(*this);
+    auto& pages = output->pages_;
+    auto& tip = output->tip_;
+    // Pages copied from the previous snapshot which may be modified
+    auto copied = std::map<std::size_t, Space*>{};
+    const auto writable = [&](const std::size_t index) -> Space& {
+        if (auto it = copied.find(index); copied.end() != it) {
+            return *it->second;
+        }
+
+        if (index >= pages.size()) { pages.resize(index + 1u); }
+
+        auto& page = pages.at(index);
+        auto copy = page ? std::make_shared<Space>(*page)
+                         : std::make_shared<Space>();
+        auto* pCopy = copy.get();
+        page = std::move(copy);
+        copied.emplace(index, pCopy);
+
+        return *pCopy;
+    };
+
+    if (update.HaveReorg()) {
+        tip = update.ReorgParent();
+        const auto count = static_cast<std::size_t>(tip.first + 1);
+        const auto needed = (count + page_size_ - 1u) / page_size_;
+        pages.resize(needed);
+
+        if (0u < needed) {
+            const auto last = needed - 1u;
+            writable(last).resize((count - (last * page_size_)) * hash_size_);
+        }
+    }
+
+    for (const auto& [height, hash] : best) {
+        const auto bytes = hash->Bytes();
+
+        OT_ASSERT(0 <= height);
+        OT_ASSERT(hash_size_ == bytes.size());
+
+        const auto index = static_cast<std::size_t>(height);
+        auto& page = writable(index / page_size_);
+        const auto offset = (index % page_size_) * hash_size_;
+
+        if (page.size() < (offset + hash_size_)) {
+            page.resize(offset + hash_size_);
+        }
+
+        std::memcpy(page.data() + offset, bytes.data(), hash_size_);
+    }
+
+    if (false == best.empty()) {
+        const auto& [height, hash] = *best.crbegin();
+        tip = {height, hash};
+    }
+
+    return output;
+}
+}  // namespace opentxs::blockchain::client::implementation
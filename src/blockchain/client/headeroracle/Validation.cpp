@@ -0,0 +1,78 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                        // IWYU pragma: associated
+#include "1_Internal.hpp"                      // IWYU pragma: associated
+#include "blockchain/client/HeaderOracle.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD                                                              \
+    "opentxs::blockchain::client::implementation::HeaderOracle::Validation::"
+
+namespace opentxs::blockchain::client::implementation
+{
+// Number of consecutive headers validated by a thread per claim
+constexpr auto validation_batch_ = std::size_t{50};
+// Headers with timestamps further in the future than this are rejected
+constexpr auto max_future_time_ = std::chrono::hours{2};
+
+HeaderOracle::Validation::Validation(
+    const std::vector<ReadView>& serialized,
+    const HeaderParser& parser) noexcept
+    : ParallelJob()
+    , chunks_((serialized.size() + validation_batch_ - 1u) / validation_batch_)
+    , serialized_(serialized)
+    , parser_(parser)
+    , headers_(serialized.size())
+{
+}
+
+auto HeaderOracle::Validation::process(const std::size_t chunk) noexcept
+    -> void
+{
+    const auto first = chunk * validation_batch_;
+    const auto last = std::min(first + validation_batch_, serialized_.size());
+    const auto limit = Clock::now() + max_future_time_;
+
+    for (auto i = first; i < last; ++i) {
+        auto& header = headers_.at(i);
+        header = parser_(serialized_.at(i));
+
+        if (false == bool(header)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to parse header ")(i)
+                .Flush();
+
+            continue;
+        }
+
+        const auto* bitcoin =
+            dynamic_cast<const block::bitcoin::Header*>(header.get());
+
+        if ((nullptr != bitcoin) && (bitcoin->Timestamp() > limit)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Header ")(
+                header->Hash().asHex())(" timestamp is too far in the future")
+                .Flush();
+            header.reset();
+        }
+    }
+}
+
+auto HeaderOracle::Validation::Wait() noexcept
+    -> std::vector<std::unique_ptr<block::Header>>
+{
+    ParallelJob::Wait();
+
+    return std::move(headers_);
+}
+}  // namespace opentxs::blockchain::client::implementation
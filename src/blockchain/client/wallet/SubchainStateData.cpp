@@ -12,6 +12,7 @@
 #include <future>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -125,6 +126,7 @@ SubchainStateData::SubchainStateData(
     , last_scanned_(db.SubchainLastScanned(index_))
     , blocks_to_request_()
     , outstanding_blocks_()
+    , pinned_blocks_()
     , process_block_queue_()
     , api_(api)
     , blockchain_(blockchain)
@@ -175,8 +177,10 @@ auto SubchainStateData::check_blocks() noexcept -> bool
             .Flush();
 
         if (0 == outstanding_blocks_.count(hash)) {
-            auto [it, added] = outstanding_blocks_.emplace(
-                hash, network_.BlockOracle().LoadBitcoin(hash));
+            const auto& oracle = network_.BlockOracleInternal();
+            pinned_blocks_.emplace(hash, oracle.PinBlock(hash));
+            auto [it, added] =
+                outstanding_blocks_.emplace(hash, oracle.LoadBitcoin(hash));
 
             OT_ASSERT(added);
 
@@ -305,18 +309,6 @@ auto SubchainStateData::describe() const noexcept -> std::string
     return out.str();
 }
 
-auto SubchainStateData::get_account_targets() const noexcept
-    -> std::tuple<Patterns, UTXOs, Targets>
-{
-    auto out = std::tuple<Patterns, UTXOs, Targets>{};
-    auto& [elements, utxos, targets] = out;
-    elements = db_.GetPatterns(index_);
-    utxos = db_.GetUnspentOutputs(id_, subchain_);
-    get_targets(elements, utxos, targets);
-
-    return out;
-}
-
 auto SubchainStateData::get_block_targets(
     const block::Hash& id,
     const UTXOs& utxos) const noexcept -> std::pair<Patterns, Targets>
@@ -460,6 +452,7 @@ auto SubchainStateData::process() noexcept -> void
     const auto& filters = network_.FilterOracleInternal();
     auto it = process_block_queue_.front();
     auto postcondition = ScopeGuard{[&] {
+        pinned_blocks_.erase(it->first);
         outstanding_blocks_.erase(it);
         process_block_queue_.pop();
     }};
@@ -575,6 +568,7 @@ auto SubchainStateData::reorg() noexcept -> void
 
     blocks_to_request_.clear();
     outstanding_blocks_.clear();
+    pinned_blocks_.clear();
 
     while (false == process_block_queue_.empty()) {
         process_block_queue_.pop();
@@ -613,55 +607,76 @@ auto SubchainStateData::scan() noexcept -> void
     LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(name_)(" scanning filters from ")(
         startHeight)(" to ")(stopHeight)
         .Flush();
-    const auto [elements, utxos, patterns] = get_account_targets();
-    auto highestTested = last_scanned_.value_or(null_position_);
-    auto atLeastOnce{false};
-    auto blockHash = api_.Factory().Data();
+    const auto utxos = db_.GetUnspentOutputs(id_, subchain_);
+    // NOTE each range only contains the patterns which have not already been
+    // tested against the blocks in that range
+    const auto [version, ranges] =
+        db_.GetScanTargets(index_, startHeight, stopHeight);
+    auto highestTested = std::optional<block::Position>{};
     auto cache = decltype(blocks_to_request_){};
 
-    for (auto i{startHeight}; i <= stopHeight; ++i) {
-        blockHash = headers.BestHash(i);
-        const auto pFilter = filters.LoadFilterOrResetTip(
-            filter_type_, block::Position{i, blockHash});
-
-        if (false == bool(pFilter)) {
+    for (const auto& [first, last, elements] : ranges) {
+        auto patterns = Targets{};
+        get_targets(elements, utxos, patterns);
+        LogTrace(OT_METHOD)(__FUNCTION__)(": ")(name_)(" testing ")(
+            patterns.size())(" target elements against blocks ")(first)(
+            " to ")(last)
+            .Flush();
+        // NOTE concurrent scans of other subchains are coalesced so each
+        // filter is loaded once for all of them
+        auto [tested, matches] = network_.FilterScanner().Scan(
+            filter_type_, first, last, patterns);
+        auto untested = std::vector<block::Height>{};
+
+        for (const auto& [position, pFilter] : matches) {
+            const auto& [height, blockHash] = position;
+            const auto& filter = *pFilter;
             LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(name_)(
-                " filter at height ")(i)(" not found ")
-                .Flush();
-
-            break;
-        }
-
-        atLeastOnce = true;
-        highestTested.first = i;
-        highestTested.second = blockHash;
-        const auto& filter = *pFilter;
-        auto matches = filter.Match(patterns);
-        const auto size{matches.size()};
-
-        if (0 < matches.size()) {
-            LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(name_)(" GCS for block ")(
-                blockHash->asHex())(" at height ")(i)(
+                " GCS for block ")(blockHash->asHex())(" at height ")(height)(
                 " matches at least one of the ")(patterns.size())(
                 " target elements for ")(id_)
                 .Flush();
-            const auto [untested, retest] = get_block_targets(blockHash, utxos);
-            matches = filter.Match(retest);
+            const auto [unused, retest] = get_block_targets(blockHash, utxos);
+            const auto found = filter.Match(retest);
             LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(name_)(" ")(
-                matches.size())(" of ")(size)(" matches are new")
+                found.size())(" of the matches are new")
                 .Flush();
 
-            if (0 < matches.size()) {
-                cache.emplace_back(std::move(blockHash));
+            if (0 < found.size()) {
+                cache.emplace_back(blockHash);
+                untested.emplace_back(height);
+            }
+        }
+
+        if (false == tested.has_value()) { break; }
+
+        // NOTE blocks queued for download are not marked as tested so they
+        // will be scanned again if the download is abandoned
+        auto from{first};
+
+        for (const auto height : untested) {
+            if (height > from) {
+                db_.SubchainSetTested(index_, from, height - 1, version);
             }
+
+            from = height + 1;
+        }
+
+        if (from <= tested.value().first) {
+            db_.SubchainSetTested(index_, from, tested.value().first, version);
         }
+
+        const auto interrupted = tested.value().first < last;
+        highestTested = std::move(tested);
+
+        if (interrupted) { break; }
     }
 
-    if (atLeastOnce) {
+    if (highestTested.has_value()) {
         const auto count = cache.size();
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(name_)(" found ")(count)(
             " potential matches between blocks ")(startHeight)(" and ")(
-            highestTested.first)(" in ")(
+            highestTested.value().first)(" in ")(
             std::chrono::duration_cast<std::chrono::milliseconds>(
                 Clock::now() - start)
                 .count())(" milliseconds")
@@ -90,6 +90,7 @@ public:
     using OutstandingMap =
         std::map<block::pHash, BlockOracle::BitcoinBlockFuture>;
     using ProcessQueue = std::queue<OutstandingMap::iterator>;
+    using PinnedMap = std::map<block::pHash, internal::BlockOracle::Pin>;
     using SubchainIndex = WalletDatabase::pSubchainIndex;
 
     struct ReorgQueue {
@@ -116,6 +117,8 @@ public:
     std::optional<block::Position> last_scanned_;
     std::vector<block::pHash> blocks_to_request_;
     OutstandingMap outstanding_blocks_;
+    // Keeps outstanding blocks in the block oracle memory cache
+    PinnedMap pinned_blocks_;
     ProcessQueue process_block_queue_;
 
     virtual auto index() noexcept -> void = 0;
@@ -142,8 +145,6 @@ protected:
     const block::Position null_position_;
 
     auto describe() const noexcept -> std::string;
-    auto get_account_targets() const noexcept
-        -> std::tuple<Patterns, UTXOs, Targets>;
     auto get_block_targets(const block::Hash& id, const UTXOs& utxos)
         const noexcept -> std::pair<Patterns, Targets>;
     auto get_block_targets(const block::Hash& id, Tested& tested) const noexcept
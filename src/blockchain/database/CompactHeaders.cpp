@@ -0,0 +1,456 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                            // IWYU pragma: associated
+#include "1_Internal.hpp"                          // IWYU pragma: associated
+#include "blockchain/database/CompactHeaders.hpp"  // IWYU pragma: associated
+
+#ifndef _WIN32
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
+#include <boost/endian/buffers.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/block/Block.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/blockchain/Work.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD "opentxs::blockchain::database::CompactHeaders::"
+
+namespace be = boost::endian;
+namespace fs = boost::filesystem;
+
+namespace opentxs::blockchain::database
+{
+constexpr auto compact_headers_magic_ =
+    std::array<char, 8>{'o', 't', 'h', 'e', 'a', 'd', 'e', 'r'};
+constexpr auto compact_headers_version_ = std::uint32_t{1};
+
+struct CompactHeaders::FileHeader {
+    std::array<char, 8> magic_;
+    be::little_uint32_buf_t version_;
+    be::little_uint32_buf_t record_size_;
+    be::little_uint64_buf_t sequence_;
+    be::little_uint64_buf_t count_;
+};
+
+struct CompactHeaders::Record {
+    Key hash_;
+    std::array<char, 80> header_;
+    be::little_int64_buf_t height_;
+    be::little_uint32_buf_t status_;
+    be::little_uint32_buf_t inherit_status_;
+    // Cumulative work of the parent block, big endian
+    std::array<std::uint8_t, 32> parent_work_;
+};
+
+CompactHeaders::CompactHeaders(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const std::string& folder) noexcept(false)
+    : api_(api)
+    , chain_(chain)
+    , path_((fs::path{folder} / "headers.dat").string())
+    , lock_()
+    , file_()
+    , index_()
+{
+    static_assert(32 == sizeof(FileHeader));
+    static_assert(1 == alignof(FileHeader));
+    static_assert(160 == sizeof(Record));
+    static_assert(1 == alignof(Record));
+    static_assert(std::is_trivially_copyable_v<Record>);
+
+    if (fs::exists(path_)) {
+        try {
+            map(fs::file_size(path_));
+            load_index();
+
+            return;
+        } catch (const std::exception& e) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Discarding ")(path_)(": ")(
+                e.what())
+                .Flush();
+            index_.clear();
+            file_.close();
+            fs::remove(path_);
+        }
+    }
+
+    create();
+}
+
+auto CompactHeaders::Begin() noexcept -> void
+{
+    auto lock = eLock{lock_};
+
+    if (false == file_.is_open()) { return; }
+
+    file_header().sequence_ = 0;
+
+    if (false == flush(sizeof(FileHeader))) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to flush ")(path_)
+            .Flush();
+    }
+}
+
+auto CompactHeaders::capacity() const noexcept -> std::size_t
+{
+    return (file_.size() - sizeof(FileHeader)) / sizeof(Record);
+}
+
+auto CompactHeaders::Commit(const std::size_t sequence) noexcept -> void
+{
+    auto lock = eLock{lock_};
+
+    if (false == file_.is_open()) { return; }
+
+    // The records must reach the disk before the sequence which declares
+    // them valid, otherwise a crash could leave a matching sequence in
+    // front of stale records
+    if (false == flush(file_.size())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to flush ")(path_)
+            .Flush();
+
+        return;
+    }
+
+    file_header().sequence_ = sequence;
+
+    if (false == flush(sizeof(FileHeader))) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to flush ")(path_)
+            .Flush();
+    }
+}
+
+auto CompactHeaders::Count() const noexcept -> std::size_t
+{
+    auto lock = sLock{lock_};
+
+    return index_.size();
+}
+
+auto CompactHeaders::create() noexcept(false) -> void
+{
+    auto params = boost::iostreams::mapped_file_params{path_};
+    params.flags = boost::iostreams::mapped_file::readwrite;
+    params.new_file_size =
+        sizeof(FileHeader) + (initial_capacity_ * sizeof(Record));
+    file_.open(params);
+
+    if (false == file_.is_open()) {
+        throw std::runtime_error("Failed to create header index file");
+    }
+
+    auto& header = file_header();
+    header.magic_ = compact_headers_magic_;
+    header.version_ = compact_headers_version_;
+    header.record_size_ = sizeof(Record);
+    header.sequence_ = 0;
+    header.count_ = 0;
+}
+
+auto CompactHeaders::Exists(const block::Hash& hash) const noexcept -> bool
+{
+    auto lock = sLock{lock_};
+
+    try {
+
+        return 0 < index_.count(key(hash));
+    } catch (...) {
+
+        return false;
+    }
+}
+
+auto CompactHeaders::file_header() const noexcept -> const FileHeader&
+{
+    return *reinterpret_cast<const FileHeader*>(file_.const_data());
+}
+
+auto CompactHeaders::file_header() noexcept -> FileHeader&
+{
+    return *reinterpret_cast<FileHeader*>(file_.data());
+}
+
+auto CompactHeaders::flush(const std::size_t bytes) noexcept -> bool
+{
+#ifdef _WIN32
+    return 0 != ::FlushViewOfFile(file_.const_data(), bytes);
+#else
+    return 0 == ::msync(file_.data(), bytes, MS_SYNC);
+#endif
+}
+
+auto CompactHeaders::grow(const std::size_t records) noexcept(false) -> void
+{
+    const auto required = file_header().count_.value() + records;
+    const auto current = capacity();
+
+    if (required <= current) { return; }
+
+    const auto target = std::max<std::size_t>(required, 2u * current);
+    const auto size = sizeof(FileHeader) + (target * sizeof(Record));
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Expanding ")(path_)(" to ")(
+        target)(" records")
+        .Flush();
+    file_.close();
+
+    try {
+        fs::resize_file(path_, size);
+        map(size);
+    } catch (...) {
+        // If the file can not be mapped again every later call is a no-op
+        map(fs::file_size(path_));
+
+        throw;
+    }
+}
+
+auto CompactHeaders::key(const block::Hash& hash) noexcept(false) -> Key
+{
+    auto output = Key{};
+
+    if (output.size() != hash.size()) {
+        throw std::invalid_argument("Invalid hash size");
+    }
+
+    std::memcpy(output.data(), hash.data(), output.size());
+
+    return output;
+}
+
+auto CompactHeaders::KeyHash::operator()(const Key& key) const noexcept
+    -> std::size_t
+{
+    // Block hashes are proof of work outputs so any part of them is already
+    // uniformly distributed
+    auto output = std::size_t{};
+    std::memcpy(&output, key.data(), sizeof(output));
+
+    return output;
+}
+
+auto CompactHeaders::Load(const block::Hash& hash) const noexcept
+    -> std::unique_ptr<block::bitcoin::Header>
+{
+    auto copy = Record{};
+
+    {
+        auto lock = sLock{lock_};
+
+        try {
+            const auto it = index_.find(key(hash));
+
+            if (index_.end() == it) { return {}; }
+
+            copy = record(it->second);
+        } catch (...) {
+
+            return {};
+        }
+    }
+
+    using Status = block::Header::Status;
+    const auto work = [&] {
+        const auto bytes = api_.Factory().Data(ReadView{
+            reinterpret_cast<const char*>(copy.parent_work_.data()),
+            copy.parent_work_.size()});
+
+        return OTWork{factory::Work(bytes->asHex())};
+    }();
+
+    return factory::BitcoinBlockHeader(
+        api_,
+        chain_,
+        ReadView{copy.header_.data(), copy.header_.size()},
+        hash,
+        copy.height_.value(),
+        static_cast<Status>(copy.status_.value()),
+        static_cast<Status>(copy.inherit_status_.value()),
+        work);
+}
+
+auto CompactHeaders::load_index() noexcept(false) -> void
+{
+    if (sizeof(FileHeader) > file_.size()) {
+        throw std::runtime_error("File too small");
+    }
+
+    const auto& header = file_header();
+
+    if ((compact_headers_magic_ != header.magic_) ||
+        (compact_headers_version_ != header.version_.value()) ||
+        (sizeof(Record) != header.record_size_.value())) {
+        throw std::runtime_error("Unsupported file format");
+    }
+
+    const auto count = static_cast<std::size_t>(header.count_.value());
+
+    if (count > capacity()) { throw std::runtime_error("Invalid count"); }
+
+    index_.reserve(count);
+
+    for (auto slot = std::size_t{0}; slot < count; ++slot) {
+        index_.emplace(record(slot).hash_, slot);
+    }
+
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Loaded ")(count)(
+        " headers from ")(path_)
+        .Flush();
+}
+
+auto CompactHeaders::map(const std::size_t size) noexcept(false) -> void
+{
+    auto params = boost::iostreams::mapped_file_params{path_};
+    params.flags = boost::iostreams::mapped_file::readwrite;
+    params.new_file_size = 0;
+    file_.open(params);
+
+    if ((false == file_.is_open()) || (size != file_.size())) {
+        throw std::runtime_error("Failed to map header index file");
+    }
+}
+
+auto CompactHeaders::record(const std::size_t slot) const noexcept
+    -> const Record&
+{
+    return *reinterpret_cast<const Record*>(
+        file_.const_data() + sizeof(FileHeader) + (slot * sizeof(Record)));
+}
+
+auto CompactHeaders::record(const std::size_t slot) noexcept -> Record&
+{
+    return *reinterpret_cast<Record*>(
+        file_.data() + sizeof(FileHeader) + (slot * sizeof(Record)));
+}
+
+auto CompactHeaders::Reset() noexcept -> void
+{
+    auto lock = eLock{lock_};
+    index_.clear();
+
+    if (false == file_.is_open()) { return; }
+
+    auto& header = file_header();
+    header.sequence_ = 0;
+    header.count_ = 0;
+    flush(sizeof(FileHeader));
+}
+
+auto CompactHeaders::Sequence() const noexcept -> std::size_t
+{
+    auto lock = sLock{lock_};
+
+    if (false == file_.is_open()) { return 0; }
+
+    return static_cast<std::size_t>(file_header().sequence_.value());
+}
+
+auto CompactHeaders::Store(
+    const std::vector<const block::Header*>& headers) noexcept -> bool
+{
+    auto lock = eLock{lock_};
+
+    if (false == file_.is_open()) { return false; }
+
+    try {
+        auto added = std::size_t{0};
+
+        for (const auto* header : headers) {
+            OT_ASSERT(nullptr != header);
+
+            if (0 == index_.count(key(header->Hash()))) { ++added; }
+        }
+
+        grow(added);
+
+        for (const auto* header : headers) {
+            const auto id = key(header->Hash());
+
+            if (auto it = index_.find(id); index_.end() != it) {
+                write(*header, record(it->second));
+            } else {
+                auto& count = file_header().count_;
+                const auto slot = static_cast<std::size_t>(count.value());
+                write(*header, record(slot));
+                index_.emplace(id, slot);
+                count = slot + 1u;
+            }
+        }
+
+        return true;
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        if (false == file_.is_open()) { index_.clear(); }
+
+        return false;
+    }
+}
+
+auto CompactHeaders::Supported(const blockchain::Type chain) noexcept -> bool
+{
+    switch (chain) {
+        case blockchain::Type::PKT:
+        case blockchain::Type::PKT_testnet: {
+
+            return false;
+        }
+        default: {
+
+            return true;
+        }
+    }
+}
+
+auto CompactHeaders::write(const block::Header& header, Record& out) noexcept(
+    false) -> void
+{
+    auto raw = Space{};
+
+    if ((false == header.Serialize(writer(raw))) ||
+        (out.header_.size() != raw.size())) {
+        throw std::runtime_error("Unsupported header format");
+    }
+
+    const auto work = api_.Factory().Data(
+        header.ParentWork()->asHex(), StringStyle::Hex);
+
+    if (out.parent_work_.size() < work->size()) {
+        throw std::runtime_error("Work out of range");
+    }
+
+    out.hash_ = key(header.Hash());
+    std::memcpy(out.header_.data(), raw.data(), raw.size());
+    out.height_ = header.Height();
+    out.status_ = static_cast<std::uint32_t>(header.LocalState());
+    out.inherit_status_ = static_cast<std::uint32_t>(header.InheritedState());
+    out.parent_work_.fill(0);
+    std::memcpy(
+        out.parent_work_.data() + (out.parent_work_.size() - work->size()),
+        work->data(),
+        work->size());
+}
+
+CompactHeaders::~CompactHeaders() = default;
+}  // namespace opentxs::blockchain::database
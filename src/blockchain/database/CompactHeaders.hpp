@@ -0,0 +1,123 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+class Core;
+}  // namespace api
+
+namespace blockchain
+{
+namespace block
+{
+namespace bitcoin
+{
+class Header;
+}  // namespace bitcoin
+
+class Header;
+}  // namespace block
+}  // namespace blockchain
+}  // namespace opentxs
+
+namespace opentxs::blockchain::database
+{
+// Fixed width copies of every stored header, kept in a memory mapped file
+// and indexed by hash in memory so headers can be loaded without parsing
+// protobufs.
+//
+// The file is a cache of the header tables in LMDB. Its sequence number is
+// cleared before every update and set again afterwards, and the owner must
+// discard the file whenever the sequence does not match the one committed
+// to the database. Commit writes the records to disk before the sequence.
+class CompactHeaders
+{
+public:
+    struct FileHeader;
+    struct Record;
+
+    // Chains with headers which are not 80 bytes long can not be stored
+    static auto Supported(const blockchain::Type chain) noexcept -> bool;
+
+    auto Count() const noexcept -> std::size_t;
+    auto Exists(const block::Hash& hash) const noexcept -> bool;
+    // Returns null pointer if the header is not indexed
+    auto Load(const block::Hash& hash) const noexcept
+        -> std::unique_ptr<block::bitcoin::Header>;
+    auto Sequence() const noexcept -> std::size_t;
+
+    auto Begin() noexcept -> void;
+    auto Commit(const std::size_t sequence) noexcept -> void;
+    auto Reset() noexcept -> void;
+    // Adds new headers and replaces existing ones. If this returns false
+    // some records may not have been written and the caller must Reset.
+    auto Store(const std::vector<const block::Header*>& headers) noexcept
+        -> bool;
+
+    CompactHeaders(
+        const api::Core& api,
+        const blockchain::Type chain,
+        const std::string& folder) noexcept(false);
+
+    ~CompactHeaders();
+
+private:
+    using Key = std::array<std::uint8_t, 32>;
+
+    struct KeyHash {
+        auto operator()(const Key& key) const noexcept -> std::size_t;
+    };
+
+    static constexpr auto initial_capacity_ = std::size_t{65536};
+
+    const api::Core& api_;
+    const blockchain::Type chain_;
+    const std::string path_;
+    mutable std::shared_mutex lock_;
+    boost::iostreams::mapped_file file_;
+    std::unordered_map<Key, std::size_t, KeyHash> index_;
+
+    static auto key(const block::Hash& hash) noexcept(false) -> Key;
+
+    auto capacity() const noexcept -> std::size_t;
+    auto file_header() const noexcept -> const FileHeader&;
+    auto record(const std::size_t slot) const noexcept -> const Record&;
+
+    auto create() noexcept(false) -> void;
+    auto file_header() noexcept -> FileHeader&;
+    // Writes the first bytes of the mapped file to disk
+    auto flush(const std::size_t bytes) noexcept -> bool;
+    auto grow(const std::size_t records) noexcept(false) -> void;
+    auto load_index() noexcept(false) -> void;
+    auto map(const std::size_t size) noexcept(false) -> void;
+    auto record(const std::size_t slot) noexcept -> Record&;
+    auto write(const block::Header& header, Record& out) noexcept(false)
+        -> void;
+
+    CompactHeaders() = delete;
+    CompactHeaders(const CompactHeaders&) = delete;
+    CompactHeaders(CompactHeaders&&) = delete;
+    auto operator=(const CompactHeaders&) -> CompactHeaders& = delete;
+    auto operator=(CompactHeaders&&) -> CompactHeaders& = delete;
+};
+}  // namespace opentxs::blockchain::database
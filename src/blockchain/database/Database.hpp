@@ -10,6 +10,7 @@
 
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <map>
@@ -154,10 +155,11 @@ public:
     {
         return wallet_.AddProposal(id, tx);
     }
-    auto ApplyUpdate(const client::UpdateTransaction& update) const noexcept
-        -> bool final
+    auto ApplyUpdate(
+        const client::UpdateTransaction& update,
+        const SimpleCallback& committed) const noexcept -> bool final
     {
-        return headers_.ApplyUpdate(update);
+        return headers_.ApplyUpdate(update, committed);
     }
     // Throws std::out_of_range if no block at that position
     auto BestBlock(const block::Height position) const noexcept(false)
@@ -275,6 +277,13 @@ public:
     {
         return wallet_.GetUnspentOutputs();
     }
+    auto GetScanTargets(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last) const noexcept -> ScanTargets final
+    {
+        return wallet_.GetScanTargets(index, first, last);
+    }
     auto GetUnspentOutputs(const NodeID& balanceNode, const Subchain subchain)
         const noexcept -> std::vector<UTXO> final
     {
@@ -326,6 +335,13 @@ public:
     {
         return filters_.LoadFilterHash(type, block);
     }
+    auto LoadFilters(
+        const filter::Type type,
+        const std::vector<ReadView>& blocks,
+        const FilterCallback& cb) const noexcept -> std::size_t final
+    {
+        return filters_.LoadFilters(type, blocks, cb);
+    }
     auto LoadFilterHeader(const filter::Type type, const ReadView block)
         const noexcept -> Hash final
     {
@@ -464,6 +480,14 @@ public:
     {
         return wallet_.SubchainSetLastScanned(index, position);
     }
+    auto SubchainSetTested(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last,
+        const VersionNumber version) const noexcept -> bool final
+    {
+        return wallet_.SubchainSetTested(index, first, last, version);
+    }
     auto SyncTip() const noexcept -> block::Position final
     {
         return sync_.Tip();
@@ -7,6 +7,7 @@
 
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <map>
@@ -70,6 +71,7 @@ public:
     using Hash = Parent::Hash;
     using Header = Parent::Header;
     using Filter = Parent::Filter;
+    using FilterCallback = Parent::FilterCallback;
 
     auto CurrentHeaderTip(const filter::Type type) const noexcept
         -> block::Position;
@@ -91,6 +93,13 @@ public:
     }
     auto LoadFilterHash(const filter::Type type, const ReadView block)
         const noexcept -> Hash;
+    auto LoadFilters(
+        const filter::Type type,
+        const std::vector<ReadView>& blocks,
+        const FilterCallback& cb) const noexcept -> std::size_t
+    {
+        return common_.LoadFilters(type, blocks, cb);
+    }
     auto LoadFilterHeader(const filter::Type type, const ReadView block)
         const noexcept -> Hash;
     auto SetHeaderTip(const filter::Type type, const block::Position& position)
@@ -62,8 +62,11 @@ Headers::Headers(
     , common_(common)
     , lmdb_(lmdb)
     , lock_()
+    , compact_(init_compact(type))
+    , compact_sequence_(0)
 {
     import_genesis(type);
+    load_compact();
 
     {
         const auto best = this->best();
@@ -80,8 +83,9 @@ Headers::Headers(
     }
 }
 
-auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
-    -> bool
+auto Headers::ApplyUpdate(
+    const client::UpdateTransaction& update,
+    const SimpleCallback& committed) noexcept -> bool
 {
     if (false == common_.StoreBlockHeaders(update.UpdatedHeaders())) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to save block headers")
@@ -207,6 +211,29 @@ auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
         push_best(position, false, parentTxn);
     }
 
+    const auto sequence = compact_sequence_ + 1u;
+
+    if (compact_) {
+        // Until the compact index has been updated it must not be trusted
+        // after a restart
+        compact_->Begin();
+
+        if (false == lmdb_
+                         .Store(
+                             ChainData,
+                             tsv(static_cast<std::size_t>(
+                                 Key::CompactHeaderSequence)),
+                             tsv(sequence),
+                             parentTxn)
+                         .first) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to store compact header sequence")
+                .Flush();
+
+            return false;
+        }
+    }
+
     if (0 < update.BestChain().size()) {
         const auto& tip = *update.BestChain().crbegin();
 
@@ -224,7 +251,14 @@ auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
         }
     }
 
-    parentTxn.Finalize(true);
+    if (parentTxn.Finalize(true)) {
+        update_compact(update, sequence);
+    } else if (compact_) {
+        compact_->Reset();
+    }
+
+    if (committed) { committed(); }
+
     const auto position = best(lock);
 
     if (update.HaveReorg()) {
@@ -385,6 +419,8 @@ auto Headers::HaveCheckpoint() const noexcept -> bool
 auto Headers::header_exists(const Lock& lock, const block::Hash& hash)
     const noexcept -> bool
 {
+    if (compact_ && compact_->Exists(hash)) { return true; }
+
     return common_.BlockHeaderExists(hash) &&
            lmdb_.Exists(BlockHeaderMetadata, hash.Bytes());
 }
@@ -465,22 +501,33 @@ auto Headers::IsSibling(const block::Hash& hash) const noexcept -> bool
     return lmdb_.Exists(BlockHeaderSiblings, hash.Bytes());
 }
 
+auto Headers::init_compact(const blockchain::Type type) noexcept
+    -> std::unique_ptr<CompactHeaders>
+{
+    if (false == CompactHeaders::Supported(type)) { return {}; }
+
+    try {
+        return std::make_unique<CompactHeaders>(
+            api_,
+            type,
+            common_.AllocateStorageFolder(
+                std::to_string(static_cast<std::uint32_t>(type))));
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+
 auto Headers::load_bitcoin_header(const block::Hash& hash) const
     -> std::unique_ptr<block::bitcoin::Header>
 {
-    auto proto = common_.LoadBlockHeader(hash);
-    const auto haveMeta =
-        lmdb_.Load(BlockHeaderMetadata, hash.Bytes(), [&](const auto data) {
-            *proto.mutable_local() =
-                proto::Factory<proto::BlockchainBlockLocalData>(
-                    data.data(), data.size());
-        });
-
-    if (false == haveMeta) {
-        throw std::out_of_range("Block header metadata not found");
+    if (compact_) {
+        if (auto output = compact_->Load(hash); output) { return output; }
     }
 
-    auto output = factory::BitcoinBlockHeader(api_, proto);
+    auto output =
+        factory::BitcoinBlockHeader(api_, load_serialized_header(hash));
 
     if (false == bool(output)) {
         throw std::out_of_range("Wrong header format");
@@ -489,13 +536,110 @@ auto Headers::load_bitcoin_header(const block::Hash& hash) const
     return std::move(output);
 }
 
+auto Headers::load_compact() noexcept -> void
+{
+    if (false == bool(compact_)) { return; }
+
+    const auto stored = load_compact_sequence();
+
+    if ((0 < stored) && (compact_->Sequence() == stored)) {
+        compact_sequence_ = stored;
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Loaded ")(compact_->Count())(
+            " headers from compact index")
+            .Flush();
+
+        return;
+    }
+
+    LogNormal("Rebuilding compact block header index").Flush();
+    compact_->Reset();
+    constexpr auto batch = std::size_t{1000};
+    auto headers = std::vector<std::unique_ptr<block::Header>>{};
+    auto success{true};
+    auto flush = [&] {
+        auto pointers = std::vector<const block::Header*>{};
+        std::transform(
+            headers.begin(),
+            headers.end(),
+            std::back_inserter(pointers),
+            [](const auto& header) { return header.get(); });
+        success = success && compact_->Store(pointers);
+        headers.clear();
+    };
+    lmdb_.Read(
+        BlockHeaderMetadata,
+        [&](const auto key, const auto) -> bool {
+            try {
+                const auto hash = api_.Factory().Data(key);
+                headers.emplace_back(
+                    api_.Factory().BlockHeader(load_serialized_header(hash)));
+            } catch (...) {
+                success = false;
+            }
+
+            if (batch <= headers.size()) { flush(); }
+
+            return success;
+        },
+        opentxs::storage::lmdb::LMDB::Dir::Forward);
+    flush();
+    const auto next = stored + 1u;
+    success = success &&
+              lmdb_
+                  .Store(
+                      ChainData,
+                      tsv(static_cast<std::size_t>(Key::CompactHeaderSequence)),
+                      tsv(next))
+                  .first;
+
+    if (false == success) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to rebuild compact header index")
+            .Flush();
+        compact_->Reset();
+
+        return;
+    }
+
+    compact_->Commit(next);
+    compact_sequence_ = next;
+}
+
+auto Headers::load_compact_sequence() const noexcept -> std::size_t
+{
+    auto output = std::size_t{0};
+    lmdb_.Load(
+        ChainData,
+        tsv(static_cast<std::size_t>(Key::CompactHeaderSequence)),
+        [&](const auto in) -> void {
+            std::memcpy(
+                &output, in.data(), std::min(in.size(), sizeof(output)));
+        });
+
+    return output;
+}
+
 auto Headers::load_header(const block::Hash& hash) const
     -> std::unique_ptr<block::Header>
 {
-    auto proto = common_.LoadBlockHeader(hash);
+    if (compact_) {
+        if (auto output = compact_->Load(hash); output) { return output; }
+    }
+
+    auto output = api_.Factory().BlockHeader(load_serialized_header(hash));
+
+    OT_ASSERT(output);
+
+    return output;
+}
+
+auto Headers::load_serialized_header(const block::Hash& hash) const
+    -> proto::BlockchainBlockHeader
+{
+    auto output = common_.LoadBlockHeader(hash);
     const auto haveMeta =
         lmdb_.Load(BlockHeaderMetadata, hash.Bytes(), [&](const auto data) {
-            *proto.mutable_local() =
+            *output.mutable_local() =
                 proto::Factory<proto::BlockchainBlockLocalData>(
                     data.data(), data.size());
         });
@@ -504,10 +648,6 @@ auto Headers::load_header(const block::Hash& hash) const
         throw std::out_of_range("Block header metadata not found");
     }
 
-    auto output = api_.Factory().BlockHeader(proto);
-
-    OT_ASSERT(output);
-
     return output;
 }
 
@@ -599,4 +739,26 @@ auto Headers::TryLoadHeader(const block::Hash& hash) const noexcept
         return {};
     }
 }
+
+auto Headers::update_compact(
+    const client::UpdateTransaction& update,
+    const std::size_t sequence) noexcept -> void
+{
+    compact_sequence_ = sequence;
+
+    if (false == bool(compact_)) { return; }
+
+    auto headers = std::vector<const block::Header*>{};
+
+    for (const auto& [hash, pair] : update.UpdatedHeaders()) {
+        headers.emplace_back(pair.first.get());
+    }
+
+    if (compact_->Store(headers)) {
+        compact_->Commit(sequence);
+    } else {
+        // Records which were not rewritten may be out of date
+        compact_->Reset();
+    }
+}
 }  // namespace opentxs::blockchain::database
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "api/client/blockchain/database/Database.hpp"
+#include "blockchain/database/CompactHeaders.hpp"
 #include "internal/api/client/blockchain/Blockchain.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Client.hpp"
@@ -60,6 +61,11 @@ namespace client
 class UpdateTransaction;
 }  // namespace client
 }  // namespace blockchain
+
+namespace proto
+{
+class BlockchainBlockHeader;
+}  // namespace proto
 }  // namespace opentxs
 
 namespace opentxs::blockchain::database
@@ -97,7 +103,9 @@ public:
     auto TryLoadHeader(const block::Hash& hash) const noexcept
         -> std::unique_ptr<block::Header>;
 
-    auto ApplyUpdate(const client::UpdateTransaction& update) noexcept -> bool;
+    auto ApplyUpdate(
+        const client::UpdateTransaction& update,
+        const SimpleCallback& committed) noexcept -> bool;
 
     Headers(
         const api::Core& api,
@@ -112,6 +120,9 @@ private:
     const Common& common_;
     const opentxs::storage::lmdb::LMDB& lmdb_;
     mutable std::mutex lock_;
+    // Null if the chain is not supported or the index can not be opened
+    std::unique_ptr<CompactHeaders> compact_;
+    std::size_t compact_sequence_;
 
     auto best() const noexcept -> block::Position;
     auto best(const Lock& lock) const noexcept -> block::Position;
@@ -124,6 +135,9 @@ private:
     // Throws std::out_of_range if the header does not exist
     auto load_header(const block::Hash& hash) const noexcept(false)
         -> std::unique_ptr<block::Header>;
+    // Throws std::out_of_range if the header does not exist
+    auto load_serialized_header(const block::Hash& hash) const noexcept(false)
+        -> proto::BlockchainBlockHeader;
     auto pop_best(const std::size_t i, MDB_txn* parent) const noexcept -> bool;
     auto push_best(
         const block::Position next,
@@ -131,5 +145,13 @@ private:
         MDB_txn* parent) const noexcept -> bool;
     auto recent_hashes(const Lock& lock) const noexcept
         -> std::vector<block::pHash>;
+
+    auto init_compact(const blockchain::Type type) noexcept
+        -> std::unique_ptr<CompactHeaders>;
+    auto load_compact() noexcept -> void;
+    auto load_compact_sequence() const noexcept -> std::size_t;
+    auto update_compact(
+        const client::UpdateTransaction& update,
+        const std::size_t sequence) noexcept -> void;
 };
 }  // namespace opentxs::blockchain::database
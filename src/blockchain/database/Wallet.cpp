@@ -130,6 +130,14 @@ auto Wallet::GetPatterns(const SubchainIndex& index) const noexcept -> Patterns
     return subchains_.GetPatterns(index);
 }
 
+auto Wallet::GetScanTargets(
+    const SubchainIndex& index,
+    const block::Height first,
+    const block::Height last) const noexcept -> ScanTargets
+{
+    return subchains_.GetScanTargets(index, first, last);
+}
+
 auto Wallet::GetUnspentOutputs() const noexcept -> std::vector<UTXO>
 {
     return outputs_.GetUnspentOutputs();
@@ -251,6 +259,15 @@ auto Wallet::SubchainSetLastScanned(
     return subchains_.SubchainSetLastScanned(index, position);
 }
 
+auto Wallet::SubchainSetTested(
+    const SubchainIndex& index,
+    const block::Height first,
+    const block::Height last,
+    const VersionNumber version) const noexcept -> bool
+{
+    return subchains_.SubchainSetTested(index, first, last, version);
+}
+
 auto Wallet::TransactionLoadBitcoin(const ReadView txid) const noexcept
     -> std::unique_ptr<block::bitcoin::Transaction>
 {
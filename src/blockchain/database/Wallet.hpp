@@ -105,6 +105,7 @@ public:
     using Pattern = Parent::Pattern;
     using Patterns = Parent::Patterns;
     using MatchingIndices = Parent::MatchingIndices;
+    using ScanTargets = Parent::ScanTargets;
     using UTXO = Parent::UTXO;
     using Spend = Parent::Spend;
     using State = client::Wallet::TxoState;
@@ -143,6 +144,10 @@ public:
         const Identifier& node,
         State type) const noexcept -> std::vector<UTXO>;
     auto GetPatterns(const SubchainIndex& index) const noexcept -> Patterns;
+    auto GetScanTargets(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last) const noexcept -> ScanTargets;
     auto GetUnspentOutputs() const noexcept -> std::vector<UTXO>;
     auto GetUnspentOutputs(const NodeID& balanceNode, const Subchain subchain)
         const noexcept -> std::vector<UTXO>;
@@ -181,6 +186,11 @@ public:
     auto SubchainSetLastScanned(
         const SubchainIndex& index,
         const block::Position& position) const noexcept -> bool;
+    auto SubchainSetTested(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last,
+        const VersionNumber version) const noexcept -> bool;
     auto TransactionLoadBitcoin(const ReadView txid) const noexcept
         -> std::unique_ptr<block::bitcoin::Transaction>;
 
@@ -57,6 +57,34 @@ struct SubchainData::Imp {
             return {};
         }
     }
+    auto GetScanTargets(
+        const SubchainIndex& subchain,
+        const block::Height first,
+        const block::Height last) const noexcept -> ScanTargets
+    {
+        auto lock = Lock{lock_};
+        auto output = ScanTargets{};
+        auto& [current, ranges] = output;
+        current = pattern_version(lock, subchain);
+        auto cache = std::map<VersionNumber, Patterns>{};
+
+        for (const auto& [start, stop, version] :
+             tested_versions(lock, subchain, first, last)) {
+            auto it = cache.find(version);
+
+            if (cache.end() == it) {
+                it = cache
+                         .emplace(
+                             version,
+                             untested_patterns(lock, subchain, version))
+                         .first;
+            }
+
+            ranges.emplace_back(start, stop, it->second);
+        }
+
+        return output;
+    }
     auto GetUntestedPatterns(
         const SubchainIndex& subchain,
         const ReadView blockID) const noexcept -> Patterns
@@ -92,6 +120,16 @@ struct SubchainData::Imp {
         const SubchainIndex& subchain,
         const block::Height lastGoodHeight) const noexcept(false) -> bool
     {
+        if (auto it = tested_index_.find(subchain); tested_index_.end() != it) {
+            auto& map = it->second;
+            map.erase(map.upper_bound(lastGoodHeight), map.end());
+
+            if (false == map.empty()) {
+                auto& end = map.rbegin()->second.first;
+                end = std::min(end, lastGoodHeight);
+            }
+        }
+
         try {
             auto& scanned = last_scanned_.at(subchain);
 
@@ -137,6 +175,11 @@ struct SubchainData::Imp {
         }
 
         last_indexed_[subchain] = highest;
+
+        if (false == newIndices.empty()) {
+            pattern_versions_[subchain].emplace_back(newIndices);
+        }
+
         auto& index = subchain_pattern_index_[subchain];
 
         for (auto& id : newIndices) { index.emplace(std::move(id)); }
@@ -197,6 +240,64 @@ struct SubchainData::Imp {
             return true;
         }
     }
+    auto SubchainSetTested(
+        const SubchainIndex& subchain,
+        const block::Height first,
+        const block::Height last,
+        const VersionNumber version) const noexcept -> bool
+    {
+        if (first > last) { return false; }
+
+        auto lock = Lock{lock_};
+        auto& map = tested_index_[subchain];
+        auto it = map.lower_bound(first);
+
+        if (map.begin() != it) {
+            auto& [end, previous] = std::prev(it)->second;
+
+            if (end >= first) {
+                if (end > last) {
+                    map.emplace(last + 1, Tested{end, previous});
+                }
+
+                end = first - 1;
+            }
+        }
+
+        it = map.lower_bound(first);
+
+        while ((map.end() != it) && (it->first <= last)) {
+            const auto [end, previous] = it->second;
+            it = map.erase(it);
+
+            if (end > last) {
+                map.emplace(last + 1, Tested{end, previous});
+
+                break;
+            }
+        }
+
+        it = map.emplace(first, Tested{last, version}).first;
+
+        if (auto next = std::next(it); (map.end() != next) &&
+                                       (next->first == last + 1) &&
+                                       (next->second.second == version)) {
+            it->second.first = next->second.first;
+            map.erase(next);
+        }
+
+        if (map.begin() != it) {
+            auto prev = std::prev(it);
+
+            if ((prev->second.first == first - 1) &&
+                (prev->second.second == version)) {
+                prev->second.first = it->second.first;
+                map.erase(it);
+            }
+        }
+
+        return true;
+    }
     auto Type() const noexcept -> FilterType
     {
         auto lock = Lock{lock_};
@@ -216,6 +317,8 @@ struct SubchainData::Imp {
         , subchain_pattern_index_()
         , match_index_()
         , reverse_index_()
+        , pattern_versions_()
+        , tested_index_()
     {
         // TODO persist default_filter_type_ and reindex various tables
         // if the type provided by the filter oracle has changed
@@ -236,6 +339,17 @@ private:
     using MatchIndex = std::map<block::pHash, IDSet>;
     using ReverseIndex =
         std::map<pSubchainIndex, std::tuple<pNodeID, Subchain, FilterType>>;
+    // Pattern IDs added by each call to SubchainAddElements. The version of
+    // the pattern set is the number of elements.
+    using PatternVersions =
+        std::map<pSubchainIndex, std::vector<std::vector<pPatternID>>>;
+    // Last height and pattern set version, keyed by first height, of
+    // non-overlapping ranges of blocks which have been scanned
+    using Tested = std::pair<block::Height, VersionNumber>;
+    using TestedRanges = std::map<block::Height, Tested>;
+    using TestedIndex = std::map<pSubchainIndex, TestedRanges>;
+    using VersionRanges =
+        std::vector<std::tuple<block::Height, block::Height, VersionNumber>>;
 
     const api::Core& api_;
     const FilterType default_filter_type_;
@@ -248,6 +362,8 @@ private:
     mutable SubchainPatternIndex subchain_pattern_index_;
     mutable MatchIndex match_index_;
     mutable ReverseIndex reverse_index_;
+    mutable PatternVersions pattern_versions_;
+    mutable TestedIndex tested_index_;
 
     auto check_subchain_version(
         const Lock& lock,
@@ -284,6 +400,18 @@ private:
 
         return output;
     }
+    auto pattern_version(const Lock& lock, const SubchainIndex& subchain)
+        const noexcept -> VersionNumber
+    {
+        try {
+
+            return static_cast<VersionNumber>(
+                pattern_versions_.at(subchain).size());
+        } catch (...) {
+
+            return 0;
+        }
+    }
     auto pattern_id(const SubchainIndex& subchain, const Bip32Index index)
         const noexcept -> pPatternID
     {
@@ -345,6 +473,86 @@ private:
             return 0;
         }
     }
+    // Divides [first, last] into consecutive ranges, each of which has been
+    // tested against a single pattern set version (0 if never tested)
+    auto tested_versions(
+        const Lock& lock,
+        const SubchainIndex& subchain,
+        const block::Height first,
+        const block::Height last) const noexcept -> VersionRanges
+    {
+        auto output = VersionRanges{};
+        const auto add = [&](const auto start, const auto stop, const auto v) {
+            if (false == output.empty()) {
+                auto& [prevStart, prevStop, prevVersion] = output.back();
+
+                if ((prevVersion == v) && (prevStop + 1 == start)) {
+                    prevStop = stop;
+
+                    return;
+                }
+            }
+
+            output.emplace_back(start, stop, v);
+        };
+        const auto index = tested_index_.find(subchain);
+
+        if (tested_index_.end() == index) {
+            if (first <= last) { add(first, last, VersionNumber{0}); }
+
+            return output;
+        }
+
+        const auto& map = index->second;
+        auto height{first};
+
+        while (height <= last) {
+            auto it = map.upper_bound(height);
+
+            if (map.begin() != it) {
+                const auto& [end, version] = std::prev(it)->second;
+
+                if (end >= height) {
+                    const auto stop = std::min(end, last);
+                    add(height, stop, version);
+                    height = stop + 1;
+
+                    continue;
+                }
+            }
+
+            const auto stop =
+                (map.end() == it) ? last : std::min(it->first - 1, last);
+            add(height, stop, VersionNumber{0});
+            height = stop + 1;
+        }
+
+        return output;
+    }
+    // Patterns added after the specified version of the pattern set
+    auto untested_patterns(
+        const Lock& lock,
+        const SubchainIndex& subchain,
+        const VersionNumber version) const noexcept -> Patterns
+    {
+        try {
+            const auto& versions = pattern_versions_.at(subchain);
+            auto ids = std::vector<pPatternID>{};
+
+            for (auto i = std::size_t{version}; i < versions.size(); ++i) {
+                const auto& added = versions.at(i);
+                std::copy(
+                    std::begin(added),
+                    std::end(added),
+                    std::back_inserter(ids));
+            }
+
+            return load_patterns(lock, subchain, ids);
+        } catch (...) {
+
+            return {};
+        }
+    }
     auto subchain_version_index(
         const NodeID& balanceNode,
         const Subchain subchain,
@@ -392,6 +600,14 @@ auto SubchainData::GetPatterns(const SubchainIndex& subchain) const noexcept
     return imp_->GetPatterns(subchain);
 }
 
+auto SubchainData::GetScanTargets(
+    const SubchainIndex& subchain,
+    const block::Height first,
+    const block::Height last) const noexcept -> ScanTargets
+{
+    return imp_->GetScanTargets(subchain, first, last);
+}
+
 auto SubchainData::GetUntestedPatterns(
     const SubchainIndex& subchain,
     const ReadView blockID) const noexcept -> Patterns
@@ -447,6 +663,15 @@ auto SubchainData::SubchainSetLastScanned(
     return imp_->SubchainSetLastScanned(subchain, position);
 }
 
+auto SubchainData::SubchainSetTested(
+    const SubchainIndex& subchain,
+    const block::Height first,
+    const block::Height last,
+    const VersionNumber version) const noexcept -> bool
+{
+    return imp_->SubchainSetTested(subchain, first, last, version);
+}
+
 auto SubchainData::Type() const noexcept -> FilterType { return imp_->Type(); }
 
 SubchainData::~SubchainData() = default;
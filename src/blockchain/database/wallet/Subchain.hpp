@@ -42,24 +42,29 @@ public:
     using Patterns = Parent::Patterns;
     using ElementMap = Parent::ElementMap;
     using MatchingIndices = Parent::MatchingIndices;
+    using ScanTargets = Parent::ScanTargets;
 
-    auto GetIndex(
+    OPENTXS_EXPORT auto GetIndex(
         const NodeID& balanceNode,
         const Subchain subchain,
         const FilterType type) const noexcept -> pSubchainIndex;
     auto GetSubchainID(const NodeID& balanceNode, const Subchain subchain)
         const noexcept -> pSubchainID;
-    auto GetMutex() const noexcept -> std::mutex&;
+    OPENTXS_EXPORT auto GetMutex() const noexcept -> std::mutex&;
     auto GetPatterns(const SubchainIndex& subchain) const noexcept -> Patterns;
+    OPENTXS_EXPORT auto GetScanTargets(
+        const SubchainIndex& subchain,
+        const block::Height first,
+        const block::Height last) const noexcept -> ScanTargets;
     auto GetUntestedPatterns(
         const SubchainIndex& subchain,
         const ReadView blockID) const noexcept -> Patterns;
-    auto Reorg(
+    OPENTXS_EXPORT auto Reorg(
         const Lock& lock,
         const SubchainIndex& subchain,
         const block::Height lastGoodHeight) const noexcept(false) -> bool;
     auto SetDefaultFilterType(const FilterType type) const noexcept -> bool;
-    auto SubchainAddElements(
+    OPENTXS_EXPORT auto SubchainAddElements(
         const SubchainIndex& subchain,
         const ElementMap& elements) const noexcept -> bool;
     auto SubchainLastIndexed(const SubchainIndex& subchain) const noexcept
@@ -73,11 +78,16 @@ public:
     auto SubchainSetLastScanned(
         const SubchainIndex& subchain,
         const block::Position& position) const noexcept -> bool;
+    OPENTXS_EXPORT auto SubchainSetTested(
+        const SubchainIndex& subchain,
+        const block::Height first,
+        const block::Height last,
+        const VersionNumber version) const noexcept -> bool;
     auto Type() const noexcept -> FilterType;
 
-    SubchainData(const api::Core& api) noexcept;
+    OPENTXS_EXPORT SubchainData(const api::Core& api) noexcept;
 
-    ~SubchainData();
+    OPENTXS_EXPORT ~SubchainData();
 
 private:
     struct Imp;
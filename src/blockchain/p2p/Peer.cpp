@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <string_view>
 
+#include "2_Factory.hpp"
 #include "blockchain/DownloadTask.hpp"
 #include "internal/api/client/Client.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -249,6 +250,19 @@ auto Peer::on_pipeline(
     pipeline_->Push(message);
 }
 
+auto Peer::on_pipeline(
+    const Task type,
+    const ReadView header,
+    zmq::Frame& body) noexcept -> void
+{
+    auto message = MakeWork(type);
+    message->AddFrame(header.data(), header.size());
+    message->AddFrame();
+    message->Replace(
+        message->size() - 1u, OTZMQFrame{opentxs::Factory::ZMQFrame(body)});
+    pipeline_->Push(message);
+}
+
 auto Peer::pipeline(zmq::Message& message) noexcept -> void
 {
     if (false == running_.get()) { return; }
@@ -168,6 +168,11 @@ public:
     auto on_pipeline(
         const Task type,
         const std::vector<ReadView>& frames) noexcept -> void;
+    // Forwards a message without copying its body, which is left empty
+    auto on_pipeline(
+        const Task type,
+        const ReadView header,
+        zmq::Frame& body) noexcept -> void;
     auto Shutdown() noexcept -> std::shared_future<void> final;
 
     ~Peer() override;
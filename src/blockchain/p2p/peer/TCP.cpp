@@ -8,6 +8,7 @@
 #include "blockchain/p2p/Peer.hpp"  // IWYU pragma: associated
 
 #include <boost/asio.hpp>
+#include <chrono>
 #include <cstddef>
 
 #include "opentxs/Pimpl.hpp"
@@ -47,6 +48,9 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
     OTData header_;
     OTZMQListenCallback cb_;
     OTZMQDealerSocket dealer_;
+    const std::chrono::steady_clock::time_point connected_;
+    std::size_t bytes_received_;
+    std::size_t messages_received_;
 
     auto address() const noexcept -> std::string final
     {
@@ -95,6 +99,18 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
 
         return std::future_status::ready == status;
     }
+    auto log_throughput() const noexcept -> void
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - connected_;
+        const auto seconds = std::chrono::duration<double>{elapsed}.count();
+        const auto rate = (0 < seconds) ? (bytes_received_ / seconds) : 0.0;
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Received ")(
+            messages_received_)(" messages, ")(bytes_received_)(
+            " bytes from ")(endpoint_.str())(" in ")(seconds)(" seconds, ")(
+            rate)(" bytes per second")
+            .Flush();
+    }
     auto pipeline(zmq::Message& message) noexcept -> void
     {
         if (false == running_) { return; }
@@ -147,12 +163,14 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
 
                 const auto& messageHeader = body.at(1);
                 const auto size = parent_.get_body_size(messageHeader);
+                bytes_received_ += messageHeader.size();
 
                 if (0 < size) {
                     header_->Assign(messageHeader.Bytes());
                     receive(static_cast<OTZMQWorkType>(Peer::Task::Body), size);
                     parent_.on_pipeline(Peer::Task::Header, {});
                 } else {
+                    ++messages_received_;
                     parent_.on_pipeline(
                         Peer::Task::ReceiveMessage,
                         {messageHeader.Bytes(), {}});
@@ -162,9 +180,13 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
             case Peer::Task::Body: {
                 OT_ASSERT(1 < body.size());
 
+                bytes_received_ += body.at(1).size();
+                ++messages_received_;
+                // The body is the last frame
                 parent_.on_pipeline(
                     Peer::Task::ReceiveMessage,
-                    {header_->Bytes(), body.at(1).Bytes()});
+                    header_->Bytes(),
+                    message.at(message.size() - 1u));
                 run();
             } break;
             default: {
@@ -238,6 +260,9 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
         , dealer_(api.ZeroMQ().DealerSocket(
               cb_,
               zmq::socket::Socket::Direction::Connect))
+        , connected_(std::chrono::steady_clock::now())
+        , bytes_received_(0)
+        , messages_received_(0)
     {
     }
 
@@ -245,6 +270,7 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
     {
         stop_internal();
         socket_.Close();
+        log_throughput();
     }
 };
 
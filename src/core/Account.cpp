@@ -281,6 +281,8 @@ auto Account::LoadInbox(const identity::Nym& nym) const
 
     OT_ASSERT(false != bool(box));
 
+    box->SetLazy(true);
+
     if (box->LoadInbox() && box->VerifyAccount(nym)) { return box; }
 
     auto strNymID = String::Factory(GetNymID()),
@@ -302,6 +304,8 @@ auto Account::LoadOutbox(const identity::Nym& nym) const
 
     OT_ASSERT(false != bool(box));
 
+    box->SetLazy(true);
+
     if (box->LoadOutbox() && box->VerifyAccount(nym)) { return box; }
 
     auto strNymID = String::Factory(GetNymID()),
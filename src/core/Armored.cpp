@@ -10,6 +10,7 @@
 #include <zconf.h>
 #include <zlib.h>
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
@@ -45,6 +46,24 @@ const char* OT_END_ARMORED_escaped = "- -----END OT ARMORED";
 const char* OT_BEGIN_SIGNED = "-----BEGIN SIGNED";
 const char* OT_BEGIN_SIGNED_escaped = "- -----BEGIN SIGNED";
 
+// Sent by clients to find out whether a notary accepts requests which are not
+// armored. Notaries which do echo it back. Older notaries can not decode it
+// and send an empty reply.
+const char* OT_UNARMORED_PROBE = "-----OT UNARMORED REQUESTS";
+
+namespace
+{
+// Inputs shorter than this are wrapped in a stored (uncompressed) zlib
+// stream, since deflating them costs more than it saves. Stored streams are
+// inflated like any other, so readers need not know which was used.
+constexpr auto compression_threshold_ = std::size_t{1024};
+
+auto compression_level(const std::size_t size) noexcept -> std::int32_t
+{
+    return (compression_threshold_ > size) ? Z_NO_COMPRESSION : Z_BEST_SPEED;
+}
+}  // namespace
+
 auto Armored::Factory() -> OTArmored
 {
     return OTArmored(new implementation::Armored());
@@ -183,7 +202,7 @@ auto Armored::clone() const -> Armored* { return new Armored(*this); }
  * the binary data. */
 auto Armored::compress_string(
     const std::string& str,
-    std::int32_t compressionlevel = Z_BEST_COMPRESSION) const -> std::string
+    std::int32_t compressionlevel) const -> std::string
 {
     z_stream zs;  // z_stream is zlib's control structure
     memset(&zs, 0, sizeof(zs));
@@ -534,7 +553,8 @@ auto Armored::SetString(
 
     if (strData.GetLength() < 1) return true;
 
-    std::string str_compressed = compress_string(strData.Get());
+    std::string str_compressed = compress_string(
+        strData.Get(), compression_level(strData.GetLength()));
 
     // "Success"
     if (str_compressed.size() == 0) {
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "core/OTStorage.hpp"
+#include "core/XMLReader.hpp"
 #include "internal/api/Api.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Factory.hpp"
@@ -1433,43 +1434,17 @@ auto Contract::LoadContractXML() -> bool
 
     if (!m_xmlUnsigned->Exists()) { return false; }
 
-    m_xmlUnsigned->reset();
-
-    IrrXMLReader* xml = irr::io::createIrrXMLReader(m_xmlUnsigned.get());
-    OT_ASSERT_MSG(
-        nullptr != xml,
-        "Memory allocation issue with xml reader in "
-        "Contract::LoadContractXML()\n");
-    std::unique_ptr<IrrXMLReader> xmlAngel(xml);
+    auto reader = XMLReader{m_xmlUnsigned.get()};
+    IrrXMLReader* xml = &reader;
 
     // parse the file until end reached
     while (xml->read()) {
-        auto strNodeType = String::Factory();
-
         switch (xml->getNodeType()) {
             case EXN_NONE:
-                strNodeType->Set("EXN_NONE");
-                goto switch_log;
             case EXN_COMMENT:
-                strNodeType->Set("EXN_COMMENT");
-                goto switch_log;
             case EXN_ELEMENT_END:
-                strNodeType->Set("EXN_ELEMENT_END");
-                goto switch_log;
             case EXN_CDATA:
-                strNodeType->Set("EXN_CDATA");
-                goto switch_log;
-
-            switch_log:
-                //                otErr << "SKIPPING %s element in
-                // Contract::LoadContractXML: "
-                //                              "type: %d, name: %s, value:
-                //                              %s\n",
-                //                              strNodeType.Get(),
-                // xml->getNodeType(), xml->getNodeName(), xml->getNodeData());
-
                 break;
-
             case EXN_TEXT: {
                 // unknown element type
                 //                otErr << "SKIPPING unknown text element type
@@ -8,6 +8,7 @@
 #include "opentxs/core/Ledger.hpp"  // IWYU pragma: associated
 
 #include <irrxml/irrXML.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
@@ -15,6 +16,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "core/OTStorage.hpp"
 #include "internal/api/Api.hpp"
@@ -78,7 +80,12 @@ Ledger::Ledger(
     : OTTransactionType(core, theNymID, theAccountID, theNotaryID)
     , m_Type(ledgerType::message)
     , m_bLoadedLegacyData(false)
+    , m_bLazy(false)
+    , m_bLoadReceipts(false)
+    , m_abbreviated()
     , m_mapTransactions()
+    , m_numbers()
+    , m_bNumbersValid(false)
 {
     InitLedger();
 }
@@ -95,7 +102,12 @@ Ledger::Ledger(
     : OTTransactionType(core)
     , m_Type(ledgerType::message)
     , m_bLoadedLegacyData(false)
+    , m_bLazy(false)
+    , m_bLoadReceipts(false)
+    , m_abbreviated()
     , m_mapTransactions()
+    , m_numbers()
+    , m_bNumbersValid(false)
 {
     InitLedger();
     SetRealAccountID(theAccountID);
@@ -107,7 +119,12 @@ Ledger::Ledger(const api::internal::Core& core)
     : OTTransactionType(core)
     , m_Type(ledgerType::message)
     , m_bLoadedLegacyData(false)
+    , m_bLazy(false)
+    , m_bLoadReceipts(false)
+    , m_abbreviated()
     , m_mapTransactions()
+    , m_numbers()
+    , m_bNumbersValid(false)
 {
     InitLedger();
 }
@@ -141,9 +158,14 @@ auto Ledger::VerifyAccount(const identity::Nym& theNym) -> bool
         case ledgerType::paymentInbox:
         case ledgerType::recordBox:
         case ledgerType::expiredBox: {
-            std::set<std::int64_t> setUnloaded;
-            LoadBoxReceipts(&setUnloaded);  // Note: Also useful for
-                                            // suppressing errors here.
+            if (m_bLazy) {
+                // Each box receipt is loaded when its record is accessed
+                m_bLoadReceipts = true;
+            } else {
+                std::set<std::int64_t> setUnloaded;
+                LoadBoxReceipts(&setUnloaded);  // Note: Also useful for
+                                                // suppressing errors here.
+            }
         } break;
         default: {
             const auto nLedgerType = static_cast<std::int32_t>(GetType());
@@ -241,6 +263,8 @@ auto Ledger::DeleteBoxReceipt(const std::int64_t& lTransactionNum) -> bool
 // if psetUnloaded passed in, then use it to return the #s that weren't there.
 auto Ledger::LoadBoxReceipts(std::set<std::int64_t>* psetUnloaded) -> bool
 {
+    materialize_all();
+
     // Grab a copy of all the transaction #s stored inside this ledger.
     //
     std::set<std::int64_t> the_set;
@@ -377,11 +401,9 @@ auto Ledger::GetTransactionNums(
 
     std::int32_t current_index{-1};
 
-    for (const auto& [number, pTransaction] : m_mapTransactions) {
+    for (const auto& number : numbers()) {
         ++current_index;  // 0 on first iteration.
 
-        OT_ASSERT(pTransaction);
-
         if (nullptr == pOnlyForIndices) {
             the_set.insert(number);
             continue;
@@ -1021,8 +1043,149 @@ void Ledger::InitLedger()
     m_bLoadedLegacyData = false;
 }
 
+auto Ledger::contains(const TransactionNumber number) const -> bool
+{
+    return (m_abbreviated.end() != find_abbreviated(number)) ||
+           (0 < m_mapTransactions.count(number));
+}
+
+auto Ledger::find_abbreviated(const TransactionNumber number) const
+    -> Index::iterator
+{
+    auto it = std::lower_bound(
+        m_abbreviated.begin(),
+        m_abbreviated.end(),
+        number,
+        [](const auto& lhs, const auto& rhs) { return lhs.number_ < rhs; });
+
+    if ((m_abbreviated.end() != it) && (it->number_ == number)) { return it; }
+
+    return m_abbreviated.end();
+}
+
+auto Ledger::instantiate(const Abbreviated& record) const
+    -> std::unique_ptr<OTTransaction>
+{
+    NumList numbers;
+
+    if (false == record.numbers_.empty()) { numbers.Add(record.numbers_); }
+
+    auto output{api_.Factory().Transaction(
+        GetNymID(),
+        GetPurportedAccountID(),
+        GetPurportedNotaryID(),
+        record.number_of_origin_,
+        record.origin_type_,
+        record.number_,
+        record.in_ref_to_,
+        record.in_ref_display_,
+        record.date_signed_,
+        record.type_,
+        String::Factory(record.hash_),
+        record.adjustment_,
+        record.display_value_,
+        record.closing_num_,
+        record.request_num_,
+        record.reply_success_,
+        (ledgerType::nymbox == m_Type) ? &numbers : nullptr)};
+
+    OT_ASSERT(output);
+
+    output->SetParent(*this);
+
+    return output;
+}
+
+auto Ledger::materialize(Index::iterator it) const
+    -> std::shared_ptr<OTTransaction>
+{
+    auto output = materialize_record(*it);
+    m_abbreviated.erase(it);
+
+    return output;
+}
+
+void Ledger::materialize_all() const
+{
+    while (false == m_abbreviated.empty()) {
+        materialize(std::prev(m_abbreviated.end()));
+    }
+}
+
+// Moves a record into m_mapTransactions. The caller must remove it from
+// m_abbreviated.
+auto Ledger::materialize_record(const Abbreviated& record) const
+    -> std::shared_ptr<OTTransaction>
+{
+    const auto number = record.number_;
+    std::shared_ptr<OTTransaction> output{instantiate(record)};
+
+    if (m_bLoadReceipts) {
+        auto receipt = ::opentxs::LoadBoxReceipt(
+            api_, *output, static_cast<std::int64_t>(m_Type));
+
+        if (receipt) {
+            output.reset(receipt.release());
+        } else {
+            LogDebug(OT_METHOD)(__FUNCTION__)(
+                ": Failed loading box receipt for abbreviated transaction "
+                "number: ")(number)
+                .Flush();
+        }
+    }
+
+    m_mapTransactions.emplace(number, output);
+
+    return output;
+}
+
+void Ledger::materialize_type(const transactionType type) const
+{
+    // Matching records are moved to the end while the rest keep their order,
+    // so they can all be removed at once
+    const auto matching = std::stable_partition(
+        m_abbreviated.begin(),
+        m_abbreviated.end(),
+        [&](const auto& record) { return type != record.type_; });
+
+    for (auto it = matching; it != m_abbreviated.end(); ++it) {
+        materialize_record(*it);
+    }
+
+    m_abbreviated.erase(matching, m_abbreviated.end());
+}
+
+void Ledger::numbers_changed() const { m_bNumbersValid = false; }
+
+auto Ledger::numbers() const -> const std::vector<TransactionNumber>&
+{
+    if (m_bNumbersValid) { return m_numbers; }
+
+    auto& output = m_numbers;
+    output.clear();
+    output.reserve(m_abbreviated.size() + m_mapTransactions.size());
+
+    for (const auto& record : m_abbreviated) {
+        output.emplace_back(record.number_);
+    }
+
+    for (const auto& [number, pTransaction] : m_mapTransactions) {
+        output.emplace_back(number);
+    }
+
+    std::inplace_merge(
+        output.begin(),
+        std::next(output.begin(), m_abbreviated.size()),
+        output.end());
+    m_bNumbersValid = true;
+
+    return output;
+}
+
 auto Ledger::GetTransactionMap() const -> const mapOfTransactions&
 {
+    materialize_all();
+
     return m_mapTransactions;
 }
 
@@ -1031,6 +1194,15 @@ auto Ledger::GetTransactionMap() const -> const mapOfTransactions&
 ///
 auto Ledger::RemoveTransaction(const TransactionNumber number) -> bool
 {
+    if (auto it = find_abbreviated(number); m_abbreviated.end() != it) {
+        m_abbreviated.erase(it);
+        numbers_changed();
+
+        return true;
+    }
+
+    numbers_changed();
+
     if (0 == m_mapTransactions.erase(number)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
             ": Attempt to remove Transaction from ledger, when "
@@ -1047,7 +1219,9 @@ auto Ledger::AddTransaction(std::shared_ptr<OTTransaction> theTransaction)
     -> bool
 {
     const auto number = theTransaction->GetTransactionNum();
-    const auto [it, added] = m_mapTransactions.emplace(number, theTransaction);
+    const auto added =
+        (false == contains(number)) &&
+        m_mapTransactions.emplace(number, theTransaction).second;
 
     if (false == added) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -1058,6 +1232,8 @@ auto Ledger::AddTransaction(std::shared_ptr<OTTransaction> theTransaction)
         return false;
     }
 
+    numbers_changed();
+
     return true;
 }
 
@@ -1065,6 +1241,8 @@ auto Ledger::AddTransaction(std::shared_ptr<OTTransaction> theTransaction)
 auto Ledger::GetTransaction(transactionType theType)
     -> std::shared_ptr<OTTransaction>
 {
+    materialize_type(theType);
+
     // loop through the items that make up this transaction
 
     for (auto& it : m_mapTransactions) {
@@ -1080,21 +1258,12 @@ auto Ledger::GetTransaction(transactionType theType)
 // if not found, returns -1
 auto Ledger::GetTransactionIndex(const TransactionNumber target) -> std::int32_t
 {
-    // loop through the transactions inside this ledger
-    // If a specific transaction is found, returns its index inside the ledger
-    //
-    std::int32_t output{0};
-
-    for (const auto& [number, pTransaction] : m_mapTransactions) {
-        if (target == number) {
+    const auto& all = numbers();
+    const auto it = std::lower_bound(all.begin(), all.end(), target);
 
-            return output;
-        } else {
-            ++output;
-        }
-    }
+    if ((all.end() == it) || (target != *it)) { return -1; }
 
-    return -1;
+    return static_cast<std::int32_t>(std::distance(all.begin(), it));
 }
 
 // Look up a transaction by transaction number and see if it is in the ledger.
@@ -1105,6 +1274,11 @@ auto Ledger::GetTransactionIndex(const TransactionNumber target) -> std::int32_t
 auto Ledger::GetTransaction(const TransactionNumber number) const
     -> std::shared_ptr<OTTransaction>
 {
+    if (auto it = find_abbreviated(number); m_abbreviated.end() != it) {
+
+        return materialize(it);
+    }
+
     try {
 
         return m_mapTransactions.at(number);
@@ -1124,6 +1298,10 @@ auto Ledger::GetTransactionCountInRefTo(std::int64_t lReferenceNum) const
 {
     std::int32_t nCount{0};
 
+    for (const auto& record : m_abbreviated) {
+        if (record.in_ref_to_ == lReferenceNum) nCount++;
+    }
+
     for (auto& it : m_mapTransactions) {
         const auto pTransaction = it.second;
         OT_ASSERT(pTransaction);
@@ -1143,19 +1321,7 @@ auto Ledger::GetTransactionByIndex(std::int32_t nIndex) const
     // Out of bounds.
     if ((nIndex < 0) || (nIndex >= GetTransactionCount())) return nullptr;
 
-    std::int32_t nIndexCount = -1;
-
-    for (auto& it : m_mapTransactions) {
-        nIndexCount++;  // On first iteration, this is now 0, same as nIndex.
-        auto pTransaction = it.second;
-        OT_ASSERT(pTransaction);  // Should always be good.
-
-        // If this transaction is the one at the requested index
-        if (nIndexCount == nIndex) return pTransaction;
-    }
-
-    return nullptr;  // Should never reach this point, since bounds are checked
-                     // at the top.
+    return GetTransaction(numbers().at(static_cast<std::size_t>(nIndex)));
 }
 
 // Nymbox-only.
@@ -1164,6 +1330,8 @@ auto Ledger::GetTransactionByIndex(std::int32_t nIndex) const
 auto Ledger::GetReplyNotice(const std::int64_t& lRequestNum)
     -> std::shared_ptr<OTTransaction>
 {
+    materialize_type(transactionType::replyNotice);
+
     // loop through the transactions that make up this ledger.
     for (auto& it : m_mapTransactions) {
         auto pTransaction = it.second;
@@ -1182,6 +1350,8 @@ auto Ledger::GetReplyNotice(const std::int64_t& lRequestNum)
 auto Ledger::GetTransferReceipt(std::int64_t lNumberOfOrigin)
     -> std::shared_ptr<OTTransaction>
 {
+    materialize_type(transactionType::transferReceipt);
+
     // loop through the transactions that make up this ledger.
     for (auto& it : m_mapTransactions) {
         auto pTransaction = it.second;
@@ -1258,6 +1428,9 @@ auto Ledger::GetTransferReceipt(std::int64_t lNumberOfOrigin)
 auto Ledger::GetChequeReceipt(std::int64_t lChequeNum)
     -> std::shared_ptr<OTTransaction>
 {
+    materialize_type(transactionType::chequeReceipt);
+    materialize_type(transactionType::voucherReceipt);
+
     for (auto& it : m_mapTransactions) {
         auto pCurrentReceipt = it.second;
         OT_ASSERT(nullptr != pCurrentReceipt);
@@ -1348,6 +1521,8 @@ auto Ledger::GetChequeReceipt(std::int64_t lChequeNum)
 auto Ledger::GetFinalReceipt(std::int64_t lReferenceNum)
     -> std::shared_ptr<OTTransaction>
 {
+    materialize_type(transactionType::finalReceipt);
+
     // loop through the transactions that make up this ledger.
     for (auto& it : m_mapTransactions) {
         auto pTransaction = it.second;
@@ -1537,6 +1712,8 @@ auto Ledger::GenerateBalanceStatement(
         "each one... ")
         .Flush();
 
+    materialize_all();
+
     for (auto& it : m_mapTransactions) {
         auto pTransaction = it.second;
 
@@ -1571,6 +1748,8 @@ auto Ledger::GetTotalPendingValue(const PasswordPrompt& reason) -> std::int64_t
         return 0;
     }
 
+    materialize_type(transactionType::pending);
+
     for (auto& it : m_mapTransactions) {
         const auto pTransaction = it.second;
         OT_ASSERT(pTransaction);
@@ -1604,6 +1783,8 @@ void Ledger::ProduceOutboxReport(
     // the balance item.
     // (So the balance item contains a complete report on the outoing transfers
     // in this outbox.)
+    materialize_all();
+
     for (auto& it : m_mapTransactions) {
         auto pTransaction = it.second;
         OT_ASSERT(pTransaction);
@@ -1688,8 +1869,7 @@ void Ledger::UpdateContents(const PasswordPrompt& reason)  // Before
     // later.
     std::int32_t nPartialRecordCount = 0;
     if (bSavingAbbreviated) {
-        nPartialRecordCount =
-            static_cast<std::int32_t>(m_mapTransactions.size());
+        nPartialRecordCount = GetTransactionCount();
     }
 
     // Notice I use the PURPORTED Account ID and Notary ID to create the output.
@@ -1714,9 +1894,24 @@ void Ledger::UpdateContents(const PasswordPrompt& reason)  // Before
     tag.add_attribute("nymID", strNymID->Get());
     tag.add_attribute("notaryID", strLedgerAcctNotaryID->Get());
 
-    // loop through the transactions and print them out here.
-    for (auto& it : m_mapTransactions) {
-        auto pTransaction = it.second;
+    // loop through the transactions and print them out here. Records which
+    // were never accessed are written from a temporary transaction, which
+    // produces the same abbreviated record they were loaded from.
+    auto abbreviated = m_abbreviated.cbegin();
+    auto loaded = m_mapTransactions.cbegin();
+
+    while ((m_abbreviated.cend() != abbreviated) ||
+           (m_mapTransactions.cend() != loaded)) {
+        std::shared_ptr<OTTransaction> pTransaction{};
+
+        if ((m_mapTransactions.cend() == loaded) ||
+            ((m_abbreviated.cend() != abbreviated) &&
+             (abbreviated->number_ < loaded->first))) {
+            pTransaction = instantiate(*abbreviated++);
+        } else {
+            pTransaction = (loaded++)->second;
+        }
+
         OT_ASSERT(pTransaction);
 
         if (false == bSavingAbbreviated)  // only OTLedger::message uses this
@@ -1992,9 +2187,7 @@ auto Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                     // ledger.
                     // (There can only be one.)
                     //
-                    auto pExistingTrans = GetTransaction(number);
-                    if (false != bool(pExistingTrans))  // Uh-oh, it's already
-                                                        // there!
+                    if (contains(number))  // Uh-oh, it's already there!
                     {
                         LogNormal(OT_METHOD)(__FUNCTION__)(
                             ": Error loading transaction ")(number)(" (")(
@@ -2005,6 +2198,45 @@ auto Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                         return (-1);
                     }
 
+                    if (m_bLazy) {
+                        auto record = Abbreviated{
+                            number,
+                            theType,
+                            theOriginType,
+                            bReplyTransSuccess,
+                            lAdjustment,
+                            lDisplayValue,
+                            lNumberOfOrigin,
+                            lInRefTo,
+                            lInRefDisplay,
+                            lClosingNum,
+                            lRequestNum,
+                            the_DATE_SIGNED,
+                            strHash->Get(),
+                            {}};
+
+                        if ((nullptr != pNumList) && (0 < pNumList->Count())) {
+                            auto numbers = String::Factory();
+                            pNumList->Output(numbers);
+                            record.numbers_ = numbers->Get();
+                        }
+
+                        // Records are saved in order, so this is normally
+                        // an append
+                        m_abbreviated.insert(
+                            std::upper_bound(
+                                m_abbreviated.begin(),
+                                m_abbreviated.end(),
+                                number,
+                                [](const auto& lhs, const auto& rhs) {
+                                    return lhs < rhs.number_;
+                                }),
+                            std::move(record));
+                        numbers_changed();
+
+                        continue;
+                    }
+
                     // CONSTRUCT THE ABBREVIATED RECEIPT HERE...
 
                     // Set all the values we just loaded here during actual
@@ -2083,6 +2315,7 @@ auto Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                             pTransaction.release()};
                         m_mapTransactions[transaction->GetTransactionNum()] =
                             transaction;
+                        numbers_changed();
                         transaction->SetParent(*this);
                     } else {
                         LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -2227,11 +2460,8 @@ auto Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
             // I am loading it here and adding it to the ledger. (So I do.)
             {
 
-                auto pExistingTrans =
-                    GetTransaction(pTransaction->GetTransactionNum());
-                if (false != bool(pExistingTrans))  // Uh-oh, it's already
-                                                    // there!
-                {
+                // Uh-oh, it's already there!
+                if (contains(pTransaction->GetTransactionNum())) {
                     const auto strPurportedAcctID =
                         String::Factory(GetPurportedAccountID());
                     LogNormal(OT_METHOD)(__FUNCTION__)(
@@ -2248,6 +2478,7 @@ auto Ledger::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                     pTransaction.release()};
                 m_mapTransactions[transaction->GetTransactionNum()] =
                     transaction;
+                numbers_changed();
                 transaction->SetParent(*this);
 
                 switch (GetType()) {
@@ -2347,7 +2578,10 @@ void Ledger::ReleaseTransactions()
 {
     // If there were any dynamically allocated objects, clean them up here.
 
+    m_bLoadReceipts = false;
+    m_abbreviated.clear();
     m_mapTransactions.clear();
+    numbers_changed();
 }
 
 void Ledger::Release_Ledger() { ReleaseTransactions(); }
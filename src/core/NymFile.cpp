@@ -19,6 +19,7 @@
 
 #include "2_Factory.hpp"
 #include "core/OTStorage.hpp"
+#include "core/XMLReader.hpp"
 #include "internal/api/Api.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/api/Factory.hpp"
@@ -29,7 +30,6 @@
 #include "opentxs/core/LogSource.hpp"
 #include "opentxs/core/Message.hpp"
 #include "opentxs/core/String.hpp"
-#include "opentxs/core/StringXML.hpp"
 #include "opentxs/core/crypto/OTSignedFile.hpp"
 #include "opentxs/core/identifier/Nym.hpp"
 #include "opentxs/core/util/Tag.hpp"
@@ -124,10 +124,8 @@ auto NymFile::deserialize_nymfile(
     converted = false;
     //?    ClearAll();  // Since we are loading everything up... (credentials
     // are NOT cleared here. See note in Nym::ClearAll.)
-    auto strNymXML = StringXML::Factory(strNym);  // todo optimize
-    irr::io::IrrXMLReader* xml = irr::io::createIrrXMLReader(strNymXML.get());
-    OT_ASSERT(nullptr != xml);
-    std::unique_ptr<irr::io::IrrXMLReader> theCleanup(xml);
+    auto reader = XMLReader{strNym};
+    irr::io::IrrXMLReader* xml = &reader;
 
     // parse the file until end reached
     while (xml && xml->read()) {
@@ -0,0 +1,412 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"        // IWYU pragma: associated
+#include "1_Internal.hpp"      // IWYU pragma: associated
+#include "core/XMLReader.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "opentxs/core/String.hpp"
+
+namespace opentxs
+{
+namespace
+{
+struct Entity {
+    std::string_view reference_;
+    char value_;
+};
+
+constexpr Entity entities_[] = {
+    {"&amp;", '&'},
+    {"&lt;", '<'},
+    {"&gt;", '>'},
+    {"&quot;", '"'},
+    {"&apos;", '\''},
+};
+
+constexpr auto empty_{""};
+constexpr unsigned char utf8_bom_[] = {0xEF, 0xBB, 0xBF};
+
+auto skip_bom(const char* data, const std::size_t size) noexcept -> std::size_t
+{
+    if ((sizeof(utf8_bom_) <= size) &&
+        (0 == std::memcmp(data, utf8_bom_, sizeof(utf8_bom_)))) {
+
+        return sizeof(utf8_bom_);
+    }
+
+    return 0;
+}
+}  // namespace
+
+XMLReader::XMLReader(const char* data, const std::size_t size) noexcept
+    : buffer_([&] {
+        auto out = std::vector<char>{};
+        out.reserve(size + 1);
+        out.insert(out.end(), data, data + size);
+        out.push_back('\0');
+
+        return out;
+    }())
+    , position_(buffer_.data() + skip_bom(data, size))
+    , end_(buffer_.data() + size)
+    , tag_pending_(false)
+    , type_(irr::io::EXN_NONE)
+    , source_format_(
+          (0 < skip_bom(data, size)) ? irr::io::ETF_UTF8 : irr::io::ETF_ASCII)
+    , name_(empty_)
+    , name_size_(0)
+    , empty_element_(false)
+    , attributes_()
+{
+}
+
+XMLReader::XMLReader(const String& input) noexcept
+    : XMLReader(input.Get(), input.GetLength())
+{
+}
+
+auto XMLReader::decode(char* begin, char* end) noexcept -> char*
+{
+    auto* in = static_cast<char*>(std::memchr(begin, '&', end - begin));
+
+    if (nullptr == in) { return end; }
+
+    auto* out = in;
+
+    while (in < end) {
+        if ('&' == *in) {
+            const auto remaining = static_cast<std::size_t>(end - in);
+            auto replaced{false};
+
+            for (const auto& [reference, value] : entities_) {
+                if ((reference.size() <= remaining) &&
+                    (0 == reference.compare(
+                              0, reference.size(), in, reference.size()))) {
+                    *out++ = value;
+                    in += reference.size();
+                    replaced = true;
+
+                    break;
+                }
+            }
+
+            if (replaced) { continue; }
+        }
+
+        *out++ = *in++;
+    }
+
+    return out;
+}
+
+auto XMLReader::find(const char* name) const noexcept -> const Attribute*
+{
+    if (nullptr == name) { return nullptr; }
+
+    for (const auto& attribute : attributes_) {
+        if (0 == std::strcmp(attribute.name_, name)) { return &attribute; }
+    }
+
+    return nullptr;
+}
+
+auto XMLReader::getAttributeCount() const -> int
+{
+    return static_cast<int>(attributes_.size());
+}
+
+auto XMLReader::getAttributeName(int idx) const -> const char*
+{
+    if ((0 > idx) || (getAttributeCount() <= idx)) { return nullptr; }
+
+    return attributes_[static_cast<std::size_t>(idx)].name_;
+}
+
+auto XMLReader::getAttributeValue(int idx) const -> const char*
+{
+    if ((0 > idx) || (getAttributeCount() <= idx)) { return nullptr; }
+
+    return attributes_[static_cast<std::size_t>(idx)].value_;
+}
+
+auto XMLReader::getAttributeValue(const char* name) const -> const char*
+{
+    const auto* attribute = find(name);
+
+    return (nullptr == attribute) ? nullptr : attribute->value_;
+}
+
+auto XMLReader::getAttributeValueAsFloat(const char* name) const -> float
+{
+    const auto* value = getAttributeValue(name);
+
+    return (nullptr == value) ? 0.0f : std::strtof(value, nullptr);
+}
+
+auto XMLReader::getAttributeValueAsFloat(int idx) const -> float
+{
+    const auto* value = getAttributeValue(idx);
+
+    return (nullptr == value) ? 0.0f : std::strtof(value, nullptr);
+}
+
+auto XMLReader::getAttributeValueAsInt(const char* name) const -> int
+{
+    return static_cast<int>(getAttributeValueAsFloat(name));
+}
+
+auto XMLReader::getAttributeValueAsInt(int idx) const -> int
+{
+    return static_cast<int>(getAttributeValueAsFloat(idx));
+}
+
+auto XMLReader::getAttributeValueSafe(const char* name) const -> const char*
+{
+    const auto* value = getAttributeValue(name);
+
+    return (nullptr == value) ? empty_ : value;
+}
+
+auto XMLReader::is_space(const char c) noexcept -> bool
+{
+    return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
+}
+
+// Called with position_ on the character after "<!"
+auto XMLReader::parse_cdata() noexcept -> bool
+{
+    static constexpr auto open = std::string_view{"[CDATA["};
+
+    if ('[' != *position_) { return false; }
+
+    type_ = irr::io::EXN_CDATA;
+    position_ = std::min(position_ + open.size(), end_);
+    auto* begin = position_;
+
+    for (; position_ < end_; ++position_) {
+        if (('>' == *position_) && ((position_ - begin) >= 2) &&
+            (']' == *(position_ - 1)) && (']' == *(position_ - 2))) {
+            set_name(begin, position_ - 2);
+            ++position_;
+
+            return true;
+        }
+    }
+
+    set_name(end_, end_);
+
+    return true;
+}
+
+// Called with position_ on the character after "</"
+auto XMLReader::parse_closing() noexcept -> void
+{
+    type_ = irr::io::EXN_ELEMENT_END;
+    empty_element_ = false;
+    attributes_.clear();
+    auto* begin = position_;
+
+    while ((position_ < end_) && ('>' != *position_)) { ++position_; }
+
+    set_name(begin, position_);
+
+    if (position_ < end_) { ++position_; }
+}
+
+// Called with position_ on the character after "<!"
+auto XMLReader::parse_comment() noexcept -> void
+{
+    type_ = irr::io::EXN_COMMENT;
+    auto* begin = position_;
+    auto depth = 1;
+
+    while ((0 < depth) && (position_ < end_)) {
+        if ('>' == *position_) {
+            --depth;
+        } else if ('<' == *position_) {
+            ++depth;
+        }
+
+        ++position_;
+    }
+
+    // Strip the leading "--" and the trailing "-->"
+    auto* last = position_ - 3;
+
+    if ((0 < depth) || (last < begin + 2)) {
+        set_name(end_, end_);
+    } else {
+        set_name(begin + 2, last);
+    }
+}
+
+// Called with position_ on the character after "<?"
+auto XMLReader::parse_definition() noexcept -> void
+{
+    type_ = irr::io::EXN_UNKNOWN;
+    set_name(end_, end_);
+
+    while ((position_ < end_) && ('>' != *position_)) { ++position_; }
+
+    if (position_ < end_) { ++position_; }
+}
+
+auto XMLReader::parse_node() noexcept -> void
+{
+    if (tag_pending_) {
+        tag_pending_ = false;
+    } else {
+        auto* begin = position_;
+
+        while ((position_ < end_) && ('<' != *position_)) { ++position_; }
+
+        if (position_ == end_) {
+            // Trailing text after the last tag is not reported
+            type_ = irr::io::EXN_NONE;
+            set_name(end_, end_);
+
+            return;
+        }
+
+        if ((position_ > begin) && set_text(begin, position_)) { return; }
+    }
+
+    // Skip the '<'
+    ++position_;
+
+    switch (*position_) {
+        case '/': {
+            ++position_;
+            parse_closing();
+        } break;
+        case '?': {
+            ++position_;
+            parse_definition();
+        } break;
+        case '!': {
+            ++position_;
+
+            if (false == parse_cdata()) { parse_comment(); }
+        } break;
+        default: {
+            parse_opening();
+        }
+    }
+}
+
+// Called with position_ on the first character of the element name
+auto XMLReader::parse_opening() noexcept -> void
+{
+    type_ = irr::io::EXN_ELEMENT;
+    empty_element_ = false;
+    attributes_.clear();
+    auto* nameBegin = position_;
+
+    while ((position_ < end_) && ('>' != *position_) &&
+           (false == is_space(*position_))) {
+        ++position_;
+    }
+
+    auto* nameEnd = position_;
+
+    // Names and values are terminated as soon as they have been scanned, but
+    // the element name can not be terminated until the loop below is done
+    // since its terminator may be the '>' which ends the loop.
+    while ((position_ < end_) && ('>' != *position_)) {
+        if (is_space(*position_)) {
+            ++position_;
+
+            continue;
+        }
+
+        if ('/' == *position_) {
+            ++position_;
+            empty_element_ = true;
+
+            break;
+        }
+
+        auto* attributeName = position_;
+
+        while ((position_ < end_) && ('=' != *position_) &&
+               (false == is_space(*position_))) {
+            ++position_;
+        }
+
+        auto* attributeNameEnd = position_;
+
+        while ((position_ < end_) && ('"' != *position_) &&
+               ('\'' != *position_)) {
+            ++position_;
+        }
+
+        if (position_ == end_) { break; }
+
+        const auto quote = *position_++;
+        auto* value = position_;
+
+        while ((position_ < end_) && (quote != *position_)) { ++position_; }
+
+        if (position_ == end_) { break; }
+
+        *decode(value, position_) = '\0';
+        *attributeNameEnd = '\0';
+        attributes_.push_back({attributeName, value});
+        ++position_;
+    }
+
+    if ((nameEnd > nameBegin) && ('/' == *(nameEnd - 1))) {
+        empty_element_ = true;
+        --nameEnd;
+    }
+
+    set_name(nameBegin, nameEnd);
+
+    if (position_ < end_) { ++position_; }
+}
+
+auto XMLReader::read() -> bool
+{
+    if (position_ >= end_) { return false; }
+
+    if ((false == tag_pending_) && ('\0' == *position_)) { return false; }
+
+    parse_node();
+
+    return true;
+}
+
+auto XMLReader::set_name(char* begin, char* end) noexcept -> void
+{
+    *end = '\0';
+    name_ = begin;
+    name_size_ = static_cast<std::size_t>(end - begin);
+}
+
+auto XMLReader::set_text(char* begin, char* end) noexcept -> bool
+{
+    // Text shorter than three characters is not reported if it is all
+    // whitespace
+    if ((end - begin) < 3) {
+        auto* i = begin;
+
+        while ((i < end) && is_space(*i)) { ++i; }
+
+        if (i == end) { return false; }
+    }
+
+    type_ = irr::io::EXN_TEXT;
+    // The terminator may overwrite the '<' at end
+    set_name(begin, decode(begin, end));
+    tag_pending_ = true;
+
+    return true;
+}
+}  // namespace opentxs
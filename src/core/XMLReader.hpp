@@ -0,0 +1,108 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <irrxml/irrXML.hpp>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace opentxs
+{
+class String;
+}  // namespace opentxs
+
+namespace opentxs
+{
+// Pull parser for legacy contracts which implements the irrXML reader
+// interface, so existing ProcessXMLNode() overrides work unchanged.
+//
+// The input is copied once. Names, values and text are then decoded and
+// null-terminated in place, so reading a node allocates nothing and every
+// returned pointer refers to the internal buffer. Pointers remain valid
+// until the reader is destroyed, not merely until the next call to read().
+//
+// Differences from irrXML: only 8-bit input is accepted (a UTF-8 byte order
+// mark is skipped), a single character following the last entity reference
+// in a value is not dropped, text at the end of the input is reported as
+// EXN_NONE instead of repeating the previous node, and malformed input never
+// reads past the end of the buffer.
+class XMLReader final : public irr::io::IrrXMLReader
+{
+public:
+    auto getAttributeCount() const -> int final;
+    auto getAttributeName(int idx) const -> const char* final;
+    auto getAttributeValue(int idx) const -> const char* final;
+    auto getAttributeValue(const char* name) const -> const char* final;
+    auto getAttributeValueAsFloat(const char* name) const -> float final;
+    auto getAttributeValueAsFloat(int idx) const -> float final;
+    auto getAttributeValueAsInt(const char* name) const -> int final;
+    auto getAttributeValueAsInt(int idx) const -> int final;
+    auto getAttributeValueSafe(const char* name) const -> const char* final;
+    auto getNodeData() const -> const char* final { return name_; }
+    auto getNodeName() const -> const char* final { return name_; }
+    auto getNodeType() const -> irr::io::EXML_NODE final { return type_; }
+    auto getParserFormat() const -> irr::io::ETEXT_FORMAT final
+    {
+        return irr::io::ETF_UTF8;
+    }
+    auto getSourceFormat() const -> irr::io::ETEXT_FORMAT final
+    {
+        return source_format_;
+    }
+    auto isEmptyElement() const -> bool final { return empty_element_; }
+    // Name of the current element, or the contents of the current text,
+    // comment, or CDATA node
+    auto Node() const noexcept -> std::string_view
+    {
+        return {name_, name_size_};
+    }
+
+    auto read() -> bool final;
+
+    XMLReader(const char* data, const std::size_t size) noexcept;
+    XMLReader(const String& input) noexcept;
+
+    ~XMLReader() final = default;
+
+private:
+    struct Attribute {
+        const char* name_;
+        const char* value_;
+    };
+
+    std::vector<char> buffer_;
+    char* position_;
+    char* const end_;
+    // Set when the '<' at position_ was overwritten to terminate a text node
+    bool tag_pending_;
+    irr::io::EXML_NODE type_;
+    irr::io::ETEXT_FORMAT source_format_;
+    const char* name_;
+    std::size_t name_size_;
+    bool empty_element_;
+    std::vector<Attribute> attributes_;
+
+    static auto decode(char* begin, char* end) noexcept -> char*;
+    static auto is_space(const char c) noexcept -> bool;
+
+    auto find(const char* name) const noexcept -> const Attribute*;
+    auto parse_cdata() noexcept -> bool;
+    auto parse_closing() noexcept -> void;
+    auto parse_comment() noexcept -> void;
+    auto parse_definition() noexcept -> void;
+    auto parse_node() noexcept -> void;
+    auto parse_opening() noexcept -> void;
+    auto set_name(char* begin, char* end) noexcept -> void;
+    auto set_text(char* begin, char* end) noexcept -> bool;
+
+    XMLReader() = delete;
+    XMLReader(const XMLReader&) = delete;
+    XMLReader(XMLReader&&) = delete;
+    auto operator=(const XMLReader&) -> XMLReader& = delete;
+    auto operator=(XMLReader&&) -> XMLReader& = delete;
+};
+}  // namespace opentxs
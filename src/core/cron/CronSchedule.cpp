@@ -0,0 +1,155 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                // IWYU pragma: associated
+#include "1_Internal.hpp"              // IWYU pragma: associated
+#include "core/cron/CronSchedule.hpp"  // IWYU pragma: associated
+
+#include <vector>
+
+#include "opentxs/core/Log.hpp"
+
+namespace opentxs
+{
+CronSchedule::CronSchedule() noexcept
+    : items_()
+    , positions_()
+    , round_()
+    , last_()
+    , round_active_(false)
+    , slice_active_(false)
+    , now_()
+    , limit_(0)
+    , slice_processed_(0)
+{
+}
+
+auto CronSchedule::BeginSlice(const Time now, const std::size_t limit) noexcept
+    -> bool
+{
+    now_ = now;
+    limit_ = limit;
+    slice_processed_ = 0;
+    const auto end = items_.upper_bound(now_);
+
+    if (false == round_active_) {
+        if (items_.begin() == end) { return false; }
+
+        round_active_ = true;
+        round_ = {};
+    }
+
+    // Items which became due since the previous slice, including items which
+    // were processed then and are due again
+    for (auto i = items_.begin(); i != end; ++i) {
+        count(positions_.at(i->second));
+    }
+
+    ++round_.slices_;
+    slice_active_ = true;
+
+    return true;
+}
+
+auto CronSchedule::count(Position& position) noexcept -> void
+{
+    if (position.counted_) { return; }
+
+    position.counted_ = true;
+    ++round_.due_;
+}
+
+auto CronSchedule::Defer(const Time due) noexcept -> void
+{
+    auto deferred = std::vector<std::int64_t>{};
+
+    for (auto i = items_.begin(); (items_.end() != i) && (i->first <= now_);
+         ++i) {
+        deferred.emplace_back(i->second);
+    }
+
+    for (const auto transaction : deferred) { Schedule(transaction, due); }
+}
+
+auto CronSchedule::Due() const noexcept -> bool
+{
+    if (false == slice_active_) { return false; }
+
+    if ((0 < limit_) && (slice_processed_ >= limit_)) { return false; }
+
+    return (false == items_.empty()) && (items_.begin()->first <= now_);
+}
+
+auto CronSchedule::EndSlice(
+    const std::size_t scheduled,
+    const std::chrono::microseconds elapsed) noexcept -> bool
+{
+    round_.elapsed_ += elapsed;
+    slice_active_ = false;
+
+    if ((false == items_.empty()) && (items_.begin()->first <= now_)) {
+        return true;
+    }
+
+    round_.scheduled_ = scheduled;
+    last_ = round_;
+    round_active_ = false;
+
+    return false;
+}
+
+auto CronSchedule::Next() noexcept -> std::int64_t
+{
+    OT_ASSERT(Due());
+
+    const auto it = items_.begin();
+    const auto transaction = it->second;
+    positions_.erase(transaction);
+    items_.erase(it);
+    ++slice_processed_;
+    ++round_.processed_;
+
+    return transaction;
+}
+
+auto CronSchedule::NextDue() const noexcept -> std::optional<Time>
+{
+    if (items_.empty()) { return std::nullopt; }
+
+    return items_.begin()->first;
+}
+
+auto CronSchedule::Schedule(
+    const std::int64_t transaction,
+    const Time due) noexcept -> void
+{
+    auto [it, added] = positions_.try_emplace(transaction);
+    auto& position = it->second;
+
+    if (false == added) { items_.erase(position.item_); }
+
+    // Items which are due at the same time keep the order they were
+    // scheduled in
+    position.item_ = items_.emplace(due, transaction);
+
+    if (due > now_) {
+        position.counted_ = false;
+    } else if (slice_active_) {
+        // Processed in the current slice, so it must be counted now. Between
+        // slices the next slice counts it.
+        count(position);
+    }
+}
+
+auto CronSchedule::Unschedule(const std::int64_t transaction) noexcept -> void
+{
+    auto it = positions_.find(transaction);
+
+    if (positions_.end() == it) { return; }
+
+    items_.erase(it->second.item_);
+    positions_.erase(it);
+}
+}  // namespace opentxs
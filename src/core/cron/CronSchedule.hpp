@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/core/cron/OTCron.hpp"
+
+namespace opentxs
+{
+// Transaction numbers of the items on cron, ordered by the time each item is
+// next due. Items which are due at the same time are processed in the order
+// they were scheduled.
+//
+// Due items are processed in slices of limited size. A round begins with the
+// first slice which finds a due item and ends with the first slice after
+// which no due items remain.
+class CronSchedule
+{
+public:
+    using Statistics = OTCron::RoundStatistics;
+
+    // True if the current slice has an item left to process
+    OPENTXS_EXPORT auto Due() const noexcept -> bool;
+    OPENTXS_EXPORT auto LastRound() const noexcept -> const Statistics&
+    {
+        return last_;
+    }
+    // Time the earliest item is due, if any items are scheduled
+    OPENTXS_EXPORT auto NextDue() const noexcept -> std::optional<Time>;
+
+    // Begins a slice which processes at most limit items (0 for no limit)
+    // due no later than now. Returns false if no round is in progress and
+    // no items are due.
+    OPENTXS_EXPORT auto BeginSlice(
+        const Time now,
+        const std::size_t limit) noexcept -> bool;
+    // Moves every item which is due in the current slice to the specified
+    // time
+    OPENTXS_EXPORT auto Defer(const Time due) noexcept -> void;
+    // Ends the current slice and returns true if due items remain. If none
+    // remain the round ends, and scheduled is recorded as the number of
+    // items left on cron.
+    OPENTXS_EXPORT auto EndSlice(
+        const std::size_t scheduled,
+        const std::chrono::microseconds elapsed) noexcept -> bool;
+    // Unschedules the next item of the current slice and returns its
+    // transaction number. The caller must schedule the item again unless
+    // it is removed from cron. Only valid if Due() returns true.
+    OPENTXS_EXPORT auto Next() noexcept -> std::int64_t;
+    // Counts an item removed from cron during the current round
+    OPENTXS_EXPORT auto Removed() noexcept -> void { ++round_.removed_; }
+    // Adds the item, or moves it if it is already scheduled
+    OPENTXS_EXPORT auto Schedule(
+        const std::int64_t transaction,
+        const Time due) noexcept -> void;
+    OPENTXS_EXPORT auto Unschedule(const std::int64_t transaction) noexcept
+        -> void;
+
+    OPENTXS_EXPORT CronSchedule() noexcept;
+
+    OPENTXS_EXPORT ~CronSchedule() = default;
+
+private:
+    using Items = std::multimap<Time, std::int64_t>;
+
+    struct Position {
+        Items::iterator item_{};
+        // Set once the item has been counted as due in the current round,
+        // until it is processed or moved to a time after the current slice
+        bool counted_{false};
+    };
+
+    Items items_;
+    std::map<std::int64_t, Position> positions_;
+    Statistics round_;
+    Statistics last_;
+    bool round_active_;
+    bool slice_active_;
+    // The time at which the current or most recent slice began
+    Time now_;
+    std::size_t limit_;
+    std::size_t slice_processed_;
+
+    auto count(Position& position) noexcept -> void;
+
+    CronSchedule(const CronSchedule&) = delete;
+    CronSchedule(CronSchedule&&) = delete;
+    auto operator=(const CronSchedule&) -> CronSchedule& = delete;
+    auto operator=(CronSchedule&&) -> CronSchedule& = delete;
+};
+}  // namespace opentxs
@@ -7,14 +7,19 @@
 #include "1_Internal.hpp"                // IWYU pragma: associated
 #include "opentxs/core/cron/OTCron.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
 #include "core/OTStorage.hpp"
+#include "core/cron/CronSchedule.hpp"
 #include "internal/api/Api.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Factory.hpp"
@@ -44,20 +49,21 @@ namespace opentxs
 // low, before each round.
 std::int32_t OTCron::__trans_refill_amount = 500;
 
-// The number of milliseconds (ideally) between each "Cron Process" event.
+// The minimum number of milliseconds between each time a given cron item is
+// processed.
 std::chrono::milliseconds OTCron::__cron_ms_between_process{10000};
 
 // The maximum number of cron items any given Nym can have active at the same
 // time.
 std::int32_t OTCron::__cron_max_items_per_nym{10};
 
-Time OTCron::last_executed_{};
-
 OTCron::OTCron(const api::internal::Core& server)
     : Contract(server)
     , m_mapMarkets()
     , m_mapCronItems()
     , m_multimapCronItems()
+    , m_mapPositions()
+    , m_pSchedule(std::make_unique<CronSchedule>())
     , m_NOTARY_ID(api_.Factory().ServerID())
     , m_listTransactionNumbers()
     , m_bIsActivated(false)
@@ -581,89 +587,117 @@ void OTCron::UpdateContents(const PasswordPrompt& reason)
     m_xmlUnsigned->Concatenate("%s", str_result.c_str());
 }
 
-auto OTCron::computeTimeout() -> std::chrono::milliseconds
+auto OTCron::computeTimeout() const -> std::chrono::milliseconds
+{
+    const auto due = m_pSchedule->NextDue();
+
+    if ((!m_bIsActivated) || (false == due.has_value())) {
+        return GetCronMsBetweenProcess();
+    }
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        due.value() - Clock::now());
+}
+
+// An item is not processed again until the interval it requested has passed
+// (subclasses skip their processing until then anyway), nor more often than
+// the configured minimum.
+auto OTCron::next_due(const OTCronItem& item, const Time now) const -> Time
 {
-    return GetCronMsBetweenProcess() -
-           std::chrono::duration_cast<std::chrono::milliseconds>(
-               Clock::now() - last_executed_);
+    const auto gap =
+        std::max(GetCronMsBetweenProcess(), std::chrono::milliseconds{1});
+    const auto minimum = now + gap;
+    const auto last = item.GetLastProcessDate();
+
+    if (Time{} == last) { return minimum; }
+
+    return std::max(minimum, last + item.GetProcessInterval());
 }
 
 // Make sure to call this regularly so the CronItems get a chance to process and
 // expire.
-void OTCron::ProcessCronItems()
+auto OTCron::ProcessCronItems(const std::size_t nLimit) -> bool
 {
     auto reason = api_.Factory().PasswordPrompt(__FUNCTION__);
     if (!m_bIsActivated) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Not activated yet. (Skipping).")
             .Flush();
-        return;
+        return false;
     }
 
-    // check elapsed time since last items processing
-    if (computeTimeout().count() > 0) { return; }
+    const auto start = std::chrono::steady_clock::now();
+    const auto now = Clock::now();
 
-    last_executed_ = Clock::now();
+    if (false == m_pSchedule->BeginSlice(now, nLimit)) { return false; }
 
     const std::int32_t nTwentyPercent = OTCron::GetCronRefillAmount() / 5;
-    if (GetTransactionCount() <= nTwentyPercent) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(
-            ": WARNING: Cron has fewer than 20 percent of its normal "
-            "transaction number count available since the previous round! "
-            "That is, ")(GetTransactionCount())(
-            " are currently available, with a max of ")(GetCronRefillAmount())(
-            ", meaning ")(GetCronRefillAmount() - GetTransactionCount())(
-            " were used in the last round alone!!! "
-            "SKIPPING THE CRON ITEMS THAT WERE SCHEDULED FOR THIS "
-            "ROUND!!!")
-            .Flush();
-        return;
-    }
     bool bNeedToSave = false;
 
-    // loop through the cron items and tell each one to ProcessCron().
-    // If the item returns true, that means leave it on the list. Otherwise,
-    // if it returns false, that means "it's done: remove it."
-    for (auto it = m_multimapCronItems.begin();
-         it != m_multimapCronItems.end();) {
+    // Process the due items in order. If an item returns true, that means
+    // reschedule it. Otherwise, if it returns false, that means "it's done:
+    // remove it."
+    while (m_pSchedule->Due()) {
         if (GetTransactionCount() <= nTwentyPercent) {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": WARNING: Cron has fewer than 20 percent of its normal "
-                "transaction "
-                "number count available since the previous cron item "
-                "alone! "
+                "transaction number count available! "
                 "That is, ")(GetTransactionCount())(
                 " are currently available, with a max of ")(
                 GetCronRefillAmount())(", meaning ")(
                 GetCronRefillAmount() - GetTransactionCount())(
-                " were used in the current round alone!!! "
-                "SKIPPING THE REMAINDER OF THE CRON ITEMS THAT WERE "
-                "SCHEDULED FOR THIS ROUND!!!")
+                " were used since the last refill!!! "
+                "DEFERRING THE CRON ITEMS THAT ARE DUE!!!")
                 .Flush();
+            m_pSchedule->Defer(now + GetCronMsBetweenProcess());
+
             break;
         }
-        auto pItem = it->second;
-        OT_ASSERT(false != bool(pItem));
+
+        const std::int64_t lTransactionNum = m_pSchedule->Next();
+        auto it_map = FindItemOnMap(lTransactionNum);
+        OT_ASSERT(m_mapCronItems.end() != it_map);
+        auto pItem = it_map->second;
         LogVerbose(OT_METHOD)(__FUNCTION__)(": Processing item number: ")(
-            pItem->GetTransactionNum())
+            lTransactionNum)
             .Flush();
 
         if (pItem->ProcessCron(reason)) {
-            it++;
+            m_pSchedule->Schedule(lTransactionNum, next_due(*pItem, now));
             continue;
         }
         pItem->HookRemovalFromCron(
             api_.Wallet(), nullptr, GetNextTransactionNumber(), reason);
         LogNormal(OT_METHOD)(__FUNCTION__)(": Removing cron item: ")(
-            pItem->GetTransactionNum())(".")
+            lTransactionNum)(".")
             .Flush();
-        it = m_multimapCronItems.erase(it);
-        auto it_map = FindItemOnMap(pItem->GetTransactionNum());
-        OT_ASSERT(m_mapCronItems.end() != it_map);
+        auto it_multimap = FindItemOnMultimap(lTransactionNum);
+        OT_ASSERT(m_multimapCronItems.end() != it_multimap);
+        m_pSchedule->Unschedule(lTransactionNum);
+        m_multimapCronItems.erase(it_multimap);
+        m_mapPositions.erase(lTransactionNum);
         m_mapCronItems.erase(it_map);
+        m_pSchedule->Removed();
 
         bNeedToSave = true;
     }
+
+    const bool bMore = m_pSchedule->EndSlice(
+        m_mapCronItems.size(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
+
+    if (false == bMore) {
+        const auto& round = m_pSchedule->LastRound();
+        LogDetail(OT_METHOD)(__FUNCTION__)(": Processed ")(round.processed_)(
+            " of ")(round.due_)(" due items in ")(round.slices_)(
+            " slices and ")(round.elapsed_.count())(" microseconds. Removed ")(
+            round.removed_)(", ")(round.scheduled_)(" remain.")
+            .Flush();
+    }
+
     if (bNeedToSave) SaveCron();
+
+    return bMore;
 }
 
 // OTCron IS responsible for cleaning up theItem, and takes ownership.
@@ -719,9 +753,12 @@ auto OTCron::AddCronItem(
 
         // Insert to the MULTIMAP (by Date)
         //
-        m_multimapCronItems.insert(
+        const auto it_multimap = m_multimapCronItems.insert(
             m_multimapCronItems.upper_bound(tDateAdded),
             std::pair<Time, std::shared_ptr<OTCronItem>>(tDateAdded, theItem));
+        m_mapPositions[theItem->GetTransactionNum()] = it_multimap;
+        // New items are processed in the next slice
+        m_pSchedule->Schedule(theItem->GetTransactionNum(), Clock::now());
 
         theItem->SetCronPointer(*this);
         theItem->setServerNym(m_pServerNym);
@@ -818,8 +855,10 @@ auto OTCron::RemoveCronItem(
         pItem->HookRemovalFromCron(
             api_.Wallet(), theRemover, GetNextTransactionNumber(), reason);
 
+        m_pSchedule->Unschedule(lTransactionNum);
         m_mapCronItems.erase(it_map);            // Remove from MAP.
         m_multimapCronItems.erase(it_multimap);  // Remove from MULTIMAP.
+        m_mapPositions.erase(lTransactionNum);
 
         // An item has been removed from Cron. SAVE.
         return SaveCron();
@@ -868,16 +907,13 @@ auto OTCron::FindItemOnMap(std::int64_t lTransactionNum)
 auto OTCron::FindItemOnMultimap(std::int64_t lTransactionNum)
     -> multimapOfCronItems::iterator
 {
-    auto itt = m_multimapCronItems.begin();
-
-    while (m_multimapCronItems.end() != itt) {
-        auto pItem = itt->second;
-        OT_ASSERT(false != bool(pItem));
+    auto it = m_mapPositions.find(lTransactionNum);
 
-        if (pItem->GetTransactionNum() == lTransactionNum) break;
+    if (m_mapPositions.end() == it) { return m_multimapCronItems.end(); }
 
-        ++itt;
-    }
+    auto itt = it->second;
+    OT_ASSERT(false != bool(itt->second));
+    OT_ASSERT(itt->second->GetTransactionNum() == lTransactionNum);
 
     return itt;
 }
@@ -1110,6 +1146,11 @@ auto OTCron::GetMarket(const Identifier& MARKET_ID) -> std::shared_ptr<OTMarket>
 
 void OTCron::InitCron() { m_strContractType = String::Factory("CRON"); }
 
+auto OTCron::LastRound() const -> const RoundStatistics&
+{
+    return m_pSchedule->LastRound();
+}
+
 void OTCron::Release() { Contract::Release(); }
 
 OTCron::~OTCron() { m_pServerNym = nullptr; }
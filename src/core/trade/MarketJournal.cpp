@@ -0,0 +1,283 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                  // IWYU pragma: associated
+#include "1_Internal.hpp"                // IWYU pragma: associated
+#include "core/trade/MarketJournal.hpp"  // IWYU pragma: associated
+
+#include <ctime>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#include "core/OTStorage.hpp"
+#include "internal/api/Api.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/Legacy.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/core/crypto/OTSignedFile.hpp"
+#include "opentxs/core/identifier/Nym.hpp"
+#include "opentxs/identity/Nym.hpp"
+
+#define OT_METHOD "opentxs::MarketJournal::"
+
+namespace opentxs
+{
+namespace
+{
+// The payload of a record is a line containing its type and numeric fields,
+// followed by the serialized offer if there is one
+auto parse(const std::string& payload, MarketJournal::Entry& output) noexcept
+    -> bool
+{
+    using Type = MarketJournal::Type;
+    auto stream = std::istringstream{payload};
+    auto type = int{};
+    auto date = std::int64_t{};
+    stream >> type >> output.transaction_ >> date >> output.price_ >>
+        output.amount_;
+
+    if (stream.fail() || ('\n' != stream.get())) { return false; }
+
+    switch (static_cast<Type>(type)) {
+        case Type::AddOffer:
+        case Type::RemoveOffer:
+        case Type::UpdateOffer:
+        case Type::Sale: {
+        } break;
+        default: {
+            return false;
+        }
+    }
+
+    output.type_ = static_cast<Type>(type);
+    output.date_ = Clock::from_time_t(static_cast<std::time_t>(date));
+    output.offer_.assign(
+        std::istreambuf_iterator<char>{stream},
+        std::istreambuf_iterator<char>{});
+
+    return true;
+}
+}  // namespace
+
+const std::size_t MarketJournal::snapshot_interval_{1000};
+
+MarketJournal::MarketJournal(
+    const api::internal::Core& api,
+    const Nym_p& signer,
+    const std::string& market) noexcept
+    : api_(api)
+    , signer_(signer)
+    , market_(market)
+    , sequence_(0)
+    , records_(0)
+    , writable_(false)
+{
+    OT_ASSERT(signer_);
+}
+
+auto MarketJournal::AddOffer(
+    const std::int64_t transaction,
+    const Time date,
+    const String& offer,
+    const PasswordPrompt& reason) noexcept -> bool
+{
+    return append(Type::AddOffer, transaction, date, 0, 0, offer.Get(), reason);
+}
+
+auto MarketJournal::append(
+    const Type type,
+    const std::int64_t transaction,
+    const Time date,
+    const std::int64_t price,
+    const std::int64_t amount,
+    const std::string& offer,
+    const PasswordPrompt& reason) noexcept -> bool
+{
+    if (false == writable_) { return false; }
+
+    auto payload = std::ostringstream{};
+    payload << static_cast<int>(type) << ' ' << transaction << ' '
+            << static_cast<std::int64_t>(Clock::to_time_t(date)) << ' '
+            << price << ' ' << amount << '\n'
+            << offer;
+    const auto name = filename(sequence_, records_);
+    auto pFile =
+        api_.Factory().SignedFile(api_.Legacy().Market(), name.c_str());
+
+    OT_ASSERT(pFile);
+
+    pFile->SetSignerNymID(String::Factory(signer_->ID()));
+    pFile->SetFilePayload(String::Factory(payload.str()));
+
+    if ((false == pFile->SignContract(*signer_, reason)) ||
+        (false == pFile->SaveContract()) || (false == pFile->SaveFile())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to write ")(name).Flush();
+        // The record may have been partially written
+        writable_ = false;
+
+        return false;
+    }
+
+    ++records_;
+
+    return true;
+}
+
+auto MarketJournal::erase(const std::uint64_t sequence) noexcept -> bool
+{
+    for (auto index = std::size_t{0};; ++index) {
+        const auto name = filename(sequence, index);
+
+        if (false == exists(name)) { return true; }
+
+        if (false == OTDB::EraseValueByKey(
+                         api_,
+                         api_.DataFolder(),
+                         api_.Legacy().Market(),
+                         name,
+                         "",
+                         "")) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to erase ")(name)
+                .Flush();
+
+            return false;
+        }
+    }
+}
+
+auto MarketJournal::exists(const std::string& filename) const noexcept -> bool
+{
+    return OTDB::Exists(
+        api_, api_.DataFolder(), api_.Legacy().Market(), filename, "", "");
+}
+
+auto MarketJournal::filename(
+    const std::uint64_t sequence,
+    const std::size_t index) const noexcept -> std::string
+{
+    return market_ + "." + std::to_string(sequence) + "." +
+           std::to_string(index) + ".jnl";
+}
+
+auto MarketJournal::load(const std::string& filename, Entry& output)
+    const noexcept -> bool
+{
+    auto pFile =
+        api_.Factory().SignedFile(api_.Legacy().Market(), filename.c_str());
+
+    OT_ASSERT(pFile);
+
+    if (false == pFile->LoadFile()) { return false; }
+
+    // The name inside the record must match the file it was loaded from
+    if (false == pFile->VerifyFile()) { return false; }
+
+    if (false == pFile->VerifySignature(*signer_)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid signature on ")(
+            filename)
+            .Flush();
+
+        return false;
+    }
+
+    return parse(pFile->GetFilePayload().Get(), output);
+}
+
+auto MarketJournal::NeedSnapshot() const noexcept -> bool
+{
+    return (false == writable_) || (records_ >= snapshot_interval_);
+}
+
+auto MarketJournal::Read(
+    const std::uint64_t sequence,
+    std::vector<Entry>& output) noexcept -> bool
+{
+    output.clear();
+    sequence_ = sequence;
+    records_ = 0;
+    writable_ = false;
+
+    for (auto index = std::size_t{0};; ++index) {
+        const auto name = filename(sequence, index);
+
+        if (false == exists(name)) { break; }
+
+        auto entry = Entry{};
+
+        if (load(name, entry)) {
+            output.emplace_back(std::move(entry));
+
+            continue;
+        }
+
+        if (exists(filename(sequence, index + 1))) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid journal record ")(
+                name)
+                .Flush();
+            output.clear();
+
+            return false;
+        }
+
+        // Only the last record can have been interrupted while it was being
+        // written. No records may follow it until the next snapshot.
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Ignoring incomplete record ")(
+            name)
+            .Flush();
+        records_ = output.size();
+
+        return true;
+    }
+
+    records_ = output.size();
+    writable_ = true;
+
+    return true;
+}
+
+auto MarketJournal::RemoveOffer(
+    const std::int64_t transaction,
+    const PasswordPrompt& reason) noexcept -> bool
+{
+    return append(Type::RemoveOffer, transaction, Time{}, 0, 0, {}, reason);
+}
+
+auto MarketJournal::Reset(const std::uint64_t sequence) noexcept -> bool
+{
+    if (0 < sequence) { erase(sequence - 1); }
+
+    sequence_ = sequence;
+    records_ = 0;
+    // Records left over from a snapshot which was since restored must not
+    // become part of this journal
+    writable_ = erase(sequence);
+
+    return writable_;
+}
+
+auto MarketJournal::Sale(
+    const std::int64_t transaction,
+    const Time date,
+    const std::int64_t price,
+    const std::int64_t amount,
+    const PasswordPrompt& reason) noexcept -> bool
+{
+    return append(Type::Sale, transaction, date, price, amount, {}, reason);
+}
+
+auto MarketJournal::UpdateOffer(
+    const std::int64_t transaction,
+    const String& offer,
+    const PasswordPrompt& reason) noexcept -> bool
+{
+    return append(
+        Type::UpdateOffer, transaction, Time{}, 0, 0, offer.Get(), reason);
+}
+}  // namespace opentxs
@@ -0,0 +1,135 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "opentxs/Types.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+namespace internal
+{
+struct Core;
+}  // namespace internal
+}  // namespace api
+
+class PasswordPrompt;
+class String;
+}  // namespace opentxs
+
+namespace opentxs
+{
+// Record of the changes made to an OTMarket's order book since the market
+// file was last written. The market file acts as a snapshot: loading it and
+// replaying the journal reproduces the current book.
+//
+// Each record is a separate file in the markets folder, signed by the server
+// nym and named after the market, the sequence number of the snapshot it
+// follows, and its position in the journal. Records are written and read
+// through OTDB, and a signed record can not be moved to another market,
+// snapshot or position without invalidating it.
+class MarketJournal
+{
+public:
+    enum class Type : std::uint8_t {
+        AddOffer = 1,
+        RemoveOffer = 2,
+        UpdateOffer = 3,
+        Sale = 4,
+    };
+
+    struct Entry {
+        Type type_{};
+        std::int64_t transaction_{};
+        Time date_{};
+        std::int64_t price_{};
+        std::int64_t amount_{};
+        // Serialized offer, for AddOffer and UpdateOffer
+        std::string offer_{};
+    };
+
+    // Number of records after which the market should be written in full
+    static const std::size_t snapshot_interval_;
+
+    // True if the journal can not accept records until the next Reset(),
+    // or if enough records have accumulated that a snapshot should be taken
+    auto NeedSnapshot() const noexcept -> bool;
+    auto Records() const noexcept -> std::size_t { return records_; }
+
+    auto AddOffer(
+        const std::int64_t transaction,
+        const Time date,
+        const String& offer,
+        const PasswordPrompt& reason) noexcept -> bool;
+    // Loads the records which follow the snapshot with the specified sequence
+    // number. Returns false if any record fails to verify or parse, except
+    // that a last record which was interrupted while being written is
+    // ignored.
+    auto Read(const std::uint64_t sequence, std::vector<Entry>& output) noexcept
+        -> bool;
+    auto RemoveOffer(
+        const std::int64_t transaction,
+        const PasswordPrompt& reason) noexcept -> bool;
+    // Erases the records of the previous snapshot and begins a journal for a
+    // new one
+    auto Reset(const std::uint64_t sequence) noexcept -> bool;
+    auto Sale(
+        const std::int64_t transaction,
+        const Time date,
+        const std::int64_t price,
+        const std::int64_t amount,
+        const PasswordPrompt& reason) noexcept -> bool;
+    auto UpdateOffer(
+        const std::int64_t transaction,
+        const String& offer,
+        const PasswordPrompt& reason) noexcept -> bool;
+
+    MarketJournal(
+        const api::internal::Core& api,
+        const Nym_p& signer,
+        const std::string& market) noexcept;
+
+    ~MarketJournal() = default;
+
+private:
+    const api::internal::Core& api_;
+    const Nym_p signer_;
+    const std::string market_;
+    std::uint64_t sequence_;
+    std::size_t records_;
+    // Set when every record of the current snapshot has been read or written
+    // successfully
+    bool writable_;
+
+    auto exists(const std::string& filename) const noexcept -> bool;
+    auto filename(const std::uint64_t sequence, const std::size_t index)
+        const noexcept -> std::string;
+    auto load(const std::string& filename, Entry& output) const noexcept
+        -> bool;
+
+    auto append(
+        const Type type,
+        const std::int64_t transaction,
+        const Time date,
+        const std::int64_t price,
+        const std::int64_t amount,
+        const std::string& offer,
+        const PasswordPrompt& reason) noexcept -> bool;
+    auto erase(const std::uint64_t sequence) noexcept -> bool;
+
+    MarketJournal() = delete;
+    MarketJournal(const MarketJournal&) = delete;
+    MarketJournal(MarketJournal&&) = delete;
+    auto operator=(const MarketJournal&) -> MarketJournal& = delete;
+    auto operator=(MarketJournal&&) -> MarketJournal& = delete;
+};
+}  // namespace opentxs
@@ -10,13 +10,18 @@
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
+#include <ctime>
+#include <functional>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/OTStorage.hpp"
+#include "core/trade/MarketJournal.hpp"
 #include "internal/api/Api.hpp"
 #include "opentxs/Exclusive.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -55,6 +60,19 @@ OTMarket::OTMarket(const api::internal::Core& core, const char* szFilename)
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
+    , m_mapOfferPositions()
+    , m_mapBidLevels()
+    , m_mapAskLevels()
+    , m_lAskVolume(0)
+    , m_lockCache()
+    , m_lOfferListDepth(-1)
+    , m_nOfferListCount(0)
+    , m_strOfferList()
+    , m_bTradeListCached(false)
+    , m_nTradeListCount(0)
+    , m_strTradeList()
+    , m_pJournal()
+    , m_lJournalSequence(0)
     , m_NOTARY_ID(identifier::Server::Factory())
     , m_INSTRUMENT_DEFINITION_ID(identifier::UnitDefinition::Factory())
     , m_CURRENCY_TYPE_ID(identifier::UnitDefinition::Factory())
@@ -76,6 +94,19 @@ OTMarket::OTMarket(const api::internal::Core& core)
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
+    , m_mapOfferPositions()
+    , m_mapBidLevels()
+    , m_mapAskLevels()
+    , m_lAskVolume(0)
+    , m_lockCache()
+    , m_lOfferListDepth(-1)
+    , m_nOfferListCount(0)
+    , m_strOfferList()
+    , m_bTradeListCached(false)
+    , m_nTradeListCount(0)
+    , m_strTradeList()
+    , m_pJournal()
+    , m_lJournalSequence(0)
     , m_NOTARY_ID(identifier::Server::Factory())
     , m_INSTRUMENT_DEFINITION_ID(identifier::UnitDefinition::Factory())
     , m_CURRENCY_TYPE_ID(identifier::UnitDefinition::Factory())
@@ -98,6 +129,19 @@ OTMarket::OTMarket(
     , m_mapBids()
     , m_mapAsks()
     , m_mapOffers()
+    , m_mapOfferPositions()
+    , m_mapBidLevels()
+    , m_mapAskLevels()
+    , m_lAskVolume(0)
+    , m_lockCache()
+    , m_lOfferListDepth(-1)
+    , m_nOfferListCount(0)
+    , m_strOfferList()
+    , m_bTradeListCached(false)
+    , m_nTradeListCount(0)
+    , m_strTradeList()
+    , m_pJournal()
+    , m_lJournalSequence(0)
     , m_NOTARY_ID(NOTARY_ID)
     , m_INSTRUMENT_DEFINITION_ID(INSTRUMENT_DEFINITION_ID)
     , m_CURRENCY_TYPE_ID(CURRENCY_TYPE_ID)
@@ -130,6 +174,12 @@ auto OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
         m_lLastSalePrice =
             String::StringToLong(xml->getAttributeValue("lastSalePrice"));
         m_strLastSaleDate = xml->getAttributeValue("lastSaleDate");
+        const auto strJournalSequence =
+            String::Factory(xml->getAttributeValue("journalSequence"));
+        m_lJournalSequence =
+            strJournalSequence->Exists()
+                ? String::StringToUlong(strJournalSequence->Get())
+                : 0;
 
         const auto strNotaryID =
                        String::Factory(xml->getAttributeValue("notaryID")),
@@ -167,24 +217,16 @@ auto OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                 .Flush();
             return (-1);  // error condition
         } else {
-            auto pOffer{api_.Factory().Offer(
-                m_NOTARY_ID,
-                m_INSTRUMENT_DEFINITION_ID,
-                m_CURRENCY_TYPE_ID,
-                m_lScale)};
-
-            OT_ASSERT(false != bool(pOffer));
-
-            OTOffer* offer = pOffer.release();
+            auto pOffer = load_offer(strData);
             // TODO this isn't actually used. Refactor AddOffer into two
             // functions so it's no longer required to pass a PasswordPrompt
             // if the offer will not be saved
             auto reason = api_.Factory().PasswordPrompt(__FUNCTION__);
 
-            if (pOffer->LoadContractFromString(strData) &&
-                AddOffer(nullptr, *offer, reason, false, lDateAdded))
+            if (pOffer && AddOffer(nullptr, *pOffer, reason, false, lDateAdded))
             // bSaveMarket = false (Don't SAVE -- we're loading right now!)
             {
+                pOffer.release();  // The market owns it now.
                 LogDetail(OT_METHOD)(__FUNCTION__)(
                     ": Successfully loaded offer and added to market.")
                     .Flush();
@@ -192,8 +234,6 @@ auto OTMarket::ProcessXMLNode(irr::io::IrrXMLReader*& xml) -> std::int32_t
                 LogOutput(OT_METHOD)(__FUNCTION__)(
                     ": Error adding offer to market while loading market.")
                     .Flush();
-                delete offer;
-                offer = nullptr;
                 return (-1);
             }
         }
@@ -224,6 +264,7 @@ void OTMarket::UpdateContents(const PasswordPrompt& reason)
     tag.add_attribute("marketScale", std::to_string(m_lScale));
     tag.add_attribute("lastSaleDate", m_strLastSaleDate);
     tag.add_attribute("lastSalePrice", std::to_string(m_lLastSalePrice));
+    tag.add_attribute("journalSequence", std::to_string(m_lJournalSequence));
 
     // Save the offers for sale.
     for (auto& it : m_mapAsks) {
@@ -265,16 +306,7 @@ void OTMarket::UpdateContents(const PasswordPrompt& reason)
 
 auto OTMarket::GetTotalAvailableAssets() -> std::int64_t
 {
-    std::int64_t lTotal = 0;
-
-    for (auto& it : m_mapAsks) {
-        OTOffer* pOffer = it.second;
-        OT_ASSERT(nullptr != pOffer);
-
-        lTotal += pOffer->GetAmountAvailable();
-    }
-
-    return lTotal;
+    return m_lAskVolume;
 }
 
 // Get list of offers for a particular Nym, to send that Nym
@@ -396,6 +428,16 @@ auto OTMarket::GetRecentTradeList(Armored& ascOutput, std::int32_t& nTradeCount)
         // is empty.
     }
 
+    Lock lock(m_lockCache);
+
+    if (m_bTradeListCached) {
+        nTradeCount = m_nTradeListCount;
+
+        if (0 < nTradeCount) { ascOutput.Set(m_strTradeList.c_str()); }
+
+        return true;
+    }
+
     // The market already keeps a list of recent trades (informational only)
     //
 
@@ -437,6 +479,9 @@ auto OTMarket::GetRecentTradeList(Armored& ascOutput, std::int32_t& nTradeCount)
             // This function will base64 ENCODE theData,
             // and then Set() that as the string contents.
             ascOutput.SetData(theData);
+            m_strTradeList = ascOutput.Get();
+            m_nTradeListCount = nTradeCount;
+            m_bTradeListCached = true;
 
             return true;
         } else
@@ -462,6 +507,17 @@ auto OTMarket::GetOfferList(
 
     if (0 == lDepth) lDepth = MAX_MARKET_QUERY_DEPTH;
 
+    Lock lock(m_lockCache);
+
+    // Nothing has changed since this list was last requested
+    if (lDepth == m_lOfferListDepth) {
+        nOfferCount = m_nOfferListCount;
+
+        if (0 < nOfferCount) { ascOutput.Set(m_strOfferList.c_str()); }
+
+        return true;
+    }
+
     // Loop through the offers, up to some maximum depth, and then add each
     // as a data member to an offer list, then pack it into ascOutput.
 
@@ -544,8 +600,13 @@ auto OTMarket::GetOfferList(
 
     // Now pack the list into strOutput...
 
-    if (nOfferCount == 0)
+    if (nOfferCount == 0) {
+        m_lOfferListDepth = lDepth;
+        m_nOfferListCount = 0;
+        m_strOfferList.clear();
+
         return true;  // Success, but there were zero offers found.
+    }
 
     if (nOfferCount > 0) {
         OTDB::Storage* pStorage = OTDB::GetDefaultStorage();
@@ -576,6 +637,9 @@ auto OTMarket::GetOfferList(
             // This function will base64 ENCODE theData,
             // and then Set() that as the string contents.
             ascOutput.SetData(theData);
+            m_lOfferListDepth = lDepth;
+            m_nOfferListCount = nOfferCount;
+            m_strOfferList = ascOutput.Get();
 
             return true;
         } else
@@ -634,88 +698,89 @@ auto OTMarket::RemoveOffer(
     const std::int64_t& lTransactionNum,
     const PasswordPrompt& reason) -> bool
 {
-    bool bReturnValue = false;
-
-    // See if there's something there with that transaction number.
-    auto it = m_mapOffers.find(lTransactionNum);
-
     // If it's not already on the list, then there's nothing to remove.
-    if (it == m_mapOffers.end()) {
+    if (false == bool(remove_offer(lTransactionNum))) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
             ": Attempt to remove non-existent Offer from Market. "
             "Transaction #: ")(lTransactionNum)(".")
             .Flush();
         return false;
     }
-    // Otherwise, if it WAS already there, remove it properly.
-    else {
-        OTOffer* pOffer = it->second;
 
-        OT_ASSERT(nullptr != pOffer);
+    // <====== SAVE since an offer was removed.
+    return record(
+        [&](auto& journal) {
+            return journal.RemoveOffer(lTransactionNum, reason);
+        },
+        reason);
+}
 
-        // This removes it from one list (the one indexed by transaction
-        // number.)
-        // But it's still on one of the other lists...
-        m_mapOffers.erase(it);
+auto OTMarket::remove_offer(const std::int64_t lTransactionNum)
+    -> std::unique_ptr<OTOffer>
+{
+    auto it = m_mapOffers.find(lTransactionNum);
 
-        // The code operates the same whether ask or bid. Just use a pointer.
-        mapOfOffers* pMap = (pOffer->IsBid() ? &m_mapBids : &m_mapAsks);
+    if (it == m_mapOffers.end()) { return {}; }
 
-        // Future solution here: instead of looping through all the offers and
-        // finding it,
-        // I could just have each Offer store a copy of the iterator that's
-        // returned when
-        // it's first inserted. Later I just erase that iterator from the right
-        // list to remove. Todo.
-        OTOffer* pSameOffer = nullptr;
+    auto pOffer = std::unique_ptr<OTOffer>{it->second};
 
-        for (auto iii = pMap->begin(); iii != pMap->end(); ++iii) {
-            pSameOffer = iii->second;
+    OT_ASSERT(pOffer);
 
-            OT_ASSERT_MSG(
-                nullptr != pSameOffer,
-                "nullptr offer pointer in OTMarket::RemoveOffer.\n");
+    update_level(*pOffer, -pOffer->GetAmountAvailable(), -1);
+    book_changed();
 
-            // found it!
-            if (lTransactionNum == pSameOffer->GetTransactionNum()) {
-                pMap->erase(iii);
-                break;
-            }
+    // This removes it from one list (the one indexed by transaction
+    // number.) But it's still on one of the other lists...
+    m_mapOffers.erase(it);
+    auto position = m_mapOfferPositions.find(lTransactionNum);
 
-            // Later on, below this loop, this pointer will be nullptr or not,
-            // and
-            // I will know if it was removed.
-            pSameOffer = nullptr;
-        }
+    OT_ASSERT(m_mapOfferPositions.end() != position);
+    OT_ASSERT(pOffer.get() == position->second->second);
 
-        if (nullptr == pSameOffer) {
-            LogOutput(OT_METHOD)(__FUNCTION__)(
-                ": Removed offer from offers list, but not found on bid/ask "
-                "list.")
-                .Flush();
-        } else  // This means it was found and removed from the second list as
-                // well.
-        {
-            bReturnValue = true;  // Success.
-        }
+    // The code operates the same whether ask or bid.
+    auto& map = (pOffer->IsBid() ? m_mapBids : m_mapAsks);
+    map.erase(position->second);
+    m_mapOfferPositions.erase(position);
 
-        // pOffer was found on the Offers list.
-        // pSameOffer was found on the Bid or Ask list, with the same
-        // transaction ID.
-        // They SHOULD be pointers to the SAME object.
-        // Therefore I CANNOT delete them both.
-        //
-        OT_ASSERT(pOffer == pSameOffer);
+    return pOffer;
+}
 
-        delete pOffer;
-        pOffer = nullptr;
-        pSameOffer = nullptr;
+auto OTMarket::replace_offer(std::unique_ptr<OTOffer> pOffer) -> bool
+{
+    OT_ASSERT(pOffer);
+
+    const auto lTransactionNum = pOffer->GetTransactionNum();
+    auto it = m_mapOffers.find(lTransactionNum);
+    auto position = m_mapOfferPositions.find(lTransactionNum);
+
+    if ((m_mapOffers.end() == it) ||
+        (m_mapOfferPositions.end() == position)) {
+        return false;
     }
 
-    if (bReturnValue)
-        return SaveMarket(reason);  // <====== SAVE since an offer was removed.
-    else
+    auto pExisting = std::unique_ptr<OTOffer>{it->second};
+
+    // The replacement keeps the existing offer's place in line
+    if ((pExisting->IsBid() != pOffer->IsBid()) ||
+        (position->second->first != pOffer->GetPriceLimit())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Offer ")(lTransactionNum)(
+            " changed price or side.")
+            .Flush();
+        pExisting.release();
+
         return false;
+    }
+
+    pOffer->SetDateAddedToMarket(pExisting->GetDateAddedToMarket());
+    update_level(
+        *pExisting,
+        pOffer->GetAmountAvailable() - pExisting->GetAmountAvailable(),
+        0);
+    book_changed();
+    it->second = pOffer.get();
+    position->second->second = pOffer.release();
+
+    return true;
 }
 
 // This method demands an Offer reference in order to verify that it really
@@ -780,7 +845,7 @@ auto OTMarket::AddOffer(
             // No bother checking if the offer is already on this list,
             // since the code above basically already verifies that for us.
 
-            m_mapBids.insert(
+            m_mapOfferPositions[lTransactionNum] = m_mapBids.insert(
                 m_mapBids.lower_bound(lPriceLimit),  // highest bidders go
                                                      // first, so I am last in
                                                      // line at lower bound.
@@ -789,7 +854,7 @@ auto OTMarket::AddOffer(
                 "Offer added as a bid to the market.")
                 .Flush();
         } else {
-            m_mapAsks.insert(
+            m_mapOfferPositions[lTransactionNum] = m_mapAsks.insert(
                 m_mapAsks.upper_bound(lPriceLimit),  // lowest price sells
                                                      // first, so I am last in
                                                      // line at upper bound.
@@ -799,14 +864,25 @@ auto OTMarket::AddOffer(
                 .Flush();
         }
 
+        update_level(theOffer, theOffer.GetAmountAvailable(), 1);
+        book_changed();
+
         if (bSaveFile) {
             // Set this to the current date/time, since the offer is
             // being added for the first time.
             //
             theOffer.SetDateAddedToMarket(Clock::now());
 
-            return SaveMarket(reason);  // <====== SAVE since an offer
-                                        // was added to the Market.
+            // <====== SAVE since an offer was added to the Market.
+            return record(
+                [&](auto& journal) {
+                    return journal.AddOffer(
+                        lTransactionNum,
+                        theOffer.GetDateAddedToMarket(),
+                        String::Factory(theOffer),
+                        reason);
+                },
+                reason);
         } else {
             // Set this to the date passed in, since this offer was
             // added to the market in the past, and we are preserving that date.
@@ -824,6 +900,42 @@ auto OTMarket::LoadMarket() -> bool
     OT_ASSERT(nullptr != GetCron());
     OT_ASSERT(nullptr != GetCron()->GetServerNym());
 
+    if (false == load_snapshot()) { return false; }
+
+    // Apply the changes made since the market file was written.
+    auto reason = api_.Factory().PasswordPrompt(__FUNCTION__);
+
+    if (replay_journal(reason)) { return true; }
+
+    // Nothing from the journal can be trusted, including whatever part of it
+    // was already applied. The journal is discarded by the next snapshot,
+    // which is taken as soon as the book changes.
+    LogOutput(OT_METHOD)(__FUNCTION__)(
+        ": Discarding the market journal and using the market file alone.")
+        .Flush();
+
+    return load_snapshot();
+}
+
+auto OTMarket::journal() -> MarketJournal*
+{
+    if (m_pJournal) { return m_pJournal.get(); }
+
+    // Records are signed by the server nym, like the market file
+    if ((nullptr == GetCron()) || (false == bool(GetCron()->GetServerNym()))) {
+        return nullptr;
+    }
+
+    m_pJournal = std::make_unique<MarketJournal>(
+        api_,
+        GetCron()->GetServerNym(),
+        String::Factory(Identifier::Factory(*this))->Get());
+
+    return m_pJournal.get();
+}
+
+auto OTMarket::load_snapshot() -> bool
+{
     auto MARKET_ID = Identifier::Factory(*this);
     auto str_MARKET_ID = String::Factory(MARKET_ID);
 
@@ -842,6 +954,8 @@ auto OTMarket::LoadMarket() -> bool
     if (bSuccess) {
         if (nullptr != m_pTradeList) delete m_pTradeList;
 
+        trades_changed();
+
         auto str_TRADES_FILE = String::Factory();
         str_TRADES_FILE->Format("%s.bin", str_MARKET_ID->Get());
 
@@ -860,6 +974,162 @@ auto OTMarket::LoadMarket() -> bool
     return bSuccess;
 }
 
+auto OTMarket::load_offer(const String& strOffer) const
+    -> std::unique_ptr<OTOffer>
+{
+    auto pOffer{api_.Factory().Offer(
+        m_NOTARY_ID, m_INSTRUMENT_DEFINITION_ID, m_CURRENCY_TYPE_ID, m_lScale)};
+
+    OT_ASSERT(false != bool(pOffer));
+
+    if (false == pOffer->LoadContractFromString(strOffer)) { return {}; }
+
+    return pOffer;
+}
+
+// Writes a single change to the journal. The whole market is saved instead if
+// the journal is unavailable or has grown long enough to warrant a snapshot.
+auto OTMarket::record(
+    const std::function<bool(MarketJournal&)>& write,
+    const PasswordPrompt& reason) -> bool
+{
+    auto* pJournal = journal();
+
+    if ((nullptr == pJournal) || pJournal->NeedSnapshot() ||
+        (false == write(*pJournal))) {
+        return SaveMarket(reason);
+    }
+
+    return true;
+}
+
+// Adds a trade to the list of the most recent trades.
+void OTMarket::record_sale(
+    const std::int64_t lTransactionNum,
+    const Time tDate,
+    const std::int64_t lPrice,
+    const std::int64_t lAmountSold)
+{
+    if (nullptr == m_pTradeList) {
+        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_LIST_MARKET));
+    }
+
+    std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
+        dynamic_cast<OTDB::TradeDataMarket*>(
+            OTDB::CreateObject(OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
+
+    pTradeData->transaction_id = std::to_string(lTransactionNum);
+    pTradeData->date = std::to_string(Clock::to_time_t(tDate));
+    pTradeData->price = std::to_string(lPrice);
+    pTradeData->amount_sold = std::to_string(lAmountSold);
+
+    m_strLastSaleDate = pTradeData->date;
+    trades_changed();
+
+    // *pTradeData is CLONED at this time (I'm still responsible to delete.)
+    // That's also why I add it here, after all the above: So the data is set
+    // right BEFORE the cloning occurs.
+    m_pTradeList->AddTradeDataMarket(*pTradeData);
+
+    // Here we erase the oldest elements so the list never exceeds 50 elements
+    // total.
+    while (m_pTradeList->GetTradeDataMarketCount() > MAX_MARKET_QUERY_DEPTH)
+        m_pTradeList->RemoveTradeDataMarket(0);
+}
+
+auto OTMarket::replay_journal(const PasswordPrompt& reason) -> bool
+{
+    auto* pJournal = journal();
+
+    if (nullptr == pJournal) { return true; }
+
+    auto entries = std::vector<MarketJournal::Entry>{};
+
+    if (false == pJournal->Read(m_lJournalSequence, entries)) { return false; }
+
+    const auto& serverNym = *(GetCron()->GetServerNym());
+    // Offers are signed by the server before they are journaled
+    auto load = [&](const MarketJournal::Entry& entry) {
+        auto pOffer = load_offer(String::Factory(entry.offer_));
+
+        if (pOffer && (pOffer->GetTransactionNum() == entry.transaction_) &&
+            pOffer->VerifySignature(serverNym)) {
+            return pOffer;
+        }
+
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid offer ")(
+            entry.transaction_)(" in market journal.")
+            .Flush();
+
+        return std::unique_ptr<OTOffer>{};
+    };
+
+    for (const auto& entry : entries) {
+        using Type = MarketJournal::Type;
+        auto bValid{true};
+
+        switch (entry.type_) {
+            case Type::AddOffer: {
+                auto pOffer = load(entry);
+                bValid = pOffer &&
+                         AddOffer(nullptr, *pOffer, reason, false, entry.date_);
+
+                if (bValid) { pOffer.release(); }  // The market owns it now.
+            } break;
+            case Type::RemoveOffer: {
+                bValid = bool(remove_offer(entry.transaction_));
+            } break;
+            case Type::UpdateOffer: {
+                auto pOffer = load(entry);
+
+                if (false == bool(pOffer)) {
+                    bValid = false;
+                } else if (false == replace_offer(std::move(pOffer))) {
+                    // The offer moved to a different price level, so it
+                    // goes to the back of the line at its new price.
+                    auto pExisting = remove_offer(entry.transaction_);
+                    pOffer = load(entry);
+                    bValid = pExisting && pOffer &&
+                             AddOffer(
+                                 nullptr,
+                                 *pOffer,
+                                 reason,
+                                 false,
+                                 pExisting->GetDateAddedToMarket());
+
+                    if (bValid) { pOffer.release(); }
+                }
+            } break;
+            case Type::Sale: {
+                m_lLastSalePrice = entry.price_;
+                record_sale(
+                    entry.transaction_,
+                    entry.date_,
+                    entry.price_,
+                    entry.amount_);
+            } break;
+            default: {
+                bValid = false;
+            }
+        }
+
+        if (false == bValid) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Market journal does not match the market file.")
+                .Flush();
+
+            return false;
+        }
+    }
+
+    LogDetail(OT_METHOD)(__FUNCTION__)(": Replayed ")(entries.size())(
+        " journal records.")
+        .Flush();
+
+    return true;
+}
+
 auto OTMarket::SaveMarket(const PasswordPrompt& reason) -> bool
 {
     OT_ASSERT(nullptr != GetCron());
@@ -878,6 +1148,9 @@ auto OTMarket::SaveMarket(const PasswordPrompt& reason) -> bool
     // the old version of the market from before the most recent changes.
     ReleaseSignatures();
 
+    // The journal for the previous snapshot must not be applied to this one.
+    ++m_lJournalSequence;
+
     // Sign it, save it internally to string, and then save that out to the
     // file.
     if (!SignContract(*(GetCron()->GetServerNym()), reason) ||
@@ -885,9 +1158,17 @@ auto OTMarket::SaveMarket(const PasswordPrompt& reason) -> bool
         LogOutput(OT_METHOD)(__FUNCTION__)(": Error saving Market: ")(
             szFoldername)(PathSeparator())(szFilename)(".")
             .Flush();
+        --m_lJournalSequence;
+
         return false;
     }
 
+    // If this fails every change will be written as a full snapshot until a
+    // new journal can be created.
+    if (auto* pJournal = journal(); nullptr != pJournal) {
+        pJournal->Reset(m_lJournalSequence);
+    }
+
     // Save a copy of recent trades.
 
     if (nullptr != m_pTradeList) {
@@ -941,44 +1222,69 @@ void OTMarket::GetIdentifier(Identifier& theIdentifier) const
 // bid on the market.
 auto OTMarket::GetHighestBidPrice() -> std::int64_t
 {
-    std::int64_t lPrice = 0;
+    auto rr = m_mapBidLevels.rbegin();
 
-    auto rr = m_mapBids.rbegin();
+    return (m_mapBidLevels.rend() == rr) ? 0 : rr->first;
+}
+
+auto OTMarket::GetLowestAskPrice() -> std::int64_t
+{
+    auto it = m_mapAskLevels.begin();
 
-    if (rr != m_mapBids.rend()) { lPrice = rr->first; }
+    // Market orders have a 0 price, so we need to skip them if they are here.
+    //
+    // Note that we don't have to do this with the highest bid price (above
+    // function) but in the case of asks, a "0 price" will undercut the other
+    // actual prices.
+    if ((m_mapAskLevels.end() != it) && (0 == it->first)) { ++it; }
 
-    return lPrice;
+    return (m_mapAskLevels.end() == it) ? 0 : it->first;
 }
 
-// returns 0 if there are no asks. Otherwise returns the value of the lowest ask
-// on the market.
-auto OTMarket::GetLowestAskPrice() -> std::int64_t
+void OTMarket::book_changed()
 {
-    std::int64_t lPrice = 0;
+    Lock lock(m_lockCache);
+    m_lOfferListDepth = -1;
+    m_strOfferList.clear();
+}
 
-    auto it = m_mapAsks.begin();
+void OTMarket::trades_changed()
+{
+    Lock lock(m_lockCache);
+    m_bTradeListCached = false;
+    m_nTradeListCount = 0;
+    m_strTradeList.clear();
+}
 
-    if (it != m_mapAsks.end()) {
-        lPrice = it->first;
+auto OTMarket::level_volume(
+    const mapOfPriceLevels& levels,
+    const std::int64_t lPrice) const -> std::int64_t
+{
+    auto it = levels.find(lPrice);
 
-        // Market orders have a 0 price, so we need to skip any if they are
-        // here.
-        //
-        // Note that we don't have to do this with the highest bid price (above
-        // function) but in the case of asks, a "0 price" will undercut the
-        // other
-        // actual prices, so we need to skip any that have a 0 price.
-        //
-        while (0 == lPrice) {
-            ++it;
+    return (levels.end() == it) ? 0 : it->second.volume_;
+}
 
-            if (it == m_mapAsks.end()) break;
+void OTMarket::update_level(
+    OTOffer& theOffer,
+    const std::int64_t lVolume,
+    const std::int64_t lCount)
+{
+    auto it = m_mapOffers.find(theOffer.GetTransactionNum());
 
-            lPrice = it->first;
-        }
-    }
+    // Offers which are not on this market have no level to update
+    if ((m_mapOffers.end() == it) || (&theOffer != it->second)) { return; }
+
+    const auto lPrice = theOffer.GetPriceLimit();
+    auto& levels = theOffer.IsBid() ? m_mapBidLevels : m_mapAskLevels;
+    auto& level = levels[lPrice];
+    level.volume_ += lVolume;
+    level.count_ = static_cast<std::size_t>(
+        static_cast<std::int64_t>(level.count_) + lCount);
 
-    return lPrice;
+    if (theOffer.IsAsk()) { m_lAskVolume += lVolume; }
+
+    if (0 == level.count_) { levels.erase(lPrice); }
 }
 
 // This utility function is used directly below (only).
@@ -1871,6 +2177,9 @@ void OTMarket::ProcessTrade(
                 theOtherOffer.IncrementFinishedSoFar(
                     lOtherOfferFinished);  // I was storing these up in
                                            // the loop above.
+                update_level(theOffer, -lOfferFinished, 0);
+                update_level(theOtherOffer, -lOtherOfferFinished, 0);
+                book_changed();
 
                 // These have updated values, so let's save them.
                 theTrade.ReleaseSignatures();
@@ -1894,54 +2203,36 @@ void OTMarket::ProcessTrade(
 
                 // Here we save this trade in a list of the most recent
                 // 50 trades.
-                {
-                    if (nullptr == m_pTradeList) {
-                        m_pTradeList = dynamic_cast<OTDB::TradeListMarket*>(
-                            OTDB::CreateObject(
-                                OTDB::STORED_OBJ_TRADE_LIST_MARKET));
-                    }
-
-                    std::unique_ptr<OTDB::TradeDataMarket> pTradeData(
-                        dynamic_cast<OTDB::TradeDataMarket*>(OTDB::CreateObject(
-                            OTDB::STORED_OBJ_TRADE_DATA_MARKET)));
-
-                    const std::int64_t& lTransactionNum =
-                        theOffer.GetTransactionNum();
-                    const auto theDate = Clock::now();
-                    const std::int64_t& lPriceLimit =
-                        theOtherOffer.GetPriceLimit();  // Priced per
-                                                        // scale.
-                    const std::int64_t& lAmountSold = lOfferFinished;
-
-                    pTradeData->transaction_id =
-                        std::to_string(lTransactionNum);
-                    pTradeData->date =
-                        std::to_string(Clock::to_time_t(theDate));
-                    pTradeData->price = std::to_string(lPriceLimit);
-                    pTradeData->amount_sold = std::to_string(lAmountSold);
-
-                    m_strLastSaleDate = pTradeData->date;
-
-                    // *pTradeData is CLONED at this time (I'm still
-                    // responsible to delete.) That's also why I add it
-                    // here, after all the above: So the data is set
-                    // right BEFORE the cloning occurs.
-                    //
-                    m_pTradeList->AddTradeDataMarket(*pTradeData);
-
-                    // Here we erase the oldest elements so the list
-                    // never exceeds 50 elements total.
-                    //
-                    while (m_pTradeList->GetTradeDataMarketCount() >
-                           MAX_MARKET_QUERY_DEPTH)
-                        m_pTradeList->RemoveTradeDataMarket(0);
-                }
+                const auto lTransactionNum = theOffer.GetTransactionNum();
+                const auto theDate = Clock::now();
+                record_sale(
+                    lTransactionNum,
+                    theDate,
+                    m_lLastSalePrice,
+                    lOfferFinished);
 
                 // Account balances have changed based on these trades
                 // that we just processed. Make sure to save the Market
                 // since it contains those offers that have just
                 // updated.
-                SaveMarket(reason);
+                record(
+                    [&](auto& journal) {
+                        return journal.UpdateOffer(
+                                   lTransactionNum,
+                                   String::Factory(theOffer),
+                                   reason) &&
+                               journal.UpdateOffer(
+                                   theOtherOffer.GetTransactionNum(),
+                                   String::Factory(theOtherOffer),
+                                   reason) &&
+                               journal.Sale(
+                                   lTransactionNum,
+                                   theDate,
+                                   m_lLastSalePrice,
+                                   lOfferFinished,
+                                   reason);
+                    },
+                    reason);
 
                 // The Trade has changed, and it is stored as a
                 // CronItem. So I save Cron as well, for the same reason
@@ -2461,6 +2752,18 @@ auto OTMarket::ProcessTrade(
             // know for a fact that there are not any other non-zero
             // bids. (So we might as well break.)
 
+            // If all the bids at this price together can't fill my
+            // minimum increment, then none of them can. Skip to the
+            // last bid at this price, so the loop continues with the
+            // next lower price.
+            if (level_volume(m_mapBidLevels, rr->first) <
+                theOffer.GetMinimumIncrement()) {
+                rr = std::prev(mapOfOffers::reverse_iterator(
+                    m_mapBids.lower_bound(rr->first)));
+
+                continue;
+            }
+
             // I'm selling.
             //
             // If the bid is larger than, or equal to, my
@@ -2535,10 +2838,10 @@ auto OTMarket::ProcessTrade(
         // there, and loop forwards until there are no other asks within
         // my price range.
         //
-        for (auto& it : m_mapAsks) {
+        for (auto it = m_mapAsks.begin(); it != m_mapAsks.end(); ++it) {
             // then I want to start at the lowest seller and loop UP
             // until hitting my price limit.
-            OTOffer* pAsk = it.second;
+            OTOffer* pAsk = it->second;
             OT_ASSERT(nullptr != pAsk);
 
             // NOTE: Market orders only process once, and they are
@@ -2553,10 +2856,23 @@ auto OTMarket::ProcessTrade(
             // needs to wait its turn! It will get its one shot WHEN ITS
             // TURN comes.
             //
-            if (pAsk->IsMarketOrder())
+            if (pAsk->IsMarketOrder()) {
                 //          if (theOffer.IsMarketOrder() &&
                 // pAsk->IsMarketOrder())
+                // Skip the rest of the market orders at once.
+                it = std::prev(m_mapAsks.upper_bound(it->first));
+
+                continue;
+            }
+
+            // If all the asks at this price together can't fill my
+            // minimum increment, then none of them can.
+            if (level_volume(m_mapAskLevels, it->first) <
+                theOffer.GetMinimumIncrement()) {
+                it = std::prev(m_mapAsks.upper_bound(it->first));
+
                 continue;
+            }
 
             // I'm buying.
             // If the ask price is less than, or equal to, my price
@@ -2722,6 +3038,16 @@ void OTMarket::Release_Market()
         m_pTradeList = nullptr;
     }
 
+    m_pJournal.reset();
+    m_lJournalSequence = 0;
+    m_mapOffers.clear();
+    m_mapOfferPositions.clear();
+    m_mapBidLevels.clear();
+    m_mapAskLevels.clear();
+    m_lAskVolume = 0;
+    trades_changed();
+    book_changed();
+
     // If there were any dynamically allocated objects, clean them up
     // here.
     while (!m_mapBids.empty()) {
@@ -524,25 +524,7 @@ auto OTTrade::GetOffer(
                 ": How has the trade already activated, yet not on the "
                 "market and null in my pointer?")
                 .Flush();
-        } else if (!pMarket->AddOffer(
-                       this, *offer, reason, true))  // Since
-                                                     // we're actually
-                                                     // adding an offer
-                                                     // to the market
-        {  // (not just loading from disk) then we actually want to save the
-            // market.
-            // bSaveFile=true.
-            // Error adding the offer to the market!
-            LogOutput(OT_METHOD)(__FUNCTION__)(
-                ": Error adding the offer to the market! (Even though "
-                "supposedly the right market).")
-                .Flush();
         } else {
-            // SUCCESS!
-            offer_ = offer.release();
-
-            hasTradeActivated_ = true;
-
             // The Trade (stored on Cron) has a copy of the Original Offer, with
             // the User's signature on it.
             // A copy of that original Trade object (itself with the user's
@@ -552,13 +534,11 @@ auto OTTrade::GetOffer(
             // so it's already safe before we even get here.
             //
             // So thus I am FREE to release the signatures on the offer, and
-            // sign with the server instead.
-            // The server-signed offer will be stored by the OTMarket.
-            offer_->ReleaseSignatures();
-            offer_->SignContract(*(GetCron()->GetServerNym()), reason);
-            offer_->SaveContract();
-
-            pMarket->SaveMarket(reason);
+            // sign with the server instead. This happens before the offer is
+            // added so the market only ever stores the server-signed offer.
+            offer->ReleaseSignatures();
+            offer->SignContract(*(GetCron()->GetServerNym()), reason);
+            offer->SaveContract();
 
             // Now when the market loads next time, it can verify this offer
             // using the server's signature,
@@ -566,14 +546,28 @@ auto OTTrade::GetOffer(
             // verified it and added it, and now
             // signs it, vouching for it.
 
-            // The Trade itself (all its other variables) are now allowed to
-            // change, since its signatures
-            // are also released and it is now server-signed. (With a copy
-            // stored of the original.)
+            // Since we're actually adding an offer to the market (not just
+            // loading from disk) then we actually want to save the market.
+            if (!pMarket->AddOffer(this, *offer, reason, true)) {
+                // Error adding the offer to the market!
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Error adding the offer to the market! (Even though "
+                    "supposedly the right market).")
+                    .Flush();
+            } else {
+                // SUCCESS!
+                offer_ = offer.release();
+
+                hasTradeActivated_ = true;
+
+                // The Trade itself (all its other variables) are now allowed
+                // to change, since its signatures are also released and it is
+                // now server-signed. (With a copy stored of the original.)
 
-            offer_->SetTrade(*this);
+                offer_->SetTrade(*this);
 
-            return offer_;
+                return offer_;
+            }
         }
     }
 
@@ -595,12 +589,32 @@ auto OTTrade::GetOffer(
         if ((IsGreaterThan() && (relevantPrice > GetStopPrice())) ||
             (IsLessThan() && (relevantPrice < GetStopPrice()))) {
             // Activate the stop order!
-            if (!pMarket->AddOffer(
-                    this, *offer, reason, true))  // Since we're
-                                                  // adding an offer to
-                                                  // the market (not just
-            {  // loading from disk) the we actually want to save the market.
-                // Error adding the offer to the market!    // bSaveFile=true.
+            //
+            // The Trade (stored on Cron) has a copy of the Original Offer,
+            // with the User's signature on it.
+            // A copy of that original Trade object (itself with the user's
+            // signature) is already stored in
+            // the cron folder (by transaction number.) This happens when
+            // the Trade is FIRST added to cron,
+            // so it's already safe before we even get here.
+            //
+            // So thus I am FREE to release the signatures on the offer, and
+            // sign with the server instead. This happens before the offer is
+            // added so the market only ever stores the server-signed offer.
+            offer->ReleaseSignatures();
+            offer->SignContract(*(GetCron()->GetServerNym()), reason);
+            offer->SaveContract();
+
+            // Now when the market loads next time, it can verify this offer
+            // using the server's signature,
+            // instead of having to load the user. Because the server has
+            // verified it and added it, and now
+            // signs it, vouching for it.
+
+            // Since we're adding an offer to the market (not just loading
+            // from disk) then we actually want to save the market.
+            if (!pMarket->AddOffer(this, *offer, reason, true)) {
+                // Error adding the offer to the market!
                 LogOutput(OT_METHOD)(__FUNCTION__)(
                     ": Error adding the stop order to the market! (Even "
                     "though supposedly the right market).")
@@ -612,33 +626,9 @@ auto OTTrade::GetOffer(
                 stopActivated_ = true;
                 hasTradeActivated_ = true;
 
-                // The Trade (stored on Cron) has a copy of the Original Offer,
-                // with the User's signature on it.
-                // A copy of that original Trade object (itself with the user's
-                // signature) is already stored in
-                // the cron folder (by transaction number.) This happens when
-                // the Trade is FIRST added to cron,
-                // so it's already safe before we even get here.
-                //
-                // So thus I am FREE to release the signatures on the offer, and
-                // sign with the server instead.
-                // The server-signed offer will be stored by the OTMarket.
-                offer_->ReleaseSignatures();
-                offer_->SignContract(*(GetCron()->GetServerNym()), reason);
-                offer_->SaveContract();
-
-                pMarket->SaveMarket(reason);
-
-                // Now when the market loads next time, it can verify this offer
-                // using the server's signature,
-                // instead of having to load the user. Because the server has
-                // verified it and added it, and now
-                // signs it, vouching for it.
-
-                // The Trade itself (all its other variables) are now allowed to
-                // change, since its signatures
-                // are also released and it is now server-signed. (With a copy
-                // stored of the original.)
+                // The Trade itself (all its other variables) are now allowed
+                // to change, since its signatures are also released and it is
+                // now server-signed. (With a copy stored of the original.)
 
                 offer_->SetTrade(*this);
 
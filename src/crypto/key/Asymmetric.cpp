@@ -15,6 +15,7 @@
 #include <utility>
 
 #include "crypto/key/Null.hpp"
+#include "crypto/library/VerificationCache.hpp"
 #include "internal/api/Api.hpp"
 #include "internal/crypto/key/Key.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -739,8 +740,12 @@ auto Asymmetric::Verify(const Data& plaintext, const proto::Signature& sig)
     auto signature = Data::Factory();
     signature->Assign(sig.signature().c_str(), sig.signature().size());
 
-    return engine().Verify(
-        plaintext, *this, signature, translate(sig.hashtype()));
+    const auto type = translate(sig.hashtype());
+
+    return crypto::VerificationCache::Get().Verify(
+        PublicKey(), plaintext.Bytes(), signature->Bytes(), type, [&] {
+            return engine().Verify(plaintext, *this, signature, type);
+        });
 }
 
 Asymmetric::~Asymmetric()
@@ -11,6 +11,7 @@ extern "C" {
 #include <sodium.h>
 }
 
+#include "crypto/library/VerificationCache.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
@@ -22,6 +23,7 @@ extern "C" {
 #include "opentxs/core/Secret.hpp"
 #include "opentxs/core/String.hpp"
 #include "opentxs/core/crypto/Signature.hpp"
+#include "opentxs/crypto/key/Asymmetric.hpp"
 #include "opentxs/crypto/key/asymmetric/Algorithm.hpp"
 #include "util/Sodium.hpp"
 
@@ -154,6 +156,11 @@ auto AsymmetricProvider::VerifyContractSignature(
     auto signature = Data::Factory();
     theSignature.GetData(signature);
 
-    return Verify(plaintext, theKey, signature, hashType);
+    return VerificationCache::Get().Verify(
+        theKey.PublicKey(),
+        plaintext->Bytes(),
+        signature->Bytes(),
+        hashType,
+        [&] { return Verify(plaintext, theKey, signature, hashType); });
 }
 }  // namespace opentxs::crypto::implementation
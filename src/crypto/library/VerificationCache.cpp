@@ -0,0 +1,162 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                          // IWYU pragma: associated
+#include "1_Internal.hpp"                        // IWYU pragma: associated
+#include "crypto/library/VerificationCache.hpp"  // IWYU pragma: associated
+
+extern "C" {
+#include <sodium.h>
+}
+
+#include <cstring>
+
+#include "opentxs/core/Log.hpp"
+
+namespace opentxs::crypto
+{
+VerificationCache::VerificationCache() noexcept
+    : secret_([] {
+        if (0 > ::sodium_init()) { OT_FAIL; }
+
+        auto out = std::array<std::uint8_t, 32>{};
+        ::randombytes_buf(out.data(), out.size());
+
+        return out;
+    }())
+    , lock_()
+    , capacity_(default_capacity_)
+    , hits_(0)
+    , misses_(0)
+    , entries_()
+    , order_()
+{
+}
+
+auto VerificationCache::Get() noexcept -> VerificationCache&
+{
+    static auto cache = VerificationCache{};
+
+    return cache;
+}
+
+auto VerificationCache::Hash::operator()(const Digest& digest) const noexcept
+    -> std::size_t
+{
+    auto output = std::size_t{};
+    std::memcpy(&output, digest.data(), sizeof(output));
+
+    return output;
+}
+
+auto VerificationCache::Capacity() const noexcept -> std::size_t
+{
+    auto lock = std::lock_guard<std::mutex>{lock_};
+
+    return capacity_;
+}
+
+auto VerificationCache::Clear() noexcept -> void
+{
+    auto lock = std::lock_guard<std::mutex>{lock_};
+    entries_.clear();
+    order_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+auto VerificationCache::digest(
+    const ReadView key,
+    const ReadView plaintext,
+    const ReadView signature,
+    const crypto::HashType type) const noexcept -> Digest
+{
+    auto output = Digest{};
+    auto state = ::crypto_generichash_state{};
+    ::crypto_generichash_init(
+        &state, secret_.data(), secret_.size(), output.size());
+    const auto hashType = static_cast<std::uint8_t>(type);
+    ::crypto_generichash_update(&state, &hashType, sizeof(hashType));
+
+    // Each field is length prefixed so their boundaries can not be moved
+    for (const auto& field : {key, plaintext, signature}) {
+        const auto size = static_cast<std::uint64_t>(field.size());
+        ::crypto_generichash_update(
+            &state,
+            reinterpret_cast<const unsigned char*>(&size),
+            sizeof(size));
+        ::crypto_generichash_update(
+            &state,
+            reinterpret_cast<const unsigned char*>(field.data()),
+            field.size());
+    }
+
+    ::crypto_generichash_final(&state, output.data(), output.size());
+
+    return output;
+}
+
+auto VerificationCache::SetCapacity(const std::size_t capacity) noexcept
+    -> void
+{
+    auto lock = std::lock_guard<std::mutex>{lock_};
+    capacity_ = capacity;
+    trim(capacity_);
+}
+
+auto VerificationCache::Size() const noexcept -> std::size_t
+{
+    auto lock = std::lock_guard<std::mutex>{lock_};
+
+    return entries_.size();
+}
+
+auto VerificationCache::trim(const std::size_t capacity) noexcept -> void
+{
+    while (order_.size() > capacity) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+    }
+}
+
+auto VerificationCache::Verify(
+    const ReadView key,
+    const ReadView plaintext,
+    const ReadView signature,
+    const crypto::HashType type,
+    const Verifier& verify) noexcept -> bool
+{
+    if (0 == Capacity()) { return verify(); }
+
+    const auto id = digest(key, plaintext, signature, type);
+
+    {
+        auto lock = std::lock_guard<std::mutex>{lock_};
+
+        if (0 < entries_.count(id)) {
+            ++hits_;
+
+            return true;
+        }
+    }
+
+    ++misses_;
+
+    // The lock is not held while verifying, so two threads may both verify
+    // the same signature the first time it is seen
+    if (false == verify()) { return false; }
+
+    auto lock = std::lock_guard<std::mutex>{lock_};
+
+    if (0 == capacity_) { return true; }
+
+    if (entries_.emplace(id).second) {
+        order_.emplace_back(id);
+        trim(capacity_);
+    }
+
+    return true;
+}
+}  // namespace opentxs::crypto
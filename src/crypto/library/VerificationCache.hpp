@@ -0,0 +1,84 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+#include "opentxs/Bytes.hpp"
+#include "opentxs/crypto/Types.hpp"
+
+namespace opentxs::crypto
+{
+// Process-wide record of signatures which have already been verified.
+//
+// Entries are keyed by a keyed BLAKE2b digest of the public key, the signed
+// plaintext, the signature and the hash type, so a hit means this exact
+// signature over these exact bytes was verified by this key before. Only
+// successful verifications are recorded. The oldest entry is evicted when the
+// cache is full, and a capacity of zero disables the cache.
+class VerificationCache
+{
+public:
+    using Verifier = std::function<bool()>;
+
+    static constexpr auto default_capacity_ = std::size_t{65536};
+
+    static auto Get() noexcept -> VerificationCache&;
+
+    auto Capacity() const noexcept -> std::size_t;
+    auto Hits() const noexcept -> std::size_t { return hits_; }
+    auto Misses() const noexcept -> std::size_t { return misses_; }
+    auto Size() const noexcept -> std::size_t;
+
+    auto Clear() noexcept -> void;
+    auto SetCapacity(const std::size_t capacity) noexcept -> void;
+    // Returns true if the signature has been verified before, otherwise calls
+    // verify and records the signature if it succeeds
+    auto Verify(
+        const ReadView key,
+        const ReadView plaintext,
+        const ReadView signature,
+        const crypto::HashType type,
+        const Verifier& verify) noexcept -> bool;
+
+    ~VerificationCache() = default;
+
+private:
+    using Digest = std::array<std::uint8_t, 32>;
+
+    struct Hash {
+        auto operator()(const Digest& digest) const noexcept -> std::size_t;
+    };
+
+    const std::array<std::uint8_t, 32> secret_;
+    mutable std::mutex lock_;
+    std::size_t capacity_;
+    std::atomic<std::size_t> hits_;
+    std::atomic<std::size_t> misses_;
+    std::unordered_set<Digest, Hash> entries_;
+    std::deque<Digest> order_;
+
+    auto digest(
+        const ReadView key,
+        const ReadView plaintext,
+        const ReadView signature,
+        const crypto::HashType type) const noexcept -> Digest;
+    auto trim(const std::size_t capacity) noexcept -> void;
+
+    VerificationCache() noexcept;
+    VerificationCache(const VerificationCache&) = delete;
+    VerificationCache(VerificationCache&&) = delete;
+    auto operator=(const VerificationCache&) -> VerificationCache& = delete;
+    auto operator=(VerificationCache&&) -> VerificationCache& = delete;
+};
+}  // namespace opentxs::crypto
@@ -90,6 +90,8 @@ struct ThreadPool : virtual public api::ThreadPool {
         BlockchainWallet = OT_ZMQ_INTERNAL_SIGNAL + 0,
         SyncDataFiltersIncoming = OT_ZMQ_INTERNAL_SIGNAL + 1,
         CalculateBlockFilters = OT_ZMQ_INTERNAL_SIGNAL + 2,
+        BlockchainFilterScan = OT_ZMQ_INTERNAL_SIGNAL + 3,
+        BlockchainHeaderValidate = OT_ZMQ_INTERNAL_SIGNAL + 4,
     };
 
     virtual auto Shutdown() noexcept -> void = 0;
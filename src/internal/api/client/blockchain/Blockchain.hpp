@@ -141,6 +141,8 @@ using Address = opentxs::blockchain::p2p::internal::Address;
 using Address_p = std::unique_ptr<Address>;
 using FilterData =
     opentxs::blockchain::client::internal::FilterDatabase::Filter;
+using FilterCallback =
+    opentxs::blockchain::client::internal::FilterDatabase::FilterCallback;
 using FilterHash = opentxs::blockchain::client::internal::FilterDatabase::Hash;
 using FilterHeader =
     opentxs::blockchain::client::internal::FilterDatabase::Header;
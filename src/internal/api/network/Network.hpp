@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 #include "opentxs/Bytes.hpp"
@@ -26,16 +27,29 @@ struct Asio {
     using Endpoint = opentxs::network::asio::Endpoint::Imp;
     using Socket = opentxs::network::asio::Socket::Imp;
     using Callback = std::function<void()>;
+    using Notification = opentxs::network::asio::Socket::Notification;
 
     virtual auto Connect(const ReadView id, Socket& socket) noexcept
         -> bool = 0;
-    virtual auto Context() noexcept -> boost::asio::io_context& = 0;
-    virtual auto Post(Callback cb) noexcept -> bool = 0;
+    virtual auto Context(const std::size_t shard) noexcept
+        -> boost::asio::io_context& = 0;
+    // Runs cb on the thread which serves the specified shard
+    virtual auto Post(const std::size_t shard, Callback cb) noexcept
+        -> bool = 0;
     virtual auto Receive(
         const ReadView id,
         const OTZMQWorkType type,
         const std::size_t bytes,
         Socket& socket) noexcept -> bool = 0;
+    // Called when a socket which was assigned to shard closes
+    virtual auto Release(const std::size_t shard) noexcept -> void = 0;
+    // Chooses the shard on which a new socket will run
+    virtual auto Shard() noexcept -> std::size_t = 0;
+    // Writes data on the thread which serves the socket
+    virtual auto Transmit(
+        const ReadView data,
+        Notification notifier,
+        Socket& socket) noexcept -> bool = 0;
 
     virtual ~Asio() = default;
 
@@ -147,6 +147,25 @@ struct SerializedBloomFilter {
     SerializedBloomFilter() noexcept;
 };
 
+// Stored filters are this header followed by the compressed filter. Legacy
+// records are protobuf serializations, which always begin with 0x08.
+struct SerializedGCS {
+    static constexpr auto version_ = std::uint8_t{1};
+
+    be::little_uint8_buf_t format_;
+    be::little_uint8_buf_t bits_;
+    be::little_uint32_buf_t false_positive_rate_;
+    be::little_uint32_buf_t count_;
+    std::array<std::byte, 16> key_;
+
+    SerializedGCS(
+        const std::uint8_t bits,
+        const std::uint32_t fpRate,
+        const std::uint32_t count,
+        const ReadView key) noexcept(false);
+    SerializedGCS() noexcept;
+};
+
 #if OT_BLOCKCHAIN
 struct Database : virtual public client::internal::BlockDatabase,
                   virtual public client::internal::FilterDatabase,
@@ -236,6 +255,17 @@ OPENTXS_EXPORT auto GCS(
     const ReadView key,
     const ReadView encoded) noexcept
     -> std::unique_ptr<blockchain::client::GCS>;
+// Accepts either the flat storage layout or a legacy protobuf record
+OPENTXS_EXPORT auto GCS(
+    const api::Core& api,
+    const ReadView serialized) noexcept
+    -> std::unique_ptr<blockchain::client::GCS>;
+// Refers to a flat record instead of copying it, so the returned filter must
+// not outlive the memory containing the record. Legacy records are copied.
+OPENTXS_EXPORT auto GCSView(
+    const api::Core& api,
+    const ReadView serialized) noexcept
+    -> std::unique_ptr<blockchain::client::GCS>;
 OPENTXS_EXPORT auto NumericHash(const blockchain::block::Hash& hash) noexcept
     -> std::unique_ptr<blockchain::NumericHash>;
 OPENTXS_EXPORT auto NumericHashNBits(const std::uint32_t nBits) noexcept
@@ -10,6 +10,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <tuple>
 #include <vector>
@@ -150,6 +151,29 @@ struct EncodedTransaction {
     auto size() const noexcept -> std::size_t;
 };
 
+/// Location of the parts of a serialized transaction which are needed to
+/// calculate its txid
+struct TransactionLayout {
+    std::size_t size_{};
+    /// offset of the first witness byte for segwit transactions
+    std::optional<std::size_t> witness_{};
+
+    /// tx: the same bytes which were passed to ScanTransaction
+    auto txid_preimage(const ReadView tx) const noexcept -> Space;
+};
+
+using ScanCallback = std::function<void(const ReadView)>;
+
+/// Walks a serialized transaction without copying any fields
+///
+/// outpoint: called with a view of each input outpoint (optional)
+///
+/// script: called with a view of each output script (optional)
+auto ScanTransaction(
+    const ReadView in,
+    const ScanCallback& outpoint = {},
+    const ScanCallback& script = {}) noexcept(false) -> TransactionLayout;
+
 enum class SigOption : std::uint8_t {
     All,
     None,
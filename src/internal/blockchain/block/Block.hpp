@@ -19,7 +19,7 @@ struct Block::ParsedPatterns {
     std::vector<Space> data_;
     std::map<ReadView, Patterns::const_iterator> map_;
 
-    ParsedPatterns(const Block::Patterns& in) noexcept;
+    OPENTXS_EXPORT ParsedPatterns(const Block::Patterns& in) noexcept;
 };
 
 auto SetIntersection(
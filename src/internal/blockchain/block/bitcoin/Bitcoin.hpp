@@ -24,6 +24,7 @@
 #include "opentxs/api/client/blockchain/Types.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/blockchain/block/Outpoint.hpp"
 #include "opentxs/blockchain/block/bitcoin/Input.hpp"
 #include "opentxs/blockchain/block/bitcoin/Inputs.hpp"
@@ -283,6 +284,16 @@ auto BitcoinBlockHeader(
     const blockchain::Type chain,
     const ReadView bytes) noexcept
     -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>;
+auto BitcoinBlockHeader(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const ReadView bytes,
+    const blockchain::block::Hash& hash,
+    const blockchain::block::Height height,
+    const blockchain::block::Header::Status status,
+    const blockchain::block::Header::Status inheritStatus,
+    const blockchain::Work& inheritWork) noexcept
+    -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>;
 auto BitcoinBlockHeader(
     const api::Core& api,
     const blockchain::Type chain,
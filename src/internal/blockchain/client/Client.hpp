@@ -7,7 +7,9 @@
 
 #include <boost/asio.hpp>
 #include <boost/thread/thread.hpp>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <iosfwd>
 #include <map>
@@ -246,8 +248,13 @@ struct BlockOracle : virtual public opentxs::blockchain::client::BlockOracle {
         Shutdown = value(WorkType::Shutdown),
     };
 
+    // The block will not be evicted from the memory cache while any copy of
+    // the pin exists
+    using Pin = std::shared_ptr<const block::Hash>;
+
     virtual auto GetBlockJob() const noexcept -> BlockJob = 0;
     virtual auto Heartbeat() const noexcept -> void = 0;
+    virtual auto PinBlock(const block::Hash& block) const noexcept -> Pin = 0;
     virtual auto SubmitBlock(const ReadView in) const noexcept -> void = 0;
     virtual auto Tip() const noexcept -> block::Position = 0;
 
@@ -269,12 +276,15 @@ struct BlockValidator {
 };
 
 struct OPENTXS_EXPORT Config {
+    static const std::size_t default_block_cache_bytes_;
+
     bool download_cfilters_{false};
     bool generate_cfilters_{false};
     bool provide_sync_server_{false};
     bool use_sync_server_{false};
     bool disable_wallet_{false};
     std::string sync_endpoint_{};
+    std::size_t block_cache_bytes_{default_block_cache_bytes_};
 
     auto print() const noexcept -> std::string;
 };
@@ -285,6 +295,10 @@ struct FilterDatabase {
     using Header = std::tuple<block::pHash, filter::pHeader, ReadView>;
     /// block hash, filter
     using Filter = std::pair<ReadView, std::unique_ptr<const GCS>>;
+    /// position of the block in the request, filter
+    ///
+    /// The filter refers to database memory and is only valid during the call
+    using FilterCallback = std::function<void(const std::size_t, const GCS&)>;
 
     virtual auto FilterHeaderTip(const filter::Type type) const noexcept
         -> block::Position = 0;
@@ -299,6 +313,14 @@ struct FilterDatabase {
         const noexcept -> std::unique_ptr<const GCS> = 0;
     virtual auto LoadFilterHash(const filter::Type type, const ReadView block)
         const noexcept -> Hash = 0;
+    /// Loads the filters for consecutive blocks under a single read
+    /// transaction, stopping at the first missing filter
+    ///
+    /// Returns the number of filters passed to cb
+    virtual auto LoadFilters(
+        const filter::Type type,
+        const std::vector<ReadView>& blocks,
+        const FilterCallback& cb) const noexcept -> std::size_t = 0;
     virtual auto LoadFilterHeader(const filter::Type type, const ReadView block)
         const noexcept -> Hash = 0;
     virtual auto SetFilterHeaderTip(
@@ -335,6 +357,15 @@ struct FilterOracle : virtual public opentxs::blockchain::client::FilterOracle {
         const filter::Type type,
         const block::Position& position) const noexcept
         -> std::unique_ptr<const GCS> = 0;
+    /// Loads the filters for consecutive blocks, resetting the filter tip to
+    /// the parent of the first missing filter
+    ///
+    /// Returns the number of filters passed to cb
+    virtual auto LoadFiltersOrResetTip(
+        const filter::Type type,
+        const std::vector<block::Position>& blocks,
+        const FilterDatabase::FilterCallback& cb) const noexcept
+        -> std::size_t = 0;
     virtual auto ProcessBlock(const block::bitcoin::Block& block) const noexcept
         -> bool = 0;
     virtual auto ProcessSyncData(const ParsedSyncData& data) const noexcept
@@ -348,6 +379,36 @@ struct FilterOracle : virtual public opentxs::blockchain::client::FilterOracle {
     ~FilterOracle() override = default;
 };
 
+// Matches wallet targets against a range of block filters
+//
+// Concurrent requests for the same filter type are combined so each filter is
+// loaded and each target hashed once per block regardless of how many
+// subchains are scanning, and the block range is split across the thread
+// pool.
+struct FilterScanner {
+    using Filter = std::shared_ptr<const GCS>;
+    using Match = std::pair<block::Position, Filter>;
+
+    struct Result {
+        // Highest block tested, or empty if the first filter is missing
+        std::optional<block::Position> tested_{};
+        // Blocks whose filter matches at least one target, in height order
+        std::vector<Match> matches_{};
+    };
+
+    static auto ProcessThreadPool(const zmq::Message& task) noexcept -> void;
+
+    // Blocks the calling thread, which participates in the scan, until all
+    // filters in the range have been tested
+    virtual auto Scan(
+        const filter::Type type,
+        const block::Height start,
+        const block::Height stop,
+        const GCS::Targets& targets) const noexcept -> Result = 0;
+
+    virtual ~FilterScanner() = default;
+};
+
 struct HeaderOracle : virtual public opentxs::blockchain::client::HeaderOracle {
     using CheckpointBlockHash = block::pHash;
     using PreviousBlockHash = block::pHash;
@@ -357,11 +418,24 @@ struct HeaderOracle : virtual public opentxs::blockchain::client::HeaderOracle {
         CheckpointBlockHash,
         PreviousBlockHash,
         CheckpointFilterHash>;
+    // Returns nullptr if the serialized header is malformed or does not
+    // satisfy its proof of work
+    using HeaderParser =
+        std::function<std::unique_ptr<block::Header>(const ReadView)>;
+
+    static auto ProcessThreadPool(const zmq::Message& task) noexcept -> void;
 
     virtual auto GetDefaultCheckpoint() const noexcept -> CheckpointData = 0;
-    virtual auto Init() noexcept -> void = 0;
     virtual auto LoadBitcoinHeader(const block::Hash& hash) const noexcept
         -> std::unique_ptr<block::bitcoin::Header> = 0;
+
+    // Parses and validates the headers in parallel, then connects them to the
+    // chain in order. Returns false without modifying the chain if any header
+    // is invalid.
+    virtual auto AddSerializedHeaders(
+        const std::vector<ReadView>& headers,
+        const HeaderParser& parser) noexcept -> bool = 0;
+    virtual auto Init() noexcept -> void = 0;
     virtual auto ProcessSyncData(
         const network::zeromq::Message& work,
         ParsedSyncData& out) noexcept -> bool = 0;
@@ -370,8 +444,11 @@ struct HeaderOracle : virtual public opentxs::blockchain::client::HeaderOracle {
 };
 
 struct HeaderDatabase {
+    // The callback is executed after the update is committed and before any
+    // notifications are sent
     virtual auto ApplyUpdate(
-        const client::UpdateTransaction& update) const noexcept -> bool = 0;
+        const client::UpdateTransaction& update,
+        const SimpleCallback& committed) const noexcept -> bool = 0;
     // Throws std::out_of_range if no block at that position
     virtual auto BestBlock(const block::Height position) const noexcept(false)
         -> block::pHash = 0;
@@ -476,6 +553,12 @@ struct Network : virtual public opentxs::blockchain::Network {
         SyncData = OT_ZMQ_SYNC_DATA_SIGNAL,
     };
 
+    auto BlockOracle() const noexcept -> const client::BlockOracle& final
+    {
+        return BlockOracleInternal();
+    }
+    virtual auto BlockOracleInternal() const noexcept
+        -> const internal::BlockOracle& = 0;
     virtual auto Blockchain() const noexcept
         -> const api::client::internal::Blockchain& = 0;
     virtual auto BroadcastTransaction(
@@ -489,6 +572,8 @@ struct Network : virtual public opentxs::blockchain::Network {
     }
     virtual auto FilterOracleInternal() const noexcept
         -> const internal::FilterOracle& = 0;
+    virtual auto FilterScanner() const noexcept
+        -> const internal::FilterScanner& = 0;
     auto HeaderOracle() const noexcept -> const client::HeaderOracle& final
     {
         return HeaderOracleInternal();
@@ -571,6 +656,11 @@ struct WalletDatabase {
     using Pattern = std::pair<ElementID, Space>;
     using Patterns = std::vector<Pattern>;
     using MatchingIndices = std::vector<Bip32Index>;
+    // First height, last height, and the patterns not yet tested against any
+    // block in that range
+    using ScanRange = std::tuple<block::Height, block::Height, Patterns>;
+    // Current pattern set version and the ranges to be scanned
+    using ScanTargets = std::pair<VersionNumber, std::vector<ScanRange>>;
     using UTXO = std::
         pair<blockchain::block::Outpoint, proto::BlockchainTransactionOutput>;
     using KeyID = api::client::blockchain::Key;
@@ -622,6 +712,10 @@ struct WalletDatabase {
         State type) const noexcept -> std::vector<UTXO> = 0;
     virtual auto GetPatterns(const SubchainIndex& index) const noexcept
         -> Patterns = 0;
+    virtual auto GetScanTargets(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last) const noexcept -> ScanTargets = 0;
     virtual auto GetUnspentOutputs() const noexcept -> std::vector<UTXO> = 0;
     virtual auto GetUnspentOutputs(
         const NodeID& balanceNode,
@@ -660,6 +754,11 @@ struct WalletDatabase {
     virtual auto SubchainSetLastScanned(
         const SubchainIndex& index,
         const block::Position& position) const noexcept -> bool = 0;
+    virtual auto SubchainSetTested(
+        const SubchainIndex& index,
+        const block::Height first,
+        const block::Height last,
+        const VersionNumber version) const noexcept -> bool = 0;
     virtual auto TransactionLoadBitcoin(const ReadView txid) const noexcept
         -> std::unique_ptr<block::bitcoin::Transaction> = 0;
 
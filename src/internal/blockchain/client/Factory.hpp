@@ -47,6 +47,7 @@ struct BlockOracle;
 struct Config;
 struct FilterDatabase;
 struct FilterOracle;
+struct FilterScanner;
 struct HeaderDatabase;
 struct HeaderOracle;
 struct Network;
@@ -84,6 +85,10 @@ auto BlockchainFilterOracle(
     const blockchain::Type type,
     const std::string& shutdown) noexcept
     -> std::unique_ptr<blockchain::client::internal::FilterOracle>;
+auto BlockchainFilterScanner(
+    const api::Core& api,
+    const blockchain::client::internal::Network& network) noexcept
+    -> std::unique_ptr<blockchain::client::internal::FilterScanner>;
 OPENTXS_EXPORT auto BlockchainNetworkBitcoin(
     const api::Core& api,
     const api::client::internal::Blockchain& blockchain,
@@ -115,6 +120,7 @@ OPENTXS_EXPORT auto BlockchainWallet(
     -> std::unique_ptr<blockchain::client::internal::Wallet>;
 auto BlockOracle(
     const api::Core& api,
+    const blockchain::client::internal::Config& config,
     const blockchain::client::internal::Network& network,
     const blockchain::client::internal::HeaderOracle& header,
     const blockchain::client::internal::BlockDatabase& db,
@@ -29,5 +29,6 @@ enum class Key : std::size_t {
     CheckpointHash = 3,
     BestFullBlock = 4,
     SyncPosition = 5,
+    CompactHeaderSequence = 6,
 };
 }  // namespace opentxs::blockchain::database
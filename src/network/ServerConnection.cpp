@@ -10,9 +10,12 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 
 #include "internal/api/Api.hpp"
@@ -101,6 +104,7 @@ ServerConnection::ServerConnection(
     , sockets_ready_(Flag::Factory(false))
     , status_(Flag::Factory(false))
     , use_proxy_(Flag::Factory(false))
+    , unarmored_(std::nullopt)
     , registration_lock_()
     , registered_for_push_()
 {
@@ -434,18 +438,59 @@ auto ServerConnection::Send(
 
     auto raw = String::Factory();
     message.SaveContractRaw(raw);
-    auto envelope = Armored::Factory(raw);
+    // Notaries which understand unarmored requests answer them in kind,
+    // which saves compressing and encoding the message at both ends
+    auto makeRequest =
+        [&](const bool unarmored) -> std::optional<OTZMQMessage> {
+        if (unarmored) {
+            return api_.ZeroMQ().Message(
+                std::string{raw->Get(), raw->GetLength()});
+        }
 
-    if (false == envelope->Exists()) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to armor message").Flush();
+        auto envelope = Armored::Factory(raw);
 
-        return output;
-    }
+        if (false == envelope->Exists()) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to armor message")
+                .Flush();
+
+            return std::nullopt;
+        }
 
+        return api_.ZeroMQ().Message(std::string(envelope->Get()));
+    };
     Lock socketLock(lock_);
     Cleanup cleanup(socketLock, *this, status, reply);
-    auto request = api_.ZeroMQ().Message(std::string(envelope->Get()));
-    auto sendresult = get_sync(socketLock).Send(request);
+
+    // Requests are only sent unarmored once the notary has confirmed that it
+    // accepts them. The probe has no side effects, so unlike a request it is
+    // safe to ask again if it fails.
+    if (false == unarmored_.has_value()) {
+        const auto probe = get_sync(socketLock).Send(
+            api_.ZeroMQ().Message(std::string{OT_UNARMORED_PROBE}));
+
+        if (SendResult::VALID_REPLY != probe.first) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to query capabilities of ")(server_id_)
+                .Flush();
+            status = probe.first;
+
+            return output;
+        }
+
+        const auto body = probe.second->Body();
+        unarmored_ = (1 == body.size()) &&
+                     (OT_UNARMORED_PROBE == std::string(*body.begin()));
+        LogDetail(OT_METHOD)(__FUNCTION__)(": ")(server_id_)(
+            unarmored_.value() ? " accepts" : " does not accept")(
+            " unarmored requests")
+            .Flush();
+    }
+
+    auto request = makeRequest(unarmored_.value());
+
+    if (false == request.has_value()) { return output; }
+
+    auto sendresult = get_sync(socketLock).Send(request.value());
 
     if (status_->On()) { publish(); }
 
@@ -487,10 +532,19 @@ auto ServerConnection::Send(
         return output;
     }
 
-    auto armored = Armored::Factory();
-    armored->Set(std::string(frame).c_str());
+    const auto payload = std::string(frame);
+    const auto prefix = std::strlen(OT_BEGIN_SIGNED);
     auto serialized = String::Factory();
-    armored->GetString(serialized);
+
+    if (0 == payload.compare(0, prefix, OT_BEGIN_SIGNED)) {
+        serialized->Set(
+            payload.data(), static_cast<std::uint32_t>(payload.size()));
+    } else {
+        auto armored = Armored::Factory();
+        armored->Set(payload.c_str());
+        armored->GetString(serialized);
+    }
+
     const auto loaded = replymessage->LoadContractFromString(serialized);
 
     if (loaded) {
@@ -11,6 +11,7 @@
 #include <ctime>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -118,6 +119,9 @@ private:
     OTFlag sockets_ready_;
     OTFlag status_;
     OTFlag use_proxy_;
+    // Whether the notary accepts requests without armoring. Unknown until
+    // the notary has answered a probe. Guarded by lock_.
+    std::optional<bool> unarmored_;
     mutable std::mutex registration_lock_;
     std::map<OTNymID, bool> registered_for_push_;
 
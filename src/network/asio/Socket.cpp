@@ -21,7 +21,9 @@ namespace opentxs::network::asio
 Socket::Imp::Imp(const Endpoint& endpoint, Asio& asio) noexcept
     : endpoint_(endpoint)
     , asio_(asio)
-    , socket_(asio_.Context())
+    , shard_(asio_.Shard())
+    , socket_(asio_.Context(shard_))
+    , buffer_(std::make_shared<Buffer>())
 {
 }
 
@@ -54,31 +56,14 @@ auto Socket::Imp::Receive(
 auto Socket::Imp::Transmit(const ReadView data, Notification notifier) noexcept
     -> bool
 {
-    using SharedStatus = std::shared_ptr<SendStatus>;
-    auto* buf = [&] {
-        auto out = std::make_unique<Space>();
-        *out = space(data);
-
-        return out.release();
-    }();
-    auto work =
-        [this, buf, promise = SharedStatus{std::move(notifier)}]() -> void {
-        auto cb = [buf, promise](auto& error, auto bytes) -> void {
-            auto cleanup = std::unique_ptr<Space>{buf};
-
-            try {
-                if (promise) { promise->set_value(!error); }
-            } catch (...) {
-            }
-        };
-        boost::asio::async_write(
-            socket_, boost::asio::buffer(buf->data(), buf->size()), cb);
-    };
-
-    return asio_.Post(std::move(work));
+    return asio_.Transmit(data, std::move(notifier), *this);
 }
 
-Socket::Imp::~Imp() { Close(); }
+Socket::Imp::~Imp()
+{
+    Close();
+    asio_.Release(shard_);
+}
 
 Socket::Socket(const Endpoint& endpoint, Asio& asio) noexcept
     : imp_(std::make_unique<Imp>(endpoint, asio).release())
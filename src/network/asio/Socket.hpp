@@ -8,7 +8,9 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <cstddef>
 #include <iosfwd>
+#include <memory>
 
 #include "opentxs/Bytes.hpp"
 #include "opentxs/network/asio/Socket.hpp"
@@ -44,9 +46,22 @@ namespace opentxs::network::asio
 struct Socket::Imp {
     using tcp = ip::tcp;
 
+    // Bytes which have been read from the socket but not yet delivered are
+    // data_[begin_, end_). The buffer is shared with read handlers, and with
+    // any frames still referring to data which was already delivered.
+    struct Buffer {
+        std::shared_ptr<Space> data_{};
+        std::size_t begin_{};
+        std::size_t end_{};
+        // True once a delivered frame refers to data_ instead of a copy
+        bool shared_{};
+    };
+
     const Endpoint& endpoint_;
     api::network::internal::Asio& asio_;
+    const std::size_t shard_;
     tcp::socket socket_;
+    const std::shared_ptr<Buffer> buffer_;
 
     auto Close() noexcept -> void;
     auto Connect(const ReadView id) noexcept -> bool;
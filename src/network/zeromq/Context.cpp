@@ -8,6 +8,7 @@
 #include "network/zeromq/Context.hpp"  // IWYU pragma: associated
 
 #include <zmq.h>
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -19,6 +20,7 @@
 #include "2_Factory.hpp"
 #include "PairEventListener.hpp"
 #include "internal/network/zeromq/socket/Socket.hpp"
+#include "network/zeromq/Reactor.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/core/Log.hpp"
@@ -124,8 +126,14 @@ auto Context::Z85ToRaw(
 
 namespace opentxs::network::zeromq::implementation
 {
+// Receivers share this many polling threads
+constexpr auto reactor_threads_ = std::size_t{2};
+// Minimum number of threads which run receiver callbacks
+constexpr auto reactor_workers_ = std::size_t{2};
+
 Context::Context() noexcept
     : context_(::zmq_ctx_new())
+    , reactor_()
 {
     assert(nullptr != context_);
     assert(1 == ::zmq_has("curve"));
@@ -144,6 +152,12 @@ Context::Context() noexcept
         ::zmq_ctx_set(context_, ZMQ_MAX_SOCKETS, sockets);
 
     assert(0 == init);
+
+    reactor_ = std::make_unique<Reactor>(
+        context_,
+        reactor_threads_,
+        std::max<std::size_t>(
+            reactor_workers_, std::thread::hardware_concurrency()));
 }
 
 Context::operator void*() const noexcept
@@ -274,6 +288,11 @@ auto Context::PushSocket(
         factory::PushSocket(*this, static_cast<bool>(direction))};
 }
 
+auto Context::ReactorStats() const noexcept -> ReactorStatistics
+{
+    return reactor_->Stats();
+}
+
 auto Context::ReplyMessage(const zeromq::Message& request) const noexcept
     -> OTZMQMessage
 {
@@ -363,6 +382,9 @@ auto Context::TaggedReply(
 
 Context::~Context()
 {
+    // The reactor's sockets must be closed before the context can terminate
+    reactor_.reset();
+
     if (nullptr != context_) {
         zmq_ctx_shutdown(context_);
         auto promise = std::promise<void>{};
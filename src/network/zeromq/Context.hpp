@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 #include "opentxs/Bytes.hpp"
@@ -55,6 +56,8 @@ class Factory;
 
 namespace opentxs::network::zeromq::implementation
 {
+class Reactor;
+
 class Context final : virtual public zeromq::Context
 {
 public:
@@ -114,6 +117,7 @@ public:
         -> OTZMQPullSocket final;
     auto PushSocket(const socket::Socket::Direction direction) const noexcept
         -> OTZMQPushSocket final;
+    auto ReactorStats() const noexcept -> ReactorStatistics final;
     auto ReplyMessage(const zeromq::Message& request) const noexcept
         -> OTZMQMessage final;
     auto ReplyMessage(const ReadView connectionID) const noexcept
@@ -127,6 +131,8 @@ public:
         const ListenCallback& callback,
         const socket::Socket::Direction direction) const noexcept
         -> OTZMQRouterSocket final;
+    // Polls the sockets of receivers which do not need a thread of their own
+    auto SocketReactor() const noexcept -> Reactor& { return *reactor_; }
     auto SubscribeSocket(const ListenCallback& callback) const noexcept
         -> OTZMQSubscribeSocket final;
     auto TaggedMessage(const void* tag, const std::size_t size) const noexcept
@@ -146,6 +152,7 @@ private:
     friend opentxs::Factory;
 
     void* context_{nullptr};
+    std::unique_ptr<Reactor> reactor_;
 
     auto clone() const noexcept -> Context* final { return new Context; }
 
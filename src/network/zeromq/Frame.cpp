@@ -36,6 +36,25 @@ auto Factory::ZMQFrame(const ProtobufType& data) -> network::zeromq::Frame*
 {
     return new ReturnType(data);
 }
+
+auto Factory::ZMQFrame(
+    void* data,
+    const std::size_t size,
+    void (*release)(void*, void*),
+    void* hint) -> network::zeromq::Frame*
+{
+    return new ReturnType(data, size, release, hint);
+}
+
+auto Factory::ZMQFrame(network::zeromq::Frame& take) -> network::zeromq::Frame*
+{
+    auto* output = new ReturnType();
+    const auto moved = zmq_msg_move(*output, take);
+
+    OT_ASSERT(0 == moved);
+
+    return output;
+}
 }  // namespace opentxs
 
 namespace opentxs::network::zeromq::implementation
@@ -72,6 +91,19 @@ Frame::Frame(const void* data, const std::size_t bytes) noexcept
     }
 }
 
+Frame::Frame(
+    void* data,
+    const std::size_t bytes,
+    zmq_free_fn* release,
+    void* hint) noexcept
+    : zeromq::Frame()
+    , message_()
+{
+    const auto init = zmq_msg_init_data(&message_, data, bytes, release, hint);
+
+    OT_ASSERT(0 == init);
+}
+
 Frame::operator std::string() const noexcept { return std::string{Bytes()}; }
 
 auto Frame::Bytes() const noexcept -> ReadView
@@ -0,0 +1,644 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                // IWYU pragma: associated
+#include "1_Internal.hpp"              // IWYU pragma: associated
+#include "network/zeromq/Reactor.hpp"  // IWYU pragma: associated
+
+#include <zmq.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD "opentxs::network::zeromq::implementation::Reactor::"
+
+namespace opentxs::network::zeromq::implementation
+{
+// Identifies the reactor, if any, which owns the current thread
+static thread_local const Reactor* reactor_thread_{nullptr};
+
+class Reactor::Shard
+{
+public:
+    auto Count() const noexcept -> std::size_t
+    {
+        auto lock = Lock{lock_};
+
+        return items_.size();
+    }
+    auto Stats(Statistics& out, std::uint64_t& latency) const noexcept -> void
+    {
+        out.sockets_ += Count();
+        out.wakeups_ += wakeups_.load();
+        out.notifications_ += notifications_.load();
+        latency += latency_total_.load();
+        out.max_latency_ = std::max(
+            out.max_latency_,
+            std::chrono::microseconds{latency_max_.load()});
+    }
+
+    auto Add(
+        const std::size_t id,
+        const std::vector<void*>& sockets,
+        Callback&& cb) noexcept -> bool
+    {
+        if (false == bool(wake_receive_)) { return false; }
+
+        auto lock = Lock{lock_};
+        items_.emplace(id, std::make_shared<Item>(sockets, std::move(cb)));
+        changed_ = true;
+        wake(lock);
+
+        return true;
+    }
+    auto Notify(const std::size_t id) noexcept -> void
+    {
+        auto lock = Lock{lock_};
+        auto it = items_.find(id);
+
+        if (items_.end() == it) { return; }
+
+        auto& item = *it->second;
+
+        if (false == item.notified_) {
+            item.notified_ = true;
+            item.notify_time_ = Clock::now();
+        }
+
+        if (item.busy_) {
+            // The callback will run again as soon as it returns
+            item.pending_ = true;
+        } else {
+            notified_.emplace(id);
+            wake(lock);
+        }
+    }
+    auto Remove(const std::size_t id, Callback&& done) noexcept -> bool
+    {
+        auto lock = Lock{lock_};
+        auto it = items_.find(id);
+
+        if (items_.end() == it) { return true; }
+
+        auto item = it->second;
+        items_.erase(it);
+        notified_.erase(id);
+        item->removed_ = true;
+        changed_ = true;
+        const auto async = parent_.IsReactorThread();
+
+        if (item->busy_) {
+            // The worker running the callback releases the item
+            if (async) {
+                item->done_ = std::move(done);
+
+                return false;
+            }
+
+            cv_.wait(lock, [&] { return (false == item->busy_) || !running_; });
+
+            return true;
+        }
+
+        if (std::this_thread::get_id() == thread_.get_id()) { return true; }
+
+        // The sockets may be in the poll set until it is rebuilt
+        if (async) {
+            item->done_ = std::move(done);
+            released_.emplace_back(std::move(item));
+            wake(lock);
+
+            return false;
+        }
+
+        const auto target = ++requested_;
+        wake(lock);
+        cv_.wait(lock, [&] { return (applied_ >= target) || !running_; });
+
+        return true;
+    }
+    auto Run(const std::size_t id, const Callback& job) noexcept -> bool
+    {
+        auto item = [&]() -> Pointer {
+            auto lock = Lock{lock_};
+            auto it = items_.find(id);
+
+            if ((items_.end() == it) || it->second->busy_) { return {}; }
+
+            auto output = it->second;
+            // Keeps the callback from being dispatched and takes the sockets
+            // out of the poll set
+            output->busy_ = true;
+            changed_ = true;
+
+            if (std::this_thread::get_id() == thread_.get_id()) {
+                return output;
+            }
+
+            // The shard thread never waits for callbacks, so this wait is
+            // bounded by one pass through its loop
+            const auto target = ++requested_;
+            wake(lock);
+            cv_.wait(lock, [&] { return (applied_ >= target) || !running_; });
+
+            return output;
+        }();
+
+        if (false == bool(item)) { return false; }
+
+        try {
+            job();
+        } catch (...) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Job exception").Flush();
+        }
+
+        release(item);
+
+        return true;
+    }
+
+    Shard(Reactor& parent, void* context) noexcept
+        : parent_(parent)
+        , endpoint_(
+              std::string{"inproc://opentxs//zeromq/reactor/"} +
+              std::to_string(reinterpret_cast<std::uintptr_t>(this)))
+        , lock_()
+        , cv_()
+        , wake_send_(zmq_socket(context, ZMQ_PUSH), zmq_close)
+        , wake_receive_(zmq_socket(context, ZMQ_PULL), zmq_close)
+        , items_()
+        , notified_()
+        , released_()
+        , changed_(true)
+        , wake_pending_(false)
+        , requested_(0)
+        , applied_(0)
+        , running_(true)
+        , wakeups_(0)
+        , notifications_(0)
+        , latency_total_(0)
+        , latency_max_(0)
+        , thread_()
+    {
+        OT_ASSERT(wake_send_);
+        OT_ASSERT(wake_receive_);
+
+        auto linger = 0;
+        zmq_setsockopt(wake_send_.get(), ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_setsockopt(
+            wake_receive_.get(), ZMQ_LINGER, &linger, sizeof(linger));
+
+        if ((0 != zmq_bind(wake_receive_.get(), endpoint_.c_str())) ||
+            (0 != zmq_connect(wake_send_.get(), endpoint_.c_str()))) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to create wakeup ")(
+                "sockets: ")(zmq_strerror(zmq_errno()))
+                .Flush();
+            wake_receive_.reset();
+            wake_send_.reset();
+
+            return;
+        }
+
+        thread_ = std::thread{&Shard::run, this};
+    }
+
+    ~Shard()
+    {
+        {
+            auto lock = Lock{lock_};
+            running_ = false;
+            wake(lock);
+        }
+
+        if (thread_.joinable()) { thread_.join(); }
+
+        cv_.notify_all();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using RawSocket = std::unique_ptr<void, decltype(&::zmq_close)>;
+
+    // Everything except sockets_ and cb_ is protected by the shard's lock_
+    struct Item {
+        const std::vector<void*> sockets_;
+        const Callback cb_;
+        // A worker owns the sockets and has or will run the callback, or a
+        // job passed to Run() is using them
+        bool busy_;
+        // Run the callback again once the current call returns
+        bool pending_;
+        bool removed_;
+        bool notified_;
+        Clock::time_point notify_time_;
+        // Runs after an asynchronous Remove() once the sockets are released
+        Callback done_;
+
+        Item(const std::vector<void*>& sockets, Callback&& cb) noexcept
+            : sockets_(sockets)
+            , cb_(std::move(cb))
+            , busy_(false)
+            , pending_(false)
+            , removed_(false)
+            , notified_(false)
+            , notify_time_()
+            , done_()
+        {
+        }
+    };
+
+    using Pointer = std::shared_ptr<Item>;
+
+    Reactor& parent_;
+    const std::string endpoint_;
+    mutable std::mutex lock_;
+    std::condition_variable cv_;
+    RawSocket wake_send_;
+    RawSocket wake_receive_;
+    std::map<std::size_t, Pointer> items_;
+    std::set<std::size_t> notified_;
+    // Items removed while they were in the poll set
+    std::vector<Pointer> released_;
+    bool changed_;
+    bool wake_pending_;
+    std::uint64_t requested_;
+    std::uint64_t applied_;
+    std::atomic<bool> running_;
+    std::atomic<std::uint64_t> wakeups_;
+    std::atomic<std::uint64_t> notifications_;
+    std::atomic<std::uint64_t> latency_total_;
+    std::atomic<std::uint64_t> latency_max_;
+    std::thread thread_;
+
+    static auto finish(Callback& done) noexcept -> void
+    {
+        if (false == bool(done)) { return; }
+
+        try {
+            done();
+        } catch (...) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Completion exception")
+                .Flush();
+        }
+    }
+
+    auto dispatch(const Lock& lock, const Pointer& item) noexcept -> void
+    {
+        if (item->removed_) { return; }
+
+        if (item->busy_) {
+            item->pending_ = true;
+
+            return;
+        }
+
+        item->busy_ = true;
+        changed_ = true;
+        parent_.post([this, item] { execute(item); });
+    }
+    auto execute(const Pointer& item) noexcept -> void
+    {
+        {
+            auto lock = Lock{lock_};
+
+            if (false == item->removed_) {
+                if (item->notified_) {
+                    item->notified_ = false;
+                    record_latency(Clock::now() - item->notify_time_);
+                }
+
+                lock.unlock();
+
+                try {
+                    item->cb_();
+                } catch (const std::exception& e) {
+                    LogOutput(OT_METHOD)(__FUNCTION__)(
+                        ": Callback exception: ")(e.what())
+                        .Flush();
+                } catch (...) {
+                    LogOutput(OT_METHOD)(__FUNCTION__)(": Callback exception")
+                        .Flush();
+                }
+            }
+        }
+
+        release(item);
+    }
+    auto record_latency(const Clock::duration elapsed) noexcept -> void
+    {
+        const auto micros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count());
+        ++notifications_;
+        latency_total_ += micros;
+        auto max = latency_max_.load();
+
+        while ((micros > max) &&
+               (false == latency_max_.compare_exchange_weak(max, micros))) {}
+    }
+    // Returns the sockets to the poll set once the callback or a job has
+    // finished with them, or completes a removal which happened meanwhile
+    auto release(const Pointer& item) noexcept -> void
+    {
+        auto done = Callback{};
+
+        {
+            auto lock = Lock{lock_};
+
+            if (item->removed_) {
+                item->busy_ = false;
+                done = std::move(item->done_);
+            } else if (item->pending_) {
+                // Requeue instead of looping so other callbacks get a turn
+                item->pending_ = false;
+                parent_.post([this, item] { execute(item); });
+
+                return;
+            } else {
+                item->busy_ = false;
+                changed_ = true;
+                wake(lock);
+            }
+        }
+
+        cv_.notify_all();
+        finish(done);
+    }
+    auto run() noexcept -> void
+    {
+        reactor_thread_ = &parent_;
+        auto poll = std::vector<zmq_pollitem_t>{};
+        auto owners = std::vector<Pointer>{};
+        auto released = std::vector<Pointer>{};
+
+        while (running_) {
+            {
+                auto lock = Lock{lock_};
+
+                for (const auto id : notified_) {
+                    auto it = items_.find(id);
+
+                    if (items_.end() != it) { dispatch(lock, it->second); }
+                }
+
+                notified_.clear();
+
+                if (changed_) {
+                    poll.clear();
+                    owners.clear();
+                    poll.push_back({wake_receive_.get(), 0, ZMQ_POLLIN, 0});
+                    owners.emplace_back();
+
+                    // Sockets which belong to a busy item are being used by a
+                    // worker thread
+                    for (const auto& [id, item] : items_) {
+                        if (item->busy_) { continue; }
+
+                        for (auto* socket : item->sockets_) {
+                            poll.push_back({socket, 0, ZMQ_POLLIN, 0});
+                            owners.emplace_back(item);
+                        }
+                    }
+
+                    changed_ = false;
+                }
+
+                applied_ = requested_;
+                released.swap(released_);
+            }
+
+            cv_.notify_all();
+
+            for (auto& item : released) { finish(item->done_); }
+
+            released.clear();
+
+            if (false == running_) { break; }
+
+            const auto events =
+                zmq_poll(poll.data(), static_cast<int>(poll.size()), -1);
+            ++wakeups_;
+
+            if (0 > events) {
+                const auto error = zmq_errno();
+
+                if (ETERM == error) { break; }
+
+                if (EINTR != error) {
+                    LogOutput(OT_METHOD)(__FUNCTION__)(": Poll error: ")(
+                        zmq_strerror(error))
+                        .Flush();
+                }
+
+                continue;
+            }
+
+            auto lock = Lock{lock_};
+
+            if (0 != (poll.at(0).revents & ZMQ_POLLIN)) {
+                // Any notification whose wakeup is discarded here will be
+                // found at the top of the loop
+                wake_pending_ = false;
+                auto byte = char{};
+
+                while (0 <= zmq_recv(
+                                wake_receive_.get(), &byte, 1, ZMQ_DONTWAIT)) {}
+            }
+
+            for (auto i = std::size_t{1}; i < poll.size(); ++i) {
+                if (0 == (poll.at(i).revents & ZMQ_POLLIN)) { continue; }
+
+                // dispatch() ignores items which are already busy, including
+                // items with more than one readable socket
+                dispatch(lock, owners.at(i));
+            }
+        }
+
+        auto lock = Lock{lock_};
+        applied_ = std::numeric_limits<std::uint64_t>::max();
+    }
+    auto wake(const Lock& lock) noexcept -> void
+    {
+        if (wake_pending_ || (false == bool(wake_send_))) { return; }
+
+        auto byte = char{0};
+
+        if (0 <= zmq_send(wake_send_.get(), &byte, 1, ZMQ_DONTWAIT)) {
+            wake_pending_ = true;
+        }
+    }
+
+    Shard() = delete;
+    Shard(const Shard&) = delete;
+    Shard(Shard&&) = delete;
+    auto operator=(const Shard&) -> Shard& = delete;
+    auto operator=(Shard&&) -> Shard& = delete;
+};
+
+Reactor::Reactor(
+    void* context,
+    const std::size_t threads,
+    const std::size_t workers) noexcept
+    : shards_()
+    , lock_()
+    , next_id_(0)
+    , index_()
+    , job_lock_()
+    , job_cv_()
+    , jobs_()
+    , stop_(false)
+    , workers_()
+{
+    for (auto i = std::size_t{0}; i < std::max(workers, std::size_t{1}); ++i) {
+        workers_.emplace_back(&Reactor::work, this);
+    }
+
+    for (auto i = std::size_t{0}; i < std::max(threads, std::size_t{1}); ++i) {
+        shards_.emplace_back(std::make_unique<Shard>(*this, context));
+    }
+}
+
+auto Reactor::Add(const std::vector<void*>& sockets, Callback&& cb) noexcept
+    -> std::size_t
+{
+    auto lock = Lock{lock_};
+    auto* shard = std::min_element(
+                      shards_.begin(),
+                      shards_.end(),
+                      [](const auto& lhs, const auto& rhs) {
+                          return lhs->Count() < rhs->Count();
+                      })
+                      ->get();
+    const auto id = ++next_id_;
+
+    if (false == shard->Add(id, sockets, std::move(cb))) { return 0; }
+
+    index_.emplace(id, shard);
+
+    return id;
+}
+
+auto Reactor::IsReactorThread() const noexcept -> bool
+{
+    return this == reactor_thread_;
+}
+
+auto Reactor::Notify(const std::size_t id) noexcept -> void
+{
+    auto* shard = this->shard(id);
+
+    if (nullptr != shard) { shard->Notify(id); }
+}
+
+auto Reactor::post(Callback&& job) noexcept -> void
+{
+    {
+        auto lock = Lock{job_lock_};
+
+        if (stop_) { return; }
+
+        jobs_.emplace_back(std::move(job));
+    }
+
+    job_cv_.notify_one();
+}
+
+auto Reactor::Remove(const std::size_t id, Callback&& done) noexcept -> bool
+{
+    auto* shard = [&]() -> Shard* {
+        auto lock = Lock{lock_};
+        auto it = index_.find(id);
+
+        if (index_.end() == it) { return nullptr; }
+
+        auto* output = it->second;
+        index_.erase(it);
+
+        return output;
+    }();
+
+    if (nullptr == shard) { return true; }
+
+    return shard->Remove(id, std::move(done));
+}
+
+auto Reactor::Run(const std::size_t id, const Callback& job) noexcept -> bool
+{
+    auto* shard = this->shard(id);
+
+    return (nullptr == shard) ? false : shard->Run(id, job);
+}
+
+auto Reactor::shard(const std::size_t id) const noexcept -> Shard*
+{
+    auto lock = Lock{lock_};
+    auto it = index_.find(id);
+
+    return (index_.end() == it) ? nullptr : it->second;
+}
+
+auto Reactor::Stats() const noexcept -> Statistics
+{
+    auto output = Statistics{};
+    auto latency = std::uint64_t{0};
+    output.threads_ = shards_.size();
+    output.workers_ = workers_.size();
+
+    for (const auto& shard : shards_) { shard->Stats(output, latency); }
+
+    if (0 < output.notifications_) {
+        output.average_latency_ =
+            std::chrono::microseconds{latency / output.notifications_};
+    }
+
+    return output;
+}
+
+auto Reactor::work() noexcept -> void
+{
+    reactor_thread_ = this;
+    auto lock = Lock{job_lock_};
+
+    while (true) {
+        job_cv_.wait(lock, [&] { return stop_ || (0 < jobs_.size()); });
+
+        if (stop_) { return; }
+
+        auto job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
+
+Reactor::~Reactor()
+{
+    {
+        auto lock = Lock{job_lock_};
+        stop_ = true;
+        jobs_.clear();
+    }
+
+    job_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) { worker.join(); }
+    }
+
+    shards_.clear();
+}
+}  // namespace opentxs::network::zeromq::implementation
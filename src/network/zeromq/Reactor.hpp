@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "opentxs/network/zeromq/Context.hpp"
+
+namespace opentxs::network::zeromq::implementation
+{
+// Polls the sockets of many receivers from a small number of threads, instead
+// of each receiver running a thread of its own.
+//
+// Each registration is assigned to one polling shard for its lifetime. When
+// its sockets are readable, or after Notify(), the shard stops polling them
+// and hands the callback to a pool of worker threads. The sockets are polled
+// again once the callback returns, so callbacks for one registration run one
+// at a time and are the only code which touches its sockets, other than jobs
+// passed to Run(), while a slow callback only occupies one worker. Shard
+// threads never wait for callbacks.
+class Reactor
+{
+public:
+    using Callback = std::function<void()>;
+
+    using Statistics = zeromq::Context::ReactorStatistics;
+
+    // True if the calling thread is one of the reactor's polling or worker
+    // threads. Such threads must not wait for other registrations.
+    auto IsReactorThread() const noexcept -> bool;
+    auto Stats() const noexcept -> Statistics;
+
+    // Registers sockets to be polled together. The callback runs whenever
+    // any of them is readable, and after each call to Notify(). Returns 0 on
+    // failure.
+    auto Add(const std::vector<void*>& sockets, Callback&& cb) noexcept
+        -> std::size_t;
+    // Runs the callback once even if none of its sockets are readable
+    auto Notify(const std::size_t id) noexcept -> void;
+    // Stops polling the sockets and running the callback. Returns true if
+    // the sockets may be closed as soon as this returns.
+    //
+    // Other threads wait for a running callback to finish and always get
+    // true. Reactor threads never wait: if the sockets are still in use
+    // this returns false, and done runs on a reactor thread once they have
+    // been released.
+    auto Remove(const std::size_t id, Callback&& done) noexcept -> bool;
+    // Runs job on the calling thread while the sockets are neither polled
+    // nor used by the callback. Returns false without running job if the
+    // callback is running or about to run, since reactor threads must not
+    // wait for it.
+    auto Run(const std::size_t id, const Callback& job) noexcept -> bool;
+
+    Reactor(
+        void* context,
+        const std::size_t threads,
+        const std::size_t workers) noexcept;
+
+    ~Reactor();
+
+private:
+    class Shard;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    mutable std::mutex lock_;
+    std::size_t next_id_;
+    std::map<std::size_t, Shard*> index_;
+    std::mutex job_lock_;
+    std::condition_variable job_cv_;
+    std::deque<Callback> jobs_;
+    bool stop_;
+    std::vector<std::thread> workers_;
+
+    auto shard(const std::size_t id) const noexcept -> Shard*;
+
+    auto post(Callback&& job) noexcept -> void;
+    auto work() noexcept -> void;
+
+    Reactor() = delete;
+    Reactor(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    auto operator=(const Reactor&) -> Reactor& = delete;
+    auto operator=(Reactor&&) -> Reactor& = delete;
+};
+}  // namespace opentxs::network::zeromq::implementation
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -21,6 +24,11 @@ namespace network
 {
 namespace zeromq
 {
+namespace implementation
+{
+class Reactor;
+}  // namespace implementation
+
 class Context;
 }  // namespace zeromq
 }  // namespace network
@@ -28,6 +36,9 @@ class Context;
 
 #define CALLBACK_WAIT_MILLISECONDS 50
 #define RECEIVER_POLL_MILLISECONDS 100
+// Maximum number of messages a socket polled by the reactor receives before
+// other sockets get a turn
+#define RECEIVER_REACTOR_BATCH 16
 
 #define RECEIVER_METHOD "opentxs::network::zeromq::implementation::Receiver::"
 
@@ -43,22 +54,33 @@ public:
 protected:
     const bool start_thread_;
     mutable std::thread receiver_thread_;
+    // Set if the socket is polled by the context's reactor instead of by
+    // receiver_thread_
+    zeromq::implementation::Reactor* const reactor_;
 
     virtual auto have_callback() const noexcept -> bool { return false; }
     void run_tasks(const Lock& lock) const noexcept;
 
     void init() noexcept override;
+    void queue_updated() const noexcept final;
     virtual void process_incoming(
         const Lock& lock,
         MessageType& message) noexcept = 0;
     void shutdown(const Lock& lock) noexcept override;
     virtual void thread() noexcept;
 
+    // If useReactor is true the socket is polled by a thread shared with
+    // other sockets and its callback runs on the reactor's worker threads.
+    // Socket operations requested from those threads, such as Start(), run
+    // immediately on the calling thread and fail if the socket's callback is
+    // running on another thread. Close() from those threads completes
+    // asynchronously.
     Receiver(
         const zeromq::Context& context,
         const SocketType type,
         const Socket::Direction direction,
-        const bool startThread) noexcept;
+        const bool startThread,
+        const bool useReactor = false) noexcept;
 
     ~Receiver() override;
 
@@ -67,11 +89,26 @@ private:
     mutable std::mutex task_lock_;
     mutable std::map<int, SocketCallback> socket_tasks_;
     mutable std::map<int, bool> task_result_;
+    mutable std::condition_variable task_cv_;
+    // The thread running reactor_callback(), and the lock it holds
+    std::atomic<std::thread::id> callback_thread_;
+    const Lock* callback_lock_;
+    mutable std::atomic<std::size_t> reactor_id_;
+    // False from the time the socket is removed from the reactor until the
+    // reactor has stopped using it. Protected by task_lock_.
+    mutable bool reactor_released_;
 
     auto add_task(SocketCallback&& cb) const noexcept -> int;
+    auto apply_reactor(SocketCallback&& cb) const noexcept -> bool;
     auto task_result(const int id) const noexcept -> bool;
     auto task_running(const int id) const noexcept -> bool;
 
+    void reactor_callback() noexcept;
+    void reactor_released() const noexcept;
+    // Returns true if the reactor no longer uses the socket
+    auto remove_from_reactor() const noexcept -> bool;
+    void wait_for_reactor() const noexcept;
+
     Receiver() = delete;
     Receiver(const Receiver&) = delete;
     Receiver(Receiver&&) = delete;
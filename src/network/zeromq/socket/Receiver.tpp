@@ -9,13 +9,18 @@
 #include <zmq.h>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 
+#include "network/zeromq/Context.hpp"
+#include "network/zeromq/Reactor.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
+#include "util/ScopeGuard.hpp"
 
 namespace opentxs::network::zeromq::socket::implementation
 {
@@ -24,14 +29,28 @@ Receiver<InterfaceType, MessageType>::Receiver(
     const zeromq::Context& context,
     const SocketType type,
     const Socket::Direction direction,
-    const bool startThread) noexcept
+    const bool startThread,
+    const bool useReactor) noexcept
     : Socket(context, type, direction)
     , start_thread_(startThread)
     , receiver_thread_()
+    , reactor_([&]() -> zeromq::implementation::Reactor* {
+        if ((false == startThread) || (false == useReactor)) { return nullptr; }
+
+        const auto* internal =
+            dynamic_cast<const zeromq::implementation::Context*>(&context);
+
+        return (nullptr == internal) ? nullptr : &internal->SocketReactor();
+    }())
     , next_task_(0)
     , task_lock_()
     , socket_tasks_()
     , task_result_()
+    , task_cv_()
+    , callback_thread_()
+    , callback_lock_(nullptr)
+    , reactor_id_(0)
+    , reactor_released_(true)
 {
 }
 
@@ -51,6 +70,8 @@ template <typename InterfaceType, typename MessageType>
 auto Receiver<InterfaceType, MessageType>::apply_socket(
     SocketCallback&& cb) const noexcept -> bool
 {
+    if (nullptr != reactor_) { return apply_reactor(std::move(cb)); }
+
     const auto id = add_task(std::move(cb));
 
     while (task_running(id)) {
@@ -60,11 +81,68 @@ auto Receiver<InterfaceType, MessageType>::apply_socket(
     return task_result(id);
 }
 
+template <typename InterfaceType, typename MessageType>
+auto Receiver<InterfaceType, MessageType>::apply_reactor(
+    SocketCallback&& cb) const noexcept -> bool
+{
+    const auto reactor = reactor_id_.load();
+
+    if (0 == reactor) { return false; }
+
+    if (reactor_->IsReactorThread()) {
+        // Waiting here could deadlock against the callback of this socket,
+        // which may itself be waiting for the calling thread, so the task
+        // either runs now or fails
+        if (std::this_thread::get_id() == callback_thread_.load()) {
+            return cb(*callback_lock_);
+        }
+
+        auto output = std::optional<bool>{};
+        const auto ran = reactor_->Run(reactor, [&] {
+            // Held by a thread which is closing the socket
+            Lock lock(lock_, std::try_to_lock);
+
+            if (lock.owns_lock()) { output = cb(lock); }
+        });
+
+        if (ran && output.has_value()) { return output.value(); }
+
+        LogOutput(RECEIVER_METHOD)(__FUNCTION__)(
+            ": Socket is in use by another thread")
+            .Flush();
+
+        return false;
+    }
+
+    const auto id = add_task(std::move(cb));
+    reactor_->Notify(reactor);
+    Lock lock(task_lock_);
+    task_cv_.wait(lock, [&] {
+        return (0 == socket_tasks_.count(id)) || (0 == reactor_id_.load());
+    });
+
+    if (0 < socket_tasks_.erase(id)) { return false; }
+
+    const auto it = task_result_.find(id);
+
+    OT_ASSERT(task_result_.end() != it);
+
+    auto output = it->second;
+    task_result_.erase(it);
+
+    return output;
+}
+
 template <typename InterfaceType, typename MessageType>
 auto Receiver<InterfaceType, MessageType>::Close() const noexcept -> bool
 {
     running_->Off();
 
+    if (false == remove_from_reactor()) {
+        // The socket is closed by reactor_released()
+        return true;
+    }
+
     if (receiver_thread_.joinable()) { receiver_thread_.join(); }
 
     return Socket::Close();
@@ -75,11 +153,116 @@ void Receiver<InterfaceType, MessageType>::init() noexcept
 {
     Socket::init();
 
-    if (start_thread_) {
+    if (false == start_thread_) { return; }
+
+    if (nullptr != reactor_) {
+        reactor_id_ = reactor_->Add({socket_}, [this] { reactor_callback(); });
+    }
+
+    if (0 == reactor_id_.load()) {
         receiver_thread_ = std::thread(&Receiver::thread, this);
     }
 }
 
+template <typename InterfaceType, typename MessageType>
+void Receiver<InterfaceType, MessageType>::queue_updated() const noexcept
+{
+    const auto id = reactor_id_.load();
+
+    if (0 < id) { reactor_->Notify(id); }
+}
+
+template <typename InterfaceType, typename MessageType>
+void Receiver<InterfaceType, MessageType>::reactor_callback() noexcept
+{
+    Lock lock(lock_, std::try_to_lock);
+
+    if (false == lock.owns_lock()) {
+        // Try again on the next pass through the reactor
+        queue_updated();
+
+        return;
+    }
+
+    if (false == running_.get()) { return; }
+
+    callback_lock_ = &lock;
+    callback_thread_.store(std::this_thread::get_id());
+    auto postcondition = ScopeGuard{[this] {
+        callback_thread_.store(std::thread::id{});
+        callback_lock_ = nullptr;
+    }};
+
+    for (const auto& endpoint : endpoint_queue_.pop()) {
+        start(lock, endpoint);
+    }
+
+    run_tasks(lock);
+
+    // Messages remain queued in the socket until a callback is available
+    if (false == have_callback()) { return; }
+
+    for (auto i = 0; i < RECEIVER_REACTOR_BATCH; ++i) {
+        auto events = int{0};
+        auto size = sizeof(events);
+
+        if (0 != zmq_getsockopt(socket_, ZMQ_EVENTS, &events, &size)) {
+            break;
+        }
+
+        if (0 == (events & ZMQ_POLLIN)) { break; }
+
+        auto reply = MessageType::Factory();
+
+        if (false == Socket::receive_message(lock, socket_, reply)) { break; }
+
+        process_incoming(lock, reply);
+    }
+}
+
+template <typename InterfaceType, typename MessageType>
+void Receiver<InterfaceType, MessageType>::reactor_released() const noexcept
+{
+    {
+        // If the lock is not available the socket is being shut down by
+        // another thread, which closes it after wait_for_reactor()
+        Lock lock(lock_, std::try_to_lock);
+
+        if (lock.owns_lock() && (false == running_.get())) {
+            const_cast<Receiver*>(this)->Socket::shutdown(lock);
+        }
+    }
+
+    Lock lock(task_lock_);
+    reactor_released_ = true;
+    task_cv_.notify_all();
+}
+
+template <typename InterfaceType, typename MessageType>
+auto Receiver<InterfaceType, MessageType>::remove_from_reactor() const noexcept
+    -> bool
+{
+    const auto id = reactor_id_.exchange(0);
+
+    if (0 == id) { return true; }
+
+    {
+        Lock lock(task_lock_);
+        reactor_released_ = false;
+    }
+
+    if (reactor_->Remove(id, [this] { reactor_released(); })) {
+        Lock lock(task_lock_);
+        reactor_released_ = true;
+        // Release any thread waiting in apply_reactor()
+        task_cv_.notify_all();
+
+        return true;
+    }
+
+    return false;
+}
+
 template <typename InterfaceType, typename MessageType>
 void Receiver<InterfaceType, MessageType>::run_tasks(
     const Lock& lock) const noexcept
@@ -92,11 +275,16 @@ void Receiver<InterfaceType, MessageType>::run_tasks(
         task_result_.emplace(id, cb(lock));
         i = socket_tasks_.erase(i);
     }
+
+    task_cv_.notify_all();
 }
 
 template <typename InterfaceType, typename MessageType>
 void Receiver<InterfaceType, MessageType>::shutdown(const Lock& lock) noexcept
 {
+    remove_from_reactor();
+    wait_for_reactor();
+
     if (receiver_thread_.joinable()) { receiver_thread_.join(); }
 
     Socket::shutdown(lock);
@@ -178,9 +366,19 @@ void Receiver<InterfaceType, MessageType>::thread() noexcept
     }
 }
 
+template <typename InterfaceType, typename MessageType>
+void Receiver<InterfaceType, MessageType>::wait_for_reactor() const noexcept
+{
+    Lock lock(task_lock_);
+    task_cv_.wait(lock, [&] { return reactor_released_; });
+}
+
 template <typename InterfaceType, typename MessageType>
 Receiver<InterfaceType, MessageType>::~Receiver()
 {
+    remove_from_reactor();
+    wait_for_reactor();
+
     if (receiver_thread_.joinable()) { receiver_thread_.join(); }
 }
 }  // namespace opentxs::network::zeromq::socket::implementation
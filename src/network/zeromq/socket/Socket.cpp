@@ -318,8 +318,12 @@ auto Socket::Start(const std::string& endpoint) const noexcept -> bool
 
 auto Socket::StartAsync(const std::string& endpoint) const noexcept -> void
 {
-    Lock lock{endpoint_queue_.lock_};
-    endpoint_queue_.queue_.push(endpoint);
+    {
+        Lock lock{endpoint_queue_.lock_};
+        endpoint_queue_.queue_.push(endpoint);
+    }
+
+    queue_updated();
 }
 
 auto Socket::start(const Lock& lock, const std::string& endpoint) const noexcept
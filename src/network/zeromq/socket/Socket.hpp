@@ -126,6 +126,8 @@ protected:
         -> bool;
 
     virtual void init() noexcept {}
+    // Called after StartAsync() queues an endpoint
+    virtual void queue_updated() const noexcept {}
     virtual void shutdown(const Lock& lock) noexcept;
 
     explicit Socket(
@@ -46,7 +46,12 @@ namespace opentxs::network::zeromq::socket::implementation
 Subscribe::Subscribe(
     const zeromq::Context& context,
     const zeromq::ListenCallback& callback) noexcept
-    : Receiver(context, SocketType::Subscribe, Socket::Direction::Connect, true)
+    : Receiver(
+          context,
+          SocketType::Subscribe,
+          Socket::Direction::Connect,
+          true,
+          true)
     , Client(this->get())
     , callback_(callback)
 {
@@ -8,15 +8,15 @@
 #include "opentxs/otx/consensus/TransactionStatement.hpp"  // IWYU pragma: associated
 
 #include <irrxml/irrXML.hpp>
-#include <memory>
 
+#include "core/XMLReader.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/core/Armored.hpp"
 #include "opentxs/core/Contract.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
 #include "opentxs/core/NumList.hpp"
-#include "opentxs/core/StringXML.hpp"
+#include "opentxs/core/String.hpp"
 #include "opentxs/core/util/Tag.hpp"
 
 #define OT_METHOD "opentxs::TransactionStatement::"
@@ -46,11 +46,8 @@ TransactionStatement::TransactionStatement(const String& serialized)
     , available_()
     , issued_()
 {
-    auto raw =
-        irr::io::createIrrXMLReader(StringXML::Factory(serialized).get());
-    std::unique_ptr<irr::io::IrrXMLReader> xml(raw);
-
-    if (!xml) { return; }
+    auto reader = XMLReader{serialized};
+    irr::io::IrrXMLReader* xml = &reader;
 
     while (xml && xml->read()) {
         const auto nodeName = String::Factory(xml->getNodeName());
@@ -69,7 +66,7 @@ TransactionStatement::TransactionStatement(const String& serialized)
                     notary_ = xml->getAttributeValue("notaryID");
                     auto list = String::Factory();
                     const bool loaded =
-                        Contract::LoadEncodedTextField(raw, list);
+                        Contract::LoadEncodedTextField(xml, list);
 
                     if (notary_.empty() || !loaded) {
                         LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -97,7 +94,7 @@ TransactionStatement::TransactionStatement(const String& serialized)
                     notary_ = xml->getAttributeValue("notaryID");
                     auto list = String::Factory();
                     const bool loaded =
-                        Contract::LoadEncodedTextField(raw, list);
+                        Contract::LoadEncodedTextField(xml, list);
 
                     if (notary_.empty() || !loaded) {
                         LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -15,6 +15,7 @@
 #include <utility>
 
 #include "core/OTStorage.hpp"
+#include "core/XMLReader.hpp"
 #include "internal/api/Api.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
@@ -272,9 +273,8 @@ auto MainFile::LoadMainFile(bool bReadOnly) -> bool
             return false;
         }
 
-        irr::io::IrrXMLReader* xml =
-            irr::io::createIrrXMLReader(xmlFileContents.get());
-        std::unique_ptr<irr::io::IrrXMLReader> theXMLGuardian(xml);
+        auto reader = XMLReader{xmlFileContents.get()};
+        irr::io::IrrXMLReader* xml = &reader;
 
         while (xml && xml->read()) {
             // strings for storing the data that we want to read out of the file
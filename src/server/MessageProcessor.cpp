@@ -7,7 +7,9 @@
 #include "1_Internal.hpp"               // IWYU pragma: associated
 #include "server/MessageProcessor.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <ostream>
@@ -62,6 +64,53 @@ namespace zmq = opentxs::network::zeromq;
 
 namespace opentxs::server
 {
+// Maximum number of cron items processed before yielding to requests
+constexpr auto cron_slice_ = std::size_t{100};
+
+MessageProcessor::ResourceLocks::ResourceLocks() noexcept
+    : lock_()
+    , cv_()
+    , held_()
+{
+}
+
+MessageProcessor::ResourceLocks::Guard::Guard(
+    ResourceLocks& parent,
+    Keys&& keys) noexcept
+    : parent_(parent)
+    , keys_(std::move(keys))
+{
+    parent_.acquire(keys_);
+}
+
+auto MessageProcessor::ResourceLocks::acquire(const Keys& keys) noexcept
+    -> void
+{
+    // Waiting until every key is available at once, instead of acquiring them
+    // one at a time, prevents deadlocks between requests with overlapping keys
+    auto lock = std::unique_lock<std::mutex>{lock_};
+    cv_.wait(lock, [&] {
+        return std::none_of(keys.begin(), keys.end(), [&](const auto& key) {
+            return 0 < held_.count(key);
+        });
+    });
+    held_.insert(keys.begin(), keys.end());
+}
+
+auto MessageProcessor::ResourceLocks::release(const Keys& keys) noexcept
+    -> void
+{
+    {
+        Lock lock(lock_);
+
+        for (const auto& key : keys) { held_.erase(key); }
+    }
+
+    cv_.notify_all();
+}
+
+MessageProcessor::ResourceLocks::Guard::~Guard() { parent_.release(keys_); }
+
 MessageProcessor::MessageProcessor(
     Server& server,
     const PasswordPrompt& reason,
@@ -80,9 +129,7 @@ MessageProcessor::MessageProcessor(
           [=](const zmq::Message& incoming) -> OTZMQMessage {
               return this->process_backend(incoming);
           }))
-    , backend_socket_(server.API().ZeroMQ().ReplySocket(
-          backend_callback_,
-          zmq::socket::Socket::Direction::Bind))
+    , backend_sockets_()
     , internal_callback_(zmq::ListenCallback::Factory(
           [=](const zmq::Message& incoming) -> void {
               this->process_internal(incoming);
@@ -105,10 +152,13 @@ MessageProcessor::MessageProcessor(
     , drop_outgoing_(0)
     , active_connections_()
     , connection_map_lock_()
+    , notary_lock_()
+    , resource_locks_()
+    , cron_lock_()
+    , cron_cv_()
+    , cron_wake_(false)
 {
-    auto bound = backend_socket_->Start(internal_endpoint_);
-    bound &= internal_socket_->Start(internal_endpoint_);
-    bound &= notification_socket_->Start(
+    const auto bound = notification_socket_->Start(
         server_.API().Endpoints().InternalPushNotification());
 
     OT_ASSERT(bound);
@@ -136,7 +186,10 @@ void MessageProcessor::cleanup()
     frontend_socket_->Close();
     notification_socket_->Close();
     internal_socket_->Close();
-    backend_socket_->Close();
+
+    for (auto& socket : backend_sockets_) { socket->Close(); }
+
+    wake_cron();
 
     if (thread_.joinable()) { thread_.join(); }
 }
@@ -176,10 +229,32 @@ auto MessageProcessor::get_connection(const network::zeromq::Message& incoming)
 void MessageProcessor::init(
     const bool inproc,
     const int port,
-    const Secret& privkey)
+    const Secret& privkey,
+    const std::size_t workers)
 {
     if (port == 0) { OT_FAIL; }
 
+    const auto count = (0 < workers)
+                           ? workers
+                           : std::max(1u, std::thread::hardware_concurrency());
+
+    // The internal dealer socket distributes requests between the worker
+    // sockets, each of which processes requests on its own thread
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        const auto endpoint = internal_endpoint_ + "/" + std::to_string(i);
+        auto& socket = backend_sockets_.emplace_back(
+            server_.API().ZeroMQ().ReplySocket(
+                backend_callback_, zmq::socket::Socket::Direction::Bind));
+        auto started = socket->Start(endpoint);
+        started &= internal_socket_->Start(endpoint);
+
+        OT_ASSERT(started);
+    }
+
+    LogDetail(OT_METHOD)(__FUNCTION__)(": Processing requests with ")(count)(
+        " workers")
+        .Flush();
+
     auto set = frontend_socket_->SetPrivateKey(privkey);
 
     OT_ASSERT(set);
@@ -211,24 +286,58 @@ void MessageProcessor::init(
 void MessageProcessor::run()
 {
     while (running_) {
-        // timeout is the time left until the next cron should execute.
-        const auto timeout = server_.ComputeTimeout();
+        // timeout is the time left until the next cron item is due.
+        const auto timeout = [&] {
+            sLock lock(notary_lock_);
+
+            return server_.ComputeTimeout();
+        }();
 
         if (timeout.count() <= 0) {
-            // ProcessCron and process_backend must not run simultaneously
-            Lock lock(lock_);
-            server_.ProcessCron();
+            {
+                // ProcessCron and request processing must not run
+                // simultaneously
+                eLock lock(notary_lock_);
+                server_.ProcessCron(cron_slice_);
+            }
+
+            // Let waiting requests run before the next slice
+            std::this_thread::yield();
+
+            continue;
         }
 
-        Sleep(std::chrono::milliseconds(50));
+        Lock lock(cron_lock_);
+        cron_cv_.wait_for(lock, timeout, [this] {
+            return cron_wake_ || (false == running_);
+        });
+        cron_wake_ = false;
+    }
+}
+
+void MessageProcessor::wake_cron()
+{
+    {
+        Lock lock(cron_lock_);
+        cron_wake_ = true;
     }
+
+    cron_cv_.notify_all();
+}
+
+auto MessageProcessor::is_unarmored(const std::string& request) noexcept
+    -> bool
+{
+    // The base64 alphabet does not include '-', so an armored request can not
+    // begin with the bookend
+    static const auto prefix = std::string{OT_BEGIN_SIGNED};
+
+    return 0 == request.compare(0, prefix.size(), prefix);
 }
 
 auto MessageProcessor::process_backend(const zmq::Message& incoming)
     -> OTZMQMessage
 {
-    // ProcessCron and process_backend must not run simultaneously
-    Lock lock(lock_);
     std::string reply{};
 
     std::string messageString{};
@@ -246,6 +355,42 @@ auto MessageProcessor::process_backend(const zmq::Message& incoming)
     return output;
 }
 
+auto MessageProcessor::is_exclusive(const Message& request) noexcept -> bool
+{
+    // These commands modify accounts, markets, baskets, or cron items which
+    // are only identified inside the request payload, so they can not be keyed
+    switch (Message::Type(request.m_strCommand->Get())) {
+        case MessageType::pingNotary:
+        case MessageType::registerNym:
+        case MessageType::getRequestNumber:
+        case MessageType::getTransactionNumbers:
+        case MessageType::checkNym:
+        case MessageType::sendNymMessage:
+        case MessageType::getNymbox:
+        case MessageType::getBoxReceipt:
+        case MessageType::getAccountData:
+        case MessageType::processNymbox:
+        case MessageType::queryInstrumentDefinitions:
+        case MessageType::getInstrumentDefinition:
+        case MessageType::getMint:
+        case MessageType::getMarketList:
+        case MessageType::getMarketOffers:
+        case MessageType::getMarketRecentTrades:
+        case MessageType::getNymMarketOffers:
+        case MessageType::usageCredits:
+        case MessageType::registerContract:
+        case MessageType::requestAdmin:
+        case MessageType::addClaim: {
+
+            return false;
+        }
+        default: {
+
+            return true;
+        }
+    }
+}
+
 auto MessageProcessor::process_command(
     const proto::ServerRequest& serialized,
     identifier::Nym& nymID) -> bool
@@ -342,11 +487,29 @@ auto MessageProcessor::process_message(
         return true;
     }
 
-    auto armored = Armored::Factory();
-    armored->MemSet(
-        messageString.data(), static_cast<std::uint32_t>(messageString.size()));
+    if (OT_UNARMORED_PROBE == messageString) {
+        reply = OT_UNARMORED_PROBE;
+
+        return false;
+    }
+
+    // Replies use the same encoding as the request, so clients which do not
+    // send plain text requests always receive armored replies
+    const auto unarmored = is_unarmored(messageString);
     auto serialized = String::Factory();
-    armored->GetString(serialized);
+
+    if (unarmored) {
+        serialized->Set(
+            messageString.data(),
+            static_cast<std::uint32_t>(messageString.size()));
+    } else {
+        auto armored = Armored::Factory();
+        armored->MemSet(
+            messageString.data(),
+            static_cast<std::uint32_t>(messageString.size()));
+        armored->GetString(serialized);
+    }
+
     auto request{server_.API().Factory().Message()};
 
     if (false == serialized->Exists()) {
@@ -367,8 +530,7 @@ auto MessageProcessor::process_message(
 
     OT_ASSERT(false != bool(replymsg));
 
-    const bool processed =
-        server_.CommandProcessor().ProcessUserCommand(*request, *replymsg);
+    const bool processed = process_user_command(*request, *replymsg);
 
     if (false == processed) {
         LogDetail(OT_METHOD)(__FUNCTION__)(": Failed to process user command ")(
@@ -390,6 +552,12 @@ auto MessageProcessor::process_message(
         return true;
     }
 
+    if (unarmored) {
+        reply.assign(serializedReply->Get(), serializedReply->GetLength());
+
+        return false;
+    }
+
     auto armoredReply = Armored::Factory(serializedReply);
 
     if (false == armoredReply->Exists()) {
@@ -488,6 +656,32 @@ void MessageProcessor::process_proto(
     }
 }
 
+auto MessageProcessor::process_user_command(
+    const Message& request,
+    Message& reply) -> bool
+{
+    if (is_exclusive(request)) {
+        auto output = bool{false};
+
+        {
+            eLock lock(notary_lock_);
+            output =
+                server_.CommandProcessor().ProcessUserCommand(request, reply);
+        }
+
+        // Exclusive commands are the ones which may add or remove cron items
+        wake_cron();
+
+        return output;
+    }
+
+    sLock lock(notary_lock_);
+    const auto resources =
+        ResourceLocks::Guard{resource_locks_, resource_keys(request)};
+
+    return server_.CommandProcessor().ProcessUserCommand(request, reply);
+}
+
 auto MessageProcessor::query_connection(const identifier::Nym& nymID) -> OTData
 {
     sLock lock(connection_map_lock_);
@@ -498,6 +692,31 @@ auto MessageProcessor::query_connection(const identifier::Nym& nymID) -> OTData
     return it->second;
 }
 
+auto MessageProcessor::resource_keys(const Message& request) noexcept
+    -> ResourceLocks::Keys
+{
+    auto output = ResourceLocks::Keys{};
+    // The context, nymbox, and issued transaction numbers of a nym are only
+    // modified by requests from that nym, or by requests which name it as the
+    // recipient
+    output.emplace(std::string{"nym "} + request.m_strNymID->Get());
+
+    switch (Message::Type(request.m_strCommand->Get())) {
+        case MessageType::sendNymMessage:
+        case MessageType::usageCredits: {
+            output.emplace(std::string{"nym "} + request.m_strNymID2->Get());
+        } break;
+        default: {
+        }
+    }
+
+    if (request.m_strAcctID->Exists()) {
+        output.emplace(std::string{"account "} + request.m_strAcctID->Get());
+    }
+
+    return output;
+}
+
 void MessageProcessor::Start()
 {
     thread_ = std::thread(&MessageProcessor::run, this);
@@ -6,18 +6,21 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "opentxs/Proto.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Identifier.hpp"
-#include "opentxs/core/Lockable.hpp"
 #include "opentxs/network/zeromq/ListenCallback.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 #include "opentxs/network/zeromq/ReplyCallback.hpp"
@@ -51,6 +54,7 @@ class Server;
 }  // namespace server
 
 class Flag;
+class Message;
 class OTPassword;
 class PasswordPrompt;
 class Secret;
@@ -58,14 +62,22 @@ class Secret;
 
 namespace opentxs::server
 {
-class MessageProcessor final : Lockable
+class MessageProcessorTest;
+
+class MessageProcessor final
 {
 public:
     void DropIncoming(const int count) const;
     void DropOutgoing(const int count) const;
 
     void cleanup();
-    void init(const bool inproc, const int port, const Secret& privkey);
+    /// workers: number of requests processed concurrently, or 0 to use one
+    /// per hardware thread
+    void init(
+        const bool inproc,
+        const int port,
+        const Secret& privkey,
+        const std::size_t workers = 0);
     void Start();
 
     explicit MessageProcessor(
@@ -73,16 +85,59 @@ public:
         const PasswordPrompt& reason,
         const Flag& running);
 
-    ~MessageProcessor() final;
+    ~MessageProcessor();
 
 private:
+    friend MessageProcessorTest;
+
+    // Serializes requests which use the same nym, account, or other resource
+    // identified by a key. All keys for a request are acquired together.
+    class ResourceLocks
+    {
+    public:
+        using Keys = std::set<std::string>;
+
+        class Guard
+        {
+        public:
+            OPENTXS_EXPORT Guard(ResourceLocks& parent, Keys&& keys) noexcept;
+
+            OPENTXS_EXPORT ~Guard();
+
+        private:
+            ResourceLocks& parent_;
+            const Keys keys_;
+
+            Guard() = delete;
+            Guard(const Guard&) = delete;
+            Guard(Guard&&) = delete;
+            auto operator=(const Guard&) -> Guard& = delete;
+            auto operator=(Guard&&) -> Guard& = delete;
+        };
+
+        OPENTXS_EXPORT ResourceLocks() noexcept;
+
+    private:
+        std::mutex lock_;
+        std::condition_variable cv_;
+        Keys held_;
+
+        auto acquire(const Keys& keys) noexcept -> void;
+        auto release(const Keys& keys) noexcept -> void;
+
+        ResourceLocks(const ResourceLocks&) = delete;
+        ResourceLocks(ResourceLocks&&) = delete;
+        auto operator=(const ResourceLocks&) -> ResourceLocks& = delete;
+        auto operator=(ResourceLocks&&) -> ResourceLocks& = delete;
+    };
+
     Server& server_;
     const PasswordPrompt& reason_;
     const Flag& running_;
     OTZMQListenCallback frontend_callback_;
     OTZMQRouterSocket frontend_socket_;
     OTZMQReplyCallback backend_callback_;
-    OTZMQReplySocket backend_socket_;
+    std::vector<OTZMQReplySocket> backend_sockets_;
     OTZMQListenCallback internal_callback_;
     OTZMQDealerSocket internal_socket_;
     OTZMQListenCallback notification_callback_;
@@ -95,9 +150,24 @@ private:
     // nym id, connection identifier
     std::map<OTIdentifier, OTData> active_connections_;
     mutable std::shared_mutex connection_map_lock_;
+    // Held exclusively by cron and by requests which may modify state shared
+    // between nyms, and shared by all other requests
+    std::shared_mutex notary_lock_;
+    ResourceLocks resource_locks_;
+    // Wakes the cron thread when cron items may have been added or changed
+    std::mutex cron_lock_;
+    std::condition_variable cron_cv_;
+    bool cron_wake_;
 
     static auto get_connection(const network::zeromq::Message& incoming)
         -> OTData;
+    OPENTXS_EXPORT static auto is_exclusive(const Message& request) noexcept
+        -> bool;
+    // True if the request carries the signed message as plain text instead of
+    // compressing and armoring it
+    static auto is_unarmored(const std::string& request) noexcept -> bool;
+    OPENTXS_EXPORT static auto resource_keys(const Message& request) noexcept
+        -> ResourceLocks::Keys;
 
     auto extract_proto(const network::zeromq::Frame& incoming) const
         -> proto::ServerRequest;
@@ -117,12 +187,14 @@ private:
         const network::zeromq::Message& incoming);
     auto process_message(const std::string& messageString, std::string& reply)
         -> bool;
+    auto process_user_command(const Message& request, Message& reply) -> bool;
     void process_notification(const network::zeromq::Message& incoming);
     void process_proto(
         const Data& id,
         const network::zeromq::Message& incoming);
     auto query_connection(const identifier::Nym& nymID) -> OTData;
     void run();
+    void wake_cron();
 
     MessageProcessor() = delete;
 };
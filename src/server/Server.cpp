@@ -8,6 +8,7 @@
 #include "server/Server.hpp"  // IWYU pragma: associated
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <regex>
@@ -110,12 +111,10 @@ void Server::ActivateCron()
     }
 }
 
-/// Currently the test server calls this 10 times per second.
-/// It also processes all the input/output at the same rate.
-/// It sleeps in between. (See testserver.cpp for the call
-/// and OTSleep() for the sleep code.)
+/// MessageProcessor calls this whenever ComputeTimeout() indicates a cron item
+/// is due, and again after yielding to requests until no due items remain.
 ///
-void Server::ProcessCron()
+void Server::ProcessCron(const std::size_t limit)
 {
     if (!m_Cron->IsActivated()) return;
 
@@ -137,9 +136,9 @@ void Server::ProcessCron()
 
     if (bAddedNumbers) { m_Cron->SaveCron(); }
 
-    m_Cron->ProcessCronItems();  // This needs to be called regularly for
-                                 // trades, markets, payment plans, etc to
-                                 // process.
+    m_Cron->ProcessCronItems(limit);  // This needs to be called regularly
+                                      // for trades, markets, payment plans,
+                                      // etc to process.
 
     // NOTE:  TODO:  OTHER RE-OCCURRING SERVER FUNCTIONS CAN GO HERE AS WELL!!
     //
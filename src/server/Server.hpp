@@ -104,7 +104,8 @@ public:
     auto GetTransactor() -> Transactor& { return transactor_; }
     void Init(bool readOnly = false);
     auto LoadServerNym(const identifier::Nym& nymID) -> bool;
-    void ProcessCron();
+    /// Processes at most limit due cron items
+    void ProcessCron(const std::size_t limit);
     auto SendInstrumentToNym(
         const identifier::Server& notaryID,
         const identifier::Nym& senderNymID,
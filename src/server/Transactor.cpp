@@ -33,6 +33,7 @@ namespace opentxs::server
 Transactor::Transactor(Server& server, const PasswordPrompt& reason)
     : server_(server)
     , reason_(reason)
+    , number_lock_()
     , transactionNumber_(0)
     , idToBasketMap_()
     , contractIdToBasketAccountId_()
@@ -50,6 +51,15 @@ Transactor::Transactor(Server& server, const PasswordPrompt& reason)
 /// can be used in transaction requests.
 auto Transactor::issueNextTransactionNumber(
     TransactionNumber& lTransactionNumber) -> bool
+{
+    Lock lock(number_lock_);
+
+    return issue_next_number(lock, lTransactionNumber);
+}
+
+auto Transactor::issue_next_number(
+    [[maybe_unused]] const Lock& lock,
+    TransactionNumber& lTransactionNumber) -> bool
 {
     // transactionNumber_ stores the last VALID AND ISSUED transaction number.
     // So first, we increment that, since we don't want to issue the same number
@@ -75,7 +85,9 @@ auto Transactor::issueNextTransactionNumberToNym(
     otx::context::Client& context,
     TransactionNumber& lTransactionNumber) -> bool
 {
-    if (!issueNextTransactionNumber(lTransactionNumber)) { return false; }
+    Lock lock(number_lock_);
+
+    if (!issue_next_number(lock, lTransactionNumber)) { return false; }
 
     // Each Nym stores the transaction numbers that have been issued to it.
     // (On client AND server side.)
@@ -84,7 +96,7 @@ auto Transactor::issueNextTransactionNumberToNym(
     // it is recorded in his Nym file before being sent to the client (where it
     // is also recorded in his Nym file.)  That way the server always knows
     // which numbers are valid for each Nym.
-    if (!context.IssueNumber(transactionNumber_)) {
+    if (!context.IssueNumber(lTransactionNumber)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
             ": Error adding transaction number to Nym file.")
             .Flush();
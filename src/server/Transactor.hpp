@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "opentxs/Types.hpp"
@@ -98,8 +100,10 @@ private:
 
     Server& server_;
     const PasswordPrompt& reason_;
+    // Serializes issuing transaction numbers between concurrent requests
+    std::mutex number_lock_;
     // This stores the last VALID AND ISSUED transaction number.
-    TransactionNumber transactionNumber_;
+    std::atomic<TransactionNumber> transactionNumber_;
     // maps basketId with basketAccountId
     BasketsMap idToBasketMap_;
     // basket issuer account ID, which is *different* on each server, using the
@@ -109,6 +113,9 @@ private:
     // The list of voucher accounts (see GetVoucherAccount below for details)
     AccountList voucherAccounts_;
 
+    auto issue_next_number(const Lock& lock, TransactionNumber& txNumber)
+        -> bool;
+
     Transactor() = delete;
 };
 }  // namespace opentxs::server
@@ -2701,6 +2701,8 @@ auto UserCommandProcessor::load_inbox(
         return {};
     }
 
+    inbox->SetLazy(true);
+
     if (false == inbox->LoadInbox()) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to load inbox for ")(
             nymID)(".")
@@ -2740,6 +2742,8 @@ auto UserCommandProcessor::load_nymbox(
         return {};
     }
 
+    nymbox->SetLazy(true);
+
     if (false == nymbox->LoadNymbox()) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to load nymbox for ")(
             nymID)(".")
@@ -2790,6 +2794,8 @@ auto UserCommandProcessor::load_outbox(
         return {};
     }
 
+    outbox->SetLazy(true);
+
     if (false == outbox->LoadOutbox()) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Unable to load outbox for ")(
             nymID)(".")
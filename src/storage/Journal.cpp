@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"         // IWYU pragma: associated
+#include "1_Internal.hpp"       // IWYU pragma: associated
+#include "storage/Journal.hpp"  // IWYU pragma: associated
+
+#include <utility>
+
+#include "opentxs/Types.hpp"
+
+namespace opentxs::storage
+{
+Journal::Journal(const opentxs::api::storage::Driver& driver) noexcept
+    : driver_(driver)
+    , sweep_lock_()
+    , lock_()
+    , written_()
+{
+}
+
+auto Journal::Delete(const std::string& key) const -> bool
+{
+    return driver_.Delete(key);
+}
+
+auto Journal::EmptyBucket(const bool bucket) const -> bool
+{
+    return driver_.EmptyBucket(bucket);
+}
+
+auto Journal::Load(
+    const std::string& key,
+    const bool checking,
+    std::string& value) const -> bool
+{
+    return driver_.Load(key, checking, value);
+}
+
+auto Journal::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const -> bool
+{
+    return driver_.LoadFromBucket(key, value, bucket);
+}
+
+auto Journal::LoadRoot() const -> std::string { return driver_.LoadRoot(); }
+
+auto Journal::Migrate(
+    const std::string& key,
+    const opentxs::api::storage::Driver& to) const -> bool
+{
+    return driver_.Migrate(key, to);
+}
+
+auto Journal::record(const std::string& key) const noexcept -> void
+{
+    Lock lock(lock_);
+    written_.emplace(key);
+}
+
+auto Journal::Reset() const noexcept -> Keys
+{
+    auto output = Keys{};
+    Lock lock(lock_);
+    output.swap(written_);
+
+    return output;
+}
+
+auto Journal::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket) const -> bool
+{
+    sLock lock(sweep_lock_);
+    record(key);
+
+    return driver_.Store(isTransaction, key, value, bucket);
+}
+
+void Journal::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>& promise) const
+{
+    sLock lock(sweep_lock_);
+    record(key);
+    driver_.Store(isTransaction, key, value, bucket, promise);
+}
+
+auto Journal::Store(
+    const bool isTransaction,
+    const std::string& value,
+    std::string& key) const -> bool
+{
+    // The key is not known until the driver has hashed the value, so the
+    // shared lock must be held until the key has been recorded to prevent a
+    // concurrent sweep from deleting an object which was just rewritten
+    sLock lock(sweep_lock_);
+    const auto output = driver_.Store(isTransaction, value, key);
+
+    if (output) { record(key); }
+
+    return output;
+}
+
+auto Journal::StoreRoot(const bool commit, const std::string& hash) const
+    -> bool
+{
+    return driver_.StoreRoot(commit, hash);
+}
+
+auto Journal::Sweep(
+    const std::vector<std::string>& garbage,
+    std::size_t& position,
+    const std::chrono::microseconds budget) const noexcept -> std::size_t
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto output = std::size_t{0};
+    eLock sweep(sweep_lock_);
+    Lock lock(lock_);
+
+    while (position < garbage.size()) {
+        const auto& key = garbage.at(position++);
+
+        if (0 == written_.count(key)) {
+            driver_.Delete(key);
+            ++output;
+        }
+
+        if ((std::chrono::steady_clock::now() - start) >= budget) { break; }
+    }
+
+    return output;
+}
+}  // namespace opentxs::storage
@@ -0,0 +1,91 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "opentxs/api/storage/Driver.hpp"
+
+namespace opentxs::storage
+{
+// Forwards every operation to the wrapped driver and records the key of
+// every object written through it.
+//
+// Between two garbage collection passes an object can only become garbage if
+// it was reachable during the previous pass or if it was written since then,
+// so the journal lets the collector avoid examining the rest of the store.
+class Journal final : virtual public opentxs::api::storage::Driver
+{
+public:
+    using Keys = std::set<std::string>;
+
+    auto Delete(const std::string& key) const -> bool final;
+    auto EmptyBucket(const bool bucket) const -> bool final;
+    auto Load(const std::string& key, const bool checking, std::string& value)
+        const -> bool final;
+    auto LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const -> bool final;
+    auto LoadRoot() const -> std::string final;
+    auto Migrate(
+        const std::string& key,
+        const opentxs::api::storage::Driver& to) const -> bool final;
+    /// Returns the keys written since the previous call and starts a new
+    /// journal
+    auto Reset() const noexcept -> Keys;
+    auto Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const -> bool final;
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const final;
+    auto Store(
+        const bool isTransaction,
+        const std::string& value,
+        std::string& key) const -> bool final;
+    auto StoreRoot(const bool commit, const std::string& hash) const
+        -> bool final;
+    /// Deletes keys starting at position until either the list is exhausted
+    /// or the time budget is spent. Writers are blocked for the duration of
+    /// the call. Keys which have been written again since the most recent
+    /// Reset() are skipped. Returns the number of deleted keys.
+    auto Sweep(
+        const std::vector<std::string>& garbage,
+        std::size_t& position,
+        const std::chrono::microseconds budget) const noexcept -> std::size_t;
+
+    Journal(const opentxs::api::storage::Driver& driver) noexcept;
+
+    ~Journal() final = default;
+
+private:
+    const opentxs::api::storage::Driver& driver_;
+    mutable std::shared_mutex sweep_lock_;
+    mutable std::mutex lock_;
+    mutable Keys written_;
+
+    auto record(const std::string& key) const noexcept -> void;
+
+    Journal() = delete;
+    Journal(const Journal&) = delete;
+    Journal(Journal&&) = delete;
+    auto operator=(const Journal&) -> Journal& = delete;
+    auto operator=(Journal&&) -> Journal& = delete;
+};
+}  // namespace opentxs::storage
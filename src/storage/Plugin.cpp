@@ -7,11 +7,15 @@
 #include "1_Internal.hpp"      // IWYU pragma: associated
 #include "storage/Plugin.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
+#include <map>
 #include <thread>
+#include <utility>
 
 #include "opentxs/api/storage/Storage.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/core/Log.hpp"
+#include "storage/StorageConfig.hpp"
 
 #define OT_METHOD "opentxs::Plugin"
 
@@ -29,9 +33,48 @@ Plugin::Plugin(
     , storage_(storage)
     , digest_(hash)
     , current_bucket_(bucket)
+    , batch_size_(std::max<std::size_t>(config.write_batch_size_, 1u))
+    , queue_limit_(std::max<std::size_t>(config.write_queue_limit_, 1u))
+    , flush_interval_(config.write_flush_interval_)
+    , write_lock_()
+    , write_ready_()
+    , write_space_()
+    , write_queue_()
+    , write_stats_()
+    , running_(true)
+    , write_thread_(&Plugin::write_queue, this)
 {
 }
 
+void Plugin::flush(WriteBatch& batch) const
+{
+    // Group writes which can share a driver transaction while preserving the
+    // order in which they were submitted within each group
+    auto groups = std::map<std::pair<bool, bool>, WriteBatch>{};
+
+    for (auto& write : batch) {
+        groups[{write.isTransaction_, write.bucket_}].emplace_back(
+            std::move(write));
+    }
+
+    for (auto& [mode, group] : groups) {
+        const auto& [isTransaction, bucket] = mode;
+        store_batch(isTransaction, bucket, group);
+    }
+}
+
+auto Plugin::Delete(const std::string& key) const -> bool
+{
+    if (key.empty()) { return false; }
+
+    // Objects may exist in either bucket if a bucket swap garbage collection
+    // was interrupted
+    const auto a = delete_key(key, true);
+    const auto b = delete_key(key, false);
+
+    return a && b;
+}
+
 auto Plugin::Load(
     const std::string& key,
     const bool checking,
@@ -131,9 +174,25 @@ void Plugin::Store(
     const bool bucket,
     std::promise<bool>& promise) const
 {
-    std::thread thread(
-        &Plugin::store, this, isTransaction, key, value, bucket, &promise);
-    thread.detach();
+    auto lock = Lock{write_lock_};
+    write_space_.wait(lock, [&] {
+        return (false == running_) || (write_queue_.size() < queue_limit_);
+    });
+
+    if (false == running_) {
+        lock.unlock();
+        store(isTransaction, key, value, bucket, &promise);
+
+        return;
+    }
+
+    write_queue_.push_back({isTransaction, key, value, bucket, &promise});
+    auto& stats = write_stats_;
+    stats.queue_depth_ = write_queue_.size();
+    stats.max_queue_depth_ =
+        std::max(stats.max_queue_depth_, stats.queue_depth_);
+    lock.unlock();
+    write_ready_.notify_one();
 }
 
 auto Plugin::Store(
@@ -151,4 +210,98 @@ auto Plugin::Store(
 
     return false;
 }
+
+void Plugin::stop_write_queue() noexcept
+{
+    if (false == write_thread_.joinable()) { return; }
+
+    {
+        auto lock = Lock{write_lock_};
+        running_ = false;
+    }
+
+    write_ready_.notify_all();
+    write_space_.notify_all();
+    write_thread_.join();
+    const auto stats = WriteQueue();
+    LogDetail(OT_METHOD)(__FUNCTION__)(": ")(stats.writes_)(" writes in ")(
+        stats.batches_)(" batches. Largest batch: ")(stats.largest_batch_)(
+        ". Maximum queue depth: ")(stats.max_queue_depth_)
+        .Flush();
+}
+
+void Plugin::store_batch(
+    const bool isTransaction,
+    const bool bucket,
+    WriteBatch& batch) const
+{
+    for (auto& write : batch) {
+        store(isTransaction, write.key_, write.value_, bucket, write.promise_);
+    }
+}
+
+auto Plugin::WriteQueue() const noexcept -> WriteQueueStats
+{
+    auto lock = Lock{write_lock_};
+
+    return write_stats_;
+}
+
+void Plugin::write_queue() noexcept
+{
+    auto lock = Lock{write_lock_};
+
+    while (true) {
+        write_ready_.wait(lock, [&] {
+            return (false == running_) || (0 < write_queue_.size());
+        });
+
+        if (write_queue_.empty()) {
+            if (running_) { continue; }
+
+            return;
+        }
+
+        if (running_ && (0 < flush_interval_.count()) &&
+            (write_queue_.size() < batch_size_)) {
+            write_ready_.wait_for(lock, flush_interval_, [&] {
+                return (false == running_) ||
+                       (write_queue_.size() >= batch_size_);
+            });
+        }
+
+        const auto count = std::min(write_queue_.size(), batch_size_);
+        auto batch = WriteBatch{};
+        batch.reserve(count);
+
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            batch.emplace_back(std::move(write_queue_.front()));
+            write_queue_.pop_front();
+        }
+
+        // Statistics are updated before the batch is written so they already
+        // account for it when its promises are satisfied
+        const auto remaining = write_queue_.size();
+        auto& stats = write_stats_;
+        stats.queue_depth_ = remaining;
+        ++stats.batches_;
+        stats.writes_ += count;
+        stats.last_batch_ = count;
+        stats.largest_batch_ = std::max(stats.largest_batch_, count);
+        lock.unlock();
+        write_space_.notify_all();
+        LogTrace(OT_METHOD)(__FUNCTION__)(": Writing ")(count)(
+            " items. Queue depth: ")(remaining)
+            .Flush();
+        flush(batch);
+        lock.lock();
+    }
+}
+
+Plugin::~Plugin()
+{
+    // The derived driver has already been destroyed so any writes still in
+    // the queue at this point can not be performed
+    OT_ASSERT(false == write_thread_.joinable());
+}
 }  // namespace opentxs
@@ -6,9 +6,16 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Proto.hpp"
@@ -34,9 +41,19 @@ class Storage;
 class Flag;
 class StorageConfig;
 
-class Plugin : virtual public opentxs::api::storage::Plugin
+class OPENTXS_EXPORT Plugin : virtual public opentxs::api::storage::Plugin
 {
 public:
+    struct WriteQueueStats {
+        std::size_t queue_depth_{};
+        std::size_t max_queue_depth_{};
+        std::size_t batches_{};
+        std::size_t writes_{};
+        std::size_t largest_batch_{};
+        std::size_t last_batch_{};
+    };
+
+    auto Delete(const std::string& key) const -> bool override;
     auto EmptyBucket(const bool bucket) const -> bool override = 0;
 
     auto Load(const std::string& key, const bool checking, std::string& value)
@@ -69,11 +86,23 @@ public:
     auto StoreRoot(const bool commit, const std::string& hash) const
         -> bool override = 0;
 
+    auto WriteQueue() const noexcept -> WriteQueueStats;
+
     virtual void Cleanup() = 0;
 
-    ~Plugin() override = default;
+    ~Plugin() override;
 
 protected:
+    struct PendingWrite {
+        bool isTransaction_;
+        std::string key_;
+        std::string value_;
+        bool bucket_;
+        std::promise<bool>* promise_;
+    };
+
+    using WriteBatch = std::vector<PendingWrite>;
+
     const StorageConfig& config_;
     const Random& random_;
 
@@ -85,17 +114,44 @@ protected:
         const Flag& bucket);
     Plugin() = delete;
 
+    virtual auto delete_key(const std::string& key, const bool bucket) const
+        -> bool = 0;
     virtual void store(
         const bool isTransaction,
         const std::string& key,
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const = 0;
+    // Every item in the batch shares the same bucket and transaction mode.
+    // Drivers which can write several keys in a single transaction should
+    // override this. All promises must be satisfied before returning.
+    virtual void store_batch(
+        const bool isTransaction,
+        const bool bucket,
+        WriteBatch& batch) const;
+    // Writes every queued item, stops the write thread and logs the queue
+    // statistics. Concrete drivers must call this before releasing any of
+    // their own resources since the queue is drained through store(). Writes
+    // submitted afterwards are performed synchronously.
+    void stop_write_queue() noexcept;
 
 private:
     const api::storage::Storage& storage_;
     const Digest& digest_;
     const Flag& current_bucket_;
+    const std::size_t batch_size_;
+    const std::size_t queue_limit_;
+    const std::chrono::milliseconds flush_interval_;
+    mutable std::mutex write_lock_;
+    mutable std::condition_variable write_ready_;
+    mutable std::condition_variable write_space_;
+    mutable std::deque<PendingWrite> write_queue_;
+    mutable WriteQueueStats write_stats_;
+    bool running_;
+    std::thread write_thread_;
+
+    void flush(WriteBatch& batch) const;
+    void write_queue() noexcept;
 
     Plugin(const Plugin&) = delete;
     Plugin(Plugin&&) = delete;
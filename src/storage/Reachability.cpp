@@ -0,0 +1,153 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"              // IWYU pragma: associated
+#include "1_Internal.hpp"            // IWYU pragma: associated
+#include "storage/Reachability.hpp"  // IWYU pragma: associated
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace opentxs::storage
+{
+Reachability::Reachability(const opentxs::api::storage::Driver& driver) noexcept
+    : driver_(driver)
+    , references_()
+{
+}
+
+auto Reachability::Delete(const std::string& key) const -> bool
+{
+    return driver_.Delete(key);
+}
+
+auto Reachability::EmptyBucket(const bool bucket) const -> bool
+{
+    return driver_.EmptyBucket(bucket);
+}
+
+auto Reachability::Load(
+    const std::string& key,
+    const bool checking,
+    std::string& value) const -> bool
+{
+    return driver_.Load(key, checking, value);
+}
+
+auto Reachability::LoadFromBucket(
+    const std::string& key,
+    std::string& value,
+    const bool bucket) const -> bool
+{
+    return driver_.LoadFromBucket(key, value, bucket);
+}
+
+auto Reachability::LoadRoot() const -> std::string
+{
+    return driver_.LoadRoot();
+}
+
+auto Reachability::Mark(const std::string& key) const noexcept -> void
+{
+    if (key.empty()) { return; }
+
+    ++references_[key];
+}
+
+auto Reachability::Migrate(
+    const std::string& key,
+    const opentxs::api::storage::Driver&) const -> bool
+{
+    Mark(key);
+
+    return true;
+}
+
+// Serialized format: a sequence of records consisting of a one byte key
+// length, the key, and a four byte reference count in host byte order. The
+// index never leaves the local machine.
+auto Reachability::Parse(const std::string& serialized) noexcept -> References
+{
+    auto output = References{};
+    const auto* it = serialized.data();
+    auto remaining = serialized.size();
+    auto count = std::uint32_t{};
+
+    while (0 < remaining) {
+        const auto size = static_cast<std::size_t>(
+            *reinterpret_cast<const std::uint8_t*>(it));
+        ++it;
+        --remaining;
+
+        if (remaining < (size + sizeof(count))) { break; }
+
+        auto key = std::string{it, size};
+        it += size;
+        std::memcpy(&count, it, sizeof(count));
+        it += sizeof(count);
+        remaining -= (size + sizeof(count));
+        output.emplace(std::move(key), count);
+    }
+
+    return output;
+}
+
+auto Reachability::Release() noexcept -> References
+{
+    auto output = References{};
+    output.swap(references_);
+
+    return output;
+}
+
+auto Reachability::Serialize(const References& index) noexcept -> std::string
+{
+    auto output = std::string{};
+
+    for (const auto& [key, count] : index) {
+        if (key.size() > std::numeric_limits<std::uint8_t>::max()) { continue; }
+
+        output.push_back(static_cast<char>(key.size()));
+        output.append(key);
+        output.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    return output;
+}
+
+auto Reachability::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket) const -> bool
+{
+    return driver_.Store(isTransaction, key, value, bucket);
+}
+
+void Reachability::Store(
+    const bool isTransaction,
+    const std::string& key,
+    const std::string& value,
+    const bool bucket,
+    std::promise<bool>& promise) const
+{
+    driver_.Store(isTransaction, key, value, bucket, promise);
+}
+
+auto Reachability::Store(
+    const bool isTransaction,
+    const std::string& value,
+    std::string& key) const -> bool
+{
+    return driver_.Store(isTransaction, value, key);
+}
+
+auto Reachability::StoreRoot(const bool commit, const std::string& hash) const
+    -> bool
+{
+    return driver_.StoreRoot(commit, hash);
+}
+}  // namespace opentxs::storage
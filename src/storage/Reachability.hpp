@@ -0,0 +1,79 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+#include "opentxs/api/storage/Driver.hpp"
+
+namespace opentxs::storage
+{
+// Mark phase of the incremental garbage collector.
+//
+// Loads are forwarded to the wrapped driver. Migrate() does not touch the
+// stored object but instead increments the reference count for its key, so
+// calling Migrate() on a storage::Tree constructed on top of this object
+// produces a reference count for every reachable hash while only reading
+// index objects.
+class Reachability final : virtual public opentxs::api::storage::Driver
+{
+public:
+    using References = std::unordered_map<std::string, std::uint32_t>;
+
+    static auto Parse(const std::string& serialized) noexcept -> References;
+    static auto Serialize(const References& index) noexcept -> std::string;
+
+    auto Delete(const std::string& key) const -> bool final;
+    auto EmptyBucket(const bool bucket) const -> bool final;
+    auto Load(const std::string& key, const bool checking, std::string& value)
+        const -> bool final;
+    auto LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const -> bool final;
+    auto LoadRoot() const -> std::string final;
+    auto Mark(const std::string& key) const noexcept -> void;
+    auto Migrate(
+        const std::string& key,
+        const opentxs::api::storage::Driver& to) const -> bool final;
+    auto Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const -> bool final;
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const final;
+    auto Store(
+        const bool isTransaction,
+        const std::string& value,
+        std::string& key) const -> bool final;
+    auto StoreRoot(const bool commit, const std::string& hash) const
+        -> bool final;
+
+    auto Release() noexcept -> References;
+
+    Reachability(const opentxs::api::storage::Driver& driver) noexcept;
+
+    ~Reachability() final = default;
+
+private:
+    const opentxs::api::storage::Driver& driver_;
+    mutable References references_;
+
+    Reachability() = delete;
+    Reachability(const Reachability&) = delete;
+    Reachability(Reachability&&) = delete;
+    auto operator=(const Reachability&) -> Reachability& = delete;
+    auto operator=(Reachability&&) -> Reachability& = delete;
+};
+}  // namespace opentxs::storage
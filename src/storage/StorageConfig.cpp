@@ -19,6 +19,9 @@ StorageConfig::StorageConfig() noexcept
     , auto_publish_servers_(true)
     , auto_publish_units_(true)
     , gc_interval_(C::duration_cast<C::seconds>(C::hours(1)).count())
+    , write_batch_size_(256)
+    , write_queue_limit_(4096)
+    , write_flush_interval_(0)
     , path_()
     , dht_callback_()
     , primary_plugin_(default_plugin_)
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -31,6 +32,9 @@ public:
     bool auto_publish_servers_;
     bool auto_publish_units_;
     std::int64_t gc_interval_;
+    std::size_t write_batch_size_;
+    std::size_t write_queue_limit_;
+    std::chrono::milliseconds write_flush_interval_;
     std::string path_;
     InsertCB dht_callback_;
 
@@ -53,6 +57,6 @@ public:
     std::string lmdb_control_table_;
     std::string lmdb_root_key_;
 
-    StorageConfig() noexcept;
+    OPENTXS_EXPORT StorageConfig() noexcept;
 };
 }  // namespace opentxs
@@ -106,9 +106,14 @@ private:
      */
     void Init_StorageExample();
 
-    /** Polymorphic cleanup method. Child class-specific actions go here.
+    /** Polymorphic cleanup method. Child class-specific actions go here,
+     *  after the write queue has been stopped.
+     *
+     *  \warning Writes still queued by the parent class are performed via
+     *           \ref store, so stop_write_queue() must be called before any
+     *           backend resources are released.
      */
-    void Cleanup_StorageExample();
+    void Cleanup_StorageExample() { stop_write_queue(); }
 
 public:
     /** Obtain the most current value of the root hash
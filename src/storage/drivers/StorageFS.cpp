@@ -48,9 +48,19 @@ StorageFS::StorageFS(
 
 void StorageFS::Cleanup() { Cleanup_StorageFS(); }
 
-void StorageFS::Cleanup_StorageFS()
+void StorageFS::Cleanup_StorageFS() { stop_write_queue(); }
+
+auto StorageFS::delete_key(const std::string& key, const bool bucket) const
+    -> bool
 {
-    // future cleanup actions go here
+    if (false == ready_.get() || folder_.empty()) { return false; }
+
+    std::string directory{};
+    const auto filename = calculate_path(key, bucket, directory);
+    boost::system::error_code ec{};
+    boost::filesystem::remove(filename, ec);
+
+    return !ec;
 }
 
 void StorageFS::Init_StorageFS()
@@ -87,6 +87,8 @@ private:
     virtual auto prepare_write(const std::string& input) const -> std::string;
     auto read_file(const std::string& filename) const -> std::string;
     virtual auto root_filename() const -> std::string = 0;
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool override;
     void store(
         const bool isTransaction,
         const std::string& key,
@@ -106,9 +106,12 @@ void StorageFSArchive::Cleanup()
     ot_super::Cleanup();
 }
 
-void StorageFSArchive::Cleanup_StorageFSArchive()
+void StorageFSArchive::Cleanup_StorageFSArchive() { stop_write_queue(); }
+
+auto StorageFSArchive::delete_key(const std::string&, const bool) const
+    -> bool
 {
-    // future cleanup actions go here
+    return true;
 }
 
 auto StorageFSArchive::EmptyBucket(const bool) const -> bool { return true; }
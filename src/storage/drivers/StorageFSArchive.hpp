@@ -65,6 +65,8 @@ private:
         const std::string& key,
         const bool bucket,
         std::string& directory) const -> std::string final;
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool final;
     auto prepare_read(const std::string& ciphertext) const -> std::string final;
     auto prepare_write(const std::string& plaintext) const -> std::string final;
     auto root_filename() const -> std::string final;
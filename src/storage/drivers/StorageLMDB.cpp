@@ -7,6 +7,7 @@
 #include "1_Internal.hpp"                   // IWYU pragma: associated
 #include "storage/drivers/StorageLMDB.hpp"  // IWYU pragma: associated
 
+#include <exception>
 #include <string>
 #include <utility>
 
@@ -61,7 +62,15 @@ StorageLMDB::StorageLMDB(
 
 void StorageLMDB::Cleanup() { Cleanup_StorageLMDB(); }
 
-void StorageLMDB::Cleanup_StorageLMDB() {}
+void StorageLMDB::Cleanup_StorageLMDB() { stop_write_queue(); }
+
+auto StorageLMDB::delete_key(const std::string& key, const bool bucket) const
+    -> bool
+{
+    const auto table = get_table(bucket);
+
+    return lmdb_.Delete(table, key) || (false == lmdb_.Exists(table, key));
+}
 
 auto StorageLMDB::EmptyBucket(const bool bucket) const -> bool
 {
@@ -117,6 +126,39 @@ void StorageLMDB::store(
     }
 }
 
+void StorageLMDB::store_batch(
+    const bool isTransaction,
+    const bool bucket,
+    WriteBatch& batch) const
+{
+    if (isTransaction) {
+        ot_super::store_batch(isTransaction, bucket, batch);
+
+        return;
+    }
+
+    const auto table = get_table(bucket);
+    auto success{true};
+
+    try {
+        auto transaction = lmdb_.TransactionRW();
+
+        for (const auto& write : batch) {
+            success = lmdb_.Store(table, write.key_, write.value_, transaction)
+                          .first;
+
+            if (false == success) { break; }
+        }
+
+        success = transaction.Finalize(success) && success;
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+        success = false;
+    }
+
+    for (auto& write : batch) { write.promise_->set_value(success); }
+}
+
 auto StorageLMDB::StoreRoot(const bool commit, const std::string& hash) const
     -> bool
 {
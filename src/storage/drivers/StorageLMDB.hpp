@@ -70,12 +70,18 @@ private:
     lmdb::LMDB lmdb_;
 
     auto get_table(const bool bucket) const -> Table;
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool final;
     void store(
         const bool isTransaction,
         const std::string& key,
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const final;
+    void store_batch(
+        const bool isTransaction,
+        const bool bucket,
+        WriteBatch& batch) const final;
 
     void Init_StorageLMDB();
 
@@ -44,6 +44,20 @@ StorageMemDB::StorageMemDB(
 {
 }
 
+auto StorageMemDB::delete_key(const std::string& key, const bool bucket) const
+    -> bool
+{
+    eLock lock(shared_lock_);
+
+    if (bucket) {
+        a_.erase(key);
+    } else {
+        b_.erase(key);
+    }
+
+    return true;
+}
+
 auto StorageMemDB::EmptyBucket(const bool bucket) const -> bool
 {
     eLock lock(shared_lock_);
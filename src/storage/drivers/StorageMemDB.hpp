@@ -51,9 +51,9 @@ public:
     auto StoreRoot(const bool commit, const std::string& hash) const
         -> bool final;
 
-    void Cleanup() final {}
+    void Cleanup() final { stop_write_queue(); }
 
-    ~StorageMemDB() final = default;
+    ~StorageMemDB() final { stop_write_queue(); }
 
 private:
     using ot_super = Plugin;
@@ -64,6 +64,8 @@ private:
     mutable std::map<std::string, std::string> a_{};
     mutable std::map<std::string, std::string> b_{};
 
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool final;
     void store(
         const bool isTransaction,
         const std::string& key,
@@ -135,6 +135,19 @@ void StorageMultiplex::Cleanup() { Cleanup_StorageMultiplex(); }
 
 void StorageMultiplex::Cleanup_StorageMultiplex() {}
 
+auto StorageMultiplex::Delete(const std::string& key) const -> bool
+{
+    OT_ASSERT(primary_plugin_);
+
+    for (const auto& plugin : backup_plugins_) {
+        OT_ASSERT(plugin);
+
+        plugin->Delete(key);
+    }
+
+    return primary_plugin_->Delete(key);
+}
+
 auto StorageMultiplex::EmptyBucket(const bool bucket) const -> bool
 {
     OT_ASSERT(primary_plugin_);
@@ -364,6 +377,9 @@ auto StorageMultiplex::Store(
 
     std::vector<std::promise<bool>> promises{};
     std::vector<std::future<bool>> futures{};
+    // The plugins keep pointers to these promises until they are satisfied
+    promises.reserve(1u + backup_plugins_.size());
+    futures.reserve(1u + backup_plugins_.size());
     promises.push_back(std::promise<bool>());
     auto& primaryPromise = promises.back();
     futures.push_back(primaryPromise.get_future());
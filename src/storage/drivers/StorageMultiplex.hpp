@@ -44,6 +44,7 @@ namespace opentxs::storage::implementation
 class StorageMultiplex final : virtual public opentxs::api::storage::Multiplex
 {
 public:
+    auto Delete(const std::string& key) const -> bool final;
     auto EmptyBucket(const bool bucket) const -> bool final;
     auto LoadFromBucket(
         const std::string& key,
@@ -76,7 +76,11 @@ auto StorageSqlite3::bind_key(
 
 void StorageSqlite3::Cleanup() { Cleanup_StorageSqlite3(); }
 
-void StorageSqlite3::Cleanup_StorageSqlite3() { sqlite3_close(db_); }
+void StorageSqlite3::Cleanup_StorageSqlite3()
+{
+    stop_write_queue();
+    sqlite3_close(db_);
+}
 
 void StorageSqlite3::commit(std::stringstream& sql) const
 {
@@ -110,6 +114,24 @@ auto StorageSqlite3::Create(const std::string& tablename) const -> bool
         SQLITE_OK == sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, nullptr));
 }
 
+auto StorageSqlite3::delete_key(const std::string& key, const bool bucket)
+    const -> bool
+{
+    OT_ASSERT(std::numeric_limits<int>::max() >= key.size());
+
+    sqlite3_stmt* statement{nullptr};
+    const std::string query =
+        "DELETE FROM `" + GetTableName(bucket) + "` WHERE k = ?1;";
+    sqlite3_prepare_v2(db_, query.c_str(), -1, &statement, nullptr);
+    sqlite3_bind_text(
+        statement, 1, key.c_str(), static_cast<int>(key.size()), SQLITE_STATIC);
+    LogVerbose(OT_METHOD)(__FUNCTION__)(expand_sql(statement)).Flush();
+    const auto result = sqlite3_step(statement);
+    sqlite3_finalize(statement);
+
+    return (result == SQLITE_DONE);
+}
+
 auto StorageSqlite3::EmptyBucket(const bool bucket) const -> bool
 {
     return Purge(GetTableName(bucket));
@@ -348,6 +370,47 @@ void StorageSqlite3::store(
     }
 }
 
+void StorageSqlite3::store_batch(
+    const bool isTransaction,
+    const bool bucket,
+    WriteBatch& batch) const
+{
+    Lock lock(transaction_lock_);
+
+    if (isTransaction) {
+        transaction_bucket_->Set(bucket);
+
+        for (auto& write : batch) {
+            pending_.emplace_back(write.key_, write.value_);
+            write.promise_->set_value(true);
+        }
+
+        return;
+    }
+
+    const auto tablename = GetTableName(bucket);
+    const auto exec = [&](const char* sql) {
+        return SQLITE_OK == sqlite3_exec(db_, sql, nullptr, nullptr, nullptr);
+    };
+    auto success = exec("BEGIN TRANSACTION;");
+
+    if (success) {
+        for (const auto& write : batch) {
+            success = Upsert(write.key_, tablename, write.value_);
+
+            if (false == success) { break; }
+        }
+
+        if (success) {
+            success = exec("COMMIT TRANSACTION;");
+        } else {
+            exec("ROLLBACK;");
+        }
+    }
+
+    for (auto& write : batch) { write.promise_->set_value(success); }
+}
+
 auto StorageSqlite3::StoreRoot(const bool commit, const std::string& hash) const
     -> bool
 {
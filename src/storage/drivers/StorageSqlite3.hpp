@@ -91,12 +91,18 @@ private:
     void set_data(std::stringstream& sql) const;
     void set_root(const std::string& rootHash, std::stringstream& sql) const;
     void start_transaction(std::stringstream& sql) const;
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool final;
     void store(
         const bool isTransaction,
         const std::string& key,
         const std::string& value,
         const bool bucket,
         std::promise<bool>* promise) const final;
+    void store_batch(
+        const bool isTransaction,
+        const bool bucket,
+        WriteBatch& batch) const final;
     auto Upsert(
         const std::string& key,
         const std::string& tablename,
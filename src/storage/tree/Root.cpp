@@ -7,8 +7,11 @@
 #include "1_Internal.hpp"         // IWYU pragma: associated
 #include "storage/tree/Root.hpp"  // IWYU pragma: associated
 
+#include <chrono>
 #include <ctime>
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include "opentxs/api/storage/Driver.hpp"
 #include "opentxs/core/Log.hpp"
@@ -21,6 +24,7 @@
 #include "storage/tree/Tree.hpp"
 
 #define CURRENT_VERSION 2
+#define GC_SLICE_MILLISECONDS 10
 
 #define OT_METHOD "opentxs::storage::Root::"
 
@@ -28,6 +32,8 @@ namespace opentxs
 {
 namespace storage
 {
+const std::string Root::GC_INDEX_KEY{"gcindex"};
+
 Root::Root(
     const opentxs::api::storage::Driver& storage,
     const std::string& hash,
@@ -46,6 +52,8 @@ Root::Root(
     , tree_root_()
     , tree_lock_()
     , tree_()
+    , journal_(storage)
+    , gc_index_()
 {
     if (check_hash(hash)) {
         init(hash);
@@ -81,28 +89,44 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
     LogTrace(OT_METHOD)(__FUNCTION__)(": Beginning garbage collection.")
         .Flush();
     const auto resume = gc_resume_->Set(false);
-    bool oldLocation = false;
+    bool success{false};
 
-    if (resume) {
-        oldLocation = !current_bucket_;
+    if ((false == resume) && load_gc_index()) {
+        success = collect_incremental(lock);
     } else {
-        gc_root_ = tree()->Root();
-        oldLocation = current_bucket_.Toggle();
-        save(lock);
-        driver_.StoreRoot(true, root_);
-    }
+        bool oldLocation = false;
+
+        if (resume) {
+            oldLocation = !current_bucket_;
+        } else {
+            gc_root_ = tree()->Root();
+            oldLocation = current_bucket_.Toggle();
+            save(lock);
+            driver_.StoreRoot(true, root_);
+        }
 
-    lock.unlock();
-    bool success{false};
+        // Anything written before this point which is not reachable from
+        // gc_root_ will be removed along with the old bucket
+        journal_.Reset();
+        const auto rootObject = root_;
+        lock.unlock();
+
+        if (Node::check_hash(gc_root_)) {
+            const storage::Tree tree(driver_, gc_root_);
+            success = tree.Migrate(*to);
+        }
+
+        if (success) {
+            driver_.EmptyBucket(oldLocation);
+            gc_index_ = mark(gc_root_);
 
-    if (Node::check_hash(gc_root_)) {
-        const storage::Tree tree(driver_, gc_root_);
-        success = tree.Migrate(*to);
+            if (gc_index_.has_value()) { ++gc_index_.value()[rootObject]; }
+        } else {
+            gc_index_.reset();
+        }
     }
 
-    if (success) {
-        driver_.EmptyBucket(oldLocation);
-    } else {
+    if (false == success) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Garbage collection failed. "
                                            "Will retry next cycle.")
             .Flush();
@@ -120,6 +144,61 @@ void Root::collect_garbage(const opentxs::api::storage::Driver* to) const
     LogTrace(OT_METHOD)(__FUNCTION__)(": Finished garbage collection.").Flush();
 }
 
+auto Root::collect_incremental(Lock& lock) const -> bool
+{
+    OT_ASSERT(gc_index_.has_value());
+
+    // Every mutation of the tree holds write_lock_ so the snapshot below is
+    // consistent with the journal. The lock is released before returning.
+    const auto treeRoot = tree()->Root();
+    const auto rootObject = root_;
+    const auto written = journal_.Reset();
+    lock.unlock();
+    auto marked = mark(treeRoot);
+
+    if (false == marked.has_value()) {
+        // The keys removed from the journal would be lost so the next cycle
+        // must perform a full collection
+        gc_index_.reset();
+
+        return false;
+    }
+
+    auto& reachable = marked.value();
+    ++reachable[rootObject];
+    const auto& previous = gc_index_.value();
+    auto garbage = std::vector<std::string>{};
+
+    for (const auto& [key, count] : previous) {
+        if (0 == reachable.count(key)) { garbage.emplace_back(key); }
+    }
+
+    for (const auto& key : written) {
+        if ((0 == reachable.count(key)) && (0 == previous.count(key))) {
+            garbage.emplace_back(key);
+        }
+    }
+
+    const auto budget = std::chrono::milliseconds{GC_SLICE_MILLISECONDS};
+    auto position = std::size_t{0};
+    auto deleted = std::size_t{0};
+    auto slices = std::size_t{0};
+
+    while (position < garbage.size()) {
+        deleted += journal_.Sweep(garbage, position, budget);
+        ++slices;
+        std::this_thread::yield();
+    }
+
+    LogDetail(OT_METHOD)(__FUNCTION__)(": Deleted ")(deleted)(" of ")(
+        garbage.size())(" unreachable objects in ")(slices)(" slices. ")(
+        reachable.size())(" objects remain reachable.")
+        .Flush();
+    gc_index_ = std::move(reachable);
+
+    return true;
+}
+
 void Root::init(const std::string& hash)
 {
     std::shared_ptr<proto::StorageRoot> serialized;
@@ -140,6 +219,39 @@ void Root::init(const std::string& hash)
     tree_root_ = normalize_hash(serialized->items());
 }
 
+auto Root::load_gc_index() const -> bool
+{
+    if (gc_index_.has_value()) { return true; }
+
+    auto serialized = std::string{};
+
+    if (false == driver_.Load(GC_INDEX_KEY, true, serialized)) {
+        return false;
+    }
+
+    // A persisted index is only valid in combination with the journal of the
+    // session which wrote it. Removing it ensures an unclean shutdown will
+    // trigger a full collection.
+    driver_.Delete(GC_INDEX_KEY);
+    gc_index_ = Reachability::Parse(serialized);
+
+    return true;
+}
+
+auto Root::mark(const std::string& root) const
+    -> std::optional<Reachability::References>
+{
+    auto marker = Reachability{driver_};
+
+    if (Node::check_hash(root)) {
+        const storage::Tree tree(marker, root);
+
+        if (false == tree.Migrate(marker)) { return std::nullopt; }
+    }
+
+    return marker.Release();
+}
+
 auto Root::Migrate(const opentxs::api::storage::Driver& to) const -> bool
 {
     if (0 == gc_interval_) {
@@ -195,7 +307,7 @@ auto Root::save(const Lock& lock) const -> bool
 
     sequence_++;
 
-    return save(lock, driver_);
+    return save(lock, journal_);
 }
 
 void Root::save(storage::Tree* tree, const Lock& lock)
@@ -213,6 +325,22 @@ void Root::save(storage::Tree* tree, const Lock& lock)
     OT_ASSERT(saved);
 }
 
+void Root::save_gc_index() const
+{
+    Lock gcLock(gc_lock_);
+
+    if (false == load_gc_index()) { return; }
+
+    auto& index = gc_index_.value();
+
+    // Objects written since the last collection are not referenced by the
+    // index but must be examined by the next collection
+    for (const auto& key : journal_.Reset()) { index.emplace(key, 0); }
+
+    driver_.Store(
+        false, GC_INDEX_KEY, Reachability::Serialize(index), current_bucket_);
+}
+
 auto Root::Save(const opentxs::api::storage::Driver& to) const -> bool
 {
     Lock lock(write_lock_);
@@ -240,7 +368,7 @@ auto Root::tree() const -> storage::Tree*
 {
     Lock lock(tree_lock_);
 
-    if (!tree_) { tree_.reset(new storage::Tree(driver_, tree_root_)); }
+    if (!tree_) { tree_.reset(new storage::Tree(journal_, tree_root_)); }
 
     OT_ASSERT(tree_);
 
@@ -10,6 +10,7 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -18,6 +19,8 @@
 #include "opentxs/api/Editor.hpp"
 #include "opentxs/core/Flag.hpp"
 #include "opentxs/protobuf/StorageRoot.pb.h"
+#include "storage/Journal.hpp"
+#include "storage/Reachability.hpp"
 #include "storage/tree/Node.hpp"
 #include "storage/tree/Tree.hpp"
 
@@ -43,12 +46,18 @@ namespace implementation
 class StorageMultiplex;
 }  // namespace implementation
 
+class RootTest;
+
 class Root final : public Node
 {
 private:
     using ot_super = Node;
     friend opentxs::storage::implementation::StorageMultiplex;
     friend api::storage::implementation::Storage;
+    // Unit tests run collection without a storage api
+    friend RootTest;
+
+    static const std::string GC_INDEX_KEY;
 
     const std::uint64_t gc_interval_{std::numeric_limits<std::int64_t>::max()};
     mutable std::string gc_root_;
@@ -62,13 +71,20 @@ private:
     std::string tree_root_;
     mutable std::mutex tree_lock_;
     mutable std::unique_ptr<storage::Tree> tree_;
+    const storage::Journal journal_;
+    mutable std::optional<Reachability::References> gc_index_;
 
+    auto load_gc_index() const -> bool;
+    auto mark(const std::string& root) const
+        -> std::optional<Reachability::References>;
     auto serialize() const -> proto::StorageRoot;
     auto tree() const -> storage::Tree*;
 
     void blank(const VersionNumber version) final;
     void cleanup() const;
     void collect_garbage(const opentxs::api::storage::Driver* to) const;
+    auto collect_incremental(Lock& lock) const -> bool;
+    void save_gc_index() const;
     void init(const std::string& hash) final;
     auto save(const Lock& lock, const opentxs::api::storage::Driver& to) const
         -> bool;
@@ -0,0 +1,327 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"       // IWYU pragma: associated
+#include "1_Internal.hpp"     // IWYU pragma: associated
+#include "util/Executor.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD "opentxs::Executor::"
+
+namespace opentxs
+{
+namespace
+{
+// The executor and worker index of the calling thread, if it is a worker
+thread_local const Executor* current_executor_{nullptr};
+thread_local std::size_t current_index_{0};
+}  // namespace
+
+// Chase-Lev work stealing deque, with the memory orderings from Lê et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (2013).
+//
+// Only the owning worker may call Push() and Pop(). Any thread may call
+// Steal(). Arrays replaced by Push() are kept until the deque is destroyed
+// because a concurrent Steal() may still be reading them.
+class Executor::Deque
+{
+public:
+    auto Pop() noexcept -> Job*
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        auto* array = array_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        auto* output = array->Get(bottom);
+
+        if (top == bottom) {
+            // Last item, which a thief may be taking at the same time
+            if (false == top_.compare_exchange_strong(
+                             top,
+                             top + 1,
+                             std::memory_order_seq_cst,
+                             std::memory_order_relaxed)) {
+                output = nullptr;
+            }
+
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return output;
+    }
+    auto Push(Job* job) noexcept -> void
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_acquire);
+        auto* array = array_.load(std::memory_order_relaxed);
+
+        if ((bottom - top) > (array->size_ - 1)) {
+            array = grow(*array, top, bottom);
+        }
+
+        array->Put(bottom, job);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    auto Steal() noexcept -> Job*
+    {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) { return nullptr; }
+
+        auto* output = array_.load(std::memory_order_acquire)->Get(top);
+
+        if (false == top_.compare_exchange_strong(
+                         top,
+                         top + 1,
+                         std::memory_order_seq_cst,
+                         std::memory_order_relaxed)) {
+            // Lost the race to the owner or to another thief
+            return nullptr;
+        }
+
+        return output;
+    }
+
+    Deque() noexcept
+        : top_(0)
+        , bottom_(0)
+        , array_()
+        , arrays_()
+    {
+        array_.store(
+            arrays_.emplace_back(std::make_unique<Array>(initial_size_)).get());
+    }
+
+    ~Deque()
+    {
+        const auto bottom = bottom_.load();
+        auto* array = array_.load();
+
+        for (auto i = top_.load(); i < bottom; ++i) { delete array->Get(i); }
+    }
+
+private:
+    using Index = std::int64_t;
+
+    struct Array {
+        const Index size_;
+        std::unique_ptr<std::atomic<Job*>[]> data_;
+
+        auto Get(const Index i) const noexcept -> Job*
+        {
+            return data_[i & (size_ - 1)].load(std::memory_order_relaxed);
+        }
+        auto Put(const Index i, Job* job) noexcept -> void
+        {
+            data_[i & (size_ - 1)].store(job, std::memory_order_relaxed);
+        }
+
+        Array(const Index size) noexcept
+            : size_(size)
+            , data_(std::make_unique<std::atomic<Job*>[]>(size))
+        {
+        }
+    };
+
+    // Must be a power of two
+    static constexpr auto initial_size_ = Index{256};
+
+    std::atomic<Index> top_;
+    std::atomic<Index> bottom_;
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_;
+
+    auto grow(const Array& old, const Index top, const Index bottom) noexcept
+        -> Array*
+    {
+        auto* array =
+            arrays_.emplace_back(std::make_unique<Array>(2 * old.size_)).get();
+
+        for (auto i = top; i < bottom; ++i) { array->Put(i, old.Get(i)); }
+
+        array_.store(array, std::memory_order_release);
+
+        return array;
+    }
+
+    Deque(const Deque&) = delete;
+    Deque(Deque&&) = delete;
+    auto operator=(const Deque&) -> Deque& = delete;
+    auto operator=(Deque&&) -> Deque& = delete;
+};
+
+Executor::Worker::Worker() noexcept
+    : deque_(std::make_unique<Deque>())
+    , thread_()
+{
+}
+
+Executor::Worker::Worker(Worker&& rhs) noexcept
+    : deque_(std::move(rhs.deque_))
+    , thread_(std::move(rhs.thread_))
+{
+}
+
+Executor::Worker::~Worker() = default;
+
+Executor::Executor(const std::size_t threads) noexcept
+    : workers_(std::max(threads, std::size_t{1}))
+    , running_(true)
+    , queued_(0)
+    , sleeping_(0)
+    , lock_()
+    , cv_()
+    , shared_()
+{
+    // Every deque must exist before any worker tries to steal from it
+    for (auto i = std::size_t{0}; i < workers_.size(); ++i) {
+        workers_.at(i).thread_ = std::thread{&Executor::run, this, i};
+    }
+}
+
+auto Executor::execute(Job* job) noexcept -> void
+{
+    --queued_;
+    auto pJob = std::unique_ptr<Job>{job};
+
+    try {
+        (*pJob)();
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Job exception: ")(e.what())
+            .Flush();
+    } catch (...) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Job exception").Flush();
+    }
+}
+
+auto Executor::next(const std::size_t index) noexcept -> Job*
+{
+    if (auto* job = workers_.at(index).deque_->Pop(); nullptr != job) {
+        return job;
+    }
+
+    {
+        auto lock = Lock{lock_};
+
+        if (false == shared_.empty()) {
+            auto* job = shared_.front();
+            shared_.pop_front();
+
+            return job;
+        }
+    }
+
+    const auto count = workers_.size();
+
+    for (auto i = std::size_t{1}; i < count; ++i) {
+        auto& victim = workers_.at((index + i) % count);
+
+        if (auto* job = victim.deque_->Steal(); nullptr != job) { return job; }
+    }
+
+    return nullptr;
+}
+
+auto Executor::run(const std::size_t index) noexcept -> void
+{
+    current_executor_ = this;
+    current_index_ = index;
+
+    while (running_) {
+        if (auto* job = next(index); nullptr != job) {
+            execute(job);
+
+            continue;
+        }
+
+        if (0 < queued_.load()) {
+            // A job is being pushed or another thread is taking it
+            std::this_thread::yield();
+
+            continue;
+        }
+
+        auto lock = Lock{lock_};
+        ++sleeping_;
+        cv_.wait(lock, [&] { return (false == running_) || (0 < queued_); });
+        --sleeping_;
+    }
+
+    current_executor_ = nullptr;
+}
+
+auto Executor::Shutdown() noexcept -> void
+{
+    {
+        auto lock = Lock{lock_};
+
+        if (false == running_.exchange(false)) { return; }
+    }
+
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.thread_.joinable()) { worker.thread_.join(); }
+    }
+}
+
+auto Executor::Submit(Job&& job) noexcept -> bool
+{
+    if ((false == running_) || (false == bool(job))) { return false; }
+
+    auto pJob = std::make_unique<Job>(std::move(job));
+    // Counted before the job becomes visible so that a worker can never
+    // take it while queued_ is zero
+    ++queued_;
+
+    if (this == current_executor_) {
+        workers_.at(current_index_).deque_->Push(pJob.release());
+    } else {
+        auto lock = Lock{lock_};
+        shared_.emplace_back(pJob.release());
+    }
+
+    wake();
+
+    return true;
+}
+
+auto Executor::wake() noexcept -> void
+{
+    // queued_ was incremented before sleeping_ is read, and a sleeping worker
+    // increments sleeping_ before it reads queued_, so at least one of the two
+    // threads sees the other's change
+    if (0 == sleeping_.load()) { return; }
+
+    auto lock = Lock{lock_};
+    cv_.notify_one();
+}
+
+Executor::~Executor()
+{
+    Shutdown();
+
+    for (auto* job : shared_) { delete job; }
+}
+}  // namespace opentxs
@@ -0,0 +1,77 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opentxs
+{
+// Runs jobs on a fixed set of worker threads.
+//
+// Each worker owns a deque. Jobs submitted by a worker are pushed onto its
+// own deque and popped in LIFO order without locking; a worker with nothing
+// to do steals the oldest job from another worker's deque. Jobs submitted by
+// any other thread go through a shared queue.
+//
+// No ordering is guaranteed between jobs.
+class Executor
+{
+public:
+    using Job = std::function<void()>;
+
+    auto Threads() const noexcept -> std::size_t { return workers_.size(); }
+
+    // Returns false if the executor has been shut down
+    auto Submit(Job&& job) noexcept -> bool;
+    // Waits for running jobs to finish. Queued jobs are discarded.
+    auto Shutdown() noexcept -> void;
+
+    Executor(const std::size_t threads) noexcept;
+
+    ~Executor();
+
+private:
+    class Deque;
+
+    struct Worker {
+        std::unique_ptr<Deque> deque_;
+        std::thread thread_;
+
+        Worker() noexcept;
+        Worker(Worker&&) noexcept;
+
+        ~Worker();
+    };
+
+    std::vector<Worker> workers_;
+    std::atomic<bool> running_;
+    // Jobs which have been submitted but not yet taken by a worker
+    std::atomic<std::size_t> queued_;
+    std::atomic<std::size_t> sleeping_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::deque<Job*> shared_;
+
+    auto execute(Job* job) noexcept -> void;
+    auto next(const std::size_t index) noexcept -> Job*;
+    auto run(const std::size_t index) noexcept -> void;
+    auto wake() noexcept -> void;
+
+    Executor() = delete;
+    Executor(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    auto operator=(const Executor&) -> Executor& = delete;
+    auto operator=(Executor&&) -> Executor& = delete;
+};
+}  // namespace opentxs
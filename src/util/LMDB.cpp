@@ -318,7 +318,8 @@ struct LMDB::Imp {
         const Table table,
         const ReadView index,
         const Callback cb,
-        const Mode multiple) const noexcept -> bool
+        const Mode multiple,
+        MDB_txn* parent) const noexcept -> bool
     {
         struct Cleanup {
             bool success_;
@@ -348,19 +349,25 @@ struct LMDB::Imp {
             MDB_cursor*& cursor_;
         };
 
-        MDB_txn* transaction{nullptr};
+        // A transaction supplied by the caller is left open so the data passed
+        // to cb remains valid until the caller finalizes it
+        MDB_txn* owned{nullptr};
 
-        if (0 != ::mdb_txn_begin(env_, nullptr, MDB_RDONLY, &transaction)) {
-            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to start transaction")
-                .Flush();
+        if (nullptr == parent) {
+            if (0 != ::mdb_txn_begin(env_, nullptr, MDB_RDONLY, &owned)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to start transaction")
+                    .Flush();
 
-            return false;
-        }
+                return false;
+            }
 
-        OT_ASSERT(nullptr != transaction);
+            OT_ASSERT(nullptr != owned);
+        }
 
+        auto* transaction = (nullptr == parent) ? owned : parent;
         MDB_cursor* cursor{nullptr};
-        Cleanup cleanup(transaction, cursor);
+        Cleanup cleanup(owned, cursor);
         const auto database = db_.at(table);
 
         if (0 != ::mdb_cursor_open(transaction, database, &cursor)) {
@@ -974,7 +981,17 @@ auto LMDB::Load(
     const Callback cb,
     const Mode multiple) const noexcept -> bool
 {
-    return imp_->Load(table, index, cb, multiple);
+    return imp_->Load(table, index, cb, multiple, nullptr);
+}
+
+auto LMDB::Load(
+    const Table table,
+    const ReadView index,
+    const Callback cb,
+    MDB_txn* parent,
+    const Mode multiple) const noexcept -> bool
+{
+    return imp_->Load(table, index, cb, multiple, parent);
 }
 
 auto LMDB::Load(
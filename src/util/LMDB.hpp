@@ -95,6 +95,13 @@ public:
         const std::size_t key,
         const Callback cb,
         const Mode mode = Mode::One) const noexcept -> bool;
+    // The data passed to cb remains valid until parent is finalized
+    auto Load(
+        const Table table,
+        const ReadView key,
+        const Callback cb,
+        MDB_txn* parent,
+        const Mode mode = Mode::One) const noexcept -> bool;
     auto Queue(
         const Table table,
         const ReadView key,
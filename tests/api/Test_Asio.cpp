@@ -0,0 +1,466 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/Bytes.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/network/Asio.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/asio/Endpoint.hpp"
+#include "opentxs/network/asio/Socket.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
+#include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Dealer.hpp"
+#include "opentxs/network/zeromq/socket/Sender.tpp"
+#include "opentxs/network/zeromq/socket/Socket.hpp"
+#include "opentxs/util/WorkType.hpp"
+#include "util/Work.hpp"
+
+namespace zmq = ot::network::zeromq;
+
+namespace
+{
+using tcp = boost::asio::ip::tcp;
+
+constexpr auto header_type_ =
+    ot::OTZMQWorkType{ot::OT_ZMQ_INTERNAL_SIGNAL + 1001};
+constexpr auto body_type_ =
+    ot::OTZMQWorkType{ot::OT_ZMQ_INTERNAL_SIGNAL + 1002};
+// Each message is a header containing the size of the body which follows it
+constexpr auto header_bytes_ = sizeof(std::uint64_t);
+constexpr auto reuse_count_ = std::size_t{32};
+
+// Accepts one connection and writes whatever it is given to it
+class Server
+{
+public:
+    auto Port() const -> std::uint16_t
+    {
+        return acceptor_.local_endpoint().port();
+    }
+
+    auto Send(ot::Space data) -> void
+    {
+        boost::asio::post(context_, [this, data{std::move(data)}]() mutable {
+            if (connected_) {
+                write(data);
+            } else {
+                pending_.emplace_back(std::move(data));
+            }
+        });
+    }
+
+    Server()
+        : context_()
+        , acceptor_(
+              context_,
+              tcp::endpoint{boost::asio::ip::address_v4::loopback(), 0})
+        , peer_(context_)
+        , work_(boost::asio::make_work_guard(context_))
+        , connected_(false)
+        , pending_()
+        , thread_()
+    {
+        acceptor_.async_accept(peer_, [this](const auto& e) {
+            if (e) { return; }
+
+            connected_ = true;
+
+            for (const auto& data : pending_) { write(data); }
+
+            pending_.clear();
+        });
+        thread_ = std::thread{[this] { context_.run(); }};
+    }
+
+    ~Server()
+    {
+        context_.stop();
+        thread_.join();
+    }
+
+private:
+    boost::asio::io_context context_;
+    tcp::acceptor acceptor_;
+    tcp::socket peer_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+        work_;
+    bool connected_;
+    std::vector<ot::Space> pending_;
+    std::thread thread_;
+
+    auto write(const ot::Space& data) -> void
+    {
+        auto ec = boost::system::error_code{};
+        boost::asio::write(
+            peer_, boost::asio::buffer(data.data(), data.size()), ec);
+    }
+};
+
+class Test_Asio : public ::testing::Test
+{
+public:
+    // A message from the asio router
+    struct Delivery {
+        ot::OTZMQWorkType type_{};
+        ot::Space bytes_{};
+        const void* address_{};
+    };
+
+    const ot::api::network::Asio& asio_;
+    const zmq::Context& zmq_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::deque<Delivery> received_;
+    std::set<const void*> addresses_;
+    ot::OTZMQListenCallback cb_;
+    ot::OTZMQDealerSocket dealer_;
+
+    // Every byte depends on the message and its position, so data delivered
+    // from the wrong place in a buffer is detected
+    static auto body(const std::size_t index, const std::size_t size)
+        -> ot::Space
+    {
+        auto output = ot::space(size);
+
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            output[i] = static_cast<std::byte>((31u * index + i) % 251u);
+        }
+
+        return output;
+    }
+    static auto message(const std::size_t index, const std::size_t size)
+        -> ot::Space
+    {
+        const auto encoded = static_cast<std::uint64_t>(size);
+        auto output = ot::space(header_bytes_);
+        std::memcpy(output.data(), &encoded, sizeof(encoded));
+        const auto data = body(index, size);
+        output.insert(output.end(), data.begin(), data.end());
+
+        return output;
+    }
+
+    // Registers with the asio router and connects the socket. Returns the
+    // connection id, or nothing on failure.
+    auto connect(ot::network::asio::Socket& socket) -> ot::Space
+    {
+        if (false == dealer_->Send(zmq_.TaggedMessage(
+                         ot::WorkType::AsioRegister))) {
+            return {};
+        }
+
+        auto id = next().bytes_;
+
+        if (id.empty() || (false == socket.Connect(ot::reader(id)))) {
+            return {};
+        }
+
+        EXPECT_EQ(next().type_, ot::value(ot::WorkType::AsioConnect));
+
+        return id;
+    }
+    auto next() -> Delivery
+    {
+        auto lock = std::unique_lock<std::mutex>{lock_};
+        const auto ready = cv_.wait_for(lock, std::chrono::seconds(10), [&] {
+            return false == received_.empty();
+        });
+
+        if (false == ready) { return {}; }
+
+        auto output = std::move(received_.front());
+        received_.pop_front();
+
+        return output;
+    }
+    // Reads the header and the body of one message, the way a peer does
+    auto read(
+        ot::network::asio::Socket& socket,
+        const ot::Space& id,
+        const std::size_t index,
+        const std::size_t size) -> bool
+    {
+        const auto requested =
+            socket.Receive(ot::reader(id), header_type_, header_bytes_);
+
+        if (false == requested) { return false; }
+
+        const auto header = next();
+
+        EXPECT_EQ(header.type_, header_type_);
+
+        if (header_bytes_ != header.bytes_.size()) { return false; }
+
+        auto encoded = std::uint64_t{};
+        std::memcpy(&encoded, header.bytes_.data(), sizeof(encoded));
+
+        EXPECT_EQ(encoded, size);
+
+        if (0 == size) { return size == encoded; }
+
+        if (false == socket.Receive(ot::reader(id), body_type_, size)) {
+            return false;
+        }
+
+        const auto received = next();
+
+        EXPECT_EQ(received.type_, body_type_);
+        EXPECT_EQ(received.bytes_.size(), size);
+        EXPECT_TRUE(received.bytes_ == body(index, size));
+        addresses_.emplace(received.address_);
+
+        return body_type_ == received.type_;
+    }
+    auto receive(zmq::Message& in) -> void
+    {
+        const auto body = in.Body();
+
+        if (0 == body.size()) { return; }
+
+        auto delivery = Delivery{};
+        delivery.type_ = body.at(0).as<ot::OTZMQWorkType>();
+
+        if (1 < body.size()) {
+            const auto& frame = in.at(in.size() - 1u);
+            delivery.bytes_ = ot::space(frame.Bytes());
+            delivery.address_ = frame.data();
+        }
+
+        {
+            auto lock = std::unique_lock<std::mutex>{lock_};
+            received_.emplace_back(std::move(delivery));
+        }
+
+        cv_.notify_all();
+    }
+
+    Test_Asio()
+        : asio_(ot::Context().Asio())
+        , zmq_(ot::Context().ZMQ())
+        , lock_()
+        , cv_()
+        , received_()
+        , addresses_()
+        , cb_(zmq::ListenCallback::Factory([this](auto& in) { receive(in); }))
+        , dealer_(zmq_.DealerSocket(
+              cb_,
+              zmq::socket::Socket::Direction::Connect))
+    {
+        const auto started = dealer_->Start(asio_.NotificationEndpoint());
+
+        OT_ASSERT(started);
+    }
+};
+
+using Statistics = std::vector<ot::api::network::Asio::ThreadStatistics>;
+
+auto handled(const Statistics& stats) -> std::size_t
+{
+    auto output = std::size_t{0};
+
+    for (const auto& thread : stats) { output += thread.handled_; }
+
+    return output;
+}
+
+auto loopback(const std::uint16_t port) -> ot::network::asio::Endpoint
+{
+    using Type = ot::network::asio::Endpoint::Type;
+    const auto bytes = boost::asio::ip::address_v4::loopback().to_bytes();
+
+    return {
+        Type::ipv4,
+        ot::ReadView{reinterpret_cast<const char*>(bytes.data()), bytes.size()},
+        port};
+}
+}  // namespace
+
+// Messages written back to back must be delivered intact whether a body is
+// copied or shared, is split across reads, or is larger than a buffer
+TEST_F(Test_Asio, back_to_back_messages)
+{
+    // Sizes on both sides of the zero copy threshold and of the 256 KiB
+    // receive buffer, with small messages in between
+    const auto sizes = std::vector<std::size_t>{
+        0,
+        10,
+        4095,
+        4096,
+        4097,
+        8,
+        65536,
+        262143,
+        262145,
+        4096,
+        1048576,
+        4096,
+        0,
+        12};
+    auto server = Server{};
+    const auto endpoint = loopback(server.Port());
+    auto socket = asio_.MakeSocket(endpoint);
+    const auto id = connect(socket);
+
+    ASSERT_FALSE(id.empty());
+
+    auto stream = ot::Space{};
+
+    for (auto i = std::size_t{0}; i < sizes.size(); ++i) {
+        const auto data = message(i, sizes.at(i));
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    server.Send(std::move(stream));
+
+    for (auto i = std::size_t{0}; i < sizes.size(); ++i) {
+        ASSERT_TRUE(read(socket, id, i, sizes.at(i)));
+    }
+}
+
+// Shared buffers must return to the pool once the frames referring to them
+// are gone, so a steady stream of large messages keeps using the same memory
+TEST_F(Test_Asio, buffer_reuse)
+{
+    constexpr auto size = std::size_t{65536};
+    auto server = Server{};
+    const auto endpoint = loopback(server.Port());
+    auto socket = asio_.MakeSocket(endpoint);
+    const auto id = connect(socket);
+
+    ASSERT_FALSE(id.empty());
+
+    for (auto i = std::size_t{0}; i < reuse_count_; ++i) {
+        server.Send(message(i, size));
+
+        ASSERT_TRUE(read(socket, id, i, size));
+    }
+
+    EXPECT_LT(addresses_.size(), reuse_count_ / 2u);
+}
+
+// Sockets are assigned to the io_context thread serving the fewest sockets
+// and are released from it when destroyed
+TEST_F(Test_Asio, shard_assignment)
+{
+    const auto before = asio_.Statistics();
+
+    ASSERT_LT(0u, before.size());
+
+    auto server = Server{};
+    const auto endpoint = loopback(server.Port());
+    auto sockets = std::vector<ot::network::asio::Socket>{};
+    auto lowest = before.front().sockets_;
+    auto highest = before.front().sockets_;
+
+    for (const auto& thread : before) {
+        lowest = std::min(lowest, thread.sockets_);
+        highest = std::max(highest, thread.sockets_);
+    }
+
+    // Enough sockets to raise every thread above the busiest one
+    const auto count =
+        before.size() * (highest - lowest + 2u) + before.size() / 2u;
+
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        sockets.emplace_back(asio_.MakeSocket(endpoint));
+    }
+
+    const auto during = asio_.Statistics();
+
+    ASSERT_EQ(before.size(), during.size());
+
+    auto added = std::size_t{0};
+    lowest = during.front().sockets_;
+    highest = during.front().sockets_;
+
+    for (auto i = std::size_t{0}; i < during.size(); ++i) {
+        const auto& thread = during.at(i);
+
+        EXPECT_LE(before.at(i).sockets_, thread.sockets_);
+
+        added += thread.sockets_ - before.at(i).sockets_;
+        lowest = std::min(lowest, thread.sockets_);
+        highest = std::max(highest, thread.sockets_);
+    }
+
+    EXPECT_EQ(count, added);
+    EXPECT_LE(highest - lowest, 1u);
+
+    sockets.clear();
+    const auto after = asio_.Statistics();
+
+    ASSERT_EQ(before.size(), after.size());
+
+    for (auto i = std::size_t{0}; i < after.size(); ++i) {
+        EXPECT_EQ(before.at(i).sockets_, after.at(i).sockets_);
+    }
+}
+
+// Connecting, reading and writing are counted as handled once they complete,
+// and nothing remains queued after they have
+TEST_F(Test_Asio, statistics)
+{
+    constexpr auto size = std::size_t{65536};
+    const auto before = asio_.Statistics();
+    auto server = Server{};
+    const auto endpoint = loopback(server.Port());
+    auto socket = asio_.MakeSocket(endpoint);
+    const auto id = connect(socket);
+
+    ASSERT_FALSE(id.empty());
+
+    // One connect, two reads and one posted delivery at least
+    server.Send(message(0, size));
+
+    ASSERT_TRUE(read(socket, id, 0, size));
+
+    auto status = std::make_unique<std::promise<bool>>();
+    auto sent = status->get_future();
+
+    // Small enough to fit in the socket buffers since the server never reads
+    const auto outgoing = message(1, 1024);
+
+    ASSERT_TRUE(socket.Transmit(ot::reader(outgoing), std::move(status)));
+    ASSERT_EQ(
+        std::future_status::ready, sent.wait_for(std::chrono::seconds(10)));
+    EXPECT_TRUE(sent.get());
+
+    const auto after = asio_.Statistics();
+
+    ASSERT_EQ(before.size(), after.size());
+    EXPECT_LE(handled(before) + 5u, handled(after));
+
+    for (auto i = std::size_t{0}; i < after.size(); ++i) {
+        const auto& thread = after.at(i);
+
+        EXPECT_EQ(before.at(i).queued_, thread.queued_);
+        EXPECT_LE(thread.average_latency_, thread.max_latency_);
+    }
+}
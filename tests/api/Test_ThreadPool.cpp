@@ -0,0 +1,186 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/ThreadPool.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Push.hpp"
+#include "opentxs/network/zeromq/socket/Sender.tpp"
+#include "opentxs/network/zeromq/socket/Socket.hpp"
+#include "util/Work.hpp"
+
+namespace zmq = ot::network::zeromq;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto job_count_ = std::size_t{100000};
+constexpr auto latency_count_ = std::size_t{1000};
+constexpr auto fan_out_ = std::size_t{100};
+constexpr auto work_type_ =
+    ot::OTZMQWorkType{ot::OT_ZMQ_INTERNAL_SIGNAL + 1000};
+
+class Test_ThreadPool : public ::testing::Test
+{
+public:
+    static std::atomic<std::size_t> messages_;
+    static std::atomic<std::promise<void>*> latency_;
+
+    const ot::api::ThreadPool& pool_;
+    const zmq::Context& zmq_;
+
+    static auto wait(
+        const std::atomic<std::size_t>& counter,
+        const std::size_t target) -> bool
+    {
+        const auto deadline = Clock::now() + std::chrono::minutes(2);
+
+        while (counter < target) {
+            if (Clock::now() > deadline) { return false; }
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    static auto per_second(const std::size_t count, const Clock::duration time)
+        -> double
+    {
+        const auto seconds = std::chrono::duration<double>{time}.count();
+
+        return (0 < seconds) ? (count / seconds) : 0.0;
+    }
+
+    static auto microseconds(
+        const Clock::duration time,
+        const std::size_t count) -> double
+    {
+        return std::chrono::duration<double, std::micro>{time}.count() / count;
+    }
+
+    Test_ThreadPool()
+        : pool_(ot::Context().ThreadPool())
+        , zmq_(ot::Context().ZMQ())
+    {
+        static const auto registered = pool_.Register(
+            work_type_,
+            [](const ot::api::ThreadPool::Message&) -> void {
+                ++messages_;
+
+                if (auto* promise = latency_.load(); nullptr != promise) {
+                    promise->set_value();
+                }
+            });
+
+        OT_ASSERT(registered);
+    }
+};
+
+std::atomic<std::size_t> Test_ThreadPool::messages_{0};
+std::atomic<std::promise<void>*> Test_ThreadPool::latency_{nullptr};
+}  // namespace
+
+// Jobs submitted by other jobs go onto the submitting worker's deque and must
+// still all run, whichever worker ends up running them
+TEST_F(Test_ThreadPool, nested_jobs)
+{
+    auto counter = std::atomic<std::size_t>{0};
+
+    for (auto i = std::size_t{0}; i < fan_out_; ++i) {
+        ASSERT_TRUE(pool_.Run([&] {
+            for (auto j = std::size_t{0}; j < fan_out_; ++j) {
+                pool_.Run([&] { ++counter; });
+            }
+        }));
+    }
+
+    EXPECT_TRUE(wait(counter, fan_out_ * fan_out_));
+}
+
+// Compares the existing message based interface with submitting callables
+// directly to the executor
+TEST_F(Test_ThreadPool, benchmark)
+{
+    auto socket = zmq_.PushSocket(zmq::socket::Socket::Direction::Connect);
+
+    ASSERT_TRUE(socket->Start(pool_.Endpoint()));
+
+    messages_ = 0;
+    const auto messageStart = Clock::now();
+
+    for (auto i = std::size_t{0}; i < job_count_; ++i) {
+        ASSERT_TRUE(
+            socket->Send(ot::api::ThreadPool::MakeWork(zmq_, work_type_)));
+    }
+
+    ASSERT_TRUE(wait(messages_, job_count_));
+
+    const auto messageTime = Clock::now() - messageStart;
+    auto jobs = std::atomic<std::size_t>{0};
+    const auto jobStart = Clock::now();
+
+    for (auto i = std::size_t{0}; i < job_count_; ++i) {
+        ASSERT_TRUE(pool_.Run([&] { ++jobs; }));
+    }
+
+    ASSERT_TRUE(wait(jobs, job_count_));
+
+    const auto jobTime = Clock::now() - jobStart;
+    auto messageLatency = Clock::duration{};
+    auto jobLatency = Clock::duration{};
+
+    for (auto i = std::size_t{0}; i < latency_count_; ++i) {
+        auto promise = std::promise<void>{};
+        auto future = promise.get_future();
+        latency_ = &promise;
+        const auto start = Clock::now();
+
+        ASSERT_TRUE(
+            socket->Send(ot::api::ThreadPool::MakeWork(zmq_, work_type_)));
+
+        future.wait();
+        messageLatency += Clock::now() - start;
+        latency_ = nullptr;
+    }
+
+    for (auto i = std::size_t{0}; i < latency_count_; ++i) {
+        auto promise = std::promise<void>{};
+        auto future = promise.get_future();
+        const auto start = Clock::now();
+
+        ASSERT_TRUE(pool_.Run([&] { promise.set_value(); }));
+
+        future.wait();
+        jobLatency += Clock::now() - start;
+    }
+
+    std::cout << "Message throughput: " << per_second(job_count_, messageTime)
+              << " jobs/second\n"
+              << "Callable throughput: " << per_second(job_count_, jobTime)
+              << " jobs/second\n"
+              << "Message latency: "
+              << microseconds(messageLatency, latency_count_)
+              << " microseconds\n"
+              << "Callable latency: "
+              << microseconds(jobLatency, latency_count_)
+              << " microseconds\n";
+}
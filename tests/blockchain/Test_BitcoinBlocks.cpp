@@ -8,8 +8,11 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
+#include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -24,6 +27,7 @@
 #include "blockchain/bitcoin/CompactSize.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/bitcoin/Bitcoin.hpp"
+#include "internal/blockchain/block/Block.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -32,15 +36,18 @@
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/api/client/Blockchain.hpp"
 #include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/client/blockchain/Subchain.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
 #include "opentxs/blockchain/FilterType.hpp"
 #include "opentxs/blockchain/Network.hpp"
 #include "opentxs/blockchain/block/Block.hpp"
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/blockchain/client/FilterOracle.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/core/Data.hpp"
+#include "util/Container.hpp"
 
 namespace
 {
@@ -368,6 +375,96 @@ TEST_F(Test_BitcoinBlock, serialization)
     }
 }
 
+// Compares searching a block for wallet elements by instantiating only the
+// candidate transactions to searching every transaction individually, without
+// the block's prefilter. Both searches must find the same matches.
+TEST_F(Test_BitcoinBlock, lazy_find_matches)
+{
+    using Clock = std::chrono::steady_clock;
+    using ot::blockchain::block::Block;
+    constexpr auto chain{ot::blockchain::Type::Bitcoin_testnet3};
+    constexpr auto style{ot::blockchain::filter::Type::ES};
+    constexpr auto stride = std::size_t{10};
+    auto lazy = Clock::duration{};
+    auto full = Clock::duration{};
+
+    for (const auto& vector : bip_158_vectors_) {
+        const auto raw = vector.Block(api_);
+        auto patterns = Block::Patterns{};
+
+        {
+            const auto pBlock =
+                api_.Factory().BitcoinBlock(chain, raw->Bytes());
+
+            ASSERT_TRUE(pBlock);
+
+            const auto elements = pBlock->ExtractElements(style);
+            const auto subchain = Block::SubchainID{
+                ot::api::client::blockchain::Subchain::External,
+                api_.Factory().Identifier()};
+
+            for (auto i = std::size_t{0}; i < elements.size(); i += stride) {
+                patterns.emplace_back(
+                    Block::ElementID{static_cast<ot::Bip32Index>(i), subchain},
+                    elements.at(i));
+            }
+        }
+
+        auto start = Clock::now();
+        const auto pLazy = api_.Factory().BitcoinBlock(chain, raw->Bytes());
+
+        ASSERT_TRUE(pLazy);
+
+        const auto lazyMatches = pLazy->FindMatches(style, {}, patterns);
+        lazy += Clock::now() - start;
+        start = Clock::now();
+        const auto pFull = api_.Factory().BitcoinBlock(chain, raw->Bytes());
+
+        ASSERT_TRUE(pFull);
+
+        // Searches every transaction, without the block's prefilter
+        auto fullMatches = Block::Matches{};
+        const auto parsed = Block::ParsedPatterns{patterns};
+
+        for (const auto& tx : *pFull) {
+            ASSERT_TRUE(tx);
+
+            auto temp = tx->FindMatches(style, {}, parsed);
+            std::move(
+                temp.second.begin(),
+                temp.second.end(),
+                std::back_inserter(fullMatches.second));
+        }
+
+        ot::dedup(fullMatches.second);
+        full += Clock::now() - start;
+
+        EXPECT_EQ(patterns.empty(), fullMatches.second.empty());
+        ASSERT_EQ(lazyMatches.second.size(), fullMatches.second.size());
+
+        for (auto i = std::size_t{0}; i < fullMatches.second.size(); ++i) {
+            const auto& [lTxid, lElement] = lazyMatches.second.at(i);
+            const auto& [fTxid, fElement] = fullMatches.second.at(i);
+
+            EXPECT_EQ(lTxid.get(), fTxid.get());
+            EXPECT_EQ(lElement.first, fElement.first);
+        }
+
+        auto serialized = api_.Factory().Data();
+
+        EXPECT_TRUE(pLazy->Serialize(serialized->WriteInto()));
+        EXPECT_EQ(raw.get(), serialized);
+    }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    std::cout << "Parse and search, instantiating candidates only: "
+              << duration_cast<microseconds>(lazy).count() << " us\n"
+              << "Parse and search every transaction: "
+              << duration_cast<microseconds>(full).count() << " us\n";
+}
+
 TEST_F(Test_BitcoinBlock, bch_filter_1307544)
 {
     const auto& filter = bch_filter_1307544_;
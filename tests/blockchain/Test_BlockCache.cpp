@@ -0,0 +1,253 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Helpers.hpp"
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/BlockOracle.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/client/BlockOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+// Exposes the in-memory block cache of BlockOracle
+class BlockCacheTest
+{
+public:
+    using Mem = BlockOracle::Cache::Mem;
+};
+}  // namespace opentxs::blockchain::client::implementation
+
+namespace
+{
+using Mem = ot::blockchain::client::implementation::BlockCacheTest::Mem;
+using Block = ot::blockchain::client::BlockOracle::BitcoinBlock_p;
+using Future = ot::blockchain::client::BlockOracle::BitcoinBlockFuture;
+using Pin = ot::blockchain::client::internal::BlockOracle::Pin;
+
+constexpr auto capacity_ = std::size_t{3};
+
+class Test_BlockCache : public ::testing::Test
+{
+public:
+    const ot::api::client::Manager& api_;
+    const Block block_;
+    // Every block in the cache is a copy of the same block so they all have
+    // the same size
+    const std::size_t size_;
+    std::mutex lock_;
+    Mem mem_;
+
+    static auto id(const std::size_t i) -> ot::OTData
+    {
+        auto output = ot::Data::Factory();
+        output->SetSize(32);
+        std::memcpy(output->data(), &i, sizeof(i));
+
+        return output;
+    }
+
+    auto cached(const std::size_t i) -> bool
+    {
+        return mem_.find(id(i)->Bytes()).valid();
+    }
+    auto push(const std::size_t i) -> void
+    {
+        auto promise = std::promise<Block>{};
+        promise.set_value(block_);
+        mem_.push(id(i), promise.get_future().share());
+    }
+
+    Test_BlockCache()
+        : api_(ot::Context().StartClient({}, 0))
+        , block_(api_.Factory().BitcoinBlock(
+              ot::blockchain::Type::UnitTest,
+              api_.Factory()
+                  .Data(
+                      genesis_block_data_.at(ot::blockchain::Type::UnitTest)
+                          .genesis_block_hex_,
+                      ot::StringStyle::Hex)
+                  ->Bytes()))
+        , size_(block_ ? block_->CalculateSize() : 0u)
+        , lock_()
+        , mem_(capacity_ * size_, lock_)
+    {
+    }
+};
+}  // namespace
+
+TEST_F(Test_BlockCache, statistics)
+{
+    ASSERT_TRUE(block_);
+    ASSERT_LT(0u, size_);
+
+    push(0);
+
+    EXPECT_TRUE(cached(0));
+    EXPECT_TRUE(cached(0));
+    EXPECT_FALSE(cached(1));
+    EXPECT_FALSE(mem_.find({}).valid());
+
+    const auto stats = mem_.Statistics();
+
+    EXPECT_EQ(stats.hits_, 2u);
+    EXPECT_EQ(stats.misses_, 1u);
+    EXPECT_EQ(stats.evictions_, 0u);
+    EXPECT_EQ(stats.blocks_, 1u);
+    EXPECT_EQ(stats.bytes_, size_);
+    EXPECT_EQ(stats.limit_, capacity_ * size_);
+
+    // Replacing a block does not count it twice
+    push(0);
+
+    EXPECT_EQ(mem_.Statistics().blocks_, 1u);
+    EXPECT_EQ(mem_.Statistics().bytes_, size_);
+}
+
+TEST_F(Test_BlockCache, lru_eviction)
+{
+    ASSERT_TRUE(block_);
+
+    for (auto i = std::size_t{0}; i < capacity_; ++i) { push(i); }
+
+    EXPECT_EQ(mem_.Statistics().evictions_, 0u);
+    EXPECT_EQ(mem_.Statistics().bytes_, capacity_ * size_);
+
+    push(capacity_);
+
+    const auto stats = mem_.Statistics();
+
+    EXPECT_EQ(stats.evictions_, 1u);
+    EXPECT_EQ(stats.blocks_, capacity_);
+    EXPECT_EQ(stats.bytes_, capacity_ * size_);
+    EXPECT_FALSE(cached(0));
+
+    for (auto i = std::size_t{1}; i <= capacity_; ++i) {
+        EXPECT_TRUE(cached(i));
+    }
+}
+
+// Finding a block makes it the most recently used
+TEST_F(Test_BlockCache, lru_order)
+{
+    ASSERT_TRUE(block_);
+
+    push(0);
+    push(1);
+    push(2);
+
+    ASSERT_TRUE(cached(0));
+
+    push(3);
+
+    EXPECT_EQ(mem_.Statistics().evictions_, 1u);
+
+    ASSERT_TRUE(cached(2));
+
+    push(4);
+
+    EXPECT_EQ(mem_.Statistics().evictions_, 2u);
+    EXPECT_FALSE(cached(1));
+    EXPECT_FALSE(cached(0));
+    EXPECT_TRUE(cached(2));
+    EXPECT_TRUE(cached(3));
+    EXPECT_TRUE(cached(4));
+}
+
+TEST_F(Test_BlockCache, pinning)
+{
+    ASSERT_TRUE(block_);
+
+    const auto pin = mem_.pin(id(0));
+
+    ASSERT_TRUE(pin);
+    EXPECT_EQ(*pin, id(0).get());
+    // Pinning a block twice returns the same pin
+    EXPECT_EQ(mem_.pin(id(0)).get(), pin.get());
+
+    for (auto i = std::size_t{0}; i <= capacity_; ++i) { push(i); }
+
+    // The least recently used block is pinned so the next one is evicted
+    EXPECT_EQ(mem_.Statistics().evictions_, 1u);
+    EXPECT_TRUE(cached(0));
+    EXPECT_FALSE(cached(1));
+    EXPECT_TRUE(cached(2));
+    EXPECT_TRUE(cached(3));
+}
+
+// Pinned blocks may exceed the budget until they are unpinned, and the cache
+// returns to its budget as soon as they are
+TEST_F(Test_BlockCache, budget_with_pins)
+{
+    ASSERT_TRUE(block_);
+
+    auto pins = std::vector<Pin>{};
+
+    for (auto i = std::size_t{0}; i <= capacity_; ++i) {
+        pins.emplace_back(mem_.pin(id(i)));
+        push(i);
+    }
+
+    auto stats = mem_.Statistics();
+
+    EXPECT_EQ(stats.evictions_, 0u);
+    EXPECT_EQ(stats.blocks_, capacity_ + 1u);
+    EXPECT_EQ(stats.bytes_, (capacity_ + 1u) * size_);
+
+    // A copy of a pin keeps the block pinned
+    auto copy = pins.at(0);
+    pins.at(0).reset();
+
+    EXPECT_EQ(mem_.Statistics().evictions_, 0u);
+
+    copy.reset();
+    stats = mem_.Statistics();
+
+    EXPECT_EQ(stats.evictions_, 1u);
+    EXPECT_EQ(stats.blocks_, capacity_);
+    EXPECT_EQ(stats.bytes_, capacity_ * size_);
+    EXPECT_FALSE(cached(0));
+
+    // Releasing the rest does not evict anything since the cache is within
+    // its budget
+    pins.clear();
+
+    EXPECT_EQ(mem_.Statistics().evictions_, 1u);
+
+    for (auto i = std::size_t{1}; i <= capacity_; ++i) {
+        EXPECT_TRUE(cached(i));
+    }
+}
+
+TEST_F(Test_BlockCache, pin_outlives_cache)
+{
+    ASSERT_TRUE(block_);
+
+    auto lock = std::mutex{};
+    auto pin = Pin{};
+
+    {
+        auto mem = std::make_unique<Mem>(size_, lock);
+        pin = mem->pin(id(0));
+    }
+
+    ASSERT_TRUE(pin);
+
+    pin.reset();
+}
@@ -0,0 +1,262 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <lmdb.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "api/client/blockchain/database/Blocks.hpp"
+#include "internal/api/client/blockchain/Blockchain.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/core/Data.hpp"
+#include "util/LMDB.hpp"
+
+namespace
+{
+namespace blockchain = ot::api::client::blockchain;
+namespace fs = boost::filesystem;
+
+using Blocks = blockchain::database::implementation::Blocks;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto block_count_ = std::size_t{100};
+constexpr auto block_size_ = std::size_t{1024};
+constexpr auto loads_per_thread_ = std::size_t{10000};
+
+class Test_BlockStorage : public ::testing::Test
+{
+public:
+    const std::string path_;
+    ot::storage::lmdb::LMDB lmdb_;
+    Blocks blocks_;
+
+    static auto make_path() -> std::string
+    {
+        const auto path = fs::temp_directory_path() /
+                          fs::unique_path("opentxs-blocks-%%%%-%%%%-%%%%-%%%%");
+        fs::create_directories(path);
+
+        return path.string();
+    }
+    static auto hash(const std::size_t i) -> ot::OTData
+    {
+        auto output = ot::Data::Factory();
+        output->SetSize(32);
+        std::memcpy(output->data(), &i, sizeof(i));
+
+        return output;
+    }
+
+    auto store(const ot::Data& block, const char fill) -> bool
+    {
+        auto writer = blocks_.Store(block, block_size_);
+
+        if (false == writer.valid()) { return false; }
+
+        std::memset(writer.get().data(), fill, writer.size());
+
+        return true;
+    }
+
+    Test_BlockStorage()
+        : path_(make_path())
+        , lmdb_(
+              {{blockchain::Config, "config"},
+               {blockchain::BlockIndex, "blocks"}},
+              path_,
+              {{blockchain::Config, MDB_INTEGERKEY},
+               {blockchain::BlockIndex, 0}})
+        , blocks_(lmdb_, path_)
+    {
+    }
+
+    ~Test_BlockStorage() override { fs::remove_all(path_); }
+};
+}  // namespace
+
+TEST_F(Test_BlockStorage, store_and_load)
+{
+    const auto block = hash(0);
+
+    EXPECT_FALSE(blocks_.Exists(block));
+    EXPECT_FALSE(blocks_.Load(block).valid());
+    ASSERT_TRUE(store(block, 'a'));
+    EXPECT_TRUE(blocks_.Exists(block));
+
+    {
+        const auto reader = blocks_.Load(block);
+
+        ASSERT_TRUE(reader.valid());
+        ASSERT_EQ(block_size_, reader.size());
+        EXPECT_EQ('a', reader.get().front());
+        EXPECT_EQ('a', reader.get().back());
+    }
+
+    ASSERT_TRUE(store(block, 'b'));
+
+    const auto reader = blocks_.Load(block);
+
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ('b', reader.get().front());
+}
+
+TEST_F(Test_BlockStorage, readers_do_not_block_other_blocks)
+{
+    const auto first = hash(0);
+    const auto second = hash(1);
+
+    ASSERT_TRUE(store(first, 'a'));
+
+    const auto reader = blocks_.Load(first);
+
+    ASSERT_TRUE(reader.valid());
+    // A held reader must not prevent this thread from writing or reading
+    // any other block
+    ASSERT_TRUE(store(second, 'b'));
+
+    const auto other = blocks_.Load(second);
+
+    ASSERT_TRUE(other.valid());
+    EXPECT_EQ('b', other.get().front());
+}
+
+TEST_F(Test_BlockStorage, store_waits_without_blocking_other_blocks)
+{
+    const auto first = hash(0);
+    const auto second = hash(1);
+
+    ASSERT_TRUE(store(first, 'a'));
+    ASSERT_TRUE(store(second, 'b'));
+
+    auto reader =
+        std::make_unique<blockchain::BlockReader>(blocks_.Load(first));
+
+    ASSERT_TRUE(reader->valid());
+
+    // Waits for the reader to be released
+    auto writer =
+        std::async(std::launch::async, [&] { return store(first, 'c'); });
+
+    EXPECT_EQ(
+        std::future_status::timeout,
+        writer.wait_for(std::chrono::milliseconds{100}));
+
+    // While the writer waits, other blocks must still be available to
+    // this thread and to other threads
+    auto other = std::async(std::launch::async, [&] {
+        const auto view = blocks_.Load(second);
+
+        return view.valid() && ('b' == view.get().front());
+    });
+    const auto loaded = other.wait_for(std::chrono::seconds{10});
+
+    EXPECT_EQ(std::future_status::ready, loaded);
+    EXPECT_EQ('a', reader->get().front());
+
+    reader.reset();
+
+    ASSERT_TRUE(writer.get());
+    EXPECT_TRUE(other.get());
+
+    const auto updated = blocks_.Load(first);
+
+    ASSERT_TRUE(updated.valid());
+    EXPECT_EQ('c', updated.get().front());
+}
+
+TEST_F(Test_BlockStorage, lock_table_shrinks)
+{
+    for (auto i = std::size_t{0}; i < block_count_; ++i) {
+        ASSERT_TRUE(store(hash(i), static_cast<char>(i)));
+    }
+
+    EXPECT_EQ(0, blocks_.LockedBlocks());
+
+    {
+        auto readers = std::vector<blockchain::BlockReader>{};
+
+        for (auto i = std::size_t{0}; i < block_count_; ++i) {
+            readers.emplace_back(blocks_.Load(hash(i)));
+
+            ASSERT_TRUE(readers.back().valid());
+        }
+
+        // A second reader shares the entry of the first
+        const auto again = blocks_.Load(hash(0));
+
+        ASSERT_TRUE(again.valid());
+        EXPECT_EQ(block_count_, blocks_.LockedBlocks());
+
+        readers.resize(block_count_ / 2);
+
+        EXPECT_EQ(block_count_ / 2, blocks_.LockedBlocks());
+    }
+
+    EXPECT_EQ(0, blocks_.LockedBlocks());
+}
+
+// Reports block load throughput as the number of loading threads increases
+TEST_F(Test_BlockStorage, concurrent_load_benchmark)
+{
+    for (auto i = std::size_t{0}; i < block_count_; ++i) {
+        ASSERT_TRUE(store(hash(i), static_cast<char>(i)));
+    }
+
+    const auto hashes = [] {
+        auto output = std::vector<ot::OTData>{};
+
+        for (auto i = std::size_t{0}; i < block_count_; ++i) {
+            output.emplace_back(hash(i));
+        }
+
+        return output;
+    }();
+    const auto max = std::max(2u, std::thread::hardware_concurrency());
+
+    for (auto count = 1u; count <= max; count *= 2u) {
+        auto failures = std::atomic<std::size_t>{0};
+        auto threads = std::vector<std::thread>{};
+        const auto start = Clock::now();
+
+        for (auto t = 0u; t < count; ++t) {
+            threads.emplace_back([&, t] {
+                for (auto i = std::size_t{0}; i < loads_per_thread_; ++i) {
+                    const auto index = (i + t) % block_count_;
+                    const auto reader = blocks_.Load(hashes.at(index));
+
+                    if ((false == reader.valid()) ||
+                        (static_cast<char>(index) != reader.get().front())) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) { thread.join(); }
+
+        const auto elapsed =
+            std::chrono::duration<double>{Clock::now() - start}.count();
+        const auto loads = count * loads_per_thread_;
+
+        EXPECT_EQ(0, failures.load());
+
+        std::cout << count << " threads: "
+                  << ((0 < elapsed) ? (loads / elapsed) : 0.0)
+                  << " loads per second\n";
+    }
+}
@@ -0,0 +1,232 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/database/CompactHeaders.hpp"
+#include "internal/blockchain/block/Block.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/Work.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace
+{
+namespace b = ot::blockchain;
+namespace fs = boost::filesystem;
+
+using CompactHeaders = b::database::CompactHeaders;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto chain_ = b::Type::UnitTest;
+// Approximately the height of the Bitcoin mainnet chain
+constexpr auto chain_height_ = b::block::Height{700000};
+constexpr auto batch_size_ = std::size_t{1000};
+constexpr auto ancestors_ = std::size_t{2016};
+
+class Test_CompactHeaders : public ::testing::Test
+{
+public:
+    const ot::api::Core& api_;
+    const std::string path_;
+
+    static auto make_path() -> std::string
+    {
+        const auto path =
+            fs::temp_directory_path() /
+            fs::unique_path("opentxs-headers-%%%%-%%%%-%%%%-%%%%");
+        fs::create_directories(path);
+
+        return path.string();
+    }
+    static auto seconds(const Clock::time_point start) -> double
+    {
+        return std::chrono::duration<double>{Clock::now() - start}.count();
+    }
+
+    auto child(const b::block::Header& parent)
+        -> std::unique_ptr<b::block::bitcoin::Header>
+    {
+        return ot::factory::BitcoinBlockHeader(
+            api_, chain_, parent.Hash(), parent.Hash(), parent.Height() + 1);
+    }
+    auto genesis() -> std::unique_ptr<b::block::bitcoin::Header>
+    {
+        auto blank = ot::Data::Factory();
+        blank->SetSize(32);
+
+        return ot::factory::BitcoinBlockHeader(api_, chain_, blank, blank, 0);
+    }
+    static auto store(
+        CompactHeaders& index,
+        const std::vector<std::unique_ptr<b::block::bitcoin::Header>>& headers)
+        -> bool
+    {
+        auto pointers = std::vector<const b::block::Header*>{};
+
+        for (const auto& header : headers) {
+            pointers.emplace_back(header.get());
+        }
+
+        return index.Store(pointers);
+    }
+
+    Test_CompactHeaders()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , path_(make_path())
+    {
+    }
+
+    ~Test_CompactHeaders() override { fs::remove_all(path_); }
+};
+}  // namespace
+
+TEST_F(Test_CompactHeaders, store_and_load)
+{
+    auto headers = std::vector<std::unique_ptr<b::block::bitcoin::Header>>{};
+    headers.emplace_back(genesis());
+
+    ASSERT_TRUE(headers.back());
+
+    for (auto i = 0; i < 10; ++i) {
+        headers.emplace_back(child(*headers.back()));
+
+        ASSERT_TRUE(headers.back());
+    }
+
+    {
+        auto index = CompactHeaders{api_, chain_, path_};
+
+        EXPECT_EQ(0, index.Count());
+        EXPECT_EQ(0, index.Sequence());
+        EXPECT_FALSE(index.Load(headers.front()->Hash()));
+        ASSERT_TRUE(store(index, headers));
+        ASSERT_TRUE(store(index, headers));
+
+        index.Commit(1);
+    }
+
+    auto index = CompactHeaders{api_, chain_, path_};
+
+    EXPECT_EQ(headers.size(), index.Count());
+    EXPECT_EQ(1, index.Sequence());
+
+    for (const auto& expected : headers) {
+        auto bytes = ot::Space{};
+
+        ASSERT_TRUE(expected->Serialize(ot::writer(bytes)));
+
+        const auto loaded = index.Load(expected->Hash());
+
+        ASSERT_TRUE(loaded);
+        EXPECT_TRUE(index.Exists(expected->Hash()));
+        EXPECT_EQ(expected->Hash(), loaded->Hash());
+        EXPECT_EQ(expected->ParentHash(), loaded->ParentHash());
+        EXPECT_EQ(expected->Height(), loaded->Height());
+        EXPECT_EQ(expected->LocalState(), loaded->LocalState());
+        EXPECT_EQ(expected->InheritedState(), loaded->InheritedState());
+        EXPECT_EQ(
+            expected->ParentWork()->asHex(), loaded->ParentWork()->asHex());
+
+        auto reserialized = ot::Space{};
+
+        ASSERT_TRUE(loaded->Serialize(ot::writer(reserialized)));
+        EXPECT_EQ(bytes, reserialized);
+    }
+
+    index.Begin();
+
+    EXPECT_EQ(0, index.Sequence());
+
+    index.Reset();
+
+    EXPECT_EQ(0, index.Count());
+    EXPECT_FALSE(index.Exists(headers.front()->Hash()));
+}
+
+// Reports how long it takes to open the index and to walk back through the
+// ancestors of the tip for a chain as long as the Bitcoin mainnet. Generating
+// the chain takes a long time so this only runs when requested with
+// --gtest_also_run_disabled_tests
+TEST_F(Test_CompactHeaders, DISABLED_mainnet_height_benchmark)
+{
+    auto tip = ot::Data::Factory();
+
+    {
+        auto index = CompactHeaders{api_, chain_, path_};
+        auto batch = std::vector<std::unique_ptr<b::block::bitcoin::Header>>{};
+        auto previous = genesis();
+
+        ASSERT_TRUE(previous);
+
+        batch.emplace_back(std::move(previous));
+        const auto start = Clock::now();
+
+        while (chain_height_ > batch.back()->Height()) {
+            auto next = child(*batch.back());
+
+            ASSERT_TRUE(next);
+
+            if (batch_size_ <= batch.size()) {
+                ASSERT_TRUE(store(index, batch));
+
+                batch.clear();
+            }
+
+            batch.emplace_back(std::move(next));
+        }
+
+        ASSERT_TRUE(store(index, batch));
+
+        tip = ot::Data::Factory(batch.back()->Hash());
+        index.Commit(1);
+
+        std::cout << "Indexed " << index.Count() << " headers in "
+                  << seconds(start) << " seconds\n";
+    }
+
+    const auto start = Clock::now();
+    auto index = CompactHeaders{api_, chain_, path_};
+
+    std::cout << "Opened index in " << seconds(start) << " seconds\n";
+
+    ASSERT_EQ(static_cast<std::size_t>(chain_height_ + 1), index.Count());
+
+    const auto walk = Clock::now();
+    auto hash = ot::Data::Factory(tip);
+
+    for (auto i = std::size_t{0}; i < ancestors_; ++i) {
+        const auto header = index.Load(hash);
+
+        ASSERT_TRUE(header);
+        EXPECT_EQ(
+            chain_height_ - static_cast<b::block::Height>(i), header->Height());
+
+        hash = ot::Data::Factory(header->ParentHash());
+    }
+
+    const auto elapsed = seconds(walk);
+
+    std::cout << "Loaded " << ancestors_ << " ancestors in " << elapsed
+              << " seconds (" << ((elapsed * 1000000) / ancestors_)
+              << " microseconds per header)\n";
+}
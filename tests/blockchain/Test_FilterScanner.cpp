@@ -0,0 +1,289 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/FilterScanner.hpp"
+#include "blockchain/client/ParallelJob.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+// Exposes the scan requests and jobs of FilterScanner
+class FilterScannerTest
+{
+public:
+    using Job = FilterScanner::Job;
+    using Request = FilterScanner::Request;
+};
+}  // namespace opentxs::blockchain::client::implementation
+
+namespace
+{
+using Height = ot::blockchain::block::Height;
+using Job = ot::blockchain::client::implementation::FilterScannerTest::Job;
+using Request =
+    ot::blockchain::client::implementation::FilterScannerTest::Request;
+using Targets = std::vector<ot::ReadView>;
+// First height, last height, and the request which owns each target
+using Segments = std::vector<std::tuple<Height, Height, std::vector<int>>>;
+// Segment index, first height, and last height
+using Chunks = std::vector<std::tuple<std::size_t, Height, Height>>;
+
+constexpr auto threads_ = std::size_t{8};
+
+class Test_FilterScanner : public ::testing::Test
+{
+public:
+    const Targets one_;
+    const Targets two_;
+    std::deque<Request> requests_;
+
+    auto add(const Height start, const Height stop, const Targets& targets)
+        -> void
+    {
+        using Type = ot::blockchain::filter::Type;
+        requests_.emplace_back(Request{Type::ES, start, stop, targets, {}});
+    }
+    auto divide() -> std::pair<Segments, Chunks>
+    {
+        auto requests = std::vector<Request*>{};
+
+        for (auto& request : requests_) { requests.emplace_back(&request); }
+
+        const auto [segments, chunks] = Job::Divide(requests);
+        auto output = std::pair<Segments, Chunks>{};
+        auto& [outSegments, outChunks] = output;
+
+        for (const auto& segment : segments) {
+            auto& [first, last, owners] = outSegments.emplace_back(
+                segment.first_, segment.last_, std::vector<int>{});
+
+            EXPECT_EQ(segment.targets_.size(), segment.owners_.size());
+
+            for (const auto owner : segment.owners_) {
+                owners.emplace_back(static_cast<int>(owner));
+            }
+        }
+
+        for (const auto& chunk : chunks) {
+            outChunks.emplace_back(chunk.segment_, chunk.first_, chunk.last_);
+        }
+
+        return output;
+    }
+
+    Test_FilterScanner()
+        : one_({ot::ReadView{"a", 1}})
+        , two_({ot::ReadView{"b", 1}, ot::ReadView{"c", 1}})
+        , requests_()
+    {
+    }
+};
+
+// Counts how many times each chunk is processed
+class Counter final
+    : public ot::blockchain::client::implementation::ParallelJob<Counter>
+{
+public:
+    std::vector<std::atomic<int>> processed_;
+    std::atomic<int> finished_;
+    // Set by finish() if every chunk had been processed by then
+    std::atomic<bool> complete_;
+
+    auto chunks() const noexcept -> std::size_t { return processed_.size(); }
+    auto finish() noexcept -> void
+    {
+        auto complete{true};
+
+        for (const auto& count : processed_) {
+            complete &= (1 == count.load());
+        }
+
+        complete_.store(complete);
+        ++finished_;
+    }
+    auto process(const std::size_t chunk) noexcept -> void
+    {
+        ++processed_.at(chunk);
+        std::this_thread::yield();
+    }
+
+    explicit Counter(const std::size_t chunks) noexcept
+        : ParallelJob()
+        , processed_(chunks)
+        , finished_(0)
+        , complete_(false)
+    {
+    }
+};
+
+// Runs the job on several threads which each wait for it to finish
+auto run(Counter& job) -> void
+{
+    auto threads = std::vector<std::thread>{};
+    auto released = std::atomic<std::size_t>{0};
+
+    for (auto i = std::size_t{0}; i < threads_; ++i) {
+        threads.emplace_back([&] {
+            job.Run();
+            job.Wait();
+
+            // No thread is released before the job is finished
+            EXPECT_EQ(job.finished_.load(), 1);
+
+            ++released;
+        });
+    }
+
+    for (auto& thread : threads) { thread.join(); }
+
+    EXPECT_EQ(released.load(), threads_);
+}
+}  // namespace
+
+TEST_F(Test_FilterScanner, no_requests)
+{
+    const auto [segments, chunks] = divide();
+
+    EXPECT_TRUE(segments.empty());
+    EXPECT_TRUE(chunks.empty());
+}
+
+TEST_F(Test_FilterScanner, invalid_range)
+{
+    add(10, 9, one_);
+
+    const auto [segments, chunks] = divide();
+
+    EXPECT_TRUE(segments.empty());
+    EXPECT_TRUE(chunks.empty());
+}
+
+TEST_F(Test_FilterScanner, overlapping_requests)
+{
+    add(0, 199, one_);
+    add(100, 299, one_);
+
+    const auto [segments, chunks] = divide();
+    const auto expectedSegments = Segments{
+        {0, 99, {0}},
+        {100, 199, {0, 1}},
+        {200, 299, {1}},
+    };
+    const auto expectedChunks =
+        Chunks{{0, 0, 99}, {1, 100, 199}, {2, 200, 299}};
+
+    EXPECT_EQ(segments, expectedSegments);
+    EXPECT_EQ(chunks, expectedChunks);
+}
+
+TEST_F(Test_FilterScanner, nested_requests)
+{
+    add(0, 299, one_);
+    add(100, 149, two_);
+
+    const auto [segments, chunks] = divide();
+    const auto expectedSegments = Segments{
+        {0, 99, {0}},
+        {100, 149, {0, 1, 1}},
+        {150, 299, {0}},
+    };
+    const auto expectedChunks =
+        Chunks{{0, 0, 99}, {1, 100, 149}, {2, 150, 249}, {2, 250, 299}};
+
+    EXPECT_EQ(segments, expectedSegments);
+    EXPECT_EQ(chunks, expectedChunks);
+}
+
+// Heights between the requests are not scanned
+TEST_F(Test_FilterScanner, disjoint_requests)
+{
+    add(100, 149, one_);
+    add(0, 49, two_);
+
+    const auto [segments, chunks] = divide();
+    const auto expectedSegments = Segments{{0, 49, {1, 1}}, {100, 149, {0}}};
+    const auto expectedChunks = Chunks{{0, 0, 49}, {1, 100, 149}};
+
+    EXPECT_EQ(segments, expectedSegments);
+    EXPECT_EQ(chunks, expectedChunks);
+}
+
+TEST_F(Test_FilterScanner, identical_requests)
+{
+    add(10, 20, one_);
+    add(10, 20, two_);
+    add(10, 20, one_);
+
+    const auto [segments, chunks] = divide();
+    const auto expectedSegments = Segments{{10, 20, {0, 1, 1, 2}}};
+    const auto expectedChunks = Chunks{{0, 10, 20}};
+
+    EXPECT_EQ(segments, expectedSegments);
+    EXPECT_EQ(chunks, expectedChunks);
+}
+
+TEST_F(Test_FilterScanner, chunk_size)
+{
+    const auto batch = Job::batch_;
+    add(0, (2 * batch) + 49, one_);
+    add(0, batch - 1, one_);
+
+    const auto [segments, chunks] = divide();
+    const auto expectedSegments = Segments{
+        {0, batch - 1, {0, 1}},
+        {batch, (2 * batch) + 49, {0}},
+    };
+    const auto expectedChunks = Chunks{
+        {0, 0, batch - 1},
+        {1, batch, (2 * batch) - 1},
+        {1, 2 * batch, (2 * batch) + 49},
+    };
+
+    EXPECT_EQ(segments, expectedSegments);
+    EXPECT_EQ(chunks, expectedChunks);
+}
+
+TEST_F(Test_FilterScanner, parallel_job)
+{
+    auto job = Counter{1000};
+    run(job);
+
+    EXPECT_EQ(job.finished_.load(), 1);
+    EXPECT_TRUE(job.complete_.load());
+
+    for (const auto& count : job.processed_) { EXPECT_EQ(count.load(), 1); }
+}
+
+// A thread which calls Run() after every chunk has been claimed returns
+// immediately and does not finish the job again
+TEST_F(Test_FilterScanner, parallel_job_late_runner)
+{
+    auto job = Counter{3};
+    job.Run();
+    job.Run();
+    job.Wait();
+
+    EXPECT_EQ(job.finished_.load(), 1);
+    EXPECT_TRUE(job.complete_.load());
+}
+
+TEST_F(Test_FilterScanner, parallel_job_empty)
+{
+    auto job = Counter{0};
+    run(job);
+
+    EXPECT_EQ(job.finished_.load(), 1);
+    EXPECT_TRUE(job.complete_.load());
+}
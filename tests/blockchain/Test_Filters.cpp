@@ -4,10 +4,14 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -17,7 +21,9 @@
 #include <vector>
 
 #include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "api/client/blockchain/database/BlockFilter.hpp"
 #include "internal/api/client/Client.hpp"
+#include "internal/api/client/blockchain/Blockchain.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Bytes.hpp"
@@ -39,13 +45,29 @@
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/protobuf/Enums.pb.h"
+#include "opentxs/protobuf/GCS.pb.h"
+#include "util/LMDB.hpp"
 
 namespace
 {
+namespace chaindb = ot::api::client::blockchain;
+namespace fs = boost::filesystem;
+
+using BlockFilter = chaindb::database::implementation::BlockFilter;
+
 const auto params_ = ot::blockchain::internal::GetFilterParams(
     ot::blockchain::filter::Type::Basic_BIP158);
 using Hash = ot::OTData;
 auto stress_test_ = std::vector<Hash>{};
+constexpr auto elements_per_filter_ = std::size_t{50};
+constexpr auto batch_count_ = std::size_t{10};
+// Position in the batch of the record stored in the protobuf layout
+constexpr auto legacy_ = std::size_t{4};
+// Position in the batch of the block without a filter
+constexpr auto missing_ = std::size_t{6};
+constexpr auto rescan_count_ = std::size_t{2000};
+// Number of filters loaded per call by the filter scanner
+constexpr auto rescan_batch_ = std::size_t{100};
 
 class Test_Filters : public ::testing::Test
 {
@@ -410,6 +432,363 @@ TEST_F(Test_Filters, gcs)
     }
 }
 
+TEST_F(Test_Filters, gcs_streaming_match)
+{
+    auto included = std::vector<ot::OTData>{};
+    auto targets = std::vector<std::string>{};
+
+    for (auto i = 0; i < 1000; ++i) {
+        const auto item = "included_" + std::to_string(i);
+        included.emplace_back(ot::Data::Factory(item.data(), item.size()));
+
+        if (0 == (i % 10)) { targets.emplace_back(item); }
+    }
+
+    for (auto i = 0; i < 100; ++i) {
+        targets.emplace_back("excluded_" + std::to_string(i));
+    }
+
+    const auto key = std::string{"0123456789abcdef"};
+    const auto pConstructed =
+        ot::factory::GCS(api_, params_.first, params_.second, key, included);
+
+    ASSERT_TRUE(pConstructed);
+
+    // A filter loaded from its serialized form has no decoded element set
+    const auto pGcs = ot::factory::GCS(api_, pConstructed->Serialize());
+
+    ASSERT_TRUE(pGcs);
+
+    const auto& gcs = *pGcs;
+    const auto views =
+        std::vector<ot::ReadView>(targets.begin(), targets.end());
+    const auto streamed = gcs.Match(views);
+    const auto cached = gcs.Match(views);
+    const auto expected = pConstructed->Match(views);
+
+    EXPECT_GE(streamed.size(), 100);
+    EXPECT_EQ(streamed, cached);
+    EXPECT_EQ(streamed.size(), expected.size());
+
+    for (const auto& match : streamed) {
+        EXPECT_EQ(match->substr(0, 9), "included_");
+    }
+
+    const auto fresh = ot::factory::GCS(api_, pConstructed->Serialize());
+
+    ASSERT_TRUE(fresh);
+    EXPECT_TRUE(fresh->Test(ot::ReadView{targets.front()}));
+    EXPECT_FALSE(fresh->Test(ot::ReadView{targets.back()}));
+}
+
+TEST_F(Test_Filters, flat_serialization)
+{
+    auto included = std::vector<ot::OTData>{};
+    auto targets = std::vector<std::string>{};
+
+    for (auto i = 0; i < 1000; ++i) {
+        const auto item = "included_" + std::to_string(i);
+        included.emplace_back(ot::Data::Factory(item.data(), item.size()));
+
+        if (0 == (i % 10)) { targets.emplace_back(item); }
+    }
+
+    for (auto i = 0; i < 100; ++i) {
+        targets.emplace_back("excluded_" + std::to_string(i));
+    }
+
+    const auto key = std::string{"0123456789abcdef"};
+    const auto pConstructed =
+        ot::factory::GCS(api_, params_.first, params_.second, key, included);
+
+    ASSERT_TRUE(pConstructed);
+
+    auto flat = ot::Space{};
+
+    ASSERT_TRUE(pConstructed->Serialize(ot::writer(flat)));
+
+    const auto legacy = pConstructed->Serialize().SerializeAsString();
+    const auto pCopy = ot::factory::GCS(api_, ot::reader(flat));
+    const auto pView = ot::factory::GCSView(api_, ot::reader(flat));
+    const auto pLegacy = ot::factory::GCS(api_, legacy);
+    const auto pLegacyView = ot::factory::GCSView(api_, legacy);
+
+    ASSERT_TRUE(pCopy);
+    ASSERT_TRUE(pView);
+    ASSERT_TRUE(pLegacy);
+    ASSERT_TRUE(pLegacyView);
+
+    const auto views =
+        std::vector<ot::ReadView>(targets.begin(), targets.end());
+    const auto expected = pConstructed->Match(views);
+    const auto encoded = pConstructed->Encode();
+
+    for (const auto* filter :
+         {pCopy.get(), pView.get(), pLegacy.get(), pLegacyView.get()}) {
+        EXPECT_EQ(encoded->asHex(), filter->Encode()->asHex());
+        EXPECT_EQ(expected, filter->Match(views));
+
+        auto reserialized = ot::Space{};
+
+        EXPECT_TRUE(filter->Serialize(ot::writer(reserialized)));
+        EXPECT_EQ(flat, reserialized);
+    }
+
+    EXPECT_FALSE(ot::factory::GCS(api_, ot::ReadView{}));
+
+    const auto truncated = ot::reader(flat).substr(
+        0, sizeof(ot::blockchain::internal::SerializedGCS) - 1u);
+
+    EXPECT_FALSE(ot::factory::GCSView(api_, truncated));
+}
+
+class Test_FilterStorage : public Test_Filters
+{
+public:
+    using FilterData = chaindb::FilterData;
+    using GCS = ot::blockchain::client::GCS;
+
+    static constexpr auto type_ = ot::blockchain::filter::Type::Basic_BIP158;
+
+    const std::string path_;
+    const std::vector<std::string> blocks_;
+    ot::storage::lmdb::LMDB lmdb_;
+    BlockFilter filters_;
+
+    static auto element(const std::size_t block, const std::size_t index)
+        -> std::string
+    {
+        return std::to_string(block) + "_" + std::to_string(index);
+    }
+    static auto make_blocks() -> std::vector<std::string>
+    {
+        auto output = std::vector<std::string>{};
+
+        for (auto i = std::size_t{0}; i < rescan_count_; ++i) {
+            auto& hash = output.emplace_back(32, '\0');
+            std::memcpy(hash.data(), &i, sizeof(i));
+        }
+
+        return output;
+    }
+    static auto make_path() -> std::string
+    {
+        const auto path =
+            fs::temp_directory_path() /
+            fs::unique_path("opentxs-filters-%%%%-%%%%-%%%%-%%%%");
+        fs::create_directories(path);
+
+        return path.string();
+    }
+
+    auto make_filter(const std::size_t block) const -> std::unique_ptr<GCS>
+    {
+        auto elements = std::vector<ot::OTData>{};
+
+        for (auto i = std::size_t{0}; i < elements_per_filter_; ++i) {
+            const auto item = element(block, i);
+            elements.emplace_back(ot::Data::Factory(item.data(), item.size()));
+        }
+
+        return ot::factory::GCS(
+            api_,
+            params_.first,
+            params_.second,
+            std::string{"0123456789abcdef"},
+            elements);
+    }
+    // Stores the filters for blocks [first, last) in the flat layout
+    auto store(const std::size_t first, const std::size_t last) const -> bool
+    {
+        auto filters = std::vector<FilterData>{};
+
+        for (auto i = first; i < last; ++i) {
+            filters.emplace_back(ot::ReadView{blocks_.at(i)}, make_filter(i));
+        }
+
+        return filters_.StoreFilters(type_, filters);
+    }
+    // Stores the filter for a block in the protobuf layout written by earlier
+    // versions
+    auto store_legacy(const std::size_t block) const -> bool
+    {
+        const auto bytes = make_filter(block)->Serialize().SerializeAsString();
+
+        return lmdb_
+            .Store(
+                chaindb::FiltersBasic, ot::ReadView{blocks_.at(block)}, bytes)
+            .first;
+    }
+    auto views(const std::size_t first, const std::size_t last) const
+        -> std::vector<ot::ReadView>
+    {
+        return std::vector<ot::ReadView>(
+            std::next(blocks_.begin(), first),
+            std::next(blocks_.begin(), last));
+    }
+
+    Test_FilterStorage()
+        : path_(make_path())
+        , blocks_(make_blocks())
+        , lmdb_(
+              {{chaindb::FiltersBasic, "block_filters_basic"},
+               {chaindb::FilterHeadersBasic, "block_filter_headers_basic"}},
+              path_,
+              {{chaindb::FiltersBasic, 0}, {chaindb::FilterHeadersBasic, 0}})
+        , filters_(api_, lmdb_)
+    {
+    }
+
+    ~Test_FilterStorage() override { fs::remove_all(path_); }
+};
+
+TEST_F(Test_FilterStorage, load_batch)
+{
+    ASSERT_TRUE(store(0, legacy_));
+    ASSERT_TRUE(store_legacy(legacy_));
+    ASSERT_TRUE(store(legacy_ + 1, batch_count_));
+
+    auto loaded = std::vector<std::string>{};
+    const auto count = filters_.LoadFilters(
+        type_, views(0, batch_count_), [&](const auto index, const auto& gcs) {
+            EXPECT_EQ(loaded.size(), index);
+            EXPECT_TRUE(gcs.Test(ot::ReadView{element(index, 0)}));
+            EXPECT_FALSE(gcs.Test(ot::ReadView{element(batch_count_, 0)}));
+
+            loaded.emplace_back(gcs.Encode()->asHex());
+        });
+
+    EXPECT_EQ(batch_count_, count);
+    ASSERT_EQ(batch_count_, loaded.size());
+
+    for (auto i = std::size_t{0}; i < batch_count_; ++i) {
+        EXPECT_EQ(make_filter(i)->Encode()->asHex(), loaded.at(i));
+    }
+
+    const auto legacy =
+        filters_.LoadFilter(type_, ot::ReadView{blocks_.at(legacy_)});
+
+    ASSERT_TRUE(legacy);
+    EXPECT_EQ(loaded.at(legacy_), legacy->Encode()->asHex());
+}
+
+TEST_F(Test_FilterStorage, load_stops_at_missing_filter)
+{
+    ASSERT_TRUE(store(0, missing_));
+    ASSERT_TRUE(store(missing_ + 1, batch_count_));
+
+    auto calls = std::size_t{0};
+    const auto cb = [&](const auto index, const auto&) {
+        EXPECT_EQ(calls, index);
+
+        ++calls;
+    };
+
+    EXPECT_EQ(
+        missing_, filters_.LoadFilters(type_, views(0, batch_count_), cb));
+    EXPECT_EQ(missing_, calls);
+
+    calls = 0;
+
+    EXPECT_EQ(
+        0, filters_.LoadFilters(type_, views(missing_, batch_count_), cb));
+    EXPECT_EQ(0, calls);
+
+    const auto remaining = batch_count_ - missing_ - 1u;
+
+    EXPECT_EQ(
+        remaining,
+        filters_.LoadFilters(type_, views(missing_ + 1, batch_count_), cb));
+    EXPECT_EQ(remaining, calls);
+}
+
+// Data loaded with a transaction supplied by the caller must remain readable
+// after Load returns, until the transaction is finalized
+TEST_F(Test_FilterStorage, load_with_transaction)
+{
+    ASSERT_TRUE(store(0, 2));
+
+    auto txn = lmdb_.TransactionRO();
+    auto load = [&](const std::size_t block, ot::ReadView& out) {
+        return lmdb_.Load(
+            chaindb::FiltersBasic,
+            ot::ReadView{blocks_.at(block)},
+            [&](const auto in) { out = in; },
+            txn);
+    };
+    auto first = ot::ReadView{};
+    auto second = ot::ReadView{};
+    auto absent = ot::ReadView{};
+
+    ASSERT_TRUE(load(0, first));
+    ASSERT_TRUE(load(1, second));
+    EXPECT_FALSE(load(2, absent));
+    EXPECT_EQ(nullptr, absent.data());
+
+    const auto pFirst = ot::factory::GCSView(api_, first);
+    const auto pSecond = ot::factory::GCSView(api_, second);
+
+    ASSERT_TRUE(pFirst);
+    ASSERT_TRUE(pSecond);
+    EXPECT_EQ(make_filter(0)->Encode()->asHex(), pFirst->Encode()->asHex());
+    EXPECT_EQ(make_filter(1)->Encode()->asHex(), pSecond->Encode()->asHex());
+
+    txn.Finalize(false);
+}
+
+// Reports how quickly a rescan reads stored filters, one transaction per
+// filter as before and one transaction per batch as the filter scanner does
+TEST_F(Test_FilterStorage, range_load_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+
+    ASSERT_TRUE(store(0, rescan_count_));
+
+    const auto target = std::string{"not present"};
+    const auto run = [&](const auto& load) {
+        const auto start = Clock::now();
+        const auto count = load();
+        const auto elapsed =
+            std::chrono::duration<double>{Clock::now() - start}.count();
+
+        EXPECT_EQ(rescan_count_, count);
+
+        return (0 < elapsed) ? (count / elapsed) : 0.0;
+    };
+    const auto singleRate = run([&] {
+        auto output = std::size_t{0};
+
+        for (const auto& block : blocks_) {
+            const auto pFilter = filters_.LoadFilter(type_, block);
+
+            if (false == bool(pFilter)) { break; }
+
+            EXPECT_FALSE(pFilter->Test(ot::ReadView{target}));
+
+            ++output;
+        }
+
+        return output;
+    });
+    const auto rangeRate = run([&] {
+        auto output = std::size_t{0};
+
+        for (auto first = std::size_t{0}; first < rescan_count_;
+             first += rescan_batch_) {
+            const auto last = std::min(first + rescan_batch_, rescan_count_);
+            output += filters_.LoadFilters(
+                type_, views(first, last), [&](const auto, const auto& gcs) {
+                    EXPECT_FALSE(gcs.Test(ot::ReadView{target}));
+                });
+        }
+
+        return output;
+    });
+
+    std::cout << "Single: " << singleRate << " filters per second\n"
+              << "Range:  " << rangeRate << " filters per second\n";
+}
+
 TEST_F(Test_Filters, bip158_case_0) { EXPECT_TRUE(TestGCSBlock(0)); }
 
 TEST_F(Test_Filters, bip158_case_49291) { EXPECT_TRUE(TestGCSBlock(49291)); }
@@ -0,0 +1,172 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/SipHash.hpp"
+#include "internal/api/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/crypto/HashType.hpp"
+
+namespace
+{
+constexpr auto benchmark_items_ = std::size_t{1000000};
+
+class Test_SipHash : public ::testing::Test
+{
+public:
+    const ot::api::client::internal::Manager& api_;
+    const std::string key_;
+    const std::vector<std::string> items_;
+
+    static auto make_items(const std::size_t count) -> std::vector<std::string>
+    {
+        auto output = std::vector<std::string>{};
+        output.reserve(count);
+        auto seed = std::uint32_t{1};
+
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            // Lengths typical of output scripts and outpoints
+            auto& item = output.emplace_back(22u + (i % 15u), '\0');
+
+            for (auto& c : item) {
+                seed = seed * 1103515245u + 12345u;
+                c = static_cast<char>(seed >> 24u);
+            }
+        }
+
+        return output;
+    }
+    static auto views(const std::vector<std::string>& in)
+        -> std::vector<ot::ReadView>
+    {
+        auto output = std::vector<ot::ReadView>{};
+        output.reserve(in.size());
+
+        for (const auto& item : in) { output.emplace_back(item); }
+
+        return output;
+    }
+
+    auto reference(const ot::ReadView item) const -> std::uint64_t
+    {
+        auto output = std::uint64_t{};
+        auto writer = ot::preallocated(sizeof(output), &output);
+        const auto rc = api_.Crypto().Hash().HMAC(
+            ot::crypto::HashType::SipHash24, key_, item, writer);
+
+        EXPECT_TRUE(rc);
+
+        return output;
+    }
+
+    Test_SipHash()
+        : api_(dynamic_cast<const ot::api::client::internal::Manager&>(
+              ot::Context().StartClient(OTTestEnvironment::test_args_, 0)))
+        , key_("0123456789abcdef")
+        , items_(make_items(benchmark_items_))
+    {
+    }
+};
+
+TEST_F(Test_SipHash, reference_vectors)
+{
+    auto key = std::string{};
+    auto message = std::string{};
+
+    for (auto i = 0; i < 16; ++i) { key.push_back(static_cast<char>(i)); }
+
+    for (auto i = 0; i < 15; ++i) { message.push_back(static_cast<char>(i)); }
+
+    const auto hasher = ot::gcs::SipHash{key};
+
+    EXPECT_EQ(hasher(message.substr(0, 0)), 0x726fdb47dd0e0e31ull);
+    EXPECT_EQ(hasher(message.substr(0, 8)), 0x93f5f5799a932462ull);
+    EXPECT_EQ(hasher(message), 0xa129ca6149be45e5ull);
+}
+
+TEST_F(Test_SipHash, fast_range)
+{
+    EXPECT_EQ(ot::gcs::FastRange(0u, 784931u), 0u);
+    EXPECT_EQ(ot::gcs::FastRange(~std::uint64_t{0}, 784931u), 784930u);
+    EXPECT_EQ(ot::gcs::FastRange(std::uint64_t{1} << 63u, 784932u), 392466u);
+}
+
+TEST_F(Test_SipHash, matches_libsodium)
+{
+    const auto hasher = ot::gcs::SipHash{key_};
+    auto message = std::string{};
+
+    for (auto i = 0; i < 100; ++i) {
+        EXPECT_EQ(hasher(message), reference(message));
+
+        message.push_back(static_cast<char>(i * 7));
+    }
+}
+
+TEST_F(Test_SipHash, batch_matches_scalar)
+{
+    const auto hasher = ot::gcs::SipHash{key_};
+    const auto input = views(items_);
+    auto output = std::vector<std::uint64_t>(input.size());
+    hasher.Batch(input, output.data());
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+        ASSERT_EQ(output.at(i), hasher(input.at(i)));
+    }
+}
+
+TEST_F(Test_SipHash, benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::milliseconds;
+    const auto input = views(items_);
+    auto api = std::vector<std::uint64_t>(input.size());
+    auto scalar = std::vector<std::uint64_t>(input.size());
+    auto batch = std::vector<std::uint64_t>(input.size());
+
+    auto start = Clock::now();
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+        api[i] = reference(input[i]);
+    }
+
+    const auto apiTime =
+        std::chrono::duration_cast<Duration>(Clock::now() - start);
+    start = Clock::now();
+    const auto hasher = ot::gcs::SipHash{key_};
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+        scalar[i] = hasher(input[i]);
+    }
+
+    const auto scalarTime =
+        std::chrono::duration_cast<Duration>(Clock::now() - start);
+    start = Clock::now();
+    hasher.Batch(input, batch.data());
+    const auto batchTime =
+        std::chrono::duration_cast<Duration>(Clock::now() - start);
+
+    EXPECT_EQ(api, scalar);
+    EXPECT_EQ(api, batch);
+
+    std::cout << "Hashed " << input.size() << " items\n"
+              << "  crypto api: " << apiTime.count() << " ms\n"
+              << "  native:     " << scalarTime.count() << " ms\n"
+              << "  batch:      " << batchTime.count() << " ms\n";
+}
+}  // namespace
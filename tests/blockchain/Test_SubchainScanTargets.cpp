@@ -0,0 +1,275 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/database/wallet/Subchain.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/client/blockchain/Subchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+namespace
+{
+using Data = ot::blockchain::database::wallet::SubchainData;
+using Height = ot::blockchain::block::Height;
+using Indices = std::vector<ot::Bip32Index>;
+// First height, last height, and the indices of the untested patterns
+using Range = std::tuple<Height, Height, Indices>;
+using Ranges = std::vector<Range>;
+
+class Test_SubchainScanTargets : public ::testing::Test
+{
+public:
+    const ot::api::client::Manager& api_;
+    const Data data_;
+    const ot::OTIdentifier node_;
+    const ot::OTIdentifier subchain_;
+    ot::Bip32Index next_;
+
+    // Adds count elements to the subchain, creating a new version of its
+    // pattern set
+    auto add(const std::size_t count) -> bool
+    {
+        auto elements = Data::ElementMap{};
+
+        for (auto i = std::size_t{0}; i < count; ++i, ++next_) {
+            elements[next_].emplace_back(
+                ot::Space{static_cast<std::byte>(next_)});
+        }
+
+        return data_.SubchainAddElements(subchain_, elements);
+    }
+    auto indices(const ot::Bip32Index first, const ot::Bip32Index last) const
+        -> Indices
+    {
+        auto output = Indices{};
+
+        for (auto i = first; i <= last; ++i) { output.emplace_back(i); }
+
+        return output;
+    }
+    auto targets(const Height first, const Height last) const -> Ranges
+    {
+        auto output = Ranges{};
+        const auto [version, ranges] =
+            data_.GetScanTargets(subchain_, first, last);
+
+        for (const auto& [start, stop, patterns] : ranges) {
+            auto& [outStart, outStop, outIndices] =
+                output.emplace_back(start, stop, Indices{});
+
+            for (const auto& [id, pattern] : patterns) {
+                outIndices.emplace_back(id.first);
+            }
+
+            std::sort(outIndices.begin(), outIndices.end());
+        }
+
+        return output;
+    }
+    auto tested(const Height first, const Height last, const int version)
+        -> bool
+    {
+        return data_.SubchainSetTested(
+            subchain_, first, last, static_cast<ot::VersionNumber>(version));
+    }
+    auto version() const -> ot::VersionNumber
+    {
+        return data_.GetScanTargets(subchain_, 0, 0).first;
+    }
+
+    Test_SubchainScanTargets()
+        : api_(ot::Context().StartClient({}, 0))
+        , data_(api_)
+        , node_(ot::Identifier::Random())
+        , subchain_(data_.GetIndex(
+              node_,
+              ot::api::client::blockchain::Subchain::External,
+              ot::blockchain::filter::Type::ES))
+        , next_(0)
+    {
+    }
+};
+}  // namespace
+
+TEST_F(Test_SubchainScanTargets, untested)
+{
+    EXPECT_EQ(version(), 0u);
+    EXPECT_EQ(targets(0, 9), (Ranges{{0, 9, {}}}));
+    ASSERT_TRUE(add(3));
+    EXPECT_EQ(version(), 1u);
+    EXPECT_EQ(targets(0, 9), (Ranges{{0, 9, indices(0, 2)}}));
+    EXPECT_FALSE(tested(5, 4, 1));
+    EXPECT_EQ(targets(0, 9), (Ranges{{0, 9, indices(0, 2)}}));
+}
+
+TEST_F(Test_SubchainScanTargets, adjacent_ranges)
+{
+    ASSERT_TRUE(add(3));
+    ASSERT_TRUE(tested(10, 19, 1));
+    ASSERT_TRUE(tested(0, 9, 1));
+    ASSERT_TRUE(tested(20, 29, 1));
+
+    // Ranges tested against the same version are merged
+    EXPECT_EQ(targets(0, 29), (Ranges{{0, 29, {}}}));
+
+    // Ranges tested against different versions are not
+    ASSERT_TRUE(add(2));
+    ASSERT_TRUE(tested(30, 39, 2));
+
+    const auto expected =
+        Ranges{{0, 29, indices(3, 4)}, {30, 39, {}}, {40, 49, indices(0, 4)}};
+
+    EXPECT_EQ(targets(0, 49), expected);
+}
+
+TEST_F(Test_SubchainScanTargets, overlapping_ranges)
+{
+    ASSERT_TRUE(add(3));
+    ASSERT_TRUE(tested(0, 29, 1));
+    ASSERT_TRUE(add(2));
+
+    // Inside an existing range
+    ASSERT_TRUE(tested(10, 14, 2));
+
+    auto expected = Ranges{
+        {0, 9, indices(3, 4)},
+        {10, 14, {}},
+        {15, 29, indices(3, 4)},
+    };
+
+    EXPECT_EQ(targets(0, 29), expected);
+
+    // Across the end of one range and the start of the next
+    ASSERT_TRUE(tested(5, 12, 2));
+
+    expected = Ranges{
+        {0, 4, indices(3, 4)},
+        {5, 14, {}},
+        {15, 29, indices(3, 4)},
+    };
+
+    EXPECT_EQ(targets(0, 29), expected);
+
+    // Covering several ranges and extending past the last one
+    ASSERT_TRUE(tested(3, 34, 2));
+
+    expected = Ranges{
+        {0, 2, indices(3, 4)},
+        {3, 34, {}},
+        {35, 39, indices(0, 4)},
+    };
+
+    EXPECT_EQ(targets(0, 39), expected);
+
+    // An older version replaces a newer one over the overlap
+    ASSERT_TRUE(tested(20, 24, 1));
+
+    expected = Ranges{
+        {0, 2, indices(3, 4)},
+        {3, 19, {}},
+        {20, 24, indices(3, 4)},
+        {25, 34, {}},
+    };
+
+    EXPECT_EQ(targets(0, 34), expected);
+}
+
+// Adding elements invalidates every tested range, but only for the patterns
+// added since the range was tested
+TEST_F(Test_SubchainScanTargets, version_bump)
+{
+    ASSERT_TRUE(add(3));
+    ASSERT_TRUE(tested(0, 99, 1));
+    EXPECT_EQ(targets(0, 99), (Ranges{{0, 99, {}}}));
+
+    ASSERT_TRUE(add(2));
+    EXPECT_EQ(version(), 2u);
+    EXPECT_EQ(targets(0, 99), (Ranges{{0, 99, indices(3, 4)}}));
+
+    ASSERT_TRUE(add(1));
+    EXPECT_EQ(version(), 3u);
+    EXPECT_EQ(targets(0, 99), (Ranges{{0, 99, indices(3, 5)}}));
+
+    ASSERT_TRUE(tested(50, 99, 3));
+
+    const auto expected = Ranges{{0, 49, indices(3, 5)}, {50, 99, {}}};
+
+    EXPECT_EQ(targets(0, 99), expected);
+}
+
+TEST_F(Test_SubchainScanTargets, holes)
+{
+    ASSERT_TRUE(add(2));
+    ASSERT_TRUE(tested(10, 19, 1));
+    ASSERT_TRUE(tested(30, 39, 1));
+
+    auto expected = Ranges{
+        {0, 9, indices(0, 1)},
+        {10, 19, {}},
+        {20, 29, indices(0, 1)},
+        {30, 39, {}},
+        {40, 49, indices(0, 1)},
+    };
+
+    EXPECT_EQ(targets(0, 49), expected);
+
+    // The requested range is clipped to the tested ranges it overlaps
+    expected = Ranges{
+        {15, 19, {}},
+        {20, 29, indices(0, 1)},
+        {30, 35, {}},
+    };
+
+    EXPECT_EQ(targets(15, 35), expected);
+    EXPECT_EQ(targets(22, 27), (Ranges{{22, 27, indices(0, 1)}}));
+    EXPECT_EQ(targets(31, 33), (Ranges{{31, 33, {}}}));
+
+    // Filling a hole merges the ranges on either side of it
+    ASSERT_TRUE(tested(20, 29, 1));
+    EXPECT_EQ(targets(10, 39), (Ranges{{10, 39, {}}}));
+}
+
+TEST_F(Test_SubchainScanTargets, reorg)
+{
+    ASSERT_TRUE(add(2));
+    ASSERT_TRUE(tested(0, 9, 1));
+    ASSERT_TRUE(tested(20, 29, 1));
+
+    {
+        auto lock = ot::Lock{data_.GetMutex()};
+        data_.Reorg(lock, subchain_, 24);
+    }
+
+    auto expected = Ranges{
+        {0, 9, {}},
+        {10, 19, indices(0, 1)},
+        {20, 24, {}},
+        {25, 29, indices(0, 1)},
+    };
+
+    EXPECT_EQ(targets(0, 29), expected);
+
+    {
+        auto lock = ot::Lock{data_.GetMutex()};
+        data_.Reorg(lock, subchain_, 5);
+    }
+
+    expected = Ranges{{0, 5, {}}, {6, 29, indices(0, 1)}};
+
+    EXPECT_EQ(targets(0, 29), expected);
+}
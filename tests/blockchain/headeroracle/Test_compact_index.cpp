@@ -0,0 +1,142 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Helpers.hpp"
+#include "api/client/blockchain/database/Database.hpp"
+#include "blockchain/database/CompactHeaders.hpp"
+#include "internal/api/client/Client.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+
+namespace
+{
+namespace fs = boost::filesystem;
+
+using CompactHeaders = b::database::CompactHeaders;
+
+// Location of the sequence number in the header of the index file
+constexpr auto sequence_offset_ = std::streamoff{16};
+
+auto folder(
+    const ot::api::client::internal::Manager& api,
+    const b::Type type) noexcept -> std::string
+{
+    const auto& db = dynamic_cast<const ot::api::client::internal::Blockchain&>(
+                         api.Blockchain())
+                         .BlockchainDB();
+
+    return db.AllocateStorageFolder(
+        std::to_string(static_cast<std::uint32_t>(type)));
+}
+
+auto overwrite(
+    const fs::path& file,
+    const std::streamoff position,
+    const std::string& bytes) noexcept -> bool
+{
+    auto stream = std::fstream{
+        file.string(), std::ios::in | std::ios::out | std::ios::binary};
+    stream.seekp(position);
+    stream.write(bytes.data(), bytes.size());
+
+    return stream.good();
+}
+}  // namespace
+
+// Reopens the chain after the index file has been desynchronized, corrupted
+// and made unavailable, and checks that the same headers are loaded each time
+TEST_F(Test_HeaderOracle, compact_index_recovery)
+{
+    EXPECT_TRUE(create_blocks(create_1_));
+    EXPECT_TRUE(apply_blocks(sequence_1_));
+    EXPECT_TRUE(verify_post_state(post_state_1_));
+
+    const auto path = fs::path{folder(api_, type_)} / "headers.dat";
+    const auto expected = create_1_.size() + 1u;
+    auto close = [&] {
+        network_->Shutdown().get();
+        network_.reset();
+    };
+    auto verify = [&] {
+        auto network = init_network(api_, type_);
+
+        EXPECT_TRUE(network);
+
+        if (false == bool(network)) { return false; }
+
+        auto& oracle = network->HeaderOracleInternal();
+
+        for (const auto& [sHash, spHash, height, status, pStatus] :
+             post_state_1_) {
+            const auto hash = get_block_hash(sHash);
+            const auto header = oracle.LoadHeader(hash);
+
+            EXPECT_TRUE(header);
+
+            if (false == bool(header)) { return false; }
+
+            EXPECT_EQ(hash, header->Hash());
+            EXPECT_EQ(height, header->Height());
+            EXPECT_EQ(status, header->LocalState());
+            EXPECT_EQ(pStatus, header->InheritedState());
+        }
+
+        EXPECT_EQ(get_block_hash(BLOCK_10), oracle.BestChain().second);
+
+        network->Shutdown().get();
+
+        return true;
+    };
+    auto sequence = std::size_t{};
+
+    close();
+
+    {
+        auto index = CompactHeaders{api_, type_, path.parent_path().string()};
+        sequence = index.Sequence();
+
+        EXPECT_LT(0, sequence);
+        EXPECT_EQ(expected, index.Count());
+    }
+
+    // A sequence which does not match the database forces a rebuild
+    ASSERT_TRUE(overwrite(path, sequence_offset_, std::string(8, '\xff')));
+    EXPECT_TRUE(verify());
+
+    {
+        auto index = CompactHeaders{api_, type_, path.parent_path().string()};
+
+        EXPECT_LT(sequence, index.Sequence());
+        EXPECT_EQ(expected, index.Count());
+    }
+
+    // A file which can not be parsed is replaced
+    ASSERT_TRUE(overwrite(path, 0, "garbage!"));
+    EXPECT_TRUE(verify());
+
+    {
+        auto index = CompactHeaders{api_, type_, path.parent_path().string()};
+
+        EXPECT_LT(0, index.Sequence());
+        EXPECT_EQ(expected, index.Count());
+    }
+
+    // Headers are loaded from the database if the index can not be created
+    fs::remove(path);
+    fs::create_directories(path);
+    std::ofstream{(path / "placeholder").string()};
+    EXPECT_TRUE(verify());
+
+    fs::remove_all(path);
+}
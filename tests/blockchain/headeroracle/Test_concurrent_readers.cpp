@@ -0,0 +1,129 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Helpers.hpp"
+#include "internal/api/client/Client.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto batch_size_ = std::size_t{100};
+constexpr auto reader_count_ = std::size_t{4};
+
+struct ReaderStats {
+    std::size_t queries_{};
+    std::size_t errors_{};
+    Clock::duration total_{};
+    Clock::duration worst_{};
+};
+}  // namespace
+
+std::vector<std::vector<std::unique_ptr<bb::Header>>> batches_{};
+
+TEST_F(Test_HeaderOracle_btc, init_opentxs) {}
+
+TEST_F(Test_HeaderOracle_btc, stage_headers)
+{
+    for (const auto& hex : bitcoin_) {
+        const auto raw = ot::Data::Factory(hex, ot::Data::Mode::Hex);
+        auto pHeader = api_.Factory().BlockHeader(type_, raw);
+
+        ASSERT_TRUE(pHeader);
+
+        if (batches_.empty() || (batch_size_ == batches_.back().size())) {
+            batches_.emplace_back();
+        }
+
+        batches_.back().emplace_back(std::move(pHeader));
+    }
+}
+
+// Measures the latency of best chain queries while header batches are
+// being processed. Readers should not wait for the writer.
+TEST_F(Test_HeaderOracle_btc, readers_during_sync)
+{
+    auto running = std::atomic<bool>{true};
+    auto stats = std::vector<ReaderStats>(reader_count_);
+    auto readers = std::vector<std::thread>{};
+
+    for (auto& data : stats) {
+        readers.emplace_back([&] {
+            while (running) {
+                const auto start = Clock::now();
+                const auto tip = header_oracle_.BestChain();
+                const auto hash = header_oracle_.BestHash(tip.first);
+                const auto best = header_oracle_.IsInBestChain(tip);
+                const auto elapsed = Clock::now() - start;
+
+                // No reorgs occur in this sequence so every position which
+                // was the tip remains in the best chain
+                if ((hash != tip.second) || (false == best)) { ++data.errors_; }
+
+                ++data.queries_;
+                data.total_ += elapsed;
+                data.worst_ = std::max(data.worst_, elapsed);
+            }
+        });
+    }
+
+    const auto start = Clock::now();
+
+    for (auto& batch : batches_) {
+        EXPECT_TRUE(header_oracle_.AddHeaders(batch));
+    }
+
+    const auto elapsed = Clock::now() - start;
+    running = false;
+
+    for (auto& thread : readers) { thread.join(); }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+    auto queries = std::size_t{0};
+    auto total = Clock::duration{};
+    auto worst = Clock::duration{};
+
+    for (const auto& data : stats) {
+        EXPECT_EQ(data.errors_, 0);
+
+        queries += data.queries_;
+        total += data.total_;
+        worst = std::max(worst, data.worst_);
+    }
+
+    std::cout << "Added " << bitcoin_.size() << " headers in "
+              << duration_cast<milliseconds>(elapsed).count() << " ms\n"
+              << reader_count_ << " readers performed " << queries
+              << " queries, mean latency "
+              << (0u < queries
+                      ? duration_cast<nanoseconds>(total).count() / queries
+                      : 0u)
+              << " ns, worst "
+              << duration_cast<microseconds>(worst).count() << " us\n";
+
+    const auto [height, hash] = header_oracle_.BestChain();
+
+    EXPECT_EQ(height, bitcoin_.size());
+    EXPECT_GT(queries, 0);
+}
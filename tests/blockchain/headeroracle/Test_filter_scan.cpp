@@ -0,0 +1,151 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Helpers.hpp"
+#include "api/client/blockchain/database/Database.hpp"
+#include "internal/api/client/Client.hpp"
+#include "internal/api/client/blockchain/Blockchain.hpp"
+#include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace
+{
+using GCS = b::client::GCS;
+
+// Heights of the blocks whose filters contain a target
+constexpr auto first_match_ = bb::Height{3};
+constexpr auto second_match_ = bb::Height{8};
+// Height of the block whose filter is stored last
+constexpr auto missing_ = bb::Height{6};
+
+auto element(const bb::Height height) noexcept -> std::string
+{
+    return "element_" + std::to_string(height);
+}
+
+auto store(
+    const ot::api::client::internal::Manager& api,
+    const b::filter::Type type,
+    const std::vector<bb::Position>& blocks) noexcept -> bool
+{
+    const auto& db = dynamic_cast<const ot::api::client::internal::Blockchain&>(
+                         api.Blockchain())
+                         .BlockchainDB();
+    const auto params = b::internal::GetFilterParams(type);
+    auto filters = std::vector<ot::api::client::blockchain::FilterData>{};
+
+    for (const auto& [height, hash] : blocks) {
+        auto elements = std::vector<ot::OTData>{};
+
+        for (const auto& item : {element(height), std::string{"common"}}) {
+            elements.emplace_back(ot::Data::Factory(item.data(), item.size()));
+        }
+
+        filters.emplace_back(
+            hash->Bytes(),
+            ot::factory::GCS(
+                api,
+                params.first,
+                params.second,
+                b::internal::BlockHashToFilterKey(hash->Bytes()),
+                elements));
+    }
+
+    return db.StoreFilters(type, filters);
+}
+}  // namespace
+
+// Scans the stored filters of the best chain, first with a filter missing
+// partway through the range and then after it has been stored
+TEST_F(Test_HeaderOracle, filter_scan)
+{
+    EXPECT_TRUE(create_blocks(create_1_));
+    EXPECT_TRUE(apply_blocks(sequence_1_));
+    EXPECT_TRUE(verify_post_state(post_state_1_));
+
+    const auto& filters = network_->FilterOracleInternal();
+    const auto& scanner = network_->FilterScanner();
+    const auto type = filters.DefaultType();
+    const auto tip = header_oracle_.BestChain().first;
+    auto blocks = std::vector<bb::Position>{};
+
+    for (auto height = bb::Height{1}; height <= tip; ++height) {
+        blocks.emplace_back(height, header_oracle_.BestHash(height));
+    }
+
+    const auto gap = static_cast<std::size_t>(missing_ - 1);
+
+    ASSERT_LT(missing_, tip);
+    ASSERT_TRUE(store(api_, type, {blocks.begin(), blocks.begin() + gap}));
+    ASSERT_TRUE(store(api_, type, {blocks.begin() + gap + 1, blocks.end()}));
+
+    auto loaded = std::vector<bb::Height>{};
+    const auto count = filters.LoadFiltersOrResetTip(
+        type, blocks, [&](const auto index, const auto& gcs) {
+            const auto height = blocks.at(index).first;
+            loaded.emplace_back(height);
+
+            EXPECT_TRUE(gcs.Test(ot::ReadView{element(height)}));
+        });
+
+    EXPECT_EQ(gap, count);
+    ASSERT_EQ(gap, loaded.size());
+
+    for (auto i = std::size_t{0}; i < gap; ++i) {
+        EXPECT_EQ(blocks.at(i).first, loaded.at(i));
+    }
+
+    const auto items = std::vector<std::string>{
+        element(first_match_), element(second_match_), "absent"};
+    const auto targets = GCS::Targets{items.begin(), items.end()};
+
+    {
+        const auto result = scanner.Scan(type, 1, tip, targets);
+
+        ASSERT_TRUE(result.tested_.has_value());
+        EXPECT_EQ(missing_ - 1, result.tested_->first);
+        EXPECT_EQ(
+            header_oracle_.BestHash(missing_ - 1), result.tested_->second);
+        ASSERT_EQ(1, result.matches_.size());
+
+        const auto& [position, gcs] = result.matches_.front();
+
+        EXPECT_EQ(first_match_, position.first);
+        ASSERT_TRUE(gcs);
+        EXPECT_TRUE(gcs->Test(ot::ReadView{element(first_match_)}));
+    }
+
+    {
+        const auto result = scanner.Scan(type, missing_, tip, targets);
+
+        EXPECT_FALSE(result.tested_.has_value());
+        EXPECT_TRUE(result.matches_.empty());
+    }
+
+    ASSERT_TRUE(store(api_, type, {blocks.at(gap)}));
+
+    const auto result = scanner.Scan(type, 1, tip, targets);
+
+    ASSERT_TRUE(result.tested_.has_value());
+    EXPECT_EQ(tip, result.tested_->first);
+    ASSERT_EQ(2, result.matches_.size());
+    EXPECT_EQ(first_match_, result.matches_.at(0).first.first);
+    EXPECT_EQ(second_match_, result.matches_.at(1).first.first);
+
+    for (const auto& [position, gcs] : result.matches_) {
+        ASSERT_TRUE(gcs);
+        EXPECT_TRUE(gcs->Test(ot::ReadView{element(position.first)}));
+    }
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Helpers.hpp"
+#include "internal/api/client/Client.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+using Clock = std::chrono::steady_clock;
+
+// Serialized headers and views of them in the form AddSerializedHeaders
+// expects
+struct Serialized {
+    std::vector<ot::OTData> raw_{};
+    std::vector<ot::ReadView> views_{};
+};
+
+auto serialize(const std::vector<std::string>& hex) -> Serialized
+{
+    auto output = Serialized{};
+
+    for (const auto& header : hex) {
+        const auto& raw = output.raw_.emplace_back(
+            ot::Data::Factory(header, ot::Data::Mode::Hex));
+        output.views_.emplace_back(raw->Bytes());
+    }
+
+    return output;
+}
+
+// Writes a little endian integer into a serialized header
+auto write(ot::Data& raw, const std::size_t offset, const std::uint32_t value)
+    -> void
+{
+    auto* bytes = static_cast<std::uint8_t*>(raw.data()) + offset;
+
+    for (auto i = std::size_t{0}; i < sizeof(value); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(value >> (8u * i));
+    }
+}
+}  // namespace
+
+TEST_F(Test_HeaderOracle_btc, invalid_header_rejects_batch)
+{
+    const auto headers = serialize(bitcoin_);
+
+    ASSERT_EQ(headers.views_.size(), bitcoin_.size());
+
+    auto& oracle = network_->HeaderOracleInternal();
+    const auto invalid = headers.views_.size() / 2u;
+    const auto parser = [&](const auto bytes) -> std::unique_ptr<bb::Header> {
+        if (bytes.data() == headers.views_.at(invalid).data()) { return {}; }
+
+        return api_.Factory().BlockHeader(
+            type_, ot::Data::Factory(bytes.data(), bytes.size()));
+    };
+    const auto before = oracle.BestChain();
+
+    EXPECT_FALSE(oracle.AddSerializedHeaders(headers.views_, parser));
+    EXPECT_EQ(oracle.BestChain(), before);
+}
+
+// Reports the rate at which headers are parsed and validated serially,
+// compared to the rate at which the two phase pipeline parses, validates, and
+// connects them
+TEST_F(Test_HeaderOracle_btc, parallel_validation)
+{
+    const auto headers = serialize(bitcoin_);
+
+    ASSERT_EQ(headers.views_.size(), bitcoin_.size());
+
+    auto& oracle = network_->HeaderOracleInternal();
+    const auto parser = [&](const auto bytes) {
+        return api_.Factory().BlockHeader(
+            type_, ot::Data::Factory(bytes.data(), bytes.size()));
+    };
+    const auto rate = [&](const Clock::duration elapsed) {
+        using std::chrono::duration;
+        const auto seconds = duration<double>{elapsed}.count();
+
+        return (0 < seconds) ? (headers.views_.size() / seconds) : 0.0;
+    };
+
+    const auto serialStart = Clock::now();
+
+    for (const auto& bytes : headers.views_) { EXPECT_TRUE(parser(bytes)); }
+
+    const auto serial = Clock::now() - serialStart;
+    const auto parallelStart = Clock::now();
+
+    EXPECT_TRUE(oracle.AddSerializedHeaders(headers.views_, parser));
+
+    const auto parallel = Clock::now() - parallelStart;
+
+    std::cout << "Serial validation: " << rate(serial) << " headers/second\n"
+              << "Parallel validation and connection: " << rate(parallel)
+              << " headers/second\n";
+
+    const auto [height, hash] = oracle.BestChain();
+
+    EXPECT_EQ(height, bitcoin_.size());
+    EXPECT_EQ(hash, oracle.BestHash(height));
+}
+
+// Headers with timestamps more than two hours in the future are rejected even
+// though they are otherwise valid
+TEST_F(Test_HeaderOracle, future_timestamp)
+{
+    auto& oracle = network_->HeaderOracleInternal();
+    const auto parser = [&](const auto bytes) {
+        return api_.Factory().BlockHeader(
+            type_, ot::Data::Factory(bytes.data(), bytes.size()));
+    };
+    const auto& genesisHash = bc::HeaderOracle::GenesisBlockHash(type_);
+    const auto genesis = oracle.LoadHeader(genesisHash);
+    const auto* bitcoin =
+        dynamic_cast<const bb::bitcoin::Header*>(genesis.get());
+
+    ASSERT_NE(bitcoin, nullptr);
+
+    // Serializes a child of the genesis block with the specified timestamp,
+    // searching for a nonce which satisfies the proof of work requirement
+    const auto child = [&](const ot::Time timestamp) {
+        auto raw = bitcoin->Encode();
+        std::memcpy(
+            static_cast<std::uint8_t*>(raw->data()) + 4u,
+            genesisHash.data(),
+            genesisHash.size());
+        write(
+            raw,
+            68u,
+            static_cast<std::uint32_t>(ot::Clock::to_time_t(timestamp)));
+
+        for (auto nonce = std::uint32_t{0}; nonce < 100000u; ++nonce) {
+            write(raw, 76u, nonce);
+
+            if (parser(raw->Bytes())) { break; }
+        }
+
+        return raw;
+    };
+    const auto future = child(ot::Clock::now() + 3h);
+    const auto near = child(ot::Clock::now() + 1h);
+
+    ASSERT_TRUE(parser(future->Bytes()));
+    ASSERT_TRUE(parser(near->Bytes()));
+
+    const auto [height, hash] = oracle.BestChain();
+
+    EXPECT_FALSE(oracle.AddSerializedHeaders({future->Bytes()}, parser));
+    EXPECT_EQ(oracle.BestChain().first, height);
+    EXPECT_TRUE(oracle.AddSerializedHeaders({near->Bytes()}, parser));
+    EXPECT_EQ(oracle.BestChain().first, height + 1);
+}
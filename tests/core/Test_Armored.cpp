@@ -0,0 +1,146 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Encode.hpp"
+#include "opentxs/core/Armored.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/String.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto iterations_ = std::size_t{200};
+const auto sizes_ = std::vector<std::size_t>{200, 1023, 1024, 4096, 65536};
+
+// Resembles a serialized notary message: repetitive markup around
+// incompressible identifiers and signatures
+auto message(const std::size_t size) -> std::string
+{
+    auto output = std::string{};
+
+    while (output.size() < size) {
+        output.append("<notaryMessage requestNum=\"12\" nymID=\"");
+        output.append(ot::Identifier::Random()->str());
+        output.append("\">\n");
+    }
+
+    output.resize(size);
+
+    return output;
+}
+
+// How Armored encoded strings before the compression level was lowered
+auto armor_best(const std::string& in) -> std::string
+{
+    auto size = compressBound(static_cast<uLong>(in.size()));
+    auto compressed = std::string(size, '\0');
+    const auto rc = compress2(
+        reinterpret_cast<Bytef*>(compressed.data()),
+        &size,
+        reinterpret_cast<const Bytef*>(in.data()),
+        static_cast<uLong>(in.size()),
+        Z_BEST_COMPRESSION);
+
+    OT_ASSERT(Z_OK == rc);
+
+    compressed.resize(size);
+
+    return ot::Context().Crypto().Encode().DataEncode(compressed);
+}
+
+auto microseconds(const Clock::duration time) -> double
+{
+    return std::chrono::duration<double, std::micro>{time}.count() /
+           iterations_;
+}
+}  // namespace
+
+TEST(Armored, round_trip)
+{
+    for (const auto size : sizes_) {
+        const auto input = message(size);
+        const auto armored = ot::Armored::Factory(ot::String::Factory(input));
+
+        ASSERT_TRUE(armored->Exists());
+
+        auto output = ot::String::Factory();
+
+        ASSERT_TRUE(armored->GetString(output));
+        EXPECT_EQ(input, std::string(output->Get()));
+    }
+}
+
+// Strings armored at the previous compression level must still decode
+TEST(Armored, decode_best_compression)
+{
+    const auto input = message(4096);
+    auto armored = ot::Armored::Factory();
+    armored->Set(armor_best(input).c_str());
+    auto output = ot::String::Factory();
+
+    ASSERT_TRUE(armored->GetString(output));
+    EXPECT_EQ(input, std::string(output->Get()));
+}
+
+// Reports the cost of encoding and decoding a message at the previous
+// compression level, at the current level, and without armoring
+TEST(Armored, latency)
+{
+    for (const auto size : sizes_) {
+        const auto input = message(size);
+        const auto string = ot::String::Factory(input);
+        auto before = Clock::duration{};
+        auto after = Clock::duration{};
+        auto unarmored = Clock::duration{};
+        auto beforeSize = std::size_t{};
+        auto afterSize = std::size_t{};
+
+        for (auto i = std::size_t{0}; i < iterations_; ++i) {
+            auto start = Clock::now();
+            const auto encoded = armor_best(input);
+            auto armored = ot::Armored::Factory();
+            armored->Set(encoded.c_str());
+            auto output = ot::String::Factory();
+            armored->GetString(output);
+            before += Clock::now() - start;
+            beforeSize = encoded.size();
+
+            start = Clock::now();
+            const auto current = ot::Armored::Factory(string);
+            current->GetString(output);
+            after += Clock::now() - start;
+            afterSize = current->GetLength();
+
+            start = Clock::now();
+            const auto copy = std::string{string->Get(), string->GetLength()};
+            output->Set(copy.data(), static_cast<std::uint32_t>(copy.size()));
+            unarmored += Clock::now() - start;
+        }
+
+        std::cout << size << " bytes:\n"
+                  << "  best compression: " << microseconds(before)
+                  << " microseconds, " << beforeSize << " bytes\n"
+                  << "  current armor:    " << microseconds(after)
+                  << " microseconds, " << afterSize << " bytes\n"
+                  << "  unarmored:        " << microseconds(unarmored)
+                  << " microseconds, " << size << " bytes\n";
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "core/cron/CronSchedule.hpp"
+#include "opentxs/Types.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+class Test_CronSchedule : public ::testing::Test
+{
+public:
+    const ot::Time start_;
+    ot::CronSchedule schedule_;
+
+    // Processes the current slice the way OTCron does, rescheduling every
+    // item to the specified offset from the start of the slice
+    auto process(
+        const ot::Time now,
+        const std::size_t limit,
+        const ot::Time::duration next) -> std::vector<std::int64_t>
+    {
+        auto output = std::vector<std::int64_t>{};
+
+        if (false == schedule_.BeginSlice(now, limit)) { return output; }
+
+        while (schedule_.Due()) {
+            const auto transaction = schedule_.Next();
+            output.emplace_back(transaction);
+            schedule_.Schedule(transaction, now + next);
+        }
+
+        return output;
+    }
+
+    Test_CronSchedule()
+        : start_(ot::Clock::now())
+        , schedule_()
+    {
+    }
+};
+}  // namespace
+
+TEST_F(Test_CronSchedule, due_time_order)
+{
+    schedule_.Schedule(1, start_ + 3s);
+    schedule_.Schedule(2, start_ + 1s);
+    schedule_.Schedule(3, start_ + 2s);
+    schedule_.Schedule(4, start_ + 1s);
+    schedule_.Schedule(5, start_ + 10s);
+
+    ASSERT_TRUE(schedule_.NextDue().has_value());
+    EXPECT_EQ(schedule_.NextDue().value(), start_ + 1s);
+    EXPECT_FALSE(schedule_.BeginSlice(start_, 0));
+
+    // Items due at the same time are processed in the order they were
+    // scheduled in
+    const auto expected = std::vector<std::int64_t>{2, 4, 3, 1};
+
+    EXPECT_EQ(process(start_ + 5s, 0, 1h), expected);
+    EXPECT_FALSE(schedule_.EndSlice(5, 1us));
+    EXPECT_EQ(schedule_.NextDue().value(), start_ + 10s);
+
+    const auto& round = schedule_.LastRound();
+
+    EXPECT_EQ(round.due_, 4u);
+    EXPECT_EQ(round.processed_, 4u);
+    EXPECT_EQ(round.slices_, 1u);
+    EXPECT_EQ(round.scheduled_, 5u);
+}
+
+TEST_F(Test_CronSchedule, slice_limit)
+{
+    for (auto i = std::int64_t{1}; i <= 10; ++i) {
+        schedule_.Schedule(i, start_ + std::chrono::seconds(i));
+    }
+
+    const auto expected = std::vector<std::vector<std::int64_t>>{
+        {1, 2, 3, 4},
+        {5, 6, 7, 8},
+        {9, 10},
+    };
+    auto slices = std::vector<std::vector<std::int64_t>>{};
+    auto more = true;
+    auto now = start_ + 10s;
+
+    while (more) {
+        slices.emplace_back(process(now, 4, 1h));
+        more = schedule_.EndSlice(10, 1us);
+        now += 1ms;
+    }
+
+    EXPECT_EQ(slices, expected);
+
+    const auto& round = schedule_.LastRound();
+
+    EXPECT_EQ(round.due_, 10u);
+    EXPECT_EQ(round.processed_, 10u);
+    EXPECT_EQ(round.slices_, 3u);
+    EXPECT_EQ(round.elapsed_, 3us);
+}
+
+// An item rescheduled to a time which has already passed by the next slice
+// is processed again in the same round, and counted as due again
+TEST_F(Test_CronSchedule, rescheduled_during_round)
+{
+    schedule_.Schedule(1, start_);
+    schedule_.Schedule(2, start_);
+    schedule_.Schedule(3, start_);
+
+    EXPECT_EQ(process(start_, 2, 1ms).size(), 2u);
+    EXPECT_TRUE(schedule_.EndSlice(3, 1us));
+
+    // Items 1 and 2 are due again, along with item 3 which was left over
+    const auto expected = std::vector<std::int64_t>{3, 1, 2};
+
+    EXPECT_EQ(process(start_ + 1s, 0, 1h), expected);
+    EXPECT_FALSE(schedule_.EndSlice(3, 1us));
+
+    const auto& round = schedule_.LastRound();
+
+    EXPECT_EQ(round.due_, 5u);
+    EXPECT_EQ(round.processed_, 5u);
+    EXPECT_EQ(round.slices_, 2u);
+}
+
+// Processing an item may reschedule or remove other items, including items
+// which are due in the current slice
+TEST_F(Test_CronSchedule, changed_during_slice)
+{
+    for (auto i = std::int64_t{1}; i <= 5; ++i) {
+        schedule_.Schedule(i, start_);
+    }
+
+    ASSERT_TRUE(schedule_.BeginSlice(start_, 0));
+    ASSERT_TRUE(schedule_.Due());
+
+    auto processed = std::vector<std::int64_t>{};
+    processed.emplace_back(schedule_.Next());
+    schedule_.Schedule(processed.back(), start_ + 1h);
+    // Item 2 is removed from cron and item 3 is moved past the slice
+    schedule_.Unschedule(2);
+    schedule_.Removed();
+    schedule_.Schedule(3, start_ + 1h);
+    // Item 6 is added and due immediately
+    schedule_.Schedule(6, start_);
+
+    while (schedule_.Due()) {
+        processed.emplace_back(schedule_.Next());
+        schedule_.Schedule(processed.back(), start_ + 1h);
+    }
+
+    EXPECT_FALSE(schedule_.EndSlice(5, 1us));
+
+    const auto expected = std::vector<std::int64_t>{1, 4, 5, 6};
+
+    EXPECT_EQ(processed, expected);
+
+    const auto& round = schedule_.LastRound();
+
+    EXPECT_EQ(round.due_, 6u);
+    EXPECT_EQ(round.processed_, 4u);
+    EXPECT_EQ(round.removed_, 1u);
+    EXPECT_LE(round.processed_, round.due_);
+}
+
+// Items added between slices are counted as due once, even if the previous
+// slice left other due items behind or some of those are removed meanwhile
+TEST_F(Test_CronSchedule, changed_between_slices)
+{
+    for (auto i = std::int64_t{1}; i <= 4; ++i) {
+        schedule_.Schedule(i, start_);
+    }
+
+    EXPECT_EQ(process(start_, 1, 1h).size(), 1u);
+    EXPECT_TRUE(schedule_.EndSlice(4, 1us));
+
+    schedule_.Unschedule(2);
+    schedule_.Unschedule(3);
+    schedule_.Schedule(5, start_ + 1ms);
+    schedule_.Schedule(6, start_ + 2ms);
+
+    const auto expected = std::vector<std::int64_t>{4, 5, 6};
+
+    EXPECT_EQ(process(start_ + 1s, 0, 1h), expected);
+    EXPECT_FALSE(schedule_.EndSlice(4, 1us));
+
+    const auto& round = schedule_.LastRound();
+
+    EXPECT_EQ(round.due_, 6u);
+    EXPECT_EQ(round.processed_, 4u);
+}
+
+// Cron's thread sleeps until the earliest item is due, and recalculates that
+// time when it is woken because an item was added
+TEST_F(Test_CronSchedule, insert_moves_next_due)
+{
+    EXPECT_FALSE(schedule_.NextDue().has_value());
+    EXPECT_FALSE(schedule_.BeginSlice(start_, 0));
+
+    schedule_.Schedule(1, start_ + 1h);
+
+    ASSERT_TRUE(schedule_.NextDue().has_value());
+    EXPECT_EQ(schedule_.NextDue().value(), start_ + 1h);
+
+    schedule_.Schedule(2, start_);
+
+    EXPECT_EQ(schedule_.NextDue().value(), start_);
+
+    const auto expected = std::vector<std::int64_t>{2};
+
+    EXPECT_EQ(process(start_, 0, 1h), expected);
+    EXPECT_FALSE(schedule_.EndSlice(2, 1us));
+    EXPECT_EQ(schedule_.NextDue().value(), start_ + 1h);
+
+    schedule_.Unschedule(1);
+    schedule_.Unschedule(2);
+
+    EXPECT_FALSE(schedule_.NextDue().has_value());
+}
+
+// When cron runs short of transaction numbers it moves every due item to a
+// later time instead of processing it
+TEST_F(Test_CronSchedule, defer)
+{
+    for (auto i = std::int64_t{1}; i <= 3; ++i) {
+        schedule_.Schedule(i, start_);
+    }
+
+    schedule_.Schedule(4, start_ + 1h);
+
+    ASSERT_TRUE(schedule_.BeginSlice(start_, 0));
+
+    schedule_.Defer(start_ + 10s);
+
+    EXPECT_FALSE(schedule_.Due());
+    EXPECT_FALSE(schedule_.EndSlice(4, 1us));
+    EXPECT_EQ(schedule_.NextDue().value(), start_ + 10s);
+    EXPECT_EQ(schedule_.LastRound().processed_, 0u);
+
+    const auto expected = std::vector<std::int64_t>{1, 2, 3};
+
+    EXPECT_EQ(process(start_ + 10s, 0, 1h), expected);
+}
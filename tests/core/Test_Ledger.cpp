@@ -4,7 +4,14 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
 #include <memory>
+#include <new>
+#include <string>
 
 #include "OTTestEnvironment.hpp"  // IWYU pragma: keep
 #include "opentxs/OT.hpp"
@@ -17,7 +24,9 @@
 #include "opentxs/api/server/Manager.hpp"
 #include "opentxs/core/Identifier.hpp"
 #include "opentxs/core/Ledger.hpp"
+#include "opentxs/core/OTTransaction.hpp"
 #include "opentxs/core/PasswordPrompt.hpp"
+#include "opentxs/core/String.hpp"
 #include "opentxs/core/contract/ServerContract.hpp"
 #include "opentxs/core/identifier/Nym.hpp"
 #include "opentxs/core/identifier/Server.hpp"
@@ -29,6 +38,38 @@ ot::OTServerID server_id_{ot::identifier::Server::Factory()};
 
 namespace
 {
+thread_local std::size_t allocated_{0};
+}  // namespace
+
+// Counts the bytes allocated by the current thread so the benchmark below can
+// report the memory cost of loading a box
+auto operator new(std::size_t size) -> void*
+{
+    allocated_ += size;
+
+    if (auto* output = std::malloc((0 == size) ? 1 : size); nullptr != output) {
+        return output;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto record_count_ = std::int64_t{100};
+constexpr auto iterations_ = std::size_t{20};
+
+const auto account_id_ = ot::Identifier::Random();
+
 struct Ledger : public ::testing::Test {
     const ot::api::client::Manager& client_;
     const ot::api::server::Manager& server_;
@@ -43,6 +84,76 @@ struct Ledger : public ::testing::Test {
         , reason_s_(server_.Factory().PasswordPrompt(__FUNCTION__))
     {
     }
+
+    // Serialized inbox holding count final receipts
+    auto inbox(const std::int64_t count) const -> ot::OTString
+    {
+        const auto nym = client_.Wallet().Nym(nym_id_);
+
+        OT_ASSERT(nym);
+
+        auto ledger = client_.Factory().Ledger(
+            nym_id_, account_id_, server_id_, ot::ledgerType::inbox, true);
+
+        OT_ASSERT(ledger);
+
+        for (auto i = std::int64_t{1}; i <= count; ++i) {
+            auto transaction = client_.Factory().Transaction(
+                *ledger,
+                ot::transactionType::finalReceipt,
+                ot::originType::not_applicable,
+                i);
+
+            OT_ASSERT(transaction);
+
+            transaction->SetReferenceToNum(i);
+
+            OT_ASSERT(ledger->AddTransaction(std::move(transaction)));
+        }
+
+        auto output = ot::String::Factory();
+        ledger->ReleaseSignatures();
+
+        OT_ASSERT(ledger->SignContract(*nym, reason_c_));
+        OT_ASSERT(ledger->SaveContract());
+        OT_ASSERT(ledger->SaveContractRaw(output));
+
+        return output;
+    }
+
+    auto load(const ot::String& serialized, const bool lazy) const
+        -> std::unique_ptr<ot::Ledger>
+    {
+        auto output =
+            client_.Factory().Ledger(nym_id_, account_id_, server_id_);
+
+        OT_ASSERT(output);
+
+        output->SetLazy(lazy);
+
+        OT_ASSERT(output->LoadInboxFromString(serialized));
+
+        return output;
+    }
+
+    // Unsigned contents after signing again, which rewrites every record
+    auto contents(ot::Ledger& ledger) const -> std::string
+    {
+        const auto nym = client_.Wallet().Nym(nym_id_);
+        auto output = ot::String::Factory();
+        ledger.ReleaseSignatures();
+
+        OT_ASSERT(ledger.SignContract(*nym, reason_c_));
+        OT_ASSERT(ledger.SaveContents(output));
+
+        return output->Get();
+    }
+
+    static auto microseconds(const Clock::duration time) -> double
+    {
+        return std::chrono::duration<double, std::micro>{time}.count() /
+               iterations_;
+    }
 };
 }  // namespace
 
@@ -85,3 +196,121 @@ TEST_F(Ledger, load_nymbox)
     ASSERT_TRUE(nymbox);
     EXPECT_TRUE(nymbox->LoadNymbox());
 }
+
+TEST_F(Ledger, lazy_matches_eager)
+{
+    const auto serialized = inbox(record_count_);
+    auto eager = load(serialized, false);
+    auto lazy = load(serialized, true);
+
+    EXPECT_FALSE(eager->IsLazy());
+    EXPECT_TRUE(lazy->IsLazy());
+    ASSERT_EQ(record_count_, eager->GetTransactionCount());
+    EXPECT_EQ(eager->GetTransactionCount(), lazy->GetTransactionCount());
+    EXPECT_EQ(eager->GetTransactionNums(), lazy->GetTransactionNums());
+    EXPECT_EQ(
+        eager->GetTransactionCountInRefTo(record_count_ / 2),
+        lazy->GetTransactionCountInRefTo(record_count_ / 2));
+    EXPECT_EQ(contents(*eager), contents(*lazy));
+
+    const auto number = record_count_ / 2;
+    const auto transaction = lazy->GetTransaction(number);
+
+    ASSERT_TRUE(transaction);
+    EXPECT_TRUE(transaction->IsAbbreviated());
+    EXPECT_EQ(number, transaction->GetTransactionNum());
+    EXPECT_EQ(number, transaction->GetReferenceToNum());
+    EXPECT_EQ(transaction, lazy->GetTransaction(number));
+    EXPECT_EQ(
+        eager->GetTransactionIndex(number), lazy->GetTransactionIndex(number));
+    EXPECT_EQ(
+        eager->GetTransactionByIndex(0)->GetTransactionNum(),
+        lazy->GetTransactionByIndex(0)->GetTransactionNum());
+    EXPECT_TRUE(lazy->GetFinalReceipt(number + 1));
+    EXPECT_EQ(contents(*eager), contents(*lazy));
+    EXPECT_TRUE(eager->RemoveTransaction(number - 1));
+    EXPECT_TRUE(lazy->RemoveTransaction(number - 1));
+    EXPECT_FALSE(lazy->RemoveTransaction(number - 1));
+    EXPECT_FALSE(lazy->GetTransaction(number - 1));
+    EXPECT_EQ(record_count_ - 1, lazy->GetTransactionCount());
+    EXPECT_EQ(contents(*eager), contents(*lazy));
+    EXPECT_EQ(
+        eager->GetTransactionMap().size(), lazy->GetTransactionMap().size());
+}
+
+TEST_F(Ledger, lookup_by_position)
+{
+    const auto serialized = inbox(record_count_);
+    auto eager = load(serialized, false);
+    auto lazy = load(serialized, true);
+    const auto compare = [&] {
+        const auto count = eager->GetTransactionCount();
+
+        ASSERT_EQ(count, lazy->GetTransactionCount());
+
+        for (auto i = std::int32_t{0}; i < count; ++i) {
+            const auto expected = eager->GetTransactionByIndex(i);
+            const auto actual = lazy->GetTransactionByIndex(i);
+
+            ASSERT_TRUE(expected);
+            ASSERT_TRUE(actual);
+
+            const auto number = expected->GetTransactionNum();
+
+            EXPECT_EQ(number, actual->GetTransactionNum());
+            EXPECT_EQ(i, lazy->GetTransactionIndex(number));
+        }
+
+        EXPECT_FALSE(lazy->GetTransactionByIndex(count));
+    };
+    const auto number = record_count_ / 2;
+
+    compare();
+    // Materializes every final receipt
+    EXPECT_TRUE(lazy->GetFinalReceipt(number + 1));
+    compare();
+    EXPECT_TRUE(eager->RemoveTransaction(number));
+    EXPECT_TRUE(lazy->RemoveTransaction(number));
+    EXPECT_EQ(-1, lazy->GetTransactionIndex(number));
+    compare();
+}
+
+// Reports the cost of loading an inbox and reading one of its records with
+// every record instantiated up front, and with records instantiated on access
+TEST_F(Ledger, benchmark)
+{
+    for (const auto count : {10, 100, 1000}) {
+        const auto serialized = inbox(count);
+        const auto number = std::int64_t{count / 2};
+        auto before = Clock::duration{};
+        auto after = Clock::duration{};
+        auto beforeBytes = std::size_t{};
+        auto afterBytes = std::size_t{};
+
+        for (auto i = std::size_t{0}; i < iterations_; ++i) {
+            auto start = Clock::now();
+            auto bytes = allocated_;
+            auto eager = load(serialized, false);
+
+            ASSERT_TRUE(eager->GetTransaction(number));
+
+            before += Clock::now() - start;
+            beforeBytes = allocated_ - bytes;
+            start = Clock::now();
+            bytes = allocated_;
+            auto lazy = load(serialized, true);
+
+            ASSERT_TRUE(lazy->GetTransaction(number));
+
+            after += Clock::now() - start;
+            afterBytes = allocated_ - bytes;
+        }
+
+        std::cout << count << " records, " << serialized->GetLength()
+                  << " bytes:\n"
+                  << "  eager: " << microseconds(before) << " microseconds, "
+                  << beforeBytes << " bytes allocated\n"
+                  << "  lazy:  " << microseconds(after) << " microseconds, "
+                  << afterBytes << " bytes allocated\n";
+    }
+}
@@ -0,0 +1,605 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "internal/api/Api.hpp"
+#include "opentxs/Exclusive.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/Legacy.hpp"
+#include "opentxs/api/Wallet.hpp"
+#include "opentxs/api/server/Manager.hpp"
+#include "opentxs/contact/ContactItemType.hpp"
+#include "opentxs/core/Account.hpp"
+#include "opentxs/core/Armored.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/PasswordPrompt.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/core/contract/UnitDefinition.hpp"
+#include "opentxs/core/cron/OTCron.hpp"
+#include "opentxs/core/crypto/OTSignedFile.hpp"
+#include "opentxs/core/identifier/Nym.hpp"
+#include "opentxs/core/identifier/Server.hpp"
+#include "opentxs/core/identifier/UnitDefinition.hpp"
+#include "opentxs/core/trade/OTMarket.hpp"
+#include "opentxs/core/trade/OTOffer.hpp"
+#include "opentxs/core/trade/OTTrade.hpp"
+#include "opentxs/identity/Nym.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto offer_count_ = std::int64_t{1200};
+constexpr auto snapshot_count_ = std::size_t{20};
+constexpr auto scale_ = std::int64_t{1};
+constexpr auto fill_count_ = std::int64_t{100};
+constexpr auto fill_size_ = std::int64_t{10};
+constexpr auto fill_price_ = std::int64_t{100};
+// The first snapshot of a new market is followed by journal 1
+constexpr auto first_journal_ = std::uint64_t{1};
+
+class Test_MarketJournal : public ::testing::Test
+{
+public:
+    // The asset and currency accounts which settle one side of a trade
+    struct Trader {
+        ot::OTIdentifier asset_;
+        ot::OTIdentifier currency_;
+    };
+
+    const ot::api::server::Manager& server_;
+    ot::OTPasswordPrompt reason_;
+    ot::Nym_p nym_;
+    ot::OTUnitID unit_;
+    ot::OTUnitID currency_;
+    std::unique_ptr<ot::OTCron> cron_;
+    std::vector<std::unique_ptr<ot::OTTrade>> trades_;
+
+    // Cron receipts can not be overwritten, so each trade needs a
+    // transaction number which is unique for the whole run
+    static auto next_trade() -> std::int64_t
+    {
+        static auto next = std::int64_t{1000000};
+
+        return ++next;
+    }
+    static auto unit(
+        const ot::api::server::Manager& server,
+        const ot::identity::Nym& nym,
+        const std::string& tla,
+        const ot::PasswordPrompt& reason) -> ot::OTUnitID
+    {
+        const auto contract = server.Wallet().UnitDefinition(
+            nym.ID().str(),
+            tla,
+            tla,
+            tla,
+            ot::Identifier::Random()->str(),
+            tla,
+            2,
+            "cent",
+            ot::contact::ContactItemType::USD,
+            reason);
+
+        return ot::identifier::UnitDefinition::Factory(contract->ID()->str());
+    }
+
+    auto account(
+        const ot::identifier::UnitDefinition& unitID,
+        const std::int64_t balance) const -> ot::OTIdentifier
+    {
+        auto account = server_.Wallet().CreateAccount(
+            nym_->ID(),
+            server_.ID(),
+            unitID,
+            *nym_,
+            ot::Account::user,
+            0,
+            reason_);
+
+        OT_ASSERT(account);
+
+        auto output = ot::Identifier::Factory(account.get().GetRealAccountID());
+
+        if (0 < balance) {
+            const auto credited = account.get().Credit(balance);
+
+            OT_ASSERT(credited);
+        }
+
+        const auto saved = account.Release();
+
+        OT_ASSERT(saved);
+
+        return output;
+    }
+    auto balance(const ot::Identifier& accountID) const -> std::int64_t
+    {
+        return server_.Wallet().Account(accountID).get().GetBalance();
+    }
+    auto trader(const std::int64_t assets, const std::int64_t currency) const
+        -> Trader
+    {
+        return {account(unit_, assets), account(currency_, currency)};
+    }
+    // Writes a journal record for the market directly, the way anyone with
+    // access to the data folder could
+    auto forge(
+        const ot::OTMarket& market,
+        const std::size_t index,
+        const std::string& payload,
+        const ot::identity::Nym& signer) const -> bool
+    {
+        const auto& api = dynamic_cast<const ot::api::internal::Core&>(server_);
+        const auto id = ot::String::Factory(ot::Identifier::Factory(market));
+        const auto filename = std::string{id->Get()} + "." +
+                              std::to_string(first_journal_) + "." +
+                              std::to_string(index) + ".jnl";
+        auto pFile =
+            api.Factory().SignedFile(api.Legacy().Market(), filename.c_str());
+
+        OT_ASSERT(pFile);
+
+        pFile->SetSignerNymID(ot::String::Factory(signer.ID()));
+        pFile->SetFilePayload(ot::String::Factory(payload));
+
+        return pFile->SignContract(signer, reason_) && pFile->SaveContract() &&
+               pFile->SaveFile();
+    }
+    auto market() const -> std::unique_ptr<ot::OTMarket>
+    {
+        auto output =
+            server_.Factory().Market(server_.ID(), unit_, currency_, scale_);
+
+        OT_ASSERT(output);
+
+        output->SetCronPointer(*cron_);
+
+        return output;
+    }
+
+    auto offer(const std::int64_t transaction) const
+        -> std::unique_ptr<ot::OTOffer>
+    {
+        const auto selling = (0 == transaction % 2);
+        const auto price = 100 + (transaction % 50);
+
+        return offer(selling, price, 1000, transaction);
+    }
+    auto offer(
+        const bool selling,
+        const std::int64_t price,
+        const std::int64_t amount,
+        const std::int64_t transaction) const -> std::unique_ptr<ot::OTOffer>
+    {
+        auto output =
+            server_.Factory().Offer(server_.ID(), unit_, currency_, scale_);
+
+        OT_ASSERT(output);
+
+        const auto made =
+            output->MakeOffer(selling, price, amount, scale_, transaction);
+
+        OT_ASSERT(made);
+
+        const auto isSigned = output->SignContract(*nym_, reason_);
+
+        OT_ASSERT(isSigned);
+
+        const auto saved = output->SaveContract();
+
+        OT_ASSERT(saved);
+
+        return output;
+    }
+    // Issues a trade for the offer and adds both to the market the way cron
+    // does when the trade is activated
+    auto place(
+        ot::OTMarket& market,
+        const Trader& trader,
+        std::unique_ptr<ot::OTOffer> pOffer) -> ot::OTTrade&
+    {
+        auto& trade = *trades_.emplace_back(server_.Factory().Trade(
+            server_.ID(),
+            unit_,
+            trader.asset_,
+            nym_->ID(),
+            currency_,
+            trader.currency_));
+        const auto issued = trade.IssueTrade(*pOffer);
+
+        OT_ASSERT(issued);
+
+        trade.SetCronPointer(*cron_);
+        const auto isSigned = trade.SignContract(*nym_, reason_);
+
+        OT_ASSERT(isSigned);
+
+        const auto saved = trade.SaveContract() && trade.SaveCronReceipt();
+
+        OT_ASSERT(saved);
+
+        pOffer->SetTrade(trade);
+        const auto added = market.AddOffer(&trade, *pOffer, reason_, true);
+
+        OT_ASSERT(added);
+
+        pOffer.release();
+
+        return trade;
+    }
+
+    Test_MarketJournal()
+        : server_(
+              ot::Context().StartServer(OTTestEnvironment::test_args_, 0, true))
+        , reason_(server_.Factory().PasswordPrompt(__FUNCTION__))
+        , nym_(server_.Wallet().Nym(server_.NymID()))
+        , unit_(unit(server_, *nym_, "GLD", reason_))
+        , currency_(unit(server_, *nym_, "USD", reason_))
+        , cron_(server_.Factory().Cron())
+        , trades_()
+    {
+        OT_ASSERT(nym_);
+        OT_ASSERT(cron_);
+
+        cron_->SetServerNym(nym_);
+        cron_->SetNotaryID(server_.ID());
+
+        // Each fill consumes a transaction number for its receipts
+        for (auto i = std::int64_t{1}; i <= 4 * fill_count_; ++i) {
+            cron_->AddTransactionNumber(next_trade());
+        }
+    }
+};
+}  // namespace
+
+// Reports the rate at which offers are added to and removed from a market
+// when each change is journaled, compared to the rate at which the whole
+// market can be written. Loading the market must reproduce the order book.
+TEST_F(Test_MarketJournal, add_remove_reload)
+{
+    const auto rate = [](const std::size_t count, const Clock::duration time) {
+        const auto seconds = std::chrono::duration<double>{time}.count();
+
+        return (0 < seconds) ? (count / seconds) : 0.0;
+    };
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+
+    const auto addStart = Clock::now();
+
+    for (auto i = std::int64_t{1}; i <= offer_count_; ++i) {
+        auto pOffer = offer(i);
+
+        ASSERT_TRUE(pMarket->AddOffer(nullptr, *pOffer, reason_, true));
+
+        pOffer.release();
+    }
+
+    const auto added = Clock::now() - addStart;
+    const auto removeStart = Clock::now();
+
+    for (auto i = std::int64_t{1}; i <= offer_count_; i += 2) {
+        EXPECT_TRUE(pMarket->RemoveOffer(i, reason_));
+    }
+
+    const auto removed = Clock::now() - removeStart;
+
+    EXPECT_FALSE(pMarket->RemoveOffer(1, reason_));
+    // Odd transaction numbers are bids
+    EXPECT_EQ(pMarket->GetBidCount(), 0);
+    EXPECT_EQ(pMarket->GetAskCount(), std::size_t{offer_count_ / 2});
+
+    {
+        auto pLoaded = market();
+
+        ASSERT_TRUE(pLoaded->LoadMarket());
+        EXPECT_EQ(pLoaded->GetAskCount(), pMarket->GetAskCount());
+        EXPECT_EQ(pLoaded->GetBidCount(), pMarket->GetBidCount());
+
+        for (auto i = std::int64_t{2}; i <= offer_count_; i += 2) {
+            EXPECT_NE(pLoaded->GetOffer(i), nullptr);
+        }
+    }
+
+    const auto saveStart = Clock::now();
+
+    for (auto i = std::size_t{0}; i < snapshot_count_; ++i) {
+        EXPECT_TRUE(pMarket->SaveMarket(reason_));
+    }
+
+    const auto saved = Clock::now() - saveStart;
+
+    std::cout << "Journaled additions: " << rate(offer_count_, added)
+              << " offers/second\n"
+              << "Journaled removals: " << rate(offer_count_ / 2, removed)
+              << " offers/second\n"
+              << "Full market saves: " << rate(snapshot_count_, saved)
+              << " saves/second with " << pMarket->GetAskCount()
+              << " offers\n";
+
+    auto pReloaded = market();
+
+    ASSERT_TRUE(pReloaded->LoadMarket());
+    EXPECT_EQ(pReloaded->GetAskCount(), pMarket->GetAskCount());
+}
+
+// The top of the book, the volume available, and the packed offer list must
+// follow each change to the book
+TEST_F(Test_MarketJournal, price_levels)
+{
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+    EXPECT_EQ(pMarket->GetHighestBidPrice(), 0);
+    EXPECT_EQ(pMarket->GetLowestAskPrice(), 0);
+
+    // Bids at 101 to 109, asks at 102 to 110
+    for (auto i = std::int64_t{1}; i <= 10; ++i) {
+        auto pOffer = offer(i);
+
+        ASSERT_TRUE(pMarket->AddOffer(nullptr, *pOffer, reason_, true));
+
+        pOffer.release();
+    }
+
+    EXPECT_EQ(pMarket->GetHighestBidPrice(), 109);
+    EXPECT_EQ(pMarket->GetLowestAskPrice(), 102);
+    EXPECT_EQ(pMarket->GetTotalAvailableAssets(), 5000);
+
+    auto first = ot::Armored::Factory();
+    auto second = ot::Armored::Factory();
+    auto count = std::int32_t{0};
+
+    ASSERT_TRUE(pMarket->GetOfferList(first, 0, count));
+    EXPECT_EQ(count, 10);
+    ASSERT_TRUE(pMarket->GetOfferList(second, 0, count));
+    EXPECT_EQ(count, 10);
+    EXPECT_STREQ(first->Get(), second->Get());
+    EXPECT_TRUE(pMarket->RemoveOffer(2, reason_));
+    EXPECT_TRUE(pMarket->RemoveOffer(9, reason_));
+    EXPECT_EQ(pMarket->GetHighestBidPrice(), 107);
+    EXPECT_EQ(pMarket->GetLowestAskPrice(), 104);
+    EXPECT_EQ(pMarket->GetTotalAvailableAssets(), 4000);
+    ASSERT_TRUE(pMarket->GetOfferList(second, 0, count));
+    EXPECT_EQ(count, 8);
+    EXPECT_STRNE(first->Get(), second->Get());
+
+    auto pLoaded = market();
+
+    ASSERT_TRUE(pLoaded->LoadMarket());
+    EXPECT_EQ(pLoaded->GetHighestBidPrice(), 107);
+    EXPECT_EQ(pLoaded->GetLowestAskPrice(), 104);
+    EXPECT_EQ(pLoaded->GetTotalAvailableAssets(), 4000);
+}
+
+// Reports the rate at which a resting bid is filled by incoming asks. Each
+// fill journals the updated offers and the sale, moves funds between four
+// accounts, and writes receipts to their inboxes.
+TEST_F(Test_MarketJournal, fill_benchmark)
+{
+    const auto total = fill_count_ * fill_size_;
+    const auto seller = trader(total, 0);
+    const auto buyer = trader(0, total * fill_price_);
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+
+    const auto bid = next_trade();
+    place(*pMarket, buyer, offer(false, fill_price_, total, bid));
+    const auto start = Clock::now();
+
+    for (auto i = std::int64_t{0}; i < fill_count_; ++i) {
+        const auto number = next_trade();
+        auto pAsk = offer(true, fill_price_, fill_size_, number);
+        auto& ask = *pAsk;
+        auto& trade = place(*pMarket, seller, std::move(pAsk));
+
+        // A completed offer is removed from the market by cron
+        EXPECT_FALSE(pMarket->ProcessTrade(
+            server_.Wallet(), trade, ask, reason_));
+        EXPECT_EQ(ask.GetAmountAvailable(), 0);
+        EXPECT_TRUE(pMarket->RemoveOffer(number, reason_));
+    }
+
+    const auto elapsed =
+        std::chrono::duration<double>{Clock::now() - start}.count();
+
+    std::cout << "Journaled fills: "
+              << ((0 < elapsed) ? (fill_count_ / elapsed) : 0.0)
+              << " fills/second\n";
+
+    auto* pBid = pMarket->GetOffer(bid);
+
+    ASSERT_NE(pBid, nullptr);
+    EXPECT_EQ(pBid->GetFinishedSoFar(), total);
+    EXPECT_EQ(balance(seller.asset_), 0);
+    EXPECT_EQ(balance(seller.currency_), total * fill_price_);
+    EXPECT_EQ(balance(buyer.asset_), total);
+    EXPECT_EQ(balance(buyer.currency_), 0);
+    EXPECT_EQ(pMarket->GetAskCount(), 0);
+}
+
+// Loading a market after a partial fill must replay the updated offers and
+// the sale from the journal
+TEST_F(Test_MarketJournal, reload_after_partial_fill)
+{
+    const auto seller = trader(30, 0);
+    const auto buyer = trader(0, 100 * fill_price_);
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+
+    const auto bid = next_trade();
+    const auto ask = next_trade();
+    place(*pMarket, buyer, offer(false, fill_price_, 100, bid));
+    // The ask accepts less than the bid, so the sale happens at the price
+    // of the bid which was already on the market
+    auto pAsk = offer(true, fill_price_ - 10, 30, ask);
+    auto& askOffer = *pAsk;
+    auto& trade = place(*pMarket, seller, std::move(pAsk));
+
+    EXPECT_FALSE(
+        pMarket->ProcessTrade(server_.Wallet(), trade, askOffer, reason_));
+    EXPECT_EQ(askOffer.GetFinishedSoFar(), 30);
+    EXPECT_EQ(balance(seller.asset_), 0);
+    EXPECT_EQ(balance(seller.currency_), 30 * fill_price_);
+    EXPECT_EQ(balance(buyer.asset_), 30);
+    EXPECT_EQ(balance(buyer.currency_), 70 * fill_price_);
+
+    const auto* pBid = pMarket->GetOffer(bid);
+
+    ASSERT_NE(pBid, nullptr);
+    EXPECT_EQ(pBid->GetFinishedSoFar(), 30);
+    EXPECT_EQ(pBid->GetAmountAvailable(), 70);
+    EXPECT_EQ(pMarket->GetLastSalePrice(), fill_price_);
+
+    auto trades = ot::Armored::Factory();
+    auto count = std::int32_t{0};
+
+    ASSERT_TRUE(pMarket->GetRecentTradeList(trades, count));
+    EXPECT_EQ(count, 1);
+
+    // The filled ask stays on the book until cron removes it
+    {
+        auto pLoaded = market();
+
+        ASSERT_TRUE(pLoaded->LoadMarket());
+        EXPECT_EQ(pLoaded->GetBidCount(), 1);
+        EXPECT_EQ(pLoaded->GetAskCount(), 1);
+        EXPECT_EQ(pLoaded->GetTotalAvailableAssets(), 0);
+
+        const auto* pFilled = pLoaded->GetOffer(ask);
+
+        ASSERT_NE(pFilled, nullptr);
+        EXPECT_EQ(pFilled->GetFinishedSoFar(), 30);
+    }
+
+    EXPECT_TRUE(pMarket->RemoveOffer(ask, reason_));
+
+    auto pLoaded = market();
+
+    ASSERT_TRUE(pLoaded->LoadMarket());
+    EXPECT_EQ(pLoaded->GetBidCount(), 1);
+    EXPECT_EQ(pLoaded->GetAskCount(), 0);
+    EXPECT_EQ(pLoaded->GetHighestBidPrice(), fill_price_);
+    EXPECT_EQ(pLoaded->GetLastSalePrice(), fill_price_);
+
+    auto* pLoadedBid = pLoaded->GetOffer(bid);
+
+    ASSERT_NE(pLoadedBid, nullptr);
+    EXPECT_EQ(pLoadedBid->GetFinishedSoFar(), 30);
+    EXPECT_EQ(pLoadedBid->GetAmountAvailable(), 70);
+    EXPECT_TRUE(pLoadedBid->VerifySignature(*nym_));
+
+    auto loadedTrades = ot::Armored::Factory();
+
+    ASSERT_TRUE(pLoaded->GetRecentTradeList(loadedTrades, count));
+    EXPECT_EQ(count, 1);
+}
+
+// A record which was not signed by the server must not change the book. At
+// the end of the journal it is ignored like an interrupted write, anywhere
+// else it invalidates the journal and the market loads from its snapshot.
+TEST_F(Test_MarketJournal, forged_record)
+{
+    const auto other = server_.Wallet().Nym(reason_, "forger");
+
+    ASSERT_TRUE(other);
+
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+
+    for (auto i = std::int64_t{1}; i <= 4; ++i) {
+        auto pOffer = offer(i);
+
+        ASSERT_TRUE(pMarket->AddOffer(nullptr, *pOffer, reason_, true));
+
+        pOffer.release();
+    }
+
+    // Removes the first offer
+    const auto removal = std::string{"2 1 0 0 0\n"};
+
+    ASSERT_TRUE(forge(*pMarket, 4, removal, *other));
+
+    {
+        auto pLoaded = market();
+
+        ASSERT_TRUE(pLoaded->LoadMarket());
+        EXPECT_NE(pLoaded->GetOffer(1), nullptr);
+        EXPECT_EQ(pLoaded->GetBidCount() + pLoaded->GetAskCount(), 4);
+    }
+
+    ASSERT_TRUE(forge(*pMarket, 1, removal, *other));
+
+    auto pLoaded = market();
+
+    ASSERT_TRUE(pLoaded->LoadMarket());
+    EXPECT_EQ(pLoaded->GetBidCount() + pLoaded->GetAskCount(), 0);
+    EXPECT_TRUE(pLoaded->VerifySignature(*nym_));
+}
+
+// Offers are signed by the server before they are journaled, so an offer
+// with any other signature means the journal was not written by this market
+TEST_F(Test_MarketJournal, unsigned_offer)
+{
+    const auto other = server_.Wallet().Nym(reason_, "trader");
+
+    ASSERT_TRUE(other);
+
+    auto pMarket = market();
+
+    ASSERT_TRUE(pMarket->SaveMarket(reason_));
+
+    {
+        auto pOffer = offer(1);
+
+        ASSERT_TRUE(pMarket->AddOffer(nullptr, *pOffer, reason_, true));
+
+        pOffer.release();
+    }
+
+    const auto add = [&](const ot::OTOffer& offer) {
+        return "1 " + std::to_string(offer.GetTransactionNum()) + " 0 0 0\n" +
+               std::string{ot::String::Factory(offer)->Get()};
+    };
+    auto pOffer = offer(2);
+
+    pOffer->ReleaseSignatures();
+    ASSERT_TRUE(pOffer->SignContract(*other, reason_));
+    ASSERT_TRUE(pOffer->SaveContract());
+    ASSERT_TRUE(forge(*pMarket, 1, add(*pOffer), *nym_));
+
+    {
+        auto pLoaded = market();
+
+        ASSERT_TRUE(pLoaded->LoadMarket());
+        EXPECT_EQ(pLoaded->GetBidCount() + pLoaded->GetAskCount(), 0);
+    }
+
+    ASSERT_TRUE(forge(*pMarket, 1, add(*offer(2)), *nym_));
+
+    auto pLoaded = market();
+
+    ASSERT_TRUE(pLoaded->LoadMarket());
+    EXPECT_EQ(pLoaded->GetBidCount() + pLoaded->GetAskCount(), 2);
+}
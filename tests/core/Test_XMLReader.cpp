@@ -0,0 +1,256 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <irrxml/irrXML.hpp>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "core/XMLReader.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/core/StringXML.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto iterations_ = std::size_t{20};
+
+const auto snippets_ = std::vector<std::string>{
+    R"(<?xml version="1.0"?>
+<notaryMessage requestNum="1" nymID="abc" success="true">
+</notaryMessage>)",
+    R"(<a x='1' y="two words"><b/><c z="3" /><d></d></a>)",
+    R"(<a>text &lt;with&gt; &amp;entities&quot;&apos; inside</a>)",
+    R"(<a v="1 &lt; 2 &amp;&amp; 3 &gt; 2 done"/>)",
+    R"(<a><!-- a comment --><b>x</b><![CDATA[<raw> & data]]></a>)",
+    R"(<a>
+    <b>  </b>
+    <c>
+</c></a>)",
+    R"(<accountLedger version="1.0" type="nymbox">
+<nymboxRecord type="message" transactionNum="5" inRefTo="0"/>
+<inReferenceTo>
+LS0tLS1CRUdJTiBPVCBBUk1PUkVEIE1FU1NBR0UtLS0tLQo=
+</inReferenceTo>
+</accountLedger>)",
+};
+
+// Resembles a legacy ledger: an element per transaction with many attributes
+// and an armored text field
+auto ledger(const std::size_t count) -> std::string
+{
+    auto output = std::string{
+        "<?xml version=\"1.0\"?>\n<accountLedger version=\"2.0\" "
+        "type=\"inbox\" numPartialRecords=\"0\">\n\n"};
+
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        const auto id = ot::Identifier::Random()->str();
+        output.append("<inboxRecord type=\"pending\" dateSigned=\"1600000000\""
+                      " transactionNum=\"");
+        output.append(std::to_string(i));
+        output.append("\" inRefDisplay=\"0\" adjustment=\"100\" "
+                      "displayValue=\"100\" notaryID=\"");
+        output.append(id);
+        output.append("\" senderAcctID=\"");
+        output.append(id);
+        output.append("\" receiptHash=\"");
+        output.append(id);
+        output.append("\" />\n\n<inReferenceTo>\n");
+
+        for (auto j = 0; j < 8; ++j) {
+            output.append(
+                "eJzNWNtu2zAMfc9XGP2ADxS7dEGxt6F7KNYLChRFgD0ZsqXEQm1JkOQk/fvRtp"
+                "\n");
+        }
+
+        output.append("</inReferenceTo>\n");
+    }
+
+    // No trailing whitespace, which irrXML would report as a repeat of the
+    // final node
+    output.append("</accountLedger>");
+
+    return output;
+}
+
+// Number of nodes and total length of names, values, and attributes seen
+auto walk(irr::io::IrrXMLReader& xml) -> std::size_t
+{
+    auto output = std::size_t{0};
+
+    while (xml.read()) {
+        ++output;
+        output += std::string{xml.getNodeName()}.size();
+
+        for (auto i = 0; i < xml.getAttributeCount(); ++i) {
+            output += std::string{xml.getAttributeValue(i)}.size();
+        }
+    }
+
+    return output;
+}
+
+auto compare(const std::string& input) -> void
+{
+    auto expected = std::unique_ptr<irr::io::IrrXMLReader>{
+        irr::io::createIrrXMLReader(ot::StringXML::Factory(
+                                        ot::String::Factory(input))
+                                        .get())};
+    auto actual = ot::XMLReader{input.data(), input.size()};
+
+    ASSERT_TRUE(expected);
+
+    while (expected->read()) {
+        ASSERT_TRUE(actual.read());
+
+        // irrXML repeats the previous node when the input ends with text
+        if (irr::io::EXN_NONE == actual.getNodeType()) {
+            EXPECT_FALSE(expected->read());
+
+            break;
+        }
+
+        const auto type = expected->getNodeType();
+
+        ASSERT_EQ(type, actual.getNodeType());
+
+        // irrXML leaves the previous name in place for definitions
+        if (irr::io::EXN_UNKNOWN == type) { continue; }
+
+        EXPECT_STREQ(expected->getNodeName(), actual.getNodeName());
+        EXPECT_EQ(expected->isEmptyElement(), actual.isEmptyElement());
+        ASSERT_EQ(expected->getAttributeCount(), actual.getAttributeCount());
+
+        for (auto i = 0; i < expected->getAttributeCount(); ++i) {
+            const auto* name = expected->getAttributeName(i);
+
+            EXPECT_STREQ(name, actual.getAttributeName(i));
+            EXPECT_STREQ(
+                expected->getAttributeValue(i), actual.getAttributeValue(i));
+            EXPECT_STREQ(
+                expected->getAttributeValueSafe(name),
+                actual.getAttributeValueSafe(name));
+            EXPECT_EQ(
+                expected->getAttributeValueAsInt(name),
+                actual.getAttributeValueAsInt(name));
+        }
+    }
+
+    EXPECT_FALSE(actual.read());
+}
+
+auto microseconds(const Clock::duration time) -> double
+{
+    return std::chrono::duration<double, std::micro>{time}.count() /
+           iterations_;
+}
+}  // namespace
+
+TEST(XMLReader, matches_irrxml)
+{
+    for (const auto& snippet : snippets_) { compare(snippet); }
+
+    compare(ledger(10));
+}
+
+TEST(XMLReader, node_contents)
+{
+    const auto input = std::string{
+        "\xEF\xBB\xBF<a v=\"x &amp;\" w=\"&lt;b\">"
+        "&lt;b&gt;<!--c--><![CDATA[d]]></a>\n"};
+    auto xml = ot::XMLReader{ot::String::Factory(input)};
+
+    EXPECT_EQ(irr::io::ETF_UTF8, xml.getSourceFormat());
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_ELEMENT, xml.getNodeType());
+    EXPECT_EQ("a", xml.Node());
+    EXPECT_STREQ("x &", xml.getAttributeValue("v"));
+    // irrXML drops a single character after the last entity reference
+    EXPECT_STREQ("<b", xml.getAttributeValue("w"));
+    EXPECT_EQ(nullptr, xml.getAttributeValue("z"));
+    EXPECT_STREQ("", xml.getAttributeValueSafe("z"));
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_TEXT, xml.getNodeType());
+    EXPECT_EQ("<b>", xml.Node());
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_COMMENT, xml.getNodeType());
+    EXPECT_EQ("c", xml.Node());
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_CDATA, xml.getNodeType());
+    EXPECT_EQ("d", xml.Node());
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_ELEMENT_END, xml.getNodeType());
+    EXPECT_EQ("a", xml.Node());
+    ASSERT_TRUE(xml.read());
+    EXPECT_EQ(irr::io::EXN_NONE, xml.getNodeType());
+    EXPECT_FALSE(xml.read());
+}
+
+TEST(XMLReader, malformed)
+{
+    const auto inputs = std::vector<std::string>{
+        "<",
+        "<a",
+        "<a b=",
+        "<a b=\"c",
+        "<a></",
+        "<!-- x",
+        "<![CDATA[ x",
+        "<?xml",
+        "text only",
+        "<a>&amp",
+    };
+
+    for (const auto& input : inputs) {
+        auto xml = ot::XMLReader{input.data(), input.size()};
+        auto count = std::size_t{0};
+
+        while (xml.read()) { ASSERT_LE(++count, input.size()); }
+    }
+}
+
+// Reports the cost of walking a ledger with irrXML and with XMLReader
+TEST(XMLReader, benchmark)
+{
+    for (const auto count : {10, 100, 1000}) {
+        const auto input = ledger(count);
+        const auto string = ot::String::Factory(input);
+        auto before = Clock::duration{};
+        auto after = Clock::duration{};
+        auto beforeTotal = std::size_t{};
+        auto afterTotal = std::size_t{};
+
+        for (auto i = std::size_t{0}; i < iterations_; ++i) {
+            auto start = Clock::now();
+            auto xml = ot::StringXML::Factory(string);
+            auto irr = std::unique_ptr<irr::io::IrrXMLReader>{
+                irr::io::createIrrXMLReader(xml.get())};
+            beforeTotal = walk(*irr);
+            before += Clock::now() - start;
+
+            start = Clock::now();
+            auto reader = ot::XMLReader{string};
+            afterTotal = walk(reader);
+            after += Clock::now() - start;
+        }
+
+        EXPECT_EQ(beforeTotal, afterTotal);
+
+        std::cout << count << " records, " << input.size() << " bytes:\n"
+                  << "  irrXML:    " << microseconds(before)
+                  << " microseconds\n"
+                  << "  XMLReader: " << microseconds(after)
+                  << " microseconds\n";
+    }
+}
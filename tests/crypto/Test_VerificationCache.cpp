@@ -0,0 +1,196 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "crypto/library/VerificationCache.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Version.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/PasswordPrompt.hpp"
+#include "opentxs/core/crypto/NymParameters.hpp"
+#include "opentxs/crypto/HashType.hpp"
+#include "opentxs/crypto/key/Asymmetric.hpp"
+#include "opentxs/crypto/library/AsymmetricProvider.hpp"
+#include "opentxs/crypto/library/EcdsaProvider.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto iterations_ = std::size_t{1000};
+constexpr auto type_ = ot::crypto::HashType::Blake2b256;
+
+class Test_VerificationCache : public ::testing::Test
+{
+public:
+    ot::crypto::VerificationCache& cache_;
+    std::size_t calls_;
+    bool valid_;
+    const ot::crypto::VerificationCache::Verifier verify_;
+
+    auto check(
+        const std::string& key,
+        const std::string& plaintext,
+        const std::string& signature,
+        const ot::crypto::HashType type = type_) -> bool
+    {
+        return cache_.Verify(key, plaintext, signature, type, verify_);
+    }
+
+    Test_VerificationCache()
+        : cache_(ot::crypto::VerificationCache::Get())
+        , calls_(0)
+        , valid_(true)
+        , verify_([this] {
+            ++calls_;
+
+            return valid_;
+        })
+    {
+        cache_.SetCapacity(ot::crypto::VerificationCache::default_capacity_);
+        cache_.Clear();
+    }
+
+    ~Test_VerificationCache() override
+    {
+        cache_.SetCapacity(ot::crypto::VerificationCache::default_capacity_);
+    }
+};
+}  // namespace
+
+TEST_F(Test_VerificationCache, hit)
+{
+    EXPECT_TRUE(check("key", "plaintext", "signature"));
+    EXPECT_TRUE(check("key", "plaintext", "signature"));
+    EXPECT_EQ(1, calls_);
+    EXPECT_EQ(1, cache_.Hits());
+    EXPECT_EQ(1, cache_.Misses());
+    EXPECT_EQ(1, cache_.Size());
+}
+
+TEST_F(Test_VerificationCache, failures_are_not_cached)
+{
+    valid_ = false;
+
+    EXPECT_FALSE(check("key", "plaintext", "signature"));
+    EXPECT_FALSE(check("key", "plaintext", "signature"));
+    EXPECT_EQ(2, calls_);
+    EXPECT_EQ(0, cache_.Hits());
+    EXPECT_EQ(0, cache_.Size());
+}
+
+TEST_F(Test_VerificationCache, every_field_is_part_of_the_key)
+{
+    EXPECT_TRUE(check("key", "plaintext", "signature"));
+    valid_ = false;
+
+    EXPECT_FALSE(check("key2", "plaintext", "signature"));
+    EXPECT_FALSE(check("key", "plaintext2", "signature"));
+    EXPECT_FALSE(check("key", "plaintext", "signature2"));
+    EXPECT_FALSE(
+        check("key", "plaintext", "signature", ot::crypto::HashType::Sha256));
+    // Moving bytes from one field to the next must not produce the same key
+    EXPECT_FALSE(check("keyp", "laintext", "signature"));
+    EXPECT_EQ(6, calls_);
+    EXPECT_EQ(0, cache_.Hits());
+}
+
+TEST_F(Test_VerificationCache, capacity)
+{
+    cache_.SetCapacity(2);
+
+    EXPECT_TRUE(check("key", "1", "signature"));
+    EXPECT_TRUE(check("key", "2", "signature"));
+    EXPECT_TRUE(check("key", "3", "signature"));
+    EXPECT_EQ(2, cache_.Size());
+    EXPECT_EQ(3, calls_);
+
+    // The oldest entry was evicted
+    EXPECT_TRUE(check("key", "3", "signature"));
+    EXPECT_TRUE(check("key", "2", "signature"));
+    EXPECT_EQ(3, calls_);
+    EXPECT_TRUE(check("key", "1", "signature"));
+    EXPECT_EQ(4, calls_);
+    EXPECT_EQ(2, cache_.Size());
+}
+
+TEST_F(Test_VerificationCache, disabled)
+{
+    cache_.SetCapacity(0);
+
+    EXPECT_EQ(0, cache_.Capacity());
+    EXPECT_TRUE(check("key", "plaintext", "signature"));
+    EXPECT_TRUE(check("key", "plaintext", "signature"));
+    EXPECT_EQ(2, calls_);
+    EXPECT_EQ(0, cache_.Size());
+    EXPECT_EQ(0, cache_.Hits());
+    EXPECT_EQ(0, cache_.Misses());
+}
+
+#if OT_CRYPTO_SUPPORTED_KEY_ED25519
+// Reports the cost of verifying an ed25519 signature and of finding it in the
+// cache
+TEST_F(Test_VerificationCache, benchmark)
+{
+    const auto& api = ot::Context().StartClient({}, 0);
+    const auto reason = api.Factory().PasswordPrompt(__FUNCTION__);
+    auto params = ot::NymParameters{ot::NymParameterType::ed25519};
+    const auto key = api.Factory().AsymmetricKey(params, reason);
+    const auto& provider = api.Crypto().ED25519();
+    const auto preimage = std::string(4096, 'x');
+    const auto plaintext = ot::Data::Factory(preimage.data(), preimage.size());
+    auto signature = ot::Data::Factory();
+
+    ASSERT_TRUE(
+        key->Sign(plaintext->Bytes(), type_, signature->WriteInto(), reason));
+
+    const auto verify = [&] {
+        return provider.Verify(plaintext, key, signature, type_);
+    };
+    auto start = Clock::now();
+
+    for (auto i = std::size_t{0}; i < iterations_; ++i) {
+        ASSERT_TRUE(verify());
+    }
+
+    const auto uncached = Clock::now() - start;
+    start = Clock::now();
+
+    for (auto i = std::size_t{0}; i < iterations_; ++i) {
+        ASSERT_TRUE(cache_.Verify(
+            key->PublicKey(),
+            plaintext->Bytes(),
+            signature->Bytes(),
+            type_,
+            verify));
+    }
+
+    const auto cached = Clock::now() - start;
+
+    EXPECT_EQ(iterations_ - 1, cache_.Hits());
+    EXPECT_EQ(1, cache_.Misses());
+
+    const auto microseconds = [](const auto time) {
+        return std::chrono::duration<double, std::micro>{time}.count() /
+               iterations_;
+    };
+
+    std::cout << "Verification: " << microseconds(uncached)
+              << " microseconds\n"
+              << "Cached:       " << microseconds(cached) << " microseconds\n";
+}
+#endif  // OT_CRYPTO_SUPPORTED_KEY_ED25519
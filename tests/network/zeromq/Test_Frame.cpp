@@ -82,3 +82,45 @@ TEST(Frame, zmq_msg_t)
     zmq_msg_t* zmq_msg = message.get();
     ASSERT_NE(nullptr, zmq_msg);
 }
+
+TEST(Frame, zero_copy)
+{
+    auto released = 0;
+    auto buffer = std::string{"testString"};
+
+    {
+        OTZMQFrame message{Factory::ZMQFrame(
+            buffer.data(),
+            buffer.size(),
+            [](void*, void* hint) { ++(*static_cast<int*>(hint)); },
+            &released)};
+
+        ASSERT_EQ(buffer.data(), message->data());
+        ASSERT_EQ(buffer.size(), message->size());
+        ASSERT_EQ(0, released);
+    }
+
+    ASSERT_EQ(1, released);
+}
+
+TEST(Frame, move)
+{
+    auto released = 0;
+    auto buffer = std::string{"testString"};
+    OTZMQFrame original{Factory::ZMQFrame(
+        buffer.data(),
+        buffer.size(),
+        [](void*, void* hint) { ++(*static_cast<int*>(hint)); },
+        &released)};
+
+    {
+        OTZMQFrame moved{Factory::ZMQFrame(original.get())};
+
+        ASSERT_EQ(buffer.data(), moved->data());
+        ASSERT_EQ(buffer.size(), moved->size());
+        ASSERT_EQ(0, original->size());
+        ASSERT_EQ(0, released);
+    }
+
+    ASSERT_EQ(1, released);
+}
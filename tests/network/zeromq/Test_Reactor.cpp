@@ -0,0 +1,302 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Publish.hpp"
+#include "opentxs/network/zeromq/socket/Sender.tpp"
+#include "opentxs/network/zeromq/socket/Subscribe.hpp"
+
+namespace zmq = ot::network::zeromq;
+
+namespace
+{
+constexpr auto subscriber_count_ = std::size_t{250};
+
+class Test_Reactor : public ::testing::Test
+{
+public:
+    const zmq::Context& context_;
+    const std::string endpoint_{"inproc://opentxs/test/reactor"};
+
+    // Publishes until done returns true or the deadline passes
+    template <typename Done>
+    auto publish_until(const zmq::socket::Publish& publisher, Done done) const
+        -> bool
+    {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+        while ((false == done()) &&
+               (std::chrono::steady_clock::now() < deadline)) {
+            publisher.Send(std::string{"reactor test message"});
+            ot::Sleep(std::chrono::milliseconds(10));
+        }
+
+        return done();
+    }
+
+    Test_Reactor()
+        : context_(ot::Context().ZMQ())
+    {
+    }
+};
+}  // namespace
+
+// Many subscribe sockets must be served by a fixed number of reactor threads,
+// and every one of them must receive published messages
+TEST_F(Test_Reactor, many_subscribers)
+{
+    const auto before = context_.ReactorStats();
+    auto received = std::vector<std::atomic<int>>(subscriber_count_);
+    auto callbacks = std::vector<ot::OTZMQListenCallback>{};
+    auto subscribers = std::vector<ot::OTZMQSubscribeSocket>{};
+    auto publisher = context_.PublishSocket();
+    callbacks.reserve(subscriber_count_);
+    subscribers.reserve(subscriber_count_);
+
+    ASSERT_TRUE(publisher->Start(endpoint_));
+
+    for (auto i = std::size_t{0}; i < subscriber_count_; ++i) {
+        auto& counter = received.at(i);
+        const auto& cb = callbacks.emplace_back(zmq::ListenCallback::Factory(
+            [&counter](auto&) -> void { ++counter; }));
+        const auto& socket =
+            subscribers.emplace_back(context_.SubscribeSocket(cb));
+
+        ASSERT_TRUE(socket->Start(endpoint_));
+    }
+
+    {
+        const auto stats = context_.ReactorStats();
+
+        EXPECT_EQ(stats.threads_, before.threads_);
+        EXPECT_EQ(stats.workers_, before.workers_);
+        EXPECT_LT(stats.threads_ + stats.workers_, subscriber_count_);
+        EXPECT_EQ(stats.sockets_, before.sockets_ + subscriber_count_);
+    }
+
+    const auto allReceived = [&] {
+        return std::all_of(received.begin(), received.end(), [](auto& value) {
+            return 0 < value.load();
+        });
+    };
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    // Subscriptions propagate asynchronously, so publish until every socket
+    // has seen a message
+    while ((false == allReceived()) &&
+           (std::chrono::steady_clock::now() < deadline)) {
+        ASSERT_TRUE(publisher->Send(std::string{"reactor test message"}));
+
+        ot::Sleep(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_TRUE(allReceived());
+
+    const auto stats = context_.ReactorStats();
+
+    EXPECT_GT(stats.wakeups_, before.wakeups_);
+
+    std::cout << subscriber_count_ << " subscribers served by "
+              << stats.threads_ << " polling threads and " << stats.workers_
+              << " worker threads\n"
+              << "Average notification latency: "
+              << stats.average_latency_.count() << " microseconds\n"
+              << "Maximum notification latency: "
+              << stats.max_latency_.count() << " microseconds\n";
+
+    for (auto& socket : subscribers) { EXPECT_TRUE(socket->Close()); }
+
+    EXPECT_EQ(context_.ReactorStats().sockets_, before.sockets_);
+}
+
+// A callback which blocks must not delay the callbacks of other sockets
+TEST_F(Test_Reactor, slow_callback)
+{
+    auto release = std::promise<void>{};
+    const auto wait = release.get_future().share();
+    auto slowStarted = std::atomic<bool>{false};
+    auto fastCount = std::atomic<int>{0};
+    auto slowCb = zmq::ListenCallback::Factory([&](auto&) -> void {
+        slowStarted = true;
+        wait.wait();
+    });
+    auto fastCb =
+        zmq::ListenCallback::Factory([&](auto&) -> void { ++fastCount; });
+    auto publisher = context_.PublishSocket();
+    auto slow = context_.SubscribeSocket(slowCb);
+    auto fast = context_.SubscribeSocket(fastCb);
+
+    ASSERT_TRUE(publisher->Start(endpoint_ + "/slow"));
+    ASSERT_TRUE(slow->Start(endpoint_ + "/slow"));
+    ASSERT_TRUE(publish_until(publisher, [&] { return slowStarted.load(); }));
+    ASSERT_TRUE(fast->Start(endpoint_ + "/slow"));
+
+    const auto before = fastCount.load();
+
+    EXPECT_TRUE(publish_until(
+        publisher, [&] { return (before + 10) < fastCount.load(); }));
+
+    release.set_value();
+
+    EXPECT_TRUE(slow->Close());
+    EXPECT_TRUE(fast->Close());
+}
+
+// Callbacks may start and close other sockets without waiting for them, even
+// while the callbacks of those sockets do the same thing
+TEST_F(Test_Reactor, callbacks_manage_sockets)
+{
+    using Pointer = std::atomic<const zmq::socket::Subscribe*>;
+
+    auto publisher = context_.PublishSocket();
+    auto noop = zmq::ListenCallback::Factory([](auto&) -> void {});
+    auto started = std::vector<ot::OTZMQSubscribeSocket>{};
+    auto startedLock = std::mutex{};
+    auto a = Pointer{nullptr};
+    auto b = Pointer{nullptr};
+    auto aDone = std::atomic<bool>{false};
+    auto bDone = std::atomic<bool>{false};
+    const auto endpoint = endpoint_ + "/manage";
+    const auto callback = [&](Pointer& other, std::atomic<bool>& done) {
+        return zmq::ListenCallback::Factory([&](auto&) -> void {
+            if (done.load()) { return; }
+
+            auto socket = context_.SubscribeSocket(noop);
+
+            if (false == socket->Start(endpoint)) { return; }
+
+            {
+                auto lock = ot::Lock{startedLock};
+                started.emplace_back(std::move(socket));
+            }
+
+            const auto* peer = other.load();
+
+            if (nullptr != peer) { peer->Close(); }
+
+            done = true;
+        });
+    };
+    auto aCb = callback(b, aDone);
+    auto bCb = callback(a, bDone);
+    auto socketA = context_.SubscribeSocket(aCb);
+    auto socketB = context_.SubscribeSocket(bCb);
+    a = &socketA.get();
+    b = &socketB.get();
+
+    ASSERT_TRUE(publisher->Start(endpoint));
+    ASSERT_TRUE(socketA->Start(endpoint));
+    ASSERT_TRUE(socketB->Start(endpoint));
+    EXPECT_TRUE(publish_until(
+        publisher, [&] { return aDone.load() || bDone.load(); }));
+
+    // Whichever callback ran first closed the other socket, so the second
+    // callback might never run
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto lock = ot::Lock{startedLock};
+
+        if (0 < started.size()) { break; }
+
+        lock.unlock();
+        ot::Sleep(std::chrono::milliseconds(10));
+    }
+
+    auto lock = ot::Lock{startedLock};
+
+    EXPECT_LT(0, started.size());
+
+    for (auto& socket : started) { socket->Close(); }
+}
+
+// Socket operations requested from a reactor thread report their actual
+// result, and fail instead of waiting if the socket's callback is running
+TEST_F(Test_Reactor, reactor_thread_results)
+{
+    auto release = std::promise<void>{};
+    const auto wait = release.get_future().share();
+    auto busyStarted = std::atomic<bool>{false};
+    auto busyCb = zmq::ListenCallback::Factory([&](auto&) -> void {
+        busyStarted = true;
+        wait.wait();
+    });
+    auto noop = zmq::ListenCallback::Factory([](auto&) -> void {});
+    auto publisher = context_.PublishSocket();
+    auto busy = context_.SubscribeSocket(busyCb);
+    const auto endpoint = endpoint_ + "/results";
+    const auto* self = static_cast<const zmq::socket::Subscribe*>(nullptr);
+    auto results = std::promise<std::vector<bool>>{};
+    auto done = std::atomic<bool>{false};
+    auto cb = zmq::ListenCallback::Factory([&](auto&) -> void {
+        if (done.exchange(true)) { return; }
+
+        auto idle = context_.SubscribeSocket(noop);
+        auto output = std::vector<bool>{};
+        output.emplace_back(self->SetTimeouts(
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds(1000),
+            std::chrono::milliseconds(1000)));
+        output.emplace_back(idle->Start(endpoint));
+        output.emplace_back(idle->Start("not an endpoint"));
+        output.emplace_back(busy->SetTimeouts(
+            std::chrono::milliseconds(0),
+            std::chrono::milliseconds(1000),
+            std::chrono::milliseconds(1000)));
+        idle->Close();
+        results.set_value(std::move(output));
+    });
+    auto socket = context_.SubscribeSocket(cb);
+    self = &socket.get();
+    auto future = results.get_future();
+
+    ASSERT_TRUE(publisher->Start(endpoint));
+    ASSERT_TRUE(busy->Start(endpoint));
+    ASSERT_TRUE(publish_until(publisher, [&] { return busyStarted.load(); }));
+    ASSERT_TRUE(socket->Start(endpoint));
+    ASSERT_TRUE(publish_until(publisher, [&] { return done.load(); }));
+    ASSERT_EQ(
+        future.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+
+    const auto output = future.get();
+
+    ASSERT_EQ(output.size(), 4);
+    // Runs inline on the thread which is running the socket's own callback
+    EXPECT_TRUE(output.at(0));
+    // Runs on the calling thread because the socket is idle
+    EXPECT_TRUE(output.at(1));
+    EXPECT_FALSE(output.at(2));
+    // The callback of this socket is blocked
+    EXPECT_FALSE(output.at(3));
+
+    release.set_value();
+
+    EXPECT_TRUE(socket->Close());
+    EXPECT_TRUE(busy->Close());
+}
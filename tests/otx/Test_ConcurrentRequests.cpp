@@ -0,0 +1,369 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/Wallet.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/server/Manager.hpp"
+#include "opentxs/core/AddressType.hpp"
+#include "opentxs/core/Armored.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/Message.hpp"
+#include "opentxs/core/PasswordPrompt.hpp"
+#include "opentxs/core/String.hpp"
+#include "opentxs/core/contract/ServerContract.hpp"
+#include "opentxs/core/identifier/Nym.hpp"
+#include "opentxs/core/identifier/Server.hpp"
+#include "opentxs/crypto/key/Asymmetric.hpp"
+#include "opentxs/identity/Nym.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
+#include "opentxs/network/zeromq/FrameIterator.hpp"
+#include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/ListenCallback.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/network/zeromq/socket/Dealer.hpp"
+#include "opentxs/network/zeromq/socket/Socket.hpp"
+#include "opentxs/protobuf/AsymmetricKey.pb.h"  // IWYU pragma: keep
+#include "server/MessageProcessor.hpp"
+
+namespace opentxs::server
+{
+// Exposes how MessageProcessor decides which requests may run concurrently
+class MessageProcessorTest
+{
+public:
+    using Guard = MessageProcessor::ResourceLocks::Guard;
+    using Keys = MessageProcessor::ResourceLocks::Keys;
+    using ResourceLocks = MessageProcessor::ResourceLocks;
+
+    static auto IsExclusive(const Message& request) noexcept -> bool
+    {
+        return MessageProcessor::is_exclusive(request);
+    }
+    static auto ResourceKeys(const Message& request) noexcept -> Keys
+    {
+        return MessageProcessor::resource_keys(request);
+    }
+};
+}  // namespace opentxs::server
+
+namespace zmq = ot::network::zeromq;
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+using Clock = std::chrono::steady_clock;
+using Guard = ot::server::MessageProcessorTest::Guard;
+using Keys = ot::server::MessageProcessorTest::Keys;
+using Processor = ot::server::MessageProcessorTest;
+using ResourceLocks = ot::server::MessageProcessorTest::ResourceLocks;
+
+constexpr auto nym_count_ = std::size_t{8};
+constexpr auto requests_per_nym_ = std::size_t{50};
+constexpr auto reply_timeout_ = std::chrono::minutes{2};
+const auto worker_counts_ = std::vector<std::size_t>{1, 2, 4, 8};
+
+class Test_ConcurrentRequests : public ::testing::Test
+{
+public:
+    const ot::api::client::Manager& client_;
+    ot::OTPasswordPrompt reason_;
+
+    // Builds a signed pingNotary request in the form sent by
+    // otx::context::Server::PingNotary
+    auto ping(const ot::identity::Nym& nym, const ot::identifier::Server& id)
+        const -> std::string
+    {
+        auto request = client_.Factory().Message();
+
+        OT_ASSERT(request);
+
+        const auto pAuth = nym.GetPublicAuthKey().Serialize();
+        const auto pEncr = nym.GetPublicEncrKey().Serialize();
+
+        OT_ASSERT(pAuth);
+        OT_ASSERT(pEncr);
+
+        request->m_strCommand->Set("pingNotary");
+        request->m_strNymID = ot::String::Factory(nym.ID());
+        request->m_strNotaryID = ot::String::Factory(id);
+        request->m_strRequestNum = ot::String::Factory("1");
+        request->m_strNymPublicKey =
+            client_.Factory().Armored(*pAuth, "ASYMMETRIC KEY");
+        request->m_strNymID2 =
+            client_.Factory().Armored(*pEncr, "ASYMMETRIC KEY");
+
+        const auto isSigned = request->SignContract(nym, reason_);
+
+        OT_ASSERT(isSigned);
+
+        const auto saved = request->SaveContract();
+
+        OT_ASSERT(saved);
+
+        auto raw = ot::String::Factory();
+        request->SaveContractRaw(raw);
+        const auto armored = ot::Armored::Factory(raw);
+
+        return armored->Get();
+    }
+
+    // Builds an unsigned request which is only used to classify it
+    auto request(
+        const std::string& command,
+        const std::string& nym,
+        const std::string& account = {}) const -> std::unique_ptr<ot::Message>
+    {
+        auto output = client_.Factory().Message();
+
+        OT_ASSERT(output);
+
+        output->m_strCommand->Set(command.c_str());
+        output->m_strNymID->Set(nym.c_str());
+
+        if (false == account.empty()) {
+            output->m_strAcctID->Set(account.c_str());
+        }
+
+        return output;
+    }
+    // Acquires the resources of the second request on another thread while
+    // the resources of the first are held for the specified duration, and
+    // reports whether the second request had to wait for them to be released
+    static auto waits(
+        const ot::Message& held,
+        const ot::Message& next,
+        const std::chrono::seconds hold) -> bool
+    {
+        auto locks = ResourceLocks{};
+        auto released = std::atomic<bool>{false};
+        auto waited = std::atomic<bool>{false};
+        auto done = std::future<void>{};
+
+        {
+            const auto guard = Guard{locks, Processor::ResourceKeys(held)};
+            done = std::async(std::launch::async, [&] {
+                const auto guard = Guard{locks, Processor::ResourceKeys(next)};
+                waited.store(released.load());
+            });
+            done.wait_for(hold);
+            released.store(true);
+        }
+
+        done.get();
+
+        return waited.load();
+    }
+    auto succeeded(const std::string& reply) const -> bool
+    {
+        if (reply.empty()) { return false; }
+
+        auto armored = ot::Armored::Factory();
+        armored->MemSet(
+            reply.data(), static_cast<std::uint32_t>(reply.size()));
+        auto serialized = ot::String::Factory();
+        armored->GetString(serialized);
+        auto message = client_.Factory().Message();
+
+        if (false == message->LoadContractFromString(serialized)) {
+            return false;
+        }
+
+        return message->m_bSuccess;
+    }
+
+    Test_ConcurrentRequests()
+        : client_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , reason_(client_.Factory().PasswordPrompt(__FUNCTION__))
+    {
+    }
+};
+}  // namespace
+
+// Reports the request throughput of a notary as the number of worker threads
+// increases. Requests from different nyms should be processed in parallel.
+TEST_F(Test_ConcurrentRequests, throughput)
+{
+    auto nyms = std::vector<ot::Nym_p>{};
+
+    for (auto i = std::size_t{0}; i < nym_count_; ++i) {
+        nyms.emplace_back(
+            client_.Wallet().Nym(reason_, "Nym " + std::to_string(i)));
+
+        ASSERT_TRUE(nyms.back());
+    }
+
+    auto rates = std::map<std::size_t, double>{};
+    auto instance = 0;
+
+    for (const auto workers : worker_counts_) {
+        auto args = OTTestEnvironment::test_args_;
+        args[OPENTXS_ARG_NOTARY_THREADS] = {std::to_string(workers)};
+        const auto& server = ot::Context().StartServer(args, instance++, true);
+        const auto contract = server.Wallet().Server(server.ID());
+        auto host = std::string{};
+        auto port = std::uint32_t{};
+        auto type = ot::core::AddressType::Error;
+
+        ASSERT_TRUE(contract->ConnectInfo(
+            host, port, type, ot::core::AddressType::Inproc));
+
+        const auto endpoint = std::string{"inproc://opentxs/notary/"} + host +
+                              ":" + std::to_string(port);
+        const auto total = nym_count_ * requests_per_nym_;
+        auto requests = std::vector<std::string>{};
+
+        for (const auto& nym : nyms) {
+            requests.emplace_back(ping(*nym, server.ID()));
+        }
+
+        auto lock = std::mutex{};
+        auto cv = std::condition_variable{};
+        auto received = std::atomic<std::size_t>{0};
+        auto good = std::atomic<std::size_t>{0};
+        const auto callback =
+            zmq::ListenCallback::Factory([&](zmq::Message& in) -> void {
+                const auto body = in.Body();
+
+                if ((1 == body.size()) &&
+                    succeeded(std::string{*body.begin()})) {
+                    ++good;
+                }
+
+                if (total == ++received) {
+                    auto done = std::lock_guard<std::mutex>{lock};
+                    cv.notify_all();
+                }
+            });
+        auto sockets = std::vector<ot::OTZMQDealerSocket>{};
+
+        for (auto i = std::size_t{0}; i < nym_count_; ++i) {
+            auto& socket = sockets.emplace_back(client_.ZeroMQ().DealerSocket(
+                callback, zmq::socket::Socket::Direction::Connect));
+
+            ASSERT_TRUE(socket->SetServerPubkey(contract));
+            ASSERT_TRUE(socket->Start(endpoint));
+        }
+
+        const auto start = Clock::now();
+
+        for (auto r = std::size_t{0}; r < requests_per_nym_; ++r) {
+            for (auto i = std::size_t{0}; i < nym_count_; ++i) {
+                auto message = client_.ZeroMQ().Message(requests.at(i));
+                message->PrependEmptyFrame();
+
+                EXPECT_TRUE(sockets.at(i)->Send(message));
+            }
+        }
+
+        {
+            auto wait = std::unique_lock<std::mutex>{lock};
+            cv.wait_for(wait, reply_timeout_, [&] {
+                return total == received.load();
+            });
+        }
+
+        const auto elapsed =
+            std::chrono::duration<double>{Clock::now() - start}.count();
+        rates[workers] = (0 < elapsed) ? (received.load() / elapsed) : 0.0;
+        sockets.clear();
+
+        EXPECT_EQ(received.load(), total);
+        EXPECT_EQ(good.load(), total);
+    }
+
+    for (const auto& [workers, rate] : rates) {
+        std::cout << workers << " notary threads: " << rate
+                  << " requests/second\n";
+    }
+}
+
+// Requests which modify resources identified only inside their payload hold
+// the notary lock exclusively, while the rest share it
+TEST_F(Test_ConcurrentRequests, exclusive_requests)
+{
+    EXPECT_TRUE(
+        Processor::IsExclusive(*request("notarizeTransaction", "a", "1")));
+    EXPECT_TRUE(Processor::IsExclusive(*request("processInbox", "a", "1")));
+    EXPECT_FALSE(Processor::IsExclusive(*request("pingNotary", "a")));
+    EXPECT_FALSE(Processor::IsExclusive(*request("getAccountData", "a", "1")));
+    EXPECT_FALSE(Processor::IsExclusive(*request("processNymbox", "a")));
+}
+
+TEST_F(Test_ConcurrentRequests, resource_keys)
+{
+    EXPECT_EQ(
+        Processor::ResourceKeys(*request("pingNotary", "a")), Keys{"nym a"});
+    EXPECT_EQ(
+        Processor::ResourceKeys(*request("getAccountData", "a", "1")),
+        (Keys{"nym a", "account 1"}));
+
+    auto message = request("sendNymMessage", "a");
+    message->m_strNymID2->Set("b");
+
+    EXPECT_EQ(Processor::ResourceKeys(*message), (Keys{"nym a", "nym b"}));
+}
+
+// Requests from different nyms on the same account are serialized
+TEST_F(Test_ConcurrentRequests, same_account)
+{
+    const auto first = request("getAccountData", "a", "1");
+    const auto second = request("getAccountData", "b", "1");
+
+    EXPECT_TRUE(waits(*first, *second, 1s));
+}
+
+// Requests from the same nym are serialized even if they name different
+// accounts
+TEST_F(Test_ConcurrentRequests, same_nym)
+{
+    const auto first = request("getAccountData", "a", "1");
+    const auto second = request("getAccountData", "a", "2");
+
+    EXPECT_TRUE(waits(*first, *second, 1s));
+}
+
+// Requests from different nyms on disjoint accounts run in parallel
+TEST_F(Test_ConcurrentRequests, disjoint_accounts)
+{
+    const auto first = request("getAccountData", "a", "1");
+    const auto second = request("getAccountData", "b", "2");
+
+    EXPECT_FALSE(waits(*first, *second, 60s));
+}
+
+// A request naming another nym as its recipient is serialized with requests
+// from that nym
+TEST_F(Test_ConcurrentRequests, recipient)
+{
+    auto first = request("sendNymMessage", "a");
+    first->m_strNymID2->Set("b");
+    const auto second = request("getAccountData", "b", "2");
+    const auto third = request("getAccountData", "c", "3");
+
+    EXPECT_TRUE(waits(*first, *second, 1s));
+    EXPECT_FALSE(waits(*first, *third, 60s));
+}
@@ -0,0 +1,692 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OTLowLevelTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Editor.hpp"
+#include "opentxs/api/storage/Driver.hpp"
+#include "opentxs/contact/ContactItemType.hpp"
+#include "opentxs/core/Flag.hpp"
+#include "opentxs/core/Identifier.hpp"
+#include "opentxs/core/identifier/Nym.hpp"
+#include "opentxs/core/identifier/Server.hpp"
+#include "opentxs/core/identifier/UnitDefinition.hpp"
+#include "storage/Journal.hpp"
+#include "storage/Reachability.hpp"
+#include "storage/tree/Accounts.hpp"
+#include "storage/tree/Root.hpp"
+#include "storage/tree/Tree.hpp"
+
+namespace opentxs::storage
+{
+// Runs collection on a root directly, as api::storage::Storage does from its
+// background thread
+class RootTest
+{
+public:
+    static auto Collect(const Root& root, const api::storage::Driver& to)
+        -> void
+    {
+        root.collect_garbage(&to);
+    }
+    static auto Hash(const Root& root) -> std::string
+    {
+        return root.Node::Root();
+    }
+    static auto Make(
+        const api::storage::Driver& driver,
+        const std::string& hash,
+        Flag& bucket) -> std::unique_ptr<Root>
+    {
+        return std::unique_ptr<Root>{new Root{driver, hash, 1, bucket}};
+    }
+    static auto SaveIndex(const Root& root) -> void { root.save_gc_index(); }
+};
+}  // namespace opentxs::storage
+
+namespace
+{
+constexpr auto object_count_ = std::size_t{1000000};
+constexpr auto garbage_ratio_ = std::size_t{10};
+constexpr auto object_size_ = std::size_t{256};
+constexpr auto account_count_ = std::size_t{200};
+constexpr auto account_size_ = std::size_t{1024};
+constexpr auto slice_ = std::chrono::milliseconds{10};
+
+using Objects = std::map<std::string, std::string>;
+
+// Cost of one collection, measured the same way for every collector
+struct Result {
+    std::chrono::microseconds elapsed_{};
+    std::size_t written_{};
+    std::size_t deleted_{};
+    std::size_t remaining_{};
+};
+
+template <typename Driver, typename Job>
+auto measure(Driver& driver, Job job) -> Result
+{
+    const auto before = driver.Size();
+    driver.bytes_written_ = 0;
+    const auto start = std::chrono::steady_clock::now();
+    job();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto after = driver.Size();
+
+    return {
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+        driver.bytes_written_,
+        before - after,
+        after};
+}
+
+auto report(const std::string& name, const Result& result) -> void
+{
+    std::cout << name << ": " << result.elapsed_.count() << " us, "
+              << result.written_ << " bytes written, " << result.deleted_
+              << " objects deleted, " << result.remaining_
+              << " objects remaining\n";
+}
+
+// Two bucket in-memory store which counts bytes written
+class CountingDriver final : virtual public ot::api::storage::Driver
+{
+public:
+    mutable std::size_t bytes_written_{};
+
+    auto Delete(const std::string& key) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        a_.erase(key);
+        b_.erase(key);
+
+        return true;
+    }
+    auto EmptyBucket(const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        get(bucket).clear();
+
+        return true;
+    }
+    auto Exists(const std::string& key) const -> bool
+    {
+        ot::Lock lock(lock_);
+
+        return (0 < a_.count(key)) || (0 < b_.count(key));
+    }
+    auto Load(const std::string& key, const bool, std::string& value) const
+        -> bool final
+    {
+        return LoadFromBucket(key, value, true) ||
+               LoadFromBucket(key, value, false);
+    }
+    auto LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        const auto& map = get(bucket);
+        const auto it = map.find(key);
+
+        if (map.end() == it) { return false; }
+
+        value = it->second;
+
+        return true;
+    }
+    auto LoadRoot() const -> std::string final { return {}; }
+    auto Migrate(const std::string& key, const Driver& to) const -> bool final
+    {
+        auto value = std::string{};
+
+        if (false == LoadFromBucket(key, value, true)) { return false; }
+
+        return to.Store(false, key, value, false);
+    }
+    // Replaces the contents of the store with the specified objects, all in
+    // the current bucket
+    auto Reset(const Objects& objects) -> void
+    {
+        ot::Lock lock(lock_);
+        a_ = objects;
+        b_.clear();
+        bytes_written_ = 0;
+    }
+    auto Size() const -> std::size_t
+    {
+        ot::Lock lock(lock_);
+
+        return a_.size() + b_.size();
+    }
+    auto Store(
+        const bool,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        get(bucket)[key] = value;
+        bytes_written_ += key.size() + value.size();
+
+        return true;
+    }
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const final
+    {
+        promise.set_value(Store(isTransaction, key, value, bucket));
+    }
+    auto Store(const bool, const std::string&, std::string&) const
+        -> bool final
+    {
+        return false;
+    }
+    auto StoreRoot(const bool, const std::string&) const -> bool final
+    {
+        return true;
+    }
+
+private:
+    mutable std::mutex lock_{};
+    mutable Objects a_{};
+    mutable Objects b_{};
+
+    auto get(const bool bucket) const -> Objects&
+    {
+        return bucket ? a_ : b_;
+    }
+};
+
+// Every collector runs against the same store of one million objects, of
+// which every tenth is garbage. The store is expensive to build so the suite
+// builds it once and each test starts from a copy.
+class Test_GarbageCollection : public ::testing::Test
+{
+public:
+    using Index = ot::storage::Reachability::References;
+
+    static Objects objects_;
+    static std::vector<std::string> live_;
+    static std::vector<std::string> dead_;
+    // Every object was reachable when the previous collection finished
+    static Index previous_;
+    static Index reachable_;
+
+    CountingDriver driver_;
+
+    static void SetUpTestSuite()
+    {
+        const auto value = std::string(object_size_, 'x');
+
+        for (auto i = std::size_t{0}; i < object_count_; ++i) {
+            const auto key = std::to_string(i);
+            objects_.emplace(key, value);
+            previous_.emplace(key, 1);
+
+            if (0 == (i % garbage_ratio_)) {
+                dead_.emplace_back(key);
+            } else {
+                live_.emplace_back(key);
+                reachable_.emplace(key, 1);
+            }
+        }
+    }
+    static void TearDownTestSuite()
+    {
+        objects_.clear();
+        live_.clear();
+        dead_.clear();
+        previous_.clear();
+        reachable_.clear();
+    }
+
+    auto survived() const -> bool
+    {
+        for (const auto& key : live_) {
+            if (false == driver_.Exists(key)) { return false; }
+        }
+
+        return true;
+    }
+
+    Test_GarbageCollection()
+        : driver_()
+    {
+        driver_.Reset(objects_);
+    }
+};
+
+Objects Test_GarbageCollection::objects_{};
+std::vector<std::string> Test_GarbageCollection::live_{};
+std::vector<std::string> Test_GarbageCollection::dead_{};
+Test_GarbageCollection::Index Test_GarbageCollection::previous_{};
+Test_GarbageCollection::Index Test_GarbageCollection::reachable_{};
+
+// Full collection copies every reachable object to the other bucket and then
+// empties the bucket which held the garbage
+TEST_F(Test_GarbageCollection, bucket_swap)
+{
+    const auto result = measure(driver_, [&] {
+        for (const auto& key : live_) {
+            EXPECT_TRUE(driver_.Migrate(key, driver_));
+        }
+
+        EXPECT_TRUE(driver_.EmptyBucket(true));
+    });
+
+    EXPECT_EQ(result.deleted_, dead_.size());
+    EXPECT_EQ(result.remaining_, live_.size());
+    EXPECT_GT(result.written_, live_.size() * object_size_);
+    EXPECT_TRUE(survived());
+
+    report("Bucket swap", result);
+}
+
+// Incremental collection compares the reachable objects with the index from
+// the previous collection and deletes the difference in time limited slices,
+// as Root::collect_incremental does after marking
+TEST_F(Test_GarbageCollection, incremental_sweep)
+{
+    const auto journal = ot::storage::Journal{driver_};
+    auto slices = std::size_t{0};
+    const auto result = measure(driver_, [&] {
+        auto garbage = std::vector<std::string>{};
+
+        for (const auto& [key, count] : previous_) {
+            if (0 == reachable_.count(key)) { garbage.emplace_back(key); }
+        }
+
+        auto position = std::size_t{0};
+
+        while (position < garbage.size()) {
+            journal.Sweep(garbage, position, slice_);
+            ++slices;
+        }
+    });
+
+    EXPECT_EQ(result.deleted_, dead_.size());
+    EXPECT_EQ(result.remaining_, live_.size());
+    EXPECT_EQ(result.written_, 0u);
+    EXPECT_TRUE(survived());
+
+    report("Incremental sweep (" + std::to_string(slices) + " slices)", result);
+}
+TEST_F(Test_GarbageCollection, rewritten_objects_survive_sweep)
+{
+    const auto journal = ot::storage::Journal{driver_};
+    const auto value = std::string(object_size_, 'y');
+    const auto& key = dead_.front();
+
+    EXPECT_TRUE(journal.Store(false, key, value, true));
+
+    auto position = std::size_t{0};
+    const auto deleted =
+        journal.Sweep(dead_, position, std::chrono::milliseconds{60000});
+
+    EXPECT_EQ(deleted, dead_.size() - 1);
+    EXPECT_TRUE(driver_.Exists(key));
+    EXPECT_EQ(journal.Reset().count(key), std::size_t{1});
+}
+
+// Content addressed two bucket store which writes to the bucket selected by
+// the root, in the same way as the storage plugins
+class BucketDriver final : virtual public ot::api::storage::Driver
+{
+public:
+    mutable std::size_t bytes_written_{};
+
+    static auto Key(const std::string& value) -> std::string
+    {
+        auto output = std::array<char, 33>{};
+        std::snprintf(
+            output.data(),
+            output.size(),
+            "%016zx%016zx",
+            std::hash<std::string>{}(value),
+            value.size());
+
+        return output.data();
+    }
+
+    auto Delete(const std::string& key) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        a_.erase(key);
+        b_.erase(key);
+
+        return true;
+    }
+    auto EmptyBucket(const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        get(bucket).clear();
+
+        return true;
+    }
+    auto Exists(const std::string& key) const -> bool
+    {
+        ot::Lock lock(lock_);
+
+        return (0 < a_.count(key)) || (0 < b_.count(key));
+    }
+    auto Load(const std::string& key, const bool, std::string& value) const
+        -> bool final
+    {
+        return LoadFromBucket(key, value, bucket_) ||
+               LoadFromBucket(key, value, !bucket_);
+    }
+    auto LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        const auto& map = get(bucket);
+        const auto it = map.find(key);
+
+        if (map.end() == it) { return false; }
+
+        value = it->second;
+
+        return true;
+    }
+    auto LoadRoot() const -> std::string final
+    {
+        ot::Lock lock(lock_);
+
+        return root_;
+    }
+    auto Migrate(const std::string& key, const Driver& to) const -> bool final
+    {
+        const bool target{bucket_};
+        const auto source = (&to == this) ? !target : target;
+        auto value = std::string{};
+
+        if (LoadFromBucket(key, value, source)) {
+            return to.Store(false, key, value, target);
+        }
+
+        return to.LoadFromBucket(key, value, target);
+    }
+    auto Size() const -> std::size_t
+    {
+        ot::Lock lock(lock_);
+
+        return a_.size() + b_.size();
+    }
+    auto Store(
+        const bool,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        get(bucket)[key] = value;
+        bytes_written_ += key.size() + value.size();
+
+        return true;
+    }
+    void Store(
+        const bool isTransaction,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>& promise) const final
+    {
+        promise.set_value(Store(isTransaction, key, value, bucket));
+    }
+    auto Store(
+        const bool isTransaction,
+        const std::string& value,
+        std::string& key) const -> bool final
+    {
+        key = Key(value);
+
+        return Store(isTransaction, key, value, bucket_);
+    }
+    auto StoreRoot(const bool, const std::string& hash) const -> bool final
+    {
+        ot::Lock lock(lock_);
+        root_ = hash;
+
+        return true;
+    }
+
+    BucketDriver(const ot::Flag& bucket)
+        : bucket_(bucket)
+    {
+    }
+
+private:
+    const ot::Flag& bucket_;
+    mutable std::mutex lock_{};
+    mutable Objects a_{};
+    mutable Objects b_{};
+    mutable std::string root_{};
+
+    auto get(const bool bucket) const -> Objects&
+    {
+        return bucket ? a_ : b_;
+    }
+};
+
+// Collects garbage from a real storage tree holding raw account data
+class Test_RootCollection : public ::testing::Test
+{
+public:
+    using Collector = ot::storage::RootTest;
+
+    const ot::api::Context& otx_;
+    ot::OTFlag bucket_;
+    BucketDriver driver_;
+    std::unique_ptr<ot::storage::Root> root_;
+    const ot::OTNymID nym_;
+    const ot::OTServerID server_;
+    const ot::OTUnitID unit_;
+    std::map<std::string, std::string> accounts_;
+
+    static auto data(const std::string& id, const std::size_t revision)
+        -> std::string
+    {
+        auto output = id + ":" + std::to_string(revision) + ":";
+        output.resize(account_size_, 'x');
+
+        return output;
+    }
+
+    auto collect() -> void { Collector::Collect(*root_, driver_); }
+    auto remove(const std::string& id) -> bool
+    {
+        accounts_.erase(id);
+
+        return root_->mutable_Tree()
+            .get()
+            .mutable_Accounts()
+            .get()
+            .Delete(id);
+    }
+    auto store(const std::string& id, const std::size_t revision) -> bool
+    {
+        const auto& value = accounts_[id] = data(id, revision);
+
+        return root_->mutable_Tree().get().mutable_Accounts().get().Store(
+            id,
+            value,
+            "",
+            nym_,
+            nym_,
+            nym_,
+            server_,
+            unit_,
+            ot::contact::ContactItemType::USD);
+    }
+    // Every account must load from the tree with its latest data
+    auto verify() const -> bool
+    {
+        const auto& accounts = root_->Tree().Accounts();
+
+        for (const auto& [id, expected] : accounts_) {
+            auto value = std::string{};
+            auto alias = std::string{};
+
+            if (false == accounts.Load(id, value, alias, false)) {
+                return false;
+            }
+
+            if (expected != value) { return false; }
+
+            if (false == driver_.Exists(BucketDriver::Key(expected))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Test_RootCollection()
+        : otx_(ot::InitContext(OTLowLevelTestEnvironment::test_args_))
+        , bucket_(ot::Flag::Factory(false))
+        , driver_(bucket_)
+        , root_(Collector::Make(driver_, "", bucket_))
+        , nym_(ot::identifier::Nym::Factory(ot::Identifier::Random()->str()))
+        , server_(
+              ot::identifier::Server::Factory(ot::Identifier::Random()->str()))
+        , unit_(ot::identifier::UnitDefinition::Factory(
+              ot::Identifier::Random()->str()))
+        , accounts_()
+    {
+    }
+
+    ~Test_RootCollection() override
+    {
+        root_.reset();
+        ot::Cleanup();
+    }
+};
+
+// The first collection has no index so it migrates every reachable object.
+// Later collections only delete what is no longer reachable, without
+// rewriting any live objects.
+TEST_F(Test_RootCollection, incremental)
+{
+    auto ids = std::vector<std::string>{};
+
+    for (auto i = std::size_t{0}; i < account_count_; ++i) {
+        ids.emplace_back(ot::Identifier::Random()->str());
+
+        ASSERT_TRUE(store(ids.back(), 0));
+    }
+
+    // Each revision replaces the previous data and index nodes
+    for (auto i = std::size_t{0}; i < account_count_; i += 2) {
+        ASSERT_TRUE(store(ids.at(i), 1));
+    }
+
+    const auto full = measure(driver_, [&] { collect(); });
+
+    EXPECT_LT(0u, full.deleted_);
+    EXPECT_GT(full.written_, account_count_ * account_size_);
+    EXPECT_TRUE(verify());
+
+    auto dead = std::vector<std::string>{};
+
+    for (auto i = std::size_t{0}; i < account_count_; i += 4) {
+        dead.emplace_back(BucketDriver::Key(accounts_.at(ids.at(i))));
+
+        ASSERT_TRUE(remove(ids.at(i)));
+    }
+
+    for (auto i = std::size_t{1}; i < account_count_; i += 4) {
+        dead.emplace_back(BucketDriver::Key(accounts_.at(ids.at(i))));
+
+        ASSERT_TRUE(store(ids.at(i), 2));
+    }
+
+    // Written and orphaned between collections
+    ASSERT_TRUE(store(ids.at(2), 3));
+    dead.emplace_back(BucketDriver::Key(accounts_.at(ids.at(2))));
+    ASSERT_TRUE(store(ids.at(2), 4));
+
+    for (const auto& key : dead) { ASSERT_TRUE(driver_.Exists(key)); }
+
+    const auto incremental = measure(driver_, [&] { collect(); });
+
+    EXPECT_TRUE(verify());
+    EXPECT_GE(incremental.deleted_, dead.size());
+    EXPECT_LT(incremental.written_, account_size_);
+
+    for (const auto& key : dead) { EXPECT_FALSE(driver_.Exists(key)); }
+
+    report("Full collection", full);
+    report("Incremental collection", incremental);
+}
+
+// An index saved at shutdown lets the next session collect incrementally,
+// including objects written after the last collection of the previous one
+TEST_F(Test_RootCollection, saved_index)
+{
+    const auto first = ot::Identifier::Random()->str();
+    const auto second = ot::Identifier::Random()->str();
+
+    ASSERT_TRUE(store(first, 0));
+    ASSERT_TRUE(store(second, 0));
+
+    collect();
+
+    ASSERT_TRUE(verify());
+
+    const auto orphaned = BucketDriver::Key(accounts_.at(first));
+
+    ASSERT_TRUE(store(first, 1));
+
+    // Storage publishes the root after every change and saves the index at
+    // shutdown
+    ASSERT_TRUE(driver_.StoreRoot(true, Collector::Hash(*root_)));
+
+    Collector::SaveIndex(*root_);
+    root_ = Collector::Make(driver_, driver_.LoadRoot(), bucket_);
+
+    ASSERT_TRUE(verify());
+
+    const auto removed = BucketDriver::Key(accounts_.at(second));
+
+    ASSERT_TRUE(remove(second));
+
+    driver_.bytes_written_ = 0;
+    collect();
+
+    EXPECT_TRUE(verify());
+    EXPECT_FALSE(driver_.Exists(orphaned));
+    EXPECT_FALSE(driver_.Exists(removed));
+    EXPECT_LT(driver_.bytes_written_, account_size_);
+
+    // The saved index is consumed by the collection which loads it
+    auto index = std::string{};
+
+    EXPECT_FALSE(driver_.Load("gcindex", false, index));
+}
+}  // namespace
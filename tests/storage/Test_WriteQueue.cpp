@@ -0,0 +1,380 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/core/Flag.hpp"
+#include "storage/Plugin.hpp"
+#include "storage/StorageConfig.hpp"
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+using Future = std::future<bool>;
+// Transaction mode, bucket, and size of each batch passed to store_batch()
+using Batches = std::vector<std::tuple<bool, bool, std::size_t>>;
+
+constexpr auto batch_size_ = std::size_t{4};
+
+// Two bucket in-memory driver which records how writes reach it and fails
+// writes to selected keys
+class MemoryDriver final : public ot::Plugin
+{
+public:
+    std::set<std::string> fail_;
+
+    auto Recorded() const -> Batches
+    {
+        auto lock = ot::Lock{lock_};
+
+        return recorded_;
+    }
+    auto Cleanup() -> void final { stop_write_queue(); }
+    auto EmptyBucket(const bool bucket) const -> bool final
+    {
+        auto lock = ot::Lock{lock_};
+        get(bucket).clear();
+
+        return true;
+    }
+    auto LoadFromBucket(
+        const std::string& key,
+        std::string& value,
+        const bool bucket) const -> bool final
+    {
+        auto lock = ot::Lock{lock_};
+        const auto& map = get(bucket);
+        const auto it = map.find(key);
+
+        if (map.end() == it) { return false; }
+
+        value = it->second;
+
+        return true;
+    }
+    auto LoadRoot() const -> std::string final { return {}; }
+    auto StoreRoot(const bool, const std::string&) const -> bool final
+    {
+        return true;
+    }
+    // Keys in the order they were written
+    auto Written() const -> std::vector<std::string>
+    {
+        auto lock = ot::Lock{lock_};
+
+        return written_;
+    }
+
+    MemoryDriver(
+        const ot::api::storage::Storage& storage,
+        const ot::StorageConfig& config,
+        const ot::Flag& bucket)
+        : ot::Plugin(storage, config, digest_, random_, bucket)
+        , fail_()
+        , lock_()
+        , a_()
+        , b_()
+        , recorded_()
+        , written_()
+    {
+    }
+
+    ~MemoryDriver() final { Cleanup(); }
+
+private:
+    static const ot::Digest digest_;
+    static const ot::Random random_;
+
+    mutable std::mutex lock_;
+    mutable std::map<std::string, std::string> a_;
+    mutable std::map<std::string, std::string> b_;
+    mutable Batches recorded_;
+    mutable std::vector<std::string> written_;
+
+    auto delete_key(const std::string& key, const bool bucket) const
+        -> bool final
+    {
+        auto lock = ot::Lock{lock_};
+        get(bucket).erase(key);
+
+        return true;
+    }
+    auto get(const bool bucket) const -> std::map<std::string, std::string>&
+    {
+        return bucket ? a_ : b_;
+    }
+    void store(
+        const bool,
+        const std::string& key,
+        const std::string& value,
+        const bool bucket,
+        std::promise<bool>* promise) const final
+    {
+        auto lock = ot::Lock{lock_};
+        written_.emplace_back(key);
+
+        if (0 < fail_.count(key)) {
+            promise->set_value(false);
+
+            return;
+        }
+
+        get(bucket)[key] = value;
+        promise->set_value(true);
+    }
+    void store_batch(
+        const bool isTransaction,
+        const bool bucket,
+        WriteBatch& batch) const final
+    {
+        {
+            auto lock = ot::Lock{lock_};
+            recorded_.emplace_back(isTransaction, bucket, batch.size());
+        }
+
+        Plugin::store_batch(isTransaction, bucket, batch);
+    }
+};
+
+const ot::Digest MemoryDriver::digest_{};
+const ot::Random MemoryDriver::random_{};
+
+class Test_WriteQueue : public ::testing::Test
+{
+public:
+    const ot::api::client::Manager& api_;
+    const ot::OTFlag bucket_;
+    ot::StorageConfig config_;
+    std::unique_ptr<MemoryDriver> driver_;
+    // Promises must outlive the writes which satisfy them
+    std::vector<std::unique_ptr<std::promise<bool>>> promises_;
+
+    static auto ready(Future& future) -> bool
+    {
+        return std::future_status::ready == future.wait_for(0s);
+    }
+
+    // Writes which do not fill a batch wait for the flush interval, which
+    // is longer than any test, so they are only written by a full batch or
+    // when the queue is stopped
+    auto start(const std::size_t queueLimit = 64) -> void
+    {
+        config_.write_batch_size_ = batch_size_;
+        config_.write_queue_limit_ = queueLimit;
+        config_.write_flush_interval_ = 1h;
+        driver_ = std::make_unique<MemoryDriver>(
+            api_.Storage(), config_, bucket_.get());
+    }
+    auto store(
+        const std::string& key,
+        const bool bucket = true,
+        const bool isTransaction = true) -> Future
+    {
+        auto& promise =
+            promises_.emplace_back(std::make_unique<std::promise<bool>>());
+        auto future = promise->get_future();
+        driver_->Store(isTransaction, key, "value " + key, bucket, *promise);
+
+        return future;
+    }
+
+    Test_WriteQueue()
+        : api_(ot::Context().StartClient({}, 0))
+        , bucket_(ot::Flag::Factory(true))
+        , config_()
+        , driver_()
+        , promises_()
+    {
+    }
+
+    ~Test_WriteQueue() override
+    {
+        // The driver must stop before the promises it writes to are released
+        driver_.reset();
+    }
+};
+}  // namespace
+
+TEST_F(Test_WriteQueue, batching)
+{
+    start();
+    auto futures = std::vector<Future>{};
+
+    for (auto i = 0; i < 10; ++i) {
+        futures.emplace_back(store(std::to_string(i)));
+    }
+
+    // Two full batches are written, the remainder waits for more writes
+    for (auto i = std::size_t{0}; i < 8u; ++i) {
+        EXPECT_TRUE(futures.at(i).get());
+    }
+
+    EXPECT_FALSE(ready(futures.at(8)));
+    EXPECT_FALSE(ready(futures.at(9)));
+
+    const auto stats = driver_->WriteQueue();
+
+    EXPECT_EQ(stats.batches_, 2u);
+    EXPECT_EQ(stats.writes_, 8u);
+    EXPECT_EQ(stats.largest_batch_, batch_size_);
+    EXPECT_EQ(stats.last_batch_, batch_size_);
+    EXPECT_EQ(stats.queue_depth_, 2u);
+    EXPECT_GE(stats.max_queue_depth_, batch_size_);
+
+    const auto expected = Batches{
+        {true, true, batch_size_},
+        {true, true, batch_size_},
+    };
+
+    EXPECT_EQ(driver_->Recorded(), expected);
+
+    // A write which completes a batch releases the writes waiting in it
+    futures.emplace_back(store("10"));
+    futures.emplace_back(store("11"));
+
+    for (auto i = std::size_t{8}; i < 12u; ++i) {
+        EXPECT_TRUE(futures.at(i).get());
+    }
+
+    EXPECT_EQ(driver_->WriteQueue().batches_, 3u);
+    EXPECT_EQ(driver_->WriteQueue().queue_depth_, 0u);
+}
+
+// Writes in one batch are grouped by bucket and transaction mode, and the
+// order they were submitted in is preserved within each group
+TEST_F(Test_WriteQueue, grouping)
+{
+    start();
+    auto futures = std::vector<Future>{};
+    futures.emplace_back(store("a", true));
+    futures.emplace_back(store("b", false));
+    futures.emplace_back(store("c", true));
+    futures.emplace_back(store("d", true, false));
+
+    for (auto& future : futures) { EXPECT_TRUE(future.get()); }
+
+    const auto expectedBatches = Batches{
+        {false, true, 1},
+        {true, false, 1},
+        {true, true, 2},
+    };
+    const auto expectedWritten = std::vector<std::string>{"d", "b", "a", "c"};
+
+    EXPECT_EQ(driver_->Recorded(), expectedBatches);
+    EXPECT_EQ(driver_->Written(), expectedWritten);
+
+    auto value = std::string{};
+
+    EXPECT_TRUE(driver_->LoadFromBucket("a", value, true));
+    EXPECT_EQ(value, "value a");
+    EXPECT_TRUE(driver_->LoadFromBucket("b", value, false));
+    EXPECT_FALSE(driver_->LoadFromBucket("b", value, true));
+}
+
+// Stopping the queue writes every item still waiting in it, and later writes
+// are performed synchronously
+TEST_F(Test_WriteQueue, flush_on_shutdown)
+{
+    start();
+    auto futures = std::vector<Future>{};
+
+    for (auto i = 0; i < 3; ++i) {
+        futures.emplace_back(store(std::to_string(i)));
+    }
+
+    for (auto& future : futures) { EXPECT_FALSE(ready(future)); }
+
+    driver_->Cleanup();
+
+    for (auto& future : futures) {
+        ASSERT_TRUE(ready(future));
+        EXPECT_TRUE(future.get());
+    }
+
+    const auto stats = driver_->WriteQueue();
+
+    EXPECT_EQ(stats.batches_, 1u);
+    EXPECT_EQ(stats.writes_, 3u);
+    EXPECT_EQ(stats.last_batch_, 3u);
+    EXPECT_EQ(stats.queue_depth_, 0u);
+
+    auto late = store("late");
+
+    ASSERT_TRUE(ready(late));
+    EXPECT_TRUE(late.get());
+    EXPECT_EQ(driver_->WriteQueue().writes_, 3u);
+
+    auto value = std::string{};
+
+    EXPECT_TRUE(driver_->LoadFromBucket("late", value, true));
+
+    // Stopping twice is harmless
+    driver_->Cleanup();
+}
+
+// A failed write is reported to the caller which submitted it without
+// affecting the other writes in its batch
+TEST_F(Test_WriteQueue, error_propagation)
+{
+    start();
+    driver_->fail_.emplace("1");
+    driver_->fail_.emplace("3");
+    auto futures = std::vector<Future>{};
+
+    for (auto i = 0; i < 4; ++i) {
+        futures.emplace_back(store(std::to_string(i)));
+    }
+
+    EXPECT_TRUE(futures.at(0).get());
+    EXPECT_FALSE(futures.at(1).get());
+    EXPECT_TRUE(futures.at(2).get());
+    EXPECT_FALSE(futures.at(3).get());
+    EXPECT_EQ(driver_->WriteQueue().writes_, 4u);
+
+    auto value = std::string{};
+
+    EXPECT_TRUE(driver_->LoadFromBucket("2", value, true));
+    EXPECT_FALSE(driver_->LoadFromBucket("3", value, true));
+
+    // Synchronous writes report failures the same way
+    EXPECT_FALSE(driver_->Store(true, "1", "value", true));
+    EXPECT_TRUE(driver_->Store(true, "4", "value", true));
+}
+
+// A full queue blocks further writes until the write thread makes room
+TEST_F(Test_WriteQueue, queue_limit)
+{
+    start(batch_size_);
+    auto futures = std::vector<Future>{};
+
+    for (auto i = std::size_t{0}; i < (3u * batch_size_); ++i) {
+        futures.emplace_back(store(std::to_string(i)));
+    }
+
+    for (auto& future : futures) { EXPECT_TRUE(future.get()); }
+
+    const auto stats = driver_->WriteQueue();
+
+    EXPECT_EQ(stats.batches_, 3u);
+    EXPECT_EQ(stats.writes_, 3u * batch_size_);
+    EXPECT_LE(stats.max_queue_depth_, batch_size_);
+}